@@ -0,0 +1,613 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+// Measures the hot paths of the library on fixed datasets, every dataset is generated from a constant seed so runs on
+// different builds can be compared line by line.
+//
+// Usage : EncodeBenchmark [filter] [--quick]
+//      filter      Only run the benchmarks that contain this text, for example "json" or "string-records".
+//      --quick     Measure each benchmark for 20ms instead of 200ms.
+//
+// Each line reports the mean time per operation, the throughput in MB of encoded data per second, when the operation
+// has an encoded size, and the number of allocations per operation made through the allocator that is passed to the
+// library. GenericValue nodes are created with the value's own allocator, normally the default one, so they are only
+// included in that count when the library and the benchmark are compiled with SOLAIRE_ENCODE_STATS defined, otherwise
+// the header says that they are missing.
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include "Solaire/Encode/BinaryFormat.hpp"
+#include "Solaire/Encode/BufferIStream.hpp"
+#include "Solaire/Encode/BufferOStream.hpp"
+#include "Solaire/Encode/CompressedFormat.hpp"
+#include "Solaire/Encode/EncodeStats.hpp"
+#include "Solaire/Encode/GenericDocument.hpp"
+#include "Solaire/Encode/JsonFormat.hpp"
+#include "Solaire/Encode/KeyTable.hpp"
+#include "Solaire/Encode/Reflection.hpp"
+#include "Solaire/Encode/SchemaFormat.hpp"
+
+namespace Solaire {
+
+    struct BenchmarkRecord {
+        uint32_t id;
+        double score;
+        bool active;
+        CString name;
+        ArrayList<int32_t> history;
+
+        BenchmarkRecord() :
+            id(0),
+            score(0.0),
+            active(false),
+            name(getDefaultAllocator()),
+            history(getDefaultAllocator())
+        {}
+    };
+}
+
+SOLAIRE_ENCODE_BEGIN(Solaire::BenchmarkRecord)
+    SOLAIRE_ENCODE_FIELD(id)
+    SOLAIRE_ENCODE_FIELD(score)
+    SOLAIRE_ENCODE_FIELD(active)
+    SOLAIRE_ENCODE_FIELD(name)
+    SOLAIRE_ENCODE_FIELD(history)
+SOLAIRE_ENCODE_END
+
+namespace Solaire {
+
+    enum : uint64_t {
+        DATASET_SEED = 0x9E3779B97F4A7C15ULL
+    };
+
+    enum : uint32_t {
+        NUMERIC_COUNT = 8192,
+        WIDE_MEMBERS = 1024,
+        DEEP_LEVELS = 200,
+        STRING_RECORDS = 512
+    };
+
+    static volatile uint64_t gSink = 0;
+
+    static SOLAIRE_FORCE_INLINE void consume(const uint64_t aValue) throw() {
+        gSink = gSink + aValue;
+    }
+
+    static SOLAIRE_FORCE_INLINE uint64_t nextRandom(uint64_t& aState) throw() {
+        // xorshift64*, the same sequence on every platform
+        aState ^= aState >> 12;
+        aState ^= aState << 25;
+        aState ^= aState >> 27;
+        return aState * 0x2545F4914F6CDD1DULL;
+    }
+
+    static void randomText(uint64_t& aState, char* const aText, const uint32_t aLength) throw() {
+        static const char CHARACTERS[] = "abcdefghijklmnopqrstuvwxyz ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+        for(uint32_t i = 0; i < aLength; ++i) aText[i] = CHARACTERS[nextRandom(aState) % (sizeof(CHARACTERS) - 1)];
+    }
+
+    static GenericValue makeNumericArray(Allocator& aAllocator) throw() {
+        uint64_t state = DATASET_SEED;
+        GenericValue value;
+        value.setArray();
+        value.reserve(NUMERIC_COUNT);
+        for(uint32_t i = 0; i < NUMERIC_COUNT; ++i) {
+            const uint64_t random = nextRandom(state);
+            if(i & 1) {
+                value.pushBack(GenericValue(static_cast<double>(random >> 11) / 9007199254740992.0 * 1000.0));
+            }else {
+                value.pushBack(GenericValue(static_cast<int64_t>(random >> 32) - INT32_MAX));
+            }
+        }
+        return value;
+    }
+
+    static GenericValue makeWideObject(Allocator& aAllocator) throw() {
+        uint64_t state = DATASET_SEED + 1;
+        GenericValue value;
+        value.setObject();
+        value.reserve(WIDE_MEMBERS);
+        char text[32];
+        for(uint32_t i = 0; i < WIDE_MEMBERS; ++i) {
+            const int length = std::snprintf(text, sizeof(text), "field_%04u", static_cast<unsigned>(i));
+            const CString name(aAllocator, text, static_cast<uint32_t>(length));
+            const uint64_t random = nextRandom(state);
+            switch(i % 4) {
+            case 0:
+                value.emplace(name, GenericValue(random % 100000));
+                break;
+            case 1:
+                value.emplace(name, GenericValue(static_cast<double>(random % 1000000) / 100.0));
+                break;
+            case 2:
+                value.emplace(name, GenericValue((random & 1) != 0));
+                break;
+            default:
+                {
+                    GenericValue member;
+                    randomText(state, text, 12);
+                    member.setString(text, 12);
+                    value.emplace(name, std::move(member));
+                }
+                break;
+            }
+        }
+        return value;
+    }
+
+    static GenericValue makeDeepNesting(Allocator& aAllocator) throw() {
+        const CString level(aAllocator, "level", 5);
+        const CString child(aAllocator, "child", 5);
+        GenericValue value(static_cast<uint64_t>(DEEP_LEVELS));
+        for(uint32_t i = DEEP_LEVELS; i > 0; --i) {
+            GenericValue parent;
+            if(i & 1) {
+                parent.setObject();
+                parent.emplace(level, GenericValue(static_cast<uint64_t>(i)));
+                parent.emplace(child, std::move(value));
+            }else {
+                parent.setArray();
+                parent.pushBack(GenericValue(static_cast<uint64_t>(i)));
+                parent.pushBack(std::move(value));
+            }
+            value = std::move(parent);
+        }
+        return value;
+    }
+
+    static GenericValue makeStringRecords(Allocator& aAllocator) throw() {
+        uint64_t state = DATASET_SEED + 2;
+        const CString id(aAllocator, "id", 2);
+        const CString name(aAllocator, "name", 4);
+        const CString email(aAllocator, "email", 5);
+        const CString description(aAllocator, "description", 11);
+        const CString tags(aAllocator, "tags", 4);
+        GenericValue value;
+        value.setArray();
+        value.reserve(STRING_RECORDS);
+        char text[256];
+        for(uint32_t i = 0; i < STRING_RECORDS; ++i) {
+            GenericValue record;
+            record.setObject();
+            record.reserve(5);
+            record.emplace(id, GenericValue(static_cast<uint64_t>(i)));
+
+            GenericValue member;
+            uint32_t length = 8 + static_cast<uint32_t>(nextRandom(state) % 17);
+            randomText(state, text, length);
+            member.setString(text, length);
+            record.emplace(name, std::move(member));
+
+            length = 16 + static_cast<uint32_t>(nextRandom(state) % 17);
+            randomText(state, text, length);
+            text[length / 2] = '@';
+            member.setString(text, length);
+            record.emplace(email, std::move(member));
+
+            length = 64 + static_cast<uint32_t>(nextRandom(state) % 193);
+            randomText(state, text, length);
+            member.setString(text, length);
+            record.emplace(description, std::move(member));
+
+            member.setArray();
+            for(uint32_t j = 0; j < 3; ++j) {
+                GenericValue tag;
+                length = 3 + static_cast<uint32_t>(nextRandom(state) % 6);
+                randomText(state, text, length);
+                tag.setString(text, length);
+                member.pushBack(std::move(tag));
+            }
+            record.emplace(tags, std::move(member));
+
+            value.pushBack(std::move(record));
+        }
+        return value;
+    }
+
+    static uint64_t getNodeAllocations() throw() {
+        EncodeStats stats;
+        EncodeStats::capture(stats);
+        uint64_t allocations = 0;
+        for(uint32_t i = 0; i < EncodeStats::NODE_KIND_COUNT; ++i) allocations += stats.nodeAllocations[i];
+        return allocations;
+    }
+
+    static void addFieldNames(Schema& aSchema, const GenericValue& aValue) throw() {
+        if(aValue.isArray()) {
+            const int32_t size = aValue.size();
+            for(int32_t i = 0; i < size; ++i) addFieldNames(aSchema, aValue[i]);
+        }else if(aValue.isObject()) {
+            const GenericObject& members = aValue.getObject();
+            for(auto i = members.begin(); i != members.end(); ++i) {
+                aSchema.addField(i->first);
+                addFieldNames(aSchema, i->second);
+            }
+        }
+    }
+
+    typedef GenericValue(*DatasetBuilder)(Allocator&);
+
+    struct Dataset {
+        const char* name;
+        DatasetBuilder build;
+    };
+
+    static const Dataset DATASETS[] = {
+        {"numeric-array",   makeNumericArray},
+        {"wide-object",     makeWideObject},
+        {"deep-nesting",    makeDeepNesting},
+        {"string-records",  makeStringRecords}
+    };
+
+	// CountingAllocator
+
+    /*!
+        \brief Counts the allocations that the library makes through the allocator it is given.
+    */
+    class CountingAllocator : public Allocator {
+    private:
+        Allocator& mParent;
+        uint64_t mAllocations;
+        uint64_t mBytes;
+    private:
+        CountingAllocator(const CountingAllocator&) = delete;
+        CountingAllocator& operator=(const CountingAllocator&) = delete;
+    public:
+        CountingAllocator(Allocator& aParent) throw() :
+            mParent(aParent),
+            mAllocations(0),
+            mBytes(0)
+        {}
+
+        SOLAIRE_FORCE_INLINE uint64_t getAllocations() const throw()    {return mAllocations;}
+        SOLAIRE_FORCE_INLINE uint64_t getBytes() const throw()          {return mBytes;}
+
+        // Inherited from Allocator
+
+        uint32_t SOLAIRE_EXPORT_CALL getAllocatedBytes() const throw() override {
+            return mParent.getAllocatedBytes();
+        }
+
+        uint32_t SOLAIRE_EXPORT_CALL getFreeBytes() const throw() override {
+            return mParent.getFreeBytes();
+        }
+
+        void* SOLAIRE_EXPORT_CALL allocate(const uint32_t aBytes) throw() override {
+            ++mAllocations;
+            mBytes += aBytes;
+            return mParent.allocate(aBytes);
+        }
+
+        bool SOLAIRE_EXPORT_CALL deallocate(const void* const aObject) throw() override {
+            return mParent.deallocate(aObject);
+        }
+    };
+
+	// Benchmark
+
+    /*!
+        \brief Runs operations until enough time has passed to report a stable mean.
+    */
+    class Benchmark {
+    private:
+        typedef std::chrono::steady_clock Clock;
+    private:
+        CountingAllocator& mAllocator;
+        const char* const mFilter;
+        const double mMinSeconds;
+    private:
+        SOLAIRE_FORCE_INLINE uint64_t countAllocations() const throw() {
+            return mAllocator.getAllocations() + getNodeAllocations();
+        }
+
+        bool accept(const char* const aGroup, const char* const aName, const char* const aDataset) const throw() {
+            if(mFilter == nullptr) return true;
+            return std::strstr(aGroup, mFilter) || std::strstr(aName, mFilter) || std::strstr(aDataset, mFilter);
+        }
+
+        void report(const char* const aGroup, const char* const aName, const char* const aDataset, const uint32_t aBytes,
+            const double aSeconds, const uint64_t aIterations, const uint64_t aAllocations) const throw() {
+            const double nanoseconds = aSeconds * 1e9 / static_cast<double>(aIterations);
+            char throughput[32] = "-";
+            if(aBytes > 0) std::snprintf(throughput, sizeof(throughput), "%.1f", static_cast<double>(aBytes) * static_cast<double>(aIterations) / aSeconds / (1024.0 * 1024.0));
+            std::printf("%-14s %-18s %-16s %14.1f %12s %12.2f\n", aGroup, aName, aDataset, nanoseconds, throughput, static_cast<double>(aAllocations) / static_cast<double>(aIterations));
+        }
+    public:
+        Benchmark(CountingAllocator& aAllocator, const char* const aFilter, const double aMinSeconds) throw() :
+            mAllocator(aAllocator),
+            mFilter(aFilter),
+            mMinSeconds(aMinSeconds)
+        {}
+
+        SOLAIRE_FORCE_INLINE Allocator& getAllocator() throw() {return mAllocator;}
+
+        void printHeader() const throw() {
+            EncodeStats stats;
+            if(! EncodeStats::capture(stats)) std::printf("allocs/op excludes GenericValue nodes, define SOLAIRE_ENCODE_STATS to count them\n");
+            std::printf("%-14s %-18s %-16s %14s %12s %12s\n", "group", "operation", "dataset", "ns/op", "MB/s", "allocs/op");
+        }
+
+        /*!
+            \brief Time an operation in batches, for operations that are too short to time individually.
+            \param aBytes The encoded size of the data that one operation processes, or 0 if it has none.
+        */
+        template<class F>
+        void run(const char* const aGroup, const char* const aName, const char* const aDataset, const uint32_t aBytes, F aOperation) throw() {
+            if(! accept(aGroup, aName, aDataset)) return;
+            aOperation();
+            uint64_t batch = 1;
+            while(true) {
+                const uint64_t allocations = countAllocations();
+                const Clock::time_point begin = Clock::now();
+                for(uint64_t i = 0; i < batch; ++i) aOperation();
+                const double seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+                if(seconds >= mMinSeconds || batch >= (1ULL << 40)) {
+                    report(aGroup, aName, aDataset, aBytes, seconds, batch, countAllocations() - allocations);
+                    return;
+                }
+                batch *= seconds * 10.0 < mMinSeconds ? 10 : 2;
+            }
+        }
+
+        /*!
+            \brief Time an operation that needs untimed preparation before every run, such as destroying a fresh tree.
+            \param aBytes The encoded size of the data that one operation processes, or 0 if it has none.
+        */
+        template<class S, class F>
+        void run(const char* const aGroup, const char* const aName, const char* const aDataset, const uint32_t aBytes, S aSetup, F aOperation) throw() {
+            if(! accept(aGroup, aName, aDataset)) return;
+            uint64_t iterations = 0;
+            uint64_t allocations = 0;
+            double seconds = 0.0;
+            while(seconds < mMinSeconds || iterations < 3) {
+                aSetup();
+                const uint64_t before = countAllocations();
+                const Clock::time_point begin = Clock::now();
+                aOperation();
+                seconds += std::chrono::duration<double>(Clock::now() - begin).count();
+                allocations += countAllocations() - before;
+                ++iterations;
+            }
+            report(aGroup, aName, aDataset, aBytes, seconds, iterations, allocations);
+        }
+    };
+
+	// GenericValue
+
+    static void benchmarkValues(Benchmark& aBenchmark, const Dataset& aDataset) throw() {
+        Allocator& allocator = aBenchmark.getAllocator();
+        const GenericValue source = aDataset.build(allocator);
+        GenericValue slot;
+
+        aBenchmark.run("GenericValue", "construct", aDataset.name, 0, [&]() {
+            slot = aDataset.build(allocator);
+        });
+
+        aBenchmark.run("GenericValue", "copy", aDataset.name, 0, [&]() {
+            const GenericValue copy(source);
+            consume(copy.size());
+        });
+
+        GenericDocument document(allocator);
+        aBenchmark.run("GenericValue", "deep-copy", aDataset.name, 0, [&]() {
+            document.clear();
+            document.getRoot() = source;
+            consume(document.getRoot().size());
+        });
+
+        aBenchmark.run("GenericValue", "move", aDataset.name, 0, [&]() {
+            GenericValue moved(std::move(slot));
+            slot = std::move(moved);
+            consume(slot.size());
+        });
+
+        aBenchmark.run("GenericValue", "destroy", aDataset.name, 0, [&]() {
+            slot = aDataset.build(allocator);
+        }, [&]() {
+            slot.setNull();
+        });
+
+        const GenericValue other = aDataset.build(allocator);
+        aBenchmark.run("GenericValue", "equal", aDataset.name, 0, [&]() {
+            consume(source == other);
+        });
+
+        aBenchmark.run("GenericValue", "hash", aDataset.name, 0, [&]() {
+            slot = aDataset.build(allocator);
+        }, [&]() {
+            consume(slot.hash());
+        });
+
+        aBenchmark.run("GenericValue", "hash-cached", aDataset.name, 0, [&]() {
+            consume(source.hash());
+        });
+    }
+
+	// Encoder
+
+    template<class T>
+    static void benchmarkEncoder(Benchmark& aBenchmark, const char* const aType, const T& aValue) throw() {
+        Allocator& allocator = aBenchmark.getAllocator();
+        const GenericValue encoded = encode<T>(allocator, aValue);
+
+        const BinaryFormat binary;
+        BufferOStream output(allocator);
+        binary.writeValue(encoded, output);
+        const uint32_t bytes = output.getSize();
+
+        aBenchmark.run("Encoder", "encode", aType, 0, [&]() {
+            const GenericValue value = encode<T>(allocator, aValue);
+            consume(value.getType());
+        });
+
+        aBenchmark.run("Encoder", "decode", aType, 0, [&]() {
+            const typename Encoder<T>::DecodeType value = decode<T>(allocator, encoded);
+            consume(sizeof(value));
+        });
+
+        aBenchmark.run("Encoder", "write", aType, bytes, [&]() {
+            output.clear();
+            Writer* const writer = binary.createWriter(allocator, output);
+            encode<T>(allocator, *writer, aValue);
+            writer->~Writer();
+            allocator.deallocate(writer);
+            consume(output.getSize());
+        });
+
+        aBenchmark.run("Encoder", "read", aType, bytes, [&]() {
+            BufferIStream input(output.getData(), output.getSize());
+            Reader* const reader = binary.createReader(allocator, input);
+            const typename Encoder<T>::DecodeType value = decode<T>(allocator, *reader);
+            consume(sizeof(value));
+            reader->~Reader();
+            allocator.deallocate(reader);
+        });
+    }
+
+    static void benchmarkEncoders(Benchmark& aBenchmark) throw() {
+        Allocator& allocator = aBenchmark.getAllocator();
+        uint64_t state = DATASET_SEED + 3;
+
+        benchmarkEncoder<char>(aBenchmark, "char", 'x');
+        benchmarkEncoder<bool>(aBenchmark, "bool", true);
+        benchmarkEncoder<uint8_t>(aBenchmark, "uint8_t", static_cast<uint8_t>(200));
+        benchmarkEncoder<uint16_t>(aBenchmark, "uint16_t", static_cast<uint16_t>(60000));
+        benchmarkEncoder<uint32_t>(aBenchmark, "uint32_t", static_cast<uint32_t>(4000000000U));
+        benchmarkEncoder<uint64_t>(aBenchmark, "uint64_t", static_cast<uint64_t>(nextRandom(state)));
+        benchmarkEncoder<int8_t>(aBenchmark, "int8_t", static_cast<int8_t>(-100));
+        benchmarkEncoder<int16_t>(aBenchmark, "int16_t", static_cast<int16_t>(-30000));
+        benchmarkEncoder<int32_t>(aBenchmark, "int32_t", static_cast<int32_t>(-2000000000));
+        benchmarkEncoder<int64_t>(aBenchmark, "int64_t", -static_cast<int64_t>(nextRandom(state) >> 2));
+        benchmarkEncoder<float>(aBenchmark, "float", 3.14159f);
+        benchmarkEncoder<double>(aBenchmark, "double", 2.718281828459045);
+
+        char text[64];
+        randomText(state, text, sizeof(text));
+        const CString string(allocator, text, sizeof(text));
+        benchmarkEncoder<String<char>>(aBenchmark, "String<char>", string);
+
+        ArrayList<uint32_t> unsignedList(allocator);
+        ArrayList<double> doubleList(allocator);
+        ArrayList<char> charList(allocator);
+        unsignedList.reserve(NUMERIC_COUNT);
+        doubleList.reserve(NUMERIC_COUNT);
+        for(uint32_t i = 0; i < NUMERIC_COUNT; ++i) {
+            unsignedList.pushBack(static_cast<uint32_t>(nextRandom(state)));
+            doubleList.pushBack(static_cast<double>(nextRandom(state) >> 11) / 9007199254740992.0);
+        }
+        // char is not packed, so this measures the element by element path
+        for(uint32_t i = 0; i < 1024; ++i) charList.pushBack(static_cast<char>('a' + nextRandom(state) % 26));
+        benchmarkEncoder<ArrayList<uint32_t>>(aBenchmark, "ArrayList<u32>", unsignedList);
+        benchmarkEncoder<ArrayList<double>>(aBenchmark, "ArrayList<double>", doubleList);
+        benchmarkEncoder<ArrayList<char>>(aBenchmark, "ArrayList<char>", charList);
+
+        BenchmarkRecord record;
+        record.id = 42;
+        record.score = 97.5;
+        record.active = true;
+        randomText(state, text, 20);
+        record.name = CString(allocator, text, 20);
+        for(int32_t i = 0; i < 16; ++i) record.history.pushBack(i * 7 - 50);
+        benchmarkEncoder<BenchmarkRecord>(aBenchmark, "reflected", record);
+    }
+
+	// Format
+
+    static void benchmarkFormat(Benchmark& aBenchmark, const char* const aFormatName, const Format& aFormat, const Dataset& aDataset) throw() {
+        Allocator& allocator = aBenchmark.getAllocator();
+        const GenericValue source = aDataset.build(allocator);
+        BufferOStream output(allocator);
+        if(! aFormat.writeValue(source, output)) {
+            std::printf("%s could not write %s\n", aFormatName, aDataset.name);
+            return;
+        }
+        const uint32_t bytes = output.getSize();
+
+        aBenchmark.run(aFormatName, "writeValue", aDataset.name, bytes, [&]() {
+            output.clear();
+            aFormat.writeValue(source, output);
+            consume(output.getSize());
+        });
+
+        aBenchmark.run(aFormatName, "readValue", aDataset.name, bytes, [&]() {
+            BufferIStream input(output.getData(), output.getSize());
+            const GenericValue value = aFormat.readValue(input);
+            consume(value.size());
+        });
+
+        GenericDocument document(allocator);
+        aBenchmark.run(aFormatName, "readDocument", aDataset.name, bytes, [&]() {
+            BufferIStream input(output.getData(), output.getSize());
+            document.clear();
+            aFormat.readDocument(input, document);
+            consume(document.getRoot().size());
+        });
+    }
+
+    static void benchmarkFormats(Benchmark& aBenchmark) throw() {
+        Allocator& allocator = aBenchmark.getAllocator();
+        Schema schema(allocator);
+        for(const Dataset& dataset : DATASETS) addFieldNames(schema, dataset.build(allocator));
+
+        const JsonFormat json;
+        const BinaryFormat binary;
+        const SchemaFormat schemaFormat(schema);
+        const CompressedFormat compressed(binary);
+
+        for(const Dataset& dataset : DATASETS) {
+            benchmarkFormat(aBenchmark, "JsonFormat", json, dataset);
+            benchmarkFormat(aBenchmark, "BinaryFormat", binary, dataset);
+            benchmarkFormat(aBenchmark, "SchemaFormat", schemaFormat, dataset);
+            benchmarkFormat(aBenchmark, "Compressed", compressed, dataset);
+        }
+
+        // The same values with their member names interned in a shared KeyTable
+        KeyTable keys(allocator);
+        KeyTable::setShared(&keys);
+        for(const Dataset& dataset : DATASETS) {
+            benchmarkFormat(aBenchmark, "Json+Keys", json, dataset);
+            benchmarkFormat(aBenchmark, "Binary+Keys", binary, dataset);
+        }
+        KeyTable::setShared(nullptr);
+    }
+}
+
+int main(int aArgc, char** aArgv) {
+    using namespace Solaire;
+
+    const char* filter = nullptr;
+    double minSeconds = 0.2;
+    for(int i = 1; i < aArgc; ++i) {
+        if(std::strcmp(aArgv[i], "--quick") == 0) {
+            minSeconds = 0.02;
+        }else {
+            filter = aArgv[i];
+        }
+    }
+
+    CountingAllocator allocator(getDefaultAllocator());
+    Benchmark benchmark(allocator, filter, minSeconds);
+    benchmark.printHeader();
+
+    for(const Dataset& dataset : DATASETS) benchmarkValues(benchmark, dataset);
+    benchmarkEncoders(benchmark);
+    benchmarkFormats(benchmark);
+    return 0;
+}
@@ -0,0 +1,104 @@
+#ifndef SOLAIRE_ARENA_ALLOCATOR_HPP
+#define SOLAIRE_ARENA_ALLOCATOR_HPP
+
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+/*!
+	\file ArenaAllocator.hpp
+	\brief
+	\author
+	Created			: Adam Smith
+	Last modified	: Adam Smith
+	\version 1.0
+	\date
+	Created			: 17th October 2026
+	Last Modified	: 17th October 2026
+*/
+
+#include "Solaire/Data/ArrayList.hpp"
+
+namespace Solaire {
+
+    /*!
+        \brief A bump allocator that releases all of its memory at once.
+        \details Memory is taken from the parent allocator in blocks. deallocate only reclaims the most recent allocation,
+        everything else is released by clear or when the ArenaAllocator is destroyed.
+        \version 1.0.0
+    */
+	class ArenaAllocator : public Allocator {
+    public:
+        enum : uint32_t {
+            DEFAULT_BLOCK_SIZE = 64 * 1024,
+            ALIGNMENT = 16
+        };
+    private:
+        struct Block {
+            Block* previous;
+            uint32_t size;
+            uint32_t used;
+        };
+    private:
+        Allocator& mAllocator;
+        Block* mHead;
+        void* mLast;
+        uint32_t mBlockSize;
+        uint32_t mAllocatedBytes;
+    private:
+        ArenaAllocator(const ArenaAllocator&) = delete;
+        ArenaAllocator& operator=(const ArenaAllocator&) = delete;
+
+        Block* addBlock(const uint32_t aBytes) throw();
+    public:
+        /*!
+            \brief Create an ArenaAllocator.
+            \param aAllocator The allocator that blocks are taken from.
+            \param aBlockSize The minimum number of bytes in each block.
+        */
+        ArenaAllocator(Allocator& aAllocator = getDefaultAllocator(), const uint32_t aBlockSize = DEFAULT_BLOCK_SIZE) throw();
+
+        /*!
+            \brief Destroy the ArenaAllocator, releasing every block.
+        */
+        SOLAIRE_EXPORT_CALL ~ArenaAllocator() throw();
+
+        /*!
+            \brief Release every allocation at once.
+            \details The most recent block is kept so the arena can be refilled without returning to the parent allocator.
+            Objects placed in the arena are not destroyed.
+        */
+        void clear() throw();
+
+        /*!
+            \brief Check if an address lies inside one of the arena's blocks.
+            \details The most recent block is checked first, so addresses of recent allocations are found quickly.
+            \param aAddress The address.
+            \return True if the memory at aAddress belongs to the arena.
+        */
+        bool contains(const void* const aAddress) const throw();
+
+        // Inherited from Allocator
+
+        uint32_t SOLAIRE_EXPORT_CALL getAllocatedBytes() const throw() override;
+        uint32_t SOLAIRE_EXPORT_CALL getFreeBytes() const throw() override;
+        void* SOLAIRE_EXPORT_CALL allocate(const uint32_t aBytes) throw() override;
+        bool SOLAIRE_EXPORT_CALL deallocate(const void* const aObject) throw() override;
+	};
+}
+
+#endif
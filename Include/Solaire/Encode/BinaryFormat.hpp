@@ -0,0 +1,93 @@
+#ifndef SOLAIRE_BINARY_FORMAT_HPP
+#define SOLAIRE_BINARY_FORMAT_HPP
+
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+/*!
+	\file BinaryFormat.hpp
+	\brief
+	\author
+	Created			: Adam Smith
+	Last modified	: Adam Smith
+	\version 1.0
+	\date
+	Created			: 17th October 2026
+	Last Modified	: 17th October 2026
+*/
+
+#include "Solaire/Encode/Format.hpp"
+#include "Solaire/Encode/BufferIStream.hpp"
+#include "Solaire/Encode/Schema.hpp"
+
+namespace Solaire {
+
+    /*!
+        \brief A compact self-describing binary Format.
+        \details Every value begins with a one byte tag equal to its GenericValue::ValueType :
+        - NULL_T : No payload.
+        - CHAR_T, BOOL_T : One byte.
+        - UNSIGNED_T : LEB128 varint.
+        - SIGNED_T : Zigzag encoded LEB128 varint.
+        - DOUBLE_T : 8 byte little endian IEEE 754 bit pattern.
+        - STRING_T : Varint length, followed by the characters.
+        - ARRAY_T : Varint element count, followed by the elements.
+        - OBJECT_T : Varint member count, followed by a length prefixed name and a value for each member.
+        - 9, 10, 11 : Packed array of UNSIGNED_T, SIGNED_T or DOUBLE_T elements. Varint element count, followed by
+        8 little endian bytes per element, which are copied in bulk on little endian machines.
+
+        When the source is a BufferIStream, such as a MappedIStream, skipped values are stepped over without being
+        copied. When string borrowing is enabled and the source is a BufferIStream, decoded string values reference the
+        characters in the buffer instead of copying them, so the buffer must outlive the decoded values. The Parser
+        returned by createParser always copies strings, as the pieces of input it is given are not kept. Its packed arrays of
+        more than 4096 elements are collected as their elements arrive, so a count that the input does not contain the
+        elements for is never allocated.
+        \version 1.0.0
+    */
+	class BinaryFormat : public Format {
+    private:
+        const Schema* const mSchema;
+        const bool mBorrowStrings;
+    protected:
+        /*!
+            \brief Create a BinaryFormat that writes member names as ids.
+            \param aSchema The schema that assigns the ids, or nullptr to write every name as characters.
+            \param aBorrowStrings If decoded strings should reference the source when it is a BufferIStream.
+            \see SchemaFormat
+        */
+        BinaryFormat(const Schema* const aSchema, const bool aBorrowStrings) throw();
+    public:
+        /*!
+            \brief Create a BinaryFormat.
+            \param aBorrowStrings If decoded strings should reference the source when it is a BufferIStream.
+            \see GenericValue::setBorrowedString
+        */
+        BinaryFormat(const bool aBorrowStrings = false) throw();
+
+
+        // Inherited from Format
+
+        GenericValue SOLAIRE_EXPORT_CALL readValue(IStream& aStream) const throw() override;
+        bool SOLAIRE_EXPORT_CALL writeValue(const GenericValue& aValue, OStream& aStream) const throw() override;
+        Reader* SOLAIRE_EXPORT_CALL createReader(Allocator& aAllocator, IStream& aStream) const throw() override;
+        Writer* SOLAIRE_EXPORT_CALL createWriter(Allocator& aAllocator, OStream& aStream) const throw() override;
+        Parser* SOLAIRE_EXPORT_CALL createParser(Allocator& aAllocator) const throw() override;
+	};
+}
+
+#endif
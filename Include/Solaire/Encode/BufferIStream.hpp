@@ -0,0 +1,80 @@
+#ifndef SOLAIRE_BUFFER_ISTREAM_HPP
+#define SOLAIRE_BUFFER_ISTREAM_HPP
+
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+/*!
+	\file BufferIStream.hpp
+	\brief
+	\author
+	Created			: Adam Smith
+	Last modified	: Adam Smith
+	\version 1.0
+	\date
+	Created			: 17th October 2026
+	Last Modified	: 17th October 2026
+*/
+
+#include "Solaire/Core/IStream.hpp"
+
+namespace Solaire {
+
+    /*!
+        \brief An IStream that reads from a block of memory.
+        \details The memory is not copied or owned by the stream. Readers that know the concrete stream type can use
+        borrow to reference bytes in place, which is how GenericValue borrowed strings are produced.
+        \version 1.0.0
+    */
+	class BufferIStream : public IStream {
+    protected:
+        const uint8_t* mData;
+        uint32_t mSize;
+        uint32_t mOffset;
+    public:
+        /*!
+            \brief Create a stream over a block of memory.
+            \param aData The first byte of the block, it must remain valid for the lifetime of the stream.
+            \param aSize The number of bytes in the block.
+        */
+        BufferIStream(const void* const aData, const uint32_t aSize) throw();
+
+        SOLAIRE_EXPORT_CALL ~BufferIStream() throw();
+
+        /*!
+            \brief Consume bytes without copying them.
+            \param aBytes The number of bytes to consume.
+            \return The first consumed byte, or nullptr if fewer than aBytes remain, in which case nothing is consumed.
+        */
+        const void* borrow(const uint32_t aBytes) throw();
+
+        SOLAIRE_FORCE_INLINE const void* getData() const throw()        {return mData;}
+        SOLAIRE_FORCE_INLINE uint32_t getSize() const throw()           {return mSize;}
+        SOLAIRE_FORCE_INLINE uint32_t getRemaining() const throw()      {return mSize - mOffset;}
+
+        // Inherited from IStream
+
+        uint32_t SOLAIRE_EXPORT_CALL read(void* const aBuffer, const uint32_t aBytes) throw() override;
+        bool SOLAIRE_EXPORT_CALL end() const throw() override;
+        bool SOLAIRE_EXPORT_CALL isOffsetable() const throw() override;
+        int32_t SOLAIRE_EXPORT_CALL getOffset() const throw() override;
+        bool SOLAIRE_EXPORT_CALL setOffset(const int32_t aOffset) throw() override;
+	};
+}
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef SOLAIRE_BUFFER_OSTREAM_HPP
+#define SOLAIRE_BUFFER_OSTREAM_HPP
+
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+/*!
+	\file BufferOStream.hpp
+	\brief
+	\author
+	Created			: Adam Smith
+	Last modified	: Adam Smith
+	\version 1.0
+	\date
+	Created			: 17th October 2026
+	Last Modified	: 17th October 2026
+*/
+
+#include "Solaire/Core/OStream.hpp"
+
+namespace Solaire {
+
+    /*!
+        \brief An OStream that writes into a block of memory which grows as needed.
+        \details The memory is taken from an allocator and released when the stream is destroyed.
+        \version 1.0.0
+    */
+	class BufferOStream : public OStream {
+    private:
+        enum : uint32_t {
+            MIN_CAPACITY = 256
+        };
+    private:
+        Allocator& mAllocator;
+        uint8_t* mData;
+        uint32_t mSize;
+        uint32_t mCapacity;
+        uint32_t mOffset;
+    private:
+        BufferOStream(const BufferOStream&) = delete;
+        BufferOStream& operator=(const BufferOStream&) = delete;
+    public:
+        /*!
+            \brief Create an empty stream.
+            \param aAllocator The allocator that memory is taken from.
+        */
+        BufferOStream(Allocator& aAllocator) throw();
+
+        SOLAIRE_EXPORT_CALL ~BufferOStream() throw();
+
+        /*!
+            \brief Make sure that bytes can be written without allocating again.
+            \param aBytes The total number of bytes the stream should be able to hold.
+            \return False if memory could not be allocated.
+        */
+        bool reserve(const uint32_t aBytes) throw();
+
+        /*!
+            \brief Discard the contents of the stream, the memory is kept for reuse.
+        */
+        void clear() throw();
+
+        SOLAIRE_FORCE_INLINE const void* getData() const throw()        {return mData;}
+        SOLAIRE_FORCE_INLINE uint32_t getSize() const throw()           {return mSize;}
+
+        // Inherited from OStream
+
+        uint32_t SOLAIRE_EXPORT_CALL write(const void* const aData, const uint32_t aBytes) throw() override;
+        bool SOLAIRE_EXPORT_CALL isOffsetable() const throw() override;
+        int32_t SOLAIRE_EXPORT_CALL getOffset() const throw() override;
+        bool SOLAIRE_EXPORT_CALL setOffset(const int32_t aOffset) throw() override;
+	};
+}
+
+#endif
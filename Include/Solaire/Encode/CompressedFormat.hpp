@@ -0,0 +1,92 @@
+#ifndef SOLAIRE_COMPRESSED_FORMAT_HPP
+#define SOLAIRE_COMPRESSED_FORMAT_HPP
+
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+/*!
+	\file CompressedFormat.hpp
+	\brief
+	\author
+	Created			: Adam Smith
+	Last modified	: Adam Smith
+	\version 1.0
+	\date
+	Created			: 17th October 2026
+	Last Modified	: 17th October 2026
+*/
+
+#include "Solaire/Encode/Format.hpp"
+#include "Solaire/Encode/WorkerPool.hpp"
+
+namespace Solaire {
+
+    /*!
+        \brief A Format that compresses the output of another Format.
+        \details Each encoded document is written as a frame of independent blocks, followed by a 4 byte zero.
+        Every block begins with three little endian 32 bit fields : the number of bytes before compression, the number
+        of bytes stored, with the high bit set if the block is stored uncompressed, and the xxHash32 of the bytes before
+        compression. Blocks are compressed with a byte oriented LZ77 codec, in the same sequence layout as LZ4, which
+        removes the member names that are repeated in every record at several hundred MB/s.
+        A frame is only decoded once every block has been read and verified, so the inner format always parses a
+        BufferIStream. When a WorkerPool is given the blocks of a frame are decompressed on its threads.
+        Decompressed blocks are released once a value has been read, so the inner format must not borrow strings.
+        createReader and createWriter return nullptr when the inner format does not provide a Reader or Writer.
+        \version 1.0.0
+        \see WorkerPool
+    */
+	class CompressedFormat : public Format {
+    public:
+        enum : uint32_t {
+            DEFAULT_BLOCK_SIZE = 64 * 1024,         //!< The number of bytes compressed together by default.
+            MAX_BLOCK_SIZE = 16 * 1024 * 1024       //!< The largest block that will be written or read.
+        };
+    private:
+        const Format& mInner;
+        WorkerPool* const mPool;
+        const uint32_t mBlockSize;
+        bool mInnerHasReader;
+    public:
+        /*!
+            \brief Create a CompressedFormat.
+            \param aInner The format that encodes values before they are compressed, it must outlive this format.
+            \param aBlockSize The number of bytes in each block, it is limited to MAX_BLOCK_SIZE. Matches are only
+            found within a block, larger blocks compress better but need more memory while reading and writing.
+            \param aPool The threads that decompress blocks, or nullptr to decompress on the calling thread. The pool
+            must not be running the tasks that read values, and values must only be read from one thread at a time.
+        */
+        CompressedFormat(const Format& aInner, const uint32_t aBlockSize = DEFAULT_BLOCK_SIZE, WorkerPool* const aPool = nullptr) throw();
+
+        /*!
+            \brief Get the format that encodes values before they are compressed.
+            \return The inner format.
+        */
+        const Format& getInner() const throw();
+
+        // Inherited from Format
+
+        GenericValue SOLAIRE_EXPORT_CALL readValue(IStream& aStream) const throw() override;
+        bool SOLAIRE_EXPORT_CALL writeValue(const GenericValue& aValue, OStream& aStream) const throw() override;
+        bool SOLAIRE_EXPORT_CALL tryReadValue(IStream& aStream, GenericValue& aValue) const throw() override;
+        Reader* SOLAIRE_EXPORT_CALL createReader(Allocator& aAllocator, IStream& aStream) const throw() override;
+        Writer* SOLAIRE_EXPORT_CALL createWriter(Allocator& aAllocator, OStream& aStream) const throw() override;
+        bool SOLAIRE_EXPORT_CALL findDocuments(const void* const aData, const uint32_t aSize, List<uint32_t>& aEnds) const throw() override;
+	};
+}
+
+#endif
@@ -0,0 +1,136 @@
+#ifndef SOLAIRE_ENCODE_STATS_HPP
+#define SOLAIRE_ENCODE_STATS_HPP
+
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+/*!
+	\file EncodeStats.hpp
+	\brief
+	\author
+	Created			: Adam Smith
+	Last modified	: Adam Smith
+	\version 1.0
+	\date
+	Created			: 17th October 2026
+	Last Modified	: 17th October 2026
+*/
+
+#include "Solaire/Core/Init.hpp"
+
+#if defined(SOLAIRE_ENCODE_STATS)
+    #include <chrono>
+#endif
+
+namespace Solaire {
+
+    class IStream;
+    class OStream;
+
+    /*!
+        \brief A snapshot of the counters that the library keeps when it is compiled with SOLAIRE_ENCODE_STATS defined.
+        \details Without SOLAIRE_ENCODE_STATS nothing is counted, the recording macros expand to nothing and capture
+        returns false. The counters are shared by every thread and updated with relaxed atomic increments, so a
+        snapshot taken while other threads are encoding may be part way through an operation.
+        Node counts include every string, array and object node that a GenericValue allocates, packed arrays are
+        counted as arrays and lazy values as the container they will become, as are the values that lazy values and packed
+        arrays are decoded into when they are read through const functions. The characters of a string are held
+        by its CString and are not included in the node bytes.
+        Only the outermost readValue or writeValue call is recorded, so a Format that wraps another, such as
+        CompressedFormat, is counted once. The bytes of a call are only known when its stream is offsetable.
+        \version 1.0.0
+    */
+    struct EncodeStats {
+        enum NodeKind : uint32_t {
+            STRING_NODE,
+            ARRAY_NODE,
+            OBJECT_NODE,
+            NODE_KIND_COUNT
+        };
+
+        enum Operation : uint32_t {
+            READ_VALUE,                 //!< Format::readValue
+            WRITE_VALUE,                //!< Format::writeValue
+            OPERATION_COUNT
+        };
+
+        uint64_t nodeAllocations[NODE_KIND_COUNT];      //!< The number of nodes allocated.
+        uint64_t nodeBytes[NODE_KIND_COUNT];            //!< The bytes requested for those nodes.
+        uint64_t deepCopies;                            //!< Nodes that were copied because they could not be shared.
+        uint64_t sharedCopies;                          //!< Copies that took a reference to an existing node.
+        uint64_t moves;                                 //!< Values that were moved instead of copied.
+        uint64_t calls[OPERATION_COUNT];                //!< The number of calls.
+        uint64_t bytes[OPERATION_COUNT];                //!< The bytes read from or written to offsetable streams.
+        uint64_t nanoseconds[OPERATION_COUNT];          //!< The time spent inside the calls.
+
+        /*!
+            \brief Read the current value of every counter.
+            \param aStats Receives the counters, every counter is 0 when statistics are not compiled in.
+            \return True if the library was compiled with SOLAIRE_ENCODE_STATS.
+        */
+        static bool SOLAIRE_EXPORT_CALL capture(EncodeStats& aStats) throw();
+
+        /*!
+            \brief Set every counter to 0.
+        */
+        static void SOLAIRE_EXPORT_CALL reset() throw();
+
+#if defined(SOLAIRE_ENCODE_STATS)
+        static void SOLAIRE_EXPORT_CALL recordNode(const NodeKind aKind, const uint32_t aBytes) throw();
+        static void SOLAIRE_EXPORT_CALL recordDeepCopy() throw();
+        static void SOLAIRE_EXPORT_CALL recordSharedCopy() throw();
+        static void SOLAIRE_EXPORT_CALL recordMove() throw();
+
+        /*!
+            \brief Records the time and bytes of a readValue or writeValue call for as long as it is in scope.
+        */
+        class Scope {
+        private:
+            const std::chrono::steady_clock::time_point mBegin;
+            const IStream* const mInput;
+            const OStream* const mOutput;
+            const int32_t mOffset;
+            const Operation mOperation;
+            const bool mOutermost;
+        private:
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+        public:
+            Scope(const IStream& aStream) throw();
+            Scope(const OStream& aStream) throw();
+            ~Scope() throw();
+        };
+#endif
+    };
+}
+
+#if defined(SOLAIRE_ENCODE_STATS)
+    #define SOLAIRE_STATS_NODE(KIND, BYTES) Solaire::EncodeStats::recordNode(KIND, BYTES)
+    #define SOLAIRE_STATS_DEEP_COPY() Solaire::EncodeStats::recordDeepCopy()
+    #define SOLAIRE_STATS_SHARED_COPY() Solaire::EncodeStats::recordSharedCopy()
+    #define SOLAIRE_STATS_MOVE() Solaire::EncodeStats::recordMove()
+    #define SOLAIRE_STATS_SCOPE(STREAM) const Solaire::EncodeStats::Scope solaireStatsScope(STREAM)
+#else
+    #define SOLAIRE_STATS_NODE(KIND, BYTES)
+    #define SOLAIRE_STATS_DEEP_COPY()
+    #define SOLAIRE_STATS_SHARED_COPY()
+    #define SOLAIRE_STATS_MOVE()
+    #define SOLAIRE_STATS_SCOPE(STREAM)
+#endif
+
+#endif
@@ -28,11 +28,14 @@
 	\version 1.0
 	\date
 	Created			: 16th January 2016
-	Last Modified	: 16th January 2016
+	Last Modified	: 17th October 2026
 */
 
+#include <utility>
 #include "Solaire/Data/ArrayList.hpp"
 #include "Solaire/Encode/GenericValue.hpp"
+#include "Solaire/Encode/Reader.hpp"
+#include "Solaire/Encode/Writer.hpp"
 
 namespace Solaire {
 
@@ -42,6 +45,44 @@ namespace Solaire {
 
 	    static DecodeType decode(Allocator&, const GenericValue&) throw();
 	    static GenericValue encode(Allocator&, const T&) throw();
+	    static bool write(Allocator&, Writer&, const T&) throw();
+	    static DecodeType read(Allocator&, Reader&) throw();
+	};
+
+	/*!
+        \brief Check if Encoder<T> can stream directly into a Writer.
+        \details Encoders that only implement decode and encode are still usable with a Writer,
+        their GenericValue output is passed to Writer::writeValue instead.
+	*/
+	template<class T>
+	struct EncoderHasWrite {
+	    template<class E>
+	    static std::true_type test(decltype(E::write(std::declval<Allocator&>(), std::declval<Writer&>(), std::declval<const T&>()))*);
+
+	    template<class E>
+	    static std::false_type test(...);
+
+	    enum : bool {
+	        value = decltype(test<Encoder<T>>(nullptr))::value
+	    };
+	};
+
+	/*!
+        \brief Check if Encoder<T> can decode directly from a Reader.
+        \details Encoders that only implement decode and encode are still usable with a Reader,
+        they are passed the output of Reader::readValue instead.
+	*/
+	template<class T>
+	struct EncoderHasRead {
+	    template<class E>
+	    static std::true_type test(decltype(E::read(std::declval<Allocator&>(), std::declval<Reader&>()))*);
+
+	    template<class E>
+	    static std::false_type test(...);
+
+	    enum : bool {
+	        value = decltype(test<Encoder<T>>(nullptr))::value
+	    };
 	};
 
 	template<class T>
@@ -50,10 +91,42 @@ namespace Solaire {
 	}
 
 	template<class T>
-	static GenericValue decode(Allocator& aAllocator, const T& aValue) {
+	static typename std::enable_if<EncoderHasRead<T>::value, typename Encoder<T>::DecodeType>::type decode(Allocator& aAllocator, Reader& aReader) {
+	    return Encoder<T>::read(aAllocator, aReader);
+	}
+
+	template<class T>
+	static typename std::enable_if<! EncoderHasRead<T>::value, typename Encoder<T>::DecodeType>::type decode(Allocator& aAllocator, Reader& aReader) {
+	    GenericValue value;
+	    aReader.readValue(value);
+	    return Encoder<T>::decode(aAllocator, value);
+	}
+
+	template<class T>
+	static GenericValue encode(Allocator& aAllocator, const T& aValue) {
 	    return Encoder<T>::encode(aAllocator, aValue);
 	}
 
+	/*!
+        \brief Encode a value that is no longer needed.
+        \details Encoders that provide an overload of encode for DecodeType&& may move strings and elements into the
+        GenericValue instead of copying them, others are passed the value as a const reference.
+	*/
+	template<class T>
+	static GenericValue encode(Allocator& aAllocator, typename Encoder<T>::DecodeType&& aValue) {
+	    return Encoder<T>::encode(aAllocator, std::move(aValue));
+	}
+
+	template<class T>
+	static typename std::enable_if<EncoderHasWrite<T>::value, bool>::type encode(Allocator& aAllocator, Writer& aWriter, const T& aValue) {
+	    return Encoder<T>::write(aAllocator, aWriter, aValue);
+	}
+
+	template<class T>
+	static typename std::enable_if<! EncoderHasWrite<T>::value, bool>::type encode(Allocator& aAllocator, Writer& aWriter, const T& aValue) {
+	    return aWriter.writeValue(Encoder<T>::encode(aAllocator, aValue));
+	}
+
 	////
 
     template<>
@@ -67,6 +140,16 @@ namespace Solaire {
 	    static GenericValue encode(Allocator& aAllocator, const char aValue) throw() {
             return GenericValue(aValue);
 	    }
+
+	    static bool write(Allocator& aAllocator, Writer& aWriter, const char aValue) throw() {
+            return aWriter.writeChar(aValue);
+	    }
+
+	    static DecodeType read(Allocator& aAllocator, Reader& aReader) throw() {
+            char value = 0;
+            aReader.readChar(value);
+            return value;
+	    }
 	};
 
     template<>
@@ -80,6 +163,16 @@ namespace Solaire {
 	    static GenericValue encode(Allocator& aAllocator, const bool aValue) throw() {
             return GenericValue(aValue);
 	    }
+
+	    static bool write(Allocator& aAllocator, Writer& aWriter, const bool aValue) throw() {
+            return aWriter.writeBool(aValue);
+	    }
+
+	    static DecodeType read(Allocator& aAllocator, Reader& aReader) throw() {
+            bool value = false;
+            aReader.readBool(value);
+            return value;
+	    }
 	};
 
     template<class T>
@@ -98,6 +191,16 @@ namespace Solaire {
 	    static GenericValue encode(Allocator& aAllocator, const T aValue) throw() {
             return GenericValue(static_cast<uint64_t>(aValue));
 	    }
+
+	    static bool write(Allocator& aAllocator, Writer& aWriter, const T aValue) throw() {
+            return aWriter.writeUnsigned(static_cast<uint64_t>(aValue));
+	    }
+
+	    static DecodeType read(Allocator& aAllocator, Reader& aReader) throw() {
+            uint64_t value = 0;
+            aReader.readUnsigned(value);
+            return static_cast<T>(value);
+	    }
 	};
 
     template<class T>
@@ -116,6 +219,16 @@ namespace Solaire {
 	    static GenericValue encode(Allocator& aAllocator, const T aValue) throw() {
             return GenericValue(static_cast<int64_t>(aValue));
 	    }
+
+	    static bool write(Allocator& aAllocator, Writer& aWriter, const T aValue) throw() {
+            return aWriter.writeSigned(static_cast<int64_t>(aValue));
+	    }
+
+	    static DecodeType read(Allocator& aAllocator, Reader& aReader) throw() {
+            int64_t value = 0;
+            aReader.readSigned(value);
+            return static_cast<T>(value);
+	    }
 	};
 
     template<class T>
@@ -132,6 +245,16 @@ namespace Solaire {
 	    static GenericValue encode(Allocator& aAllocator, const T aValue) throw() {
             return GenericValue(static_cast<double>(aValue));
 	    }
+
+	    static bool write(Allocator& aAllocator, Writer& aWriter, const T aValue) throw() {
+            return aWriter.writeDouble(static_cast<double>(aValue));
+	    }
+
+	    static DecodeType read(Allocator& aAllocator, Reader& aReader) throw() {
+            double value = 0.0;
+            aReader.readDouble(value);
+            return static_cast<T>(value);
+	    }
 	};
 
     template<>
@@ -139,21 +262,94 @@ namespace Solaire {
 	    typedef CString DecodeType;
 
 	    static DecodeType decode(Allocator& aAllocator, const GenericValue& aValue) throw() {
-            return CString(aValue.getString());
+            const GenericValue::StringView string = aValue.getString();
+            return CString(aAllocator, string.getCharacters(), string.getLength());
 	    }
 
 	    static GenericValue encode(Allocator& aAllocator, const StringConstant<char>& aValue) throw() {
-            GenericValue value;
-            //! \todo Assign string
-            //value.setString() = aValue;
+            return GenericValue(aValue);
+	    }
+
+	    static GenericValue encode(Allocator& aAllocator, CString&& aValue) throw() {
+            return GenericValue(std::move(aValue));
+	    }
+
+	    static bool write(Allocator& aAllocator, Writer& aWriter, const StringConstant<char>& aValue) throw() {
+            return aWriter.writeString(aValue);
+	    }
+
+	    static DecodeType read(Allocator& aAllocator, Reader& aReader) throw() {
+            CString value(aAllocator);
+            aReader.readString(value);
             return value;
 	    }
 	};
 
 	////
 
+	/*!
+        \brief Describes how containers of T are stored as packed arrays.
+        \details value is true for floating point types and for integer types other than char and bool.
+        \see GenericValue::setPackedArray
+	*/
+	template<class T, typename ENABLE = void>
+	struct PackedElement {
+	    enum : bool {
+	        value = false
+	    };
+	};
+
+	template<class T>
+	struct PackedElement<T, typename std::enable_if<std::is_floating_point<T>::value>::type> {
+	    typedef double Type;
+
+	    enum : bool {
+	        value = true
+	    };
+
+	    static constexpr GenericValue::ValueType TYPE = GenericValue::DOUBLE_T;
+
+	    static SOLAIRE_FORCE_INLINE const Type* get(const GenericValue& aValue) throw()                      {return aValue.getDoubleArray();}
+	    static SOLAIRE_FORCE_INLINE bool write(Writer& aWriter, const Type* aValues, uint32_t aCount) throw() {return aWriter.writeDoubleArray(aValues, aCount);}
+	    static SOLAIRE_FORCE_INLINE bool read(Reader& aReader, Type* aValues, uint32_t aCount) throw()        {return aReader.readDoubleArray(aValues, aCount);}
+	};
+
+	template<class T>
+	struct PackedElement<T, typename std::enable_if<
+        std::is_integral<T>::value && std::is_signed<T>::value && ! std::is_same<T, char>::value
+    >::type> {
+	    typedef int64_t Type;
+
+	    enum : bool {
+	        value = true
+	    };
+
+	    static constexpr GenericValue::ValueType TYPE = GenericValue::SIGNED_T;
+
+	    static SOLAIRE_FORCE_INLINE const Type* get(const GenericValue& aValue) throw()                      {return aValue.getSignedArray();}
+	    static SOLAIRE_FORCE_INLINE bool write(Writer& aWriter, const Type* aValues, uint32_t aCount) throw() {return aWriter.writeSignedArray(aValues, aCount);}
+	    static SOLAIRE_FORCE_INLINE bool read(Reader& aReader, Type* aValues, uint32_t aCount) throw()        {return aReader.readSignedArray(aValues, aCount);}
+	};
+
 	template<class T>
-	struct Encoder<StaticContainer<T>>{
+	struct PackedElement<T, typename std::enable_if<
+        std::is_integral<T>::value && std::is_unsigned<T>::value && ! std::is_same<T, char>::value && ! std::is_same<T, bool>::value
+    >::type> {
+	    typedef uint64_t Type;
+
+	    enum : bool {
+	        value = true
+	    };
+
+	    static constexpr GenericValue::ValueType TYPE = GenericValue::UNSIGNED_T;
+
+	    static SOLAIRE_FORCE_INLINE const Type* get(const GenericValue& aValue) throw()                      {return aValue.getUnsignedArray();}
+	    static SOLAIRE_FORCE_INLINE bool write(Writer& aWriter, const Type* aValues, uint32_t aCount) throw() {return aWriter.writeUnsignedArray(aValues, aCount);}
+	    static SOLAIRE_FORCE_INLINE bool read(Reader& aReader, Type* aValues, uint32_t aCount) throw()        {return aReader.readUnsignedArray(aValues, aCount);}
+	};
+
+	template<class T>
+	struct Encoder<StaticContainer<T>, typename std::enable_if<! PackedElement<T>::value>::type>{
 	    typedef ArrayList<T> DecodeType;
 
 	    static DecodeType decode(Allocator& aAllocator, const GenericValue& aValue) throw() {
@@ -161,6 +357,84 @@ namespace Solaire {
             if(aValue.isArray()){
                 const GenericArray& array_ = aValue.getArray();
                 const int32_t size = array_.size();
+                container.reserve(size);
+                for(int32_t i = 0; i < size; ++i) {
+                    container.pushBack(Encoder<T>::decode(aAllocator, array_[i]));
+                }
+            }
+            return container;
+	    }
+
+	    static GenericValue encode(Allocator& aAllocator, const StaticContainer<T>& aContainer) throw() {
+            GenericValue value;
+            value.setArray();
+            const int32_t size = aContainer.size();
+            value.reserve(size);
+            for(int32_t i = 0; i < size; ++i) {
+                value.pushBack(Encoder<T>::encode(aAllocator, aContainer[i]));
+            }
+            return value;
+	    }
+
+	    static GenericValue encode(Allocator& aAllocator, ArrayList<T>&& aContainer) throw() {
+            GenericValue value;
+            value.setArray();
+            const int32_t size = aContainer.size();
+            value.reserve(size);
+            for(int32_t i = 0; i < size; ++i) {
+                value.pushBack(Encoder<T>::encode(aAllocator, std::move(aContainer[i])));
+            }
+            return value;
+	    }
+
+	    static bool write(Allocator& aAllocator, Writer& aWriter, const StaticContainer<T>& aContainer) throw() {
+            const int32_t size = aContainer.size();
+            if(! aWriter.beginArray(size)) return false;
+            for(int32_t i = 0; i < size; ++i) {
+                if(! Solaire::encode<T>(aAllocator, aWriter, aContainer[i])) return false;
+            }
+            return aWriter.endArray();
+	    }
+
+	    static DecodeType read(Allocator& aAllocator, Reader& aReader) throw() {
+            ArrayList<T> container(aAllocator);
+            int32_t size;
+            if(aReader.peekType() == GenericValue::ARRAY_T && aReader.beginArray(size)) {
+                container.reserve(aReader.getReserveSize(size));
+                while(aReader.hasNext()) {
+                    container.pushBack(Solaire::decode<T>(aAllocator, aReader));
+                }
+                aReader.endArray();
+            }else {
+                aReader.skip();
+            }
+            return container;
+	    }
+	};
+
+	template<class T>
+	struct Encoder<StaticContainer<T>, typename std::enable_if<PackedElement<T>::value>::type>{
+	    typedef ArrayList<T> DecodeType;
+	    typedef PackedElement<T> Element;
+	    typedef typename Element::Type ElementType;
+
+	    enum : uint32_t {
+	        CHUNK_ELEMENTS = 256
+	    };
+
+	    static DecodeType decode(Allocator& aAllocator, const GenericValue& aValue) throw() {
+            ArrayList<T> container(aAllocator);
+            const ElementType* const values = Element::get(aValue);
+            if(values) {
+                const int32_t size = aValue.size();
+                container.reserve(size);
+                for(int32_t i = 0; i < size; ++i) {
+                    container.pushBack(static_cast<T>(values[i]));
+                }
+            }else if(aValue.isArray()) {
+                const GenericArray& array_ = aValue.getArray();
+                const int32_t size = array_.size();
+                container.reserve(size);
                 for(int32_t i = 0; i < size; ++i) {
                     container.pushBack(Encoder<T>::decode(aAllocator, array_[i]));
                 }
@@ -170,20 +444,71 @@ namespace Solaire {
 
 	    static GenericValue encode(Allocator& aAllocator, const StaticContainer<T>& aContainer) throw() {
             GenericValue value;
-            const GenericArray& array_ = value.setArray();
             const int32_t size = aContainer.size();
+            ElementType* const values = static_cast<ElementType*>(value.setPackedArray(Element::TYPE, static_cast<uint32_t>(size)));
+            if(values == nullptr) {
+                // Containers that are too large to pack are stored element by element
+                value.setArray();
+                for(int32_t i = 0; i < size; ++i) {
+                    value.pushBack(Encoder<T>::encode(aAllocator, aContainer[i]));
+                }
+                return value;
+            }
             for(int32_t i = 0; i < size; ++i) {
-                array_.pushBack(Encoder<T>::encode(aAllocator, aContainer[i]));
+                values[i] = static_cast<ElementType>(aContainer[i]);
             }
             return value;
 	    }
+
+	    static bool write(Allocator& aAllocator, Writer& aWriter, const StaticContainer<T>& aContainer) throw() {
+            const int32_t size = aContainer.size();
+            if(! aWriter.beginPackedArray(Element::TYPE, size)) return false;
+            ElementType buffer[CHUNK_ELEMENTS];
+            int32_t i = 0;
+            while(i < size) {
+                uint32_t count = 0;
+                while(count < CHUNK_ELEMENTS && i < size) {
+                    buffer[count++] = static_cast<ElementType>(aContainer[i++]);
+                }
+                if(! Element::write(aWriter, buffer, count)) return false;
+            }
+            return aWriter.endArray();
+	    }
+
+	    static DecodeType read(Allocator& aAllocator, Reader& aReader) throw() {
+            ArrayList<T> container(aAllocator);
+            int32_t size;
+            if(aReader.peekType() == GenericValue::ARRAY_T && aReader.beginArray(size)) {
+                if(size == Reader::UNKNOWN_SIZE) {
+                    while(aReader.hasNext()) {
+                        container.pushBack(Solaire::decode<T>(aAllocator, aReader));
+                    }
+                }else {
+                    ElementType buffer[CHUNK_ELEMENTS];
+                    container.reserve(aReader.getReserveSize(size));
+                    while(size > 0) {
+                        const uint32_t count = size < static_cast<int32_t>(CHUNK_ELEMENTS) ? static_cast<uint32_t>(size) : static_cast<uint32_t>(CHUNK_ELEMENTS);
+                        if(! Element::read(aReader, buffer, count)) break;
+                        for(uint32_t i = 0; i < count; ++i) {
+                            container.pushBack(static_cast<T>(buffer[i]));
+                        }
+                        size -= count;
+                    }
+                }
+                aReader.endArray();
+            }else {
+                aReader.skip();
+            }
+            return container;
+	    }
 	};
 
 	template<class T>
 	struct Encoder<T, typename std::enable_if<
-        std::is_base_of<StaticContainer<typename T::Type>, T>::value
+        std::is_base_of<StaticContainer<typename T::Type>, T>::value &&
+        ! std::is_same<StaticContainer<typename T::Type>, T>::value
     >::type>{
-	    typedef Encoder<StaticContainer<typename T::Value>> ValueEncoder;
+	    typedef Encoder<StaticContainer<typename T::Type>> ValueEncoder;
 	    typedef T DecodeType;
 
 	    static DecodeType decode(Allocator& aAllocator, const GenericValue& aValue) throw() {
@@ -193,6 +518,18 @@ namespace Solaire {
 	    static GenericValue encode(Allocator& aAllocator, const T& aContainer) throw() {
             return ValueEncoder::encode(aAllocator, aContainer);
 	    }
+
+	    static GenericValue encode(Allocator& aAllocator, T&& aContainer) throw() {
+            return ValueEncoder::encode(aAllocator, std::move(aContainer));
+	    }
+
+	    static bool write(Allocator& aAllocator, Writer& aWriter, const T& aContainer) throw() {
+            return ValueEncoder::write(aAllocator, aWriter, aContainer);
+	    }
+
+	    static DecodeType read(Allocator& aAllocator, Reader& aReader) throw() {
+            return T(ValueEncoder::read(aAllocator, aReader));
+	    }
 	};
 }
 
@@ -28,13 +28,16 @@
 	\version 1.0
 	\date
 	Created			: 16th January 2016
-	Last Modified	: 16th January 2016
+	Last Modified	: 17th October 2026
 */
 
 #include "Solaire/Core/IStream.hpp"
 #include "Solaire/Core/OStream.hpp"
 #include "Solaire/Encode/GenericValue.hpp"
+#include "Solaire/Encode/GenericDocument.hpp"
 #include "Solaire/Encode/Encoder.hpp"
+#include "Solaire/Encode/BufferIStream.hpp"
+#include "Solaire/Encode/Parser.hpp"
 
 namespace Solaire {
 
@@ -64,34 +67,169 @@ namespace Solaire {
         */
         virtual bool SOLAIRE_EXPORT_CALL writeValue(const GenericValue&, OStream&) const throw() = 0;
 
+        /*!
+            \brief Decode data from the storage format and report whether it was decoded successfully.
+            \details Used in place of a Reader by readDocument, readLazyValue and PathQuery when the format does not
+            provide one. readValue returns a null value when it fails, so the default implementation only reports a null
+            value as decoded when the stream is offsetable and readValue consumed input from it. Formats that can fail
+            after consuming input, or that encode null values on streams that are not offsetable, should override it.
+            \param aStream The source of encoded data.
+            \param aValue Receives the decoded data, it is null if decoding failed.
+            \return True if the data was decoded successfully.
+            \see readValue
+        */
+        virtual bool SOLAIRE_EXPORT_CALL tryReadValue(IStream& aStream, GenericValue& aValue) const throw() {
+            const int32_t offset = aStream.isOffsetable() ? aStream.getOffset() : -1;
+            aValue = readValue(aStream);
+            if(! aValue.isNull()) return true;
+            return offset >= 0 && aStream.getOffset() > offset;
+        }
+
+        /*!
+            \brief Create a Reader that decodes the storage format one token at a time.
+            \details The caller is responsible for destroying the Reader and returning its memory to aAllocator.
+            \param aAllocator The allocator to allocate the Reader from.
+            \param aStream The source of encoded data.
+            \return The Reader, or nullptr if the format can only decode complete GenericValue trees.
+        */
+        virtual Reader* SOLAIRE_EXPORT_CALL createReader(Allocator& aAllocator, IStream& aStream) const throw() {
+            return nullptr;
+        }
+
+        /*!
+            \brief Create a Writer that encodes events directly into the storage format.
+            \details The caller is responsible for destroying the Writer and returning its memory to aAllocator.
+            \param aAllocator The allocator to allocate the Writer from.
+            \param aStream The place to store the encoded data.
+            \return The Writer, or nullptr if the format can only encode complete GenericValue trees.
+        */
+        virtual Writer* SOLAIRE_EXPORT_CALL createWriter(Allocator& aAllocator, OStream& aStream) const throw() {
+            return nullptr;
+        }
+
+        /*!
+            \brief Create a Parser that decodes values from input that is pushed into it in pieces.
+            \details The caller is responsible for destroying the Parser and returning its memory to aAllocator.
+            \param aAllocator The allocator to allocate the Parser and its state from.
+            \return The Parser, or nullptr if the format can only decode from an IStream.
+        */
+        virtual Parser* SOLAIRE_EXPORT_CALL createParser(Allocator& aAllocator) const throw() {
+            return nullptr;
+        }
+
+        /*!
+            \brief Decode a value from a block of memory, leaving the arrays and objects inside it encoded.
+            \details Only the top level of the value is decoded, nested arrays and objects are recorded by the range of
+            bytes they occupy with GenericValue::setLazy and are decoded with this function when they are first accessed,
+            so the cost of reading a document is proportional to the parts of it that are used. The default implementation
+            uses Reader::readLazyValue, formats whose Readers can not reference their source decode the whole value,
+            as do formats without a Reader, with tryReadValue.
+            Errors inside a nested value are only detected when it is decoded, it then becomes empty.
+            \param aData The first byte of the value, it must remain valid until every nested value has been decoded.
+            \param aSize The number of bytes in the block.
+            \param aValue Receives the value.
+            \return True if the top level of the value was decoded successfully.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL readLazyValue(const void* const aData, const uint32_t aSize, GenericValue& aValue) const throw() {
+            BufferIStream stream(aData, aSize);
+            Allocator& allocator = getDefaultAllocator();
+            Reader* const reader = createReader(allocator, stream);
+            if(reader == nullptr) return tryReadValue(stream, aValue);
+            const bool result = reader->readLazyValue(aValue, *this);
+            reader->~Reader();
+            allocator.deallocate(reader);
+            return result;
+        }
+
+        /*!
+            \brief Find the boundaries of consecutive documents in a block of memory.
+            \details The default implementation skips one value at a time with a Reader, formats that can find
+            boundaries without decoding should override it.
+            \param aData The first byte of the block.
+            \param aSize The number of bytes in the block.
+            \param aEnds Receives the offset one past the end of each document, in order.
+            \return True if the whole block was split into documents.
+            \see ParallelDocumentReader
+        */
+        virtual bool SOLAIRE_EXPORT_CALL findDocuments(const void* const aData, const uint32_t aSize, List<uint32_t>& aEnds) const throw() {
+            BufferIStream stream(aData, aSize);
+            Allocator& allocator = getDefaultAllocator();
+            Reader* const reader = createReader(allocator, stream);
+            if(reader == nullptr) return false;
+            bool result = true;
+            while(result && ! stream.end()) {
+                result = reader->skip();
+                if(result) aEnds.pushBack(static_cast<uint32_t>(stream.getOffset()));
+            }
+            reader->~Reader();
+            allocator.deallocate(reader);
+            return result;
+        }
+
+        /*!
+            \brief Decode data from the storage format into a GenericDocument.
+            \details Every node of the decoded tree is allocated from the document's arena. Formats without a Reader
+            decode with tryReadValue, the value is then copied into the arena.
+            \param aStream The source of encoded data.
+            \param aDocument Receives the decoded data, any previous contents are released.
+            \return True if the data was decoded successfully.
+            \see readValue
+        */
+        bool readDocument(IStream& aStream, GenericDocument& aDocument) const throw() {
+            aDocument.clear();
+            Allocator& allocator = getDefaultAllocator();
+            Reader* const reader = createReader(allocator, aStream);
+            if(reader == nullptr) return tryReadValue(aStream, aDocument.getRoot());
+            const bool result = reader->readValue(aDocument.getRoot());
+            reader->~Reader();
+            allocator.deallocate(reader);
+            return result;
+        }
+
         /*!
             \brief Decode a C++ object in place.
-            \details Passes the output of readValue into Encoder<T>::decode.
+            \details If the format provides a Reader the object is pulled from it by Encoder<T>::read,
+            otherwise the output of readValue is passed into Encoder<T>::decode.
             \tparam T The type of the object being decoded.
             \param aAllocator The allocator to allocate the object, and any parseing data from.
             \param aStream The source of encoded data.
             \see readValue
+            \see createReader
             \see Encoder::decode
+            \see Encoder::read
         */
         template<class T>
         SOLAIRE_FORCE_INLINE typename Encoder<T>::DecodeType read(Allocator& aAllocator, IStream& aStream) {
-            return Encoder<T>::decode(aAllocator, readValue(aStream));
+            Reader* const reader = createReader(aAllocator, aStream);
+            if(reader == nullptr) return Encoder<T>::decode(aAllocator, readValue(aStream));
+            typename Encoder<T>::DecodeType value = Solaire::decode<T>(aAllocator, *reader);
+            reader->~Reader();
+            aAllocator.deallocate(reader);
+            return value;
         }
 
         /*!
             \brief Encode a C++ object in place.
-            \details Passes the output of Encoder<T>::encode into writeValue.
+            \details If the format provides a Writer the object is streamed through Encoder<T>::write,
+            otherwise the output of Encoder<T>::encode is passed into writeValue.
             \tparam T The type of the object being encoded.
             \param aAllocator The allocator to allocate any parseing data from.
             \param aValue The object being encoded.
             \param aStream The place to store the encoded data.
             \return True if the object was encoded successfully.
             \see writeValue
+            \see createWriter
             \see Encoder::encode
+            \see Encoder::write
         */
         template<class T>
         SOLAIRE_FORCE_INLINE bool write(Allocator& aAllocator, const T& aValue, OStream& aStream) {
-            return writeValue(Encoder<T>::encode(aAllocator, aValue), aStream);
+            Writer* const writer = createWriter(aAllocator, aStream);
+            if(writer == nullptr) return writeValue(Encoder<T>::encode(aAllocator, aValue), aStream);
+            const bool result = Solaire::encode<T>(aAllocator, *writer, aValue) && writer->flush();
+            writer->~Writer();
+            aAllocator.deallocate(writer);
+            return result;
         }
 	};
 }
@@ -0,0 +1,78 @@
+#ifndef SOLAIRE_GENERIC_DOCUMENT_HPP
+#define SOLAIRE_GENERIC_DOCUMENT_HPP
+
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+/*!
+	\file GenericDocument.hpp
+	\brief
+	\author
+	Created			: Adam Smith
+	Last modified	: Adam Smith
+	\version 1.0
+	\date
+	Created			: 17th October 2026
+	Last Modified	: 17th October 2026
+*/
+
+#include "Solaire/Encode/ArenaAllocator.hpp"
+#include "Solaire/Encode/GenericValue.hpp"
+
+namespace Solaire {
+
+    /*!
+        \brief A GenericValue tree where every node is allocated from a single ArenaAllocator.
+        \details Nodes added through GenericValue::pushBack, GenericValue::emplace and the set functions are placed in the arena,
+        values that are assigned into the document are copied into it. Destroying or clearing the document releases
+        the whole tree at once without destroying individual nodes.
+        Copying or moving a value out of the document produces an independent tree that uses the default allocator.
+        \version 1.0.0
+    */
+	class GenericDocument {
+    private:
+        ArenaAllocator mArena;
+        GenericValue mRoot;
+    private:
+        GenericDocument(const GenericDocument&) = delete;
+        GenericDocument& operator=(const GenericDocument&) = delete;
+    public:
+        /*!
+            \brief Create an empty document.
+            \param aAllocator The allocator that arena blocks are taken from.
+            \param aBlockSize The minimum number of bytes in each arena block.
+        */
+        GenericDocument(Allocator& aAllocator = getDefaultAllocator(), const uint32_t aBlockSize = ArenaAllocator::DEFAULT_BLOCK_SIZE) throw();
+
+        /*!
+            \brief Release the document and every node in it.
+        */
+        ~GenericDocument() throw();
+
+        /*!
+            \brief Release every node and reset the root to null, keeping one arena block for reuse.
+        */
+        void clear() throw();
+
+        SOLAIRE_FORCE_INLINE GenericValue& getRoot() throw()                {return mRoot;}
+        SOLAIRE_FORCE_INLINE const GenericValue& getRoot() const throw()    {return mRoot;}
+        SOLAIRE_FORCE_INLINE Allocator& getAllocator() throw()              {return mArena;}
+	};
+}
+
+#endif
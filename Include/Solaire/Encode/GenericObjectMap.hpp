@@ -0,0 +1,159 @@
+#ifndef SOLAIRE_GENERIC_OBJECT_MAP_HPP
+#define SOLAIRE_GENERIC_OBJECT_MAP_HPP
+
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+/*!
+	\file GenericObjectMap.hpp
+	\brief
+	\author
+	Created			: Adam Smith
+	Last modified	: Adam Smith
+	\version 1.0
+	\date
+	Created			: 17th October 2026
+	Last Modified	: 17th October 2026
+*/
+
+#include "Solaire/Encode/GenericValue.hpp"
+#include "Solaire/Encode/KeyTable.hpp"
+
+namespace Solaire {
+
+    /*!
+        \brief The storage used for GenericValue objects.
+        \details Members are kept in insertion order. Once an object holds INDEX_THRESHOLD members an open addressing
+        hash table of member positions is built, so lookups no longer scan and compare every key.
+        The table is kept up to date by every modifying function of Map.
+        When a KeyTable was installed with KeyTable::setShared as the object was created, the name of every member is
+        also interned, and the index, lookups and comparisons with other objects that use the same table compare keys
+        by pointer instead of by characters. If a name can not be interned the object stops using its keys.
+        \version 1.0.0
+    */
+	class GenericObjectMap : public ListMap<CString, GenericValue> {
+    public:
+        enum : int32_t {
+            INDEX_THRESHOLD = 16    //!< The number of members at which the hash index is built.
+        };
+    private:
+        typedef ListMap<CString, GenericValue> BaseType;
+
+        struct Slot {
+            uint32_t hash;
+            int32_t index;
+        };
+    private:
+        Allocator& mAllocator;
+        KeyTable* const mKeyTable;
+        const KeyTable::Key** mKeys;
+        int32_t mKeyCapacity;
+        Slot* mSlots;
+        uint32_t mSlotMask;
+    private:
+        GenericObjectMap(const GenericObjectMap&) = delete;
+        GenericObjectMap& operator=(const GenericObjectMap&) = delete;
+
+        int32_t findIndex(const StringConstant<char>& aKey) const throw();
+        int32_t findIndex(const KeyTable::Key& aKey) const throw();
+        void addKey(const CString& aKey, const int32_t aIndex) throw();
+        void releaseKeys() throw();
+        void insertIndex(const uint32_t aHash, const int32_t aIndex) throw();
+        void rebuildIndex(const int32_t aCapacity) throw();
+        void releaseIndex() throw();
+    public:
+        /*!
+            \brief Calculate the hash of a member name.
+            \param aKey The name to hash.
+            \return The 32 bit FNV-1a hash of the characters.
+        */
+        static uint32_t hash(const StringConstant<char>& aKey) throw();
+
+        /*!
+            \brief Create an empty object.
+            \param aAllocator The allocator that members and the hash index are taken from.
+        */
+        GenericObjectMap(Allocator& aAllocator) throw();
+
+        /*!
+            \brief Destroy the object and release the hash index.
+        */
+        ~GenericObjectMap() throw();
+
+        /*!
+            \brief Find a member without creating a CString for the name.
+            \param aKey The name of the member.
+            \return The first member with the name, or nullptr if there is none.
+        */
+        GenericValue* find(const StringConstant<char>& aKey) throw();
+
+        /*!
+            \copydoc find
+        */
+        const GenericValue* find(const StringConstant<char>& aKey) const throw();
+
+        /*!
+            \brief Find the member with the same name as a member of another object.
+            \details When both objects intern their names in the same KeyTable the names are compared by pointer.
+            \param aOther The object that holds the name, which may be this object.
+            \param aIndex The position of the member in aOther.
+            \return The first member with the name, or nullptr if there is none.
+        */
+        const GenericValue* find(const GenericObjectMap& aOther, const int32_t aIndex) const throw();
+
+        /*!
+            \brief Check if two members have the same name.
+            \param aIndex The position of the member in this object.
+            \param aOther The object that holds the other member, which may be this object.
+            \param aOtherIndex The position of the other member in aOther.
+            \return True if the names are equal.
+        */
+        bool equalNames(const int32_t aIndex, const GenericObjectMap& aOther, const int32_t aOtherIndex) const throw();
+
+        /*!
+            \brief Get the interned name of a member.
+            \param aIndex The position of the member.
+            \return The key, or nullptr if the object does not intern its names.
+        */
+        SOLAIRE_FORCE_INLINE const KeyTable::Key* getKey(const int32_t aIndex) const throw()    {return mKeys ? mKeys[aIndex] : nullptr;}
+
+        /*!
+            \brief Add a member, moving the value instead of copying it.
+            \param aKey The name of the member.
+            \param aValue The value of the member, which is left null.
+            \return The added member.
+        */
+        GenericValue& emplace(const CString& aKey, GenericValue&& aValue) throw();
+
+        /*!
+            \brief Size the hash index for a number of members so that it is not rebuilt while they are added.
+            \param aCapacity The number of members that the object will hold.
+        */
+        void reserve(const int32_t aCapacity) throw();
+
+        // Inherited from Map
+
+        GenericValue& emplace(const CString& aKey, const GenericValue& aValue) throw() override;
+        bool erase(const CString& aKey) throw() override;
+        void clear() throw() override;
+        GenericValue& operator[](const CString& aKey) throw() override;
+        const GenericValue& operator[](const CString& aKey) const throw() override;
+	};
+}
+
+#endif
@@ -28,15 +28,34 @@
 	\version 1.0
 	\date
 	Created			: 15th January 2016
-	Last Modified	: 16th January 2016
+	Last Modified	: 17th October 2026
 */
 
+#include <atomic>
 #include <cstdint>
 #include "Solaire/Data/CString.hpp"
 #include "Solaire/Data/ListMap.hpp"
 
 namespace Solaire {
 
+    class GenericDocument;
+    class Format;
+
+    /*!
+        \brief A dynamically typed value that can hold a number, a string, an array or an object.
+        \details Copying a string, array or object does not copy it, the copies share the same node until one of them
+        is modified through a non-const function, which then copies the node for itself. Only the top level of the node
+        is copied, the members of an array or object continue to be shared. References returned by non-const functions
+        must not be used after the value has been copied. The reference counts are atomic, so values that share nodes may
+        be copied, modified and destroyed on different threads.
+        Const functions never change how a value is stored, so a value that is not being modified may be read from several
+        threads at once. Lazy and packed arrays and objects that are read through const functions are decoded or unpacked
+        into a cache on their node, which is published atomically and shared by every copy. The exception is values in a
+        GenericDocument, whose caches are allocated from its arena. Strings are only moved out of inline or borrowed storage
+        into a CString by the non-const getString.
+        Values that belong to a GenericDocument never share nodes, copying into or out of a document copies the whole tree.
+        \version 1.0.0
+    */
 	class GenericValue {
     public:
         typedef List<GenericValue> GenericArray;
@@ -53,6 +72,62 @@ namespace Solaire {
 	        ARRAY_T,
 	        OBJECT_T
 	    };
+
+        /*!
+            \brief Read-only access to the characters of a string value, wherever they are stored.
+            \details The view references the storage of the value, so it must not be used after the value is modified or
+            destroyed. The characters are not guaranteed to be null terminated.
+        */
+        class StringView {
+        private:
+            const char* mCharacters;
+            uint32_t mLength;
+        public:
+            SOLAIRE_FORCE_INLINE StringView(const char* const aCharacters, const uint32_t aLength) throw() :
+                mCharacters(aCharacters),
+                mLength(aLength)
+            {}
+
+            SOLAIRE_FORCE_INLINE const char* getCharacters() const throw()                  {return mCharacters;}
+            SOLAIRE_FORCE_INLINE uint32_t getLength() const throw()                         {return mLength;}
+            SOLAIRE_FORCE_INLINE int32_t size() const throw()                               {return static_cast<int32_t>(mLength);}
+            SOLAIRE_FORCE_INLINE const char& operator[](const int32_t aIndex) const throw() {return mCharacters[aIndex];}
+        };
+    private:
+        enum : uint8_t {
+            FLAG_ARENA = 1,         //!< Nodes are owned by an ArenaAllocator and are released with it rather than destroyed.
+            FLAG_INLINE_STRING = 2,     //!< The string is stored in mInline rather than in a CString.
+            FLAG_BORROWED_STRING = 4,   //!< The string references characters owned by someone else through mBorrowed.
+            FLAG_PACKED_ARRAY = 8,      //!< The array is stored contiguously in mPacked rather than in a GenericArray.
+            FLAG_LAZY = 16,             //!< The array or object is still encoded, mLazy references its bytes.
+            FLAG_DECODE_FAILED = 32,    //!< The array or object is empty because the bytes given to setLazy were malformed.
+            STRING_FLAGS = FLAG_INLINE_STRING | FLAG_BORROWED_STRING,
+            CONTAINER_FLAGS = FLAG_PACKED_ARRAY | FLAG_LAZY,
+            STORAGE_FLAGS = STRING_FLAGS | CONTAINER_FLAGS | FLAG_DECODE_FAILED
+        };
+
+        struct BorrowedString {
+            const char* characters;
+            uint32_t length;
+        };
+
+        struct PackedArray {
+            uint32_t size;
+            ValueType type;
+            std::atomic<GenericValue*> unpacked;    //!< The elements as a GenericArray, once they were read through getArray.
+        };
+
+        struct LazyValue {
+            const Format* format;
+            const void* data;
+            uint32_t size;
+            std::atomic<GenericValue*> decoded;     //!< The decoded value, once it was read through a const function.
+        };
+    public:
+        enum : uint32_t {
+            INLINE_CAPACITY = 15,                       //!< The longest string that is stored inside the value without an allocation.
+            MAX_PACKED_SIZE = (0xFFFFFFFFU - 32) / 8    //!< The most elements a packed array can hold, so that its node size fits in 32 bits.
+        };
     private:
 	    union {
 	        char mChar;
@@ -63,9 +138,36 @@ namespace Solaire {
 	        CString* mString;
 	        GenericArray* mArray;
 	        GenericObject* mObject;
+	        BorrowedString mBorrowed;
+	        PackedArray* mPacked;
+	        LazyValue* mLazy;
+	        char mInline[INLINE_CAPACITY + 1];
 	    };
 	    Allocator* mAllocator;
 	    ValueType mType;
+	    uint8_t mFlags;
+	    uint8_t mInlineLength;
+    private:
+        GenericValue(Allocator& aAllocator, const uint8_t aFlags) throw();
+
+        void copyFrom(const GenericValue& aOther) throw();
+        void cloneFrom(const GenericValue& aOther) throw();
+        void* getNode() const throw();
+        bool isShared() const throw();
+        void detach() throw();
+        GenericValue& adopt(GenericValue& aChild) const throw();
+        void promoteString() throw();
+        GenericArray* unpackElements() const throw();
+        void unpackArray() throw();
+        void decodeFrom(const ValueType aType, const Format& aFormat, const void* const aData, const uint32_t aSize) throw();
+        void parseLazy() throw();
+        GenericValue* createCache() const throw();
+        const GenericValue& getDecoded() const throw();
+        const GenericArray& getUnpacked() const throw();
+        void cacheHash(const uint64_t aHash) const throw();
+
+        friend class GenericDocument;
+        friend class Reader;
     public:
         GenericValue() throw();
         GenericValue(const ValueType) throw();
@@ -84,6 +186,13 @@ namespace Solaire {
         GenericValue(const double aValue) throw();
         GenericValue(const StringConstant<char>& aValue) throw();
 
+        /*!
+            \brief Create a string value that takes the characters of a CString.
+            \param aValue The string to take, which is left in an unspecified state.
+        */
+        GenericValue(CString&& aValue) throw();
+        ~GenericValue() throw();
+
         GenericValue& operator=(const GenericValue& aOther) throw();
         GenericValue& operator=(GenericValue&& aOther) throw();
 
@@ -92,13 +201,59 @@ namespace Solaire {
         uint64_t getUnsigned() const throw();
         int64_t getSigned() const throw();
         double getDouble() const throw();
-        const String<char>& getString() const throw();
+
+        /*!
+            \brief Access the characters of a string value without changing how it is stored.
+            \return A view of the characters, which is empty if the value is not a string.
+            \see getStringPointer
+        */
+        StringView getString() const throw();
+
+        /*!
+            \brief Access a string value as a CString that may be modified.
+            \details Inline and borrowed strings are copied into a CString first, and a shared CString is copied for this value.
+            \return The string.
+        */
         String<char>& getString() throw();
+
+        /*!
+            \brief Access the characters of an inline or borrowed string without moving it into a CString.
+            \details The characters are not guaranteed to be null terminated.
+            \return The first character if the string is not stored in a CString, otherwise nullptr.
+            \see getStringLength
+        */
+        const char* getStringPointer() const throw();
+
+        /*!
+            \brief Get the number of characters in a string value.
+            \details Unlike the non-const getString this never allocates.
+            \return The length of the string, or 0 if the value is not a string.
+        */
+        uint32_t getStringLength() const throw();
         const GenericArray& getArray() const throw();
         GenericArray& getArray() throw();
         const GenericObject& getObject() const throw();
         GenericObject& getObject() throw();
 
+        /*!
+            \brief Get the element type of a packed array.
+            \return UNSIGNED_T, SIGNED_T or DOUBLE_T if the value is a packed array, otherwise NULL_T.
+            \see setPackedArray
+        */
+        ValueType getPackedType() const throw();
+
+        /*!
+            \brief Access the elements of a packed array without unpacking it.
+            \details The elements are uint64_t, int64_t or double depending on getPackedType.
+            \return The first element, or nullptr if the value is not a packed array.
+        */
+        const void* getPackedArray() const throw();
+
+        /*!
+            \copydoc getPackedArray
+        */
+        void* getPackedArray() throw();
+
         void setNull() throw();
         char& setChar(const char aValue) throw();
         bool& setBool(const bool aValue) throw();
@@ -106,9 +261,86 @@ namespace Solaire {
         int64_t& setSigned(const int64_t aValue) throw();
         double& setDouble(const double aValue) throw();
         String<char>& setString() throw();
+
+        /*!
+            \brief Set the value to a copy of a string.
+            \details Strings of up to INLINE_CAPACITY characters are stored inside the value without an allocation.
+            \param aValue The first character to copy.
+            \param aLength The number of characters to copy.
+        */
+        void setString(const char* const aValue, const uint32_t aLength) throw();
+
+        /*!
+            \brief Set the value to a copy of a string.
+            \details Strings of up to INLINE_CAPACITY characters are stored inside the value without an allocation.
+            \param aValue The string to copy.
+        */
+        void setString(const StringConstant<char>& aValue) throw();
+
+        /*!
+            \brief Set the value to a string, taking the characters of a CString instead of copying them.
+            \details Short strings are still copied inline, and strings are always copied when the value belongs to a GenericDocument.
+            \param aValue The string to take, which is left in an unspecified state.
+        */
+        void setString(CString&& aValue) throw();
+
+        /*!
+            \brief Set the value to a string that references characters instead of copying them.
+            \details The characters are copied into a CString the first time the non-const getString is called, they must remain valid
+            until then or until the value is changed. Copies of the value reference the same characters.
+            \param aValue The first character of the string.
+            \param aLength The number of characters in the string.
+        */
+        void setBorrowedString(const char* const aValue, const uint32_t aLength) throw();
         GenericArray& setArray() throw();
         GenericObject& setObject() throw();
 
+        /*!
+            \brief Set the value to an array of numbers that are stored contiguously.
+            \details The array behaves like any other array, but is only converted into a GenericArray if it is accessed
+            through getArray, operator[] or pushBack. The elements are not initialised.
+            \param aType The element type, UNSIGNED_T, SIGNED_T or DOUBLE_T.
+            \param aSize The number of elements.
+            \return The first element, or nullptr if aType can not be packed, aSize is greater than MAX_PACKED_SIZE or the
+            elements could not be allocated, in which case the value is left null.
+        */
+        void* setPackedArray(const ValueType aType, const uint32_t aSize) throw();
+
+        /*!
+            \brief Set the value to an array or object that is decoded from its encoded bytes when it is first accessed.
+            \details The bytes are decoded by Format::readLazyValue the first time the elements or members are reached
+            through getArray, getObject, operator[], find, size or any function that modifies them, and arrays and objects
+            inside it are left encoded in the same way. Copies of the value share the bytes, and share the decoded value
+            once it has been read through a const function. If the bytes can not be decoded as a value of aType the value
+            becomes an empty array or object and hasDecodeFailed returns true.
+            \param aType ARRAY_T or OBJECT_T.
+            \param aFormat The format of the bytes, it must remain valid until the value has been decoded.
+            \param aData The first byte of the encoded value, it must remain valid until the value has been decoded.
+            \param aSize The number of bytes in the encoded value.
+            \see Format::readLazyValue
+        */
+        void setLazy(const ValueType aType, const Format& aFormat, const void* const aData, const uint32_t aSize) throw();
+
+        /*!
+            \brief Check if the value is an array or object that has not been decoded yet.
+            \return True if the value was set by setLazy and has not been accessed through a non-const function since.
+        */
+        SOLAIRE_FORCE_INLINE bool isLazy() const throw()                                                        {return (mFlags & FLAG_LAZY) != 0;}
+
+        /*!
+            \brief Check if the value is an empty array or object because the bytes given to setLazy were malformed.
+            \details A value that has not been decoded yet is decoded by this call.
+            \return True if the bytes could not be decoded as a value of the type given to setLazy.
+        */
+        bool hasDecodeFailed() const throw();
+
+        SOLAIRE_FORCE_INLINE const uint64_t* getUnsignedArray() const throw()                                   {return getPackedType() == UNSIGNED_T ? static_cast<const uint64_t*>(getPackedArray()) : nullptr;}
+        SOLAIRE_FORCE_INLINE const int64_t* getSignedArray() const throw()                                      {return getPackedType() == SIGNED_T ? static_cast<const int64_t*>(getPackedArray()) : nullptr;}
+        SOLAIRE_FORCE_INLINE const double* getDoubleArray() const throw()                                       {return getPackedType() == DOUBLE_T ? static_cast<const double*>(getPackedArray()) : nullptr;}
+        SOLAIRE_FORCE_INLINE uint64_t* setUnsignedArray(const uint32_t aSize) throw()                           {return static_cast<uint64_t*>(setPackedArray(UNSIGNED_T, aSize));}
+        SOLAIRE_FORCE_INLINE int64_t* setSignedArray(const uint32_t aSize) throw()                              {return static_cast<int64_t*>(setPackedArray(SIGNED_T, aSize));}
+        SOLAIRE_FORCE_INLINE double* setDoubleArray(const uint32_t aSize) throw()                               {return static_cast<double*>(setPackedArray(DOUBLE_T, aSize));}
+
         SOLAIRE_FORCE_INLINE ValueType getType() const throw()                                                  {return mType;}
 
         SOLAIRE_FORCE_INLINE bool isNull() const throw()                                                        {return mType == NULL_T;}
@@ -134,7 +366,7 @@ namespace Solaire {
         SOLAIRE_FORCE_INLINE explicit operator float() const throw()                                            {return static_cast<float>(getDouble());}
         SOLAIRE_FORCE_INLINE explicit operator double() const throw()                                           {return getDouble();}
         SOLAIRE_FORCE_INLINE explicit operator String<char>&() throw()                                          {if(! isString()) setString(); return getString();}
-        SOLAIRE_FORCE_INLINE explicit operator const String<char>&() const throw()                              {return getString();}
+        SOLAIRE_FORCE_INLINE explicit operator StringView() const throw()                                       {return getString();}
         SOLAIRE_FORCE_INLINE explicit operator GenericArray&() throw()                                          {if(! isArray()) setArray(); return getArray();}
         SOLAIRE_FORCE_INLINE explicit operator const GenericArray&() const throw()                              {return getArray();}
         SOLAIRE_FORCE_INLINE explicit operator GenericObject&() throw()                                         {if(! isObject()) setObject(); return getObject();}
@@ -152,18 +384,77 @@ namespace Solaire {
         SOLAIRE_FORCE_INLINE GenericValue& operator=(const uint64_t aValue) throw()                             {setUnsigned(aValue); return *this;}
         SOLAIRE_FORCE_INLINE GenericValue& operator=(const float aValue) throw()                                {setDouble(aValue); return *this;}
         SOLAIRE_FORCE_INLINE GenericValue& operator=(const double aValue) throw()                               {setDouble(aValue); return *this;}
-        SOLAIRE_FORCE_INLINE GenericValue& operator=(const String<char>& aValue) throw()                        {setString() = aValue; return *this;}
+        SOLAIRE_FORCE_INLINE GenericValue& operator=(const String<char>& aValue) throw()                        {setString(aValue); return *this;}
         template<class T>
         SOLAIRE_FORCE_INLINE GenericValue& operator=(const T& aValue) throw()                                   {setString() = aValue; return *this;}
 
-        SOLAIRE_FORCE_INLINE GenericValue& operator[](const int32_t aIndex) throw()                             {return (*mArray)[aIndex];}
-        SOLAIRE_FORCE_INLINE const GenericValue& operator[](const int32_t aIndex) const throw()                 {return (*mArray)[aIndex];}
-        SOLAIRE_FORCE_INLINE GenericValue& operator[](const StringConstant<char>& aName) throw()                {return (*mObject)[aName];}
-        SOLAIRE_FORCE_INLINE const GenericValue& operator[](const StringConstant<char>& aName) const throw()    {return (*mObject)[aName];}
+        SOLAIRE_FORCE_INLINE GenericValue& operator[](const int32_t aIndex) throw()                             {return getArray()[aIndex];}
+        SOLAIRE_FORCE_INLINE const GenericValue& operator[](const int32_t aIndex) const throw()                 {return getArray()[aIndex];}
+        GenericValue& operator[](const StringConstant<char>& aName) throw();
+        const GenericValue& operator[](const StringConstant<char>& aName) const throw();
+
+        /*!
+            \brief Find a member of an object.
+            \details Objects with many members are hash indexed, so this does not scan every name.
+            \param aName The name of the member.
+            \return The member, or nullptr if the value is not an object or has no member with the name.
+        */
+        GenericValue* find(const StringConstant<char>& aName) throw();
+
+        /*!
+            \copydoc find
+        */
+        const GenericValue* find(const StringConstant<char>& aName) const throw();
+
+        GenericValue& pushBack(const GenericValue& aValue) throw();
+
+        /*!
+            \brief Append a value to an array, moving it instead of copying it.
+            \param aValue The value to append, which is left null.
+            \return The appended element.
+        */
+        GenericValue& pushBack(GenericValue&& aValue) throw();
+        GenericValue& emplace(const StringConstant<char>& aName, const GenericValue& aValue) throw();
+
+        /*!
+            \brief Add a member to an object, moving the value instead of copying it.
+            \param aName The name of the member.
+            \param aValue The value of the member, which is left null.
+            \return The added member.
+        */
+        GenericValue& emplace(const StringConstant<char>& aName, GenericValue&& aValue) throw();
+
+        /*!
+            \brief Allocate space for the elements of an array or the members of an object before they are added.
+            \details Does nothing if the value is not an array or object, or is a packed array.
+            \param aCapacity The number of elements or members that will be added.
+        */
+        void reserve(const int32_t aCapacity) throw();
+
+        /*!
+            \brief Calculate a hash of the structure and contents of the value.
+            \details The hash of an array or object is cached on its node, so it is only calculated again after the node
+            has been modified through a non-const function. Modifying a container through a reference that was obtained
+            before the hash was calculated is not detected.
+            \return The hash, which is equal for values that compare equal.
+            \see StructuralHash
+        */
+        uint64_t hash() const throw();
+
+        /*!
+            \brief Compare the structure and contents of two values.
+            \details Values of different types are never equal, even if they hold the same number. Strings and arrays are
+            compared however they are stored, and objects are equal if they have the same members in any order.
+            The comparison stops at the first difference, and arrays or objects that share a node are decided without
+            visiting their elements. Cached hashes are not used, as they can be out of date after a modification through
+            an earlier reference.
+            \param aOther The value to compare with.
+            \return True if the values are equal.
+        */
+        bool operator==(const GenericValue& aOther) const throw();
+        SOLAIRE_FORCE_INLINE bool operator!=(const GenericValue& aOther) const throw()                          {return ! operator==(aOther);}
 
-        SOLAIRE_FORCE_INLINE GenericValue& pushBack(const GenericValue& aValue) throw()                         {if(! isArray()) setArray(); return mArray->pushBack(aValue);}
-        SOLAIRE_FORCE_INLINE GenericValue& emplace(const CString& aName, const GenericValue& aValue) throw()    {if(! isObject()) setObject(); return mObject->emplace(aName, aValue);}
-        SOLAIRE_FORCE_INLINE int32_t size() const throw()                                                       {return isArray() ? mArray->size() : isObject() ? mObject->size() : 0;}
+        SOLAIRE_FORCE_INLINE int32_t size() const throw()                                                       {if(mFlags & FLAG_LAZY) return getDecoded().size(); return isArray() ? (mFlags & FLAG_PACKED_ARRAY ? static_cast<int32_t>(mPacked->size) : mArray->size()) : isObject() ? mObject->size() : 0;}
         SOLAIRE_FORCE_INLINE Allocator& getAllocator() const throw()                                            {return *mAllocator;}
         SOLAIRE_FORCE_INLINE void clear() throw()                                                               {setNull();}
 	};
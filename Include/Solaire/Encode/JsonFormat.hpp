@@ -0,0 +1,88 @@
+#ifndef SOLAIRE_JSON_FORMAT_HPP
+#define SOLAIRE_JSON_FORMAT_HPP
+
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+/*!
+	\file JsonFormat.hpp
+	\brief
+	\author
+	Created			: Adam Smith
+	Last modified	: Adam Smith
+	\version 1.0
+	\date
+	Created			: 17th October 2026
+	Last Modified	: 17th October 2026
+*/
+
+#include "Solaire/Encode/Format.hpp"
+#include "Solaire/Encode/BufferIStream.hpp"
+
+namespace Solaire {
+
+    /*!
+        \brief A Format that reads and writes RFC 8259 JSON text.
+        \details Decoding runs in two passes. The whole text is first indexed by JsonIndexer, which finds every token
+        with vector instructions, the Reader then walks the index instead of examining each character, so skipping a
+        value only visits its tokens. When the source is a BufferIStream, such as a MappedIStream, its memory is indexed
+        in place, otherwise the stream is read into a temporary buffer. Only the bytes of each top level value and the
+        whitespace after it are consumed, so a stream may hold several documents, a value followed by anything that can
+        not begin another value fails. Streams that are neither a BufferIStream nor offsetable are consumed entirely.
+        The Parser returned by createParser does not index the text, it decodes one character at a time so that values
+        may arrive in any number of pieces.
+
+        Values are mapped as follows :
+        - NULL_T, BOOL_T : null, true and false.
+        - CHAR_T : A string of one character.
+        - UNSIGNED_T, SIGNED_T : Integers, which decode as SIGNED_T when they are negative and UNSIGNED_T otherwise.
+        - DOUBLE_T : Numbers with a fraction or exponent, one is always written. Infinity and NaN are written as null.
+        - STRING_T : Strings, with escape sequences decoded to UTF-8.
+        - ARRAY_T, OBJECT_T : Arrays and objects, packed arrays are written as normal arrays.
+        Arrays and objects are read with UNKNOWN_SIZE.
+        Consecutive documents may be separated by any whitespace, including newlines.
+
+        When string borrowing is enabled and the source is a BufferIStream, decoded strings that contain no escape
+        sequences reference the characters in the buffer instead of copying them, so the buffer must outlive the
+        decoded values.
+        \version 1.0.0
+        \see JsonIndexer
+    */
+	class JsonFormat : public Format {
+    private:
+        const bool mBorrowStrings;
+    public:
+        /*!
+            \brief Create a JsonFormat.
+            \param aBorrowStrings If decoded strings should reference the source when it is a BufferIStream.
+            \see GenericValue::setBorrowedString
+        */
+        JsonFormat(const bool aBorrowStrings = false) throw();
+
+        // Inherited from Format
+
+        GenericValue SOLAIRE_EXPORT_CALL readValue(IStream& aStream) const throw() override;
+        bool SOLAIRE_EXPORT_CALL writeValue(const GenericValue& aValue, OStream& aStream) const throw() override;
+        Reader* SOLAIRE_EXPORT_CALL createReader(Allocator& aAllocator, IStream& aStream) const throw() override;
+        Writer* SOLAIRE_EXPORT_CALL createWriter(Allocator& aAllocator, OStream& aStream) const throw() override;
+        Parser* SOLAIRE_EXPORT_CALL createParser(Allocator& aAllocator) const throw() override;
+        bool SOLAIRE_EXPORT_CALL findDocuments(const void* const aData, const uint32_t aSize, List<uint32_t>& aEnds) const throw() override;
+	};
+}
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef SOLAIRE_JSON_INDEXER_HPP
+#define SOLAIRE_JSON_INDEXER_HPP
+
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+/*!
+	\file JsonIndexer.hpp
+	\brief
+	\author
+	Created			: Adam Smith
+	Last modified	: Adam Smith
+	\version 1.0
+	\date
+	Created			: 17th October 2026
+	Last Modified	: 17th October 2026
+*/
+
+#include <cstdint>
+#include "Solaire/Core/Init.hpp"
+
+namespace Solaire {
+
+    /*!
+        \brief The first pass of the JSON parser, finds the position of every token in a block of text.
+        \details Text is classified 64 bytes at a time with AVX2 or SSE2 when the compiler targets them, otherwise with
+        a portable scalar loop. Each block produces bit masks of quotes, backslashes, structural characters and
+        whitespace, from which the escaped characters and the characters inside strings are derived without branches.
+        The positions written are those of the structural characters {}[]:, outside of strings, the opening quote of
+        every string and the first character of every other scalar.
+        State is carried between calls, so a document can be indexed in several chunks.
+        \version 1.0.0
+    */
+	class JsonIndexer {
+    public:
+        enum : uint32_t {
+            BLOCK_BYTES = 64    //!< The number of bytes classified at once.
+        };
+    private:
+        uint64_t mEscapeCarry;
+        uint64_t mStringCarry;
+        uint64_t mScalarCarry;
+    public:
+        /*!
+            \brief Get the name of the instruction set the indexer was compiled for.
+            \return "AVX2", "SSE2" or "Scalar".
+        */
+        static const char* getImplementation() throw();
+
+        /*!
+            \brief Create an indexer positioned at the start of a document.
+        */
+        JsonIndexer() throw();
+
+        /*!
+            \brief Forget the state of the previous chunks, so that the next chunk begins a new document.
+        */
+        void reset() throw();
+
+        /*!
+            \brief Find the tokens in a chunk of text.
+            \details Every chunk except the last should be a multiple of BLOCK_BYTES long,
+            the end of a chunk that is not is treated as whitespace.
+            \param aText The first character of the chunk.
+            \param aLength The number of characters in the chunk.
+            \param aOffset The value added to each position that is written, normally the offset of the chunk in the document.
+            \param aPositions Receives the positions, it must have space for aLength values.
+            \return The number of positions that were written.
+        */
+        uint32_t index(const char* const aText, const uint32_t aLength, const uint32_t aOffset, uint32_t* const aPositions) throw();
+
+        /*!
+            \brief Check if the text indexed so far ends inside a string.
+            \return True if a string has been opened and not closed.
+        */
+        bool isInString() const throw();
+	};
+}
+
+#endif
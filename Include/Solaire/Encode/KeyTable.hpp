@@ -0,0 +1,164 @@
+#ifndef SOLAIRE_KEY_TABLE_HPP
+#define SOLAIRE_KEY_TABLE_HPP
+
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+/*!
+	\file KeyTable.hpp
+	\brief
+	\author
+	Created			: Adam Smith
+	Last modified	: Adam Smith
+	\version 1.0
+	\date
+	Created			: 17th October 2026
+	Last Modified	: 17th October 2026
+*/
+
+#include <atomic>
+#include <mutex>
+#include "Solaire/Core/Init.hpp"
+#include "Solaire/Data/CString.hpp"
+
+namespace Solaire {
+
+    /*!
+        \brief Interns object member names, so that names from the same table are equal only if they are the same Key.
+        \details Interning is opt-in : a table installed with setShared is picked up by every object that is created
+        afterwards, on any thread and in any document, and those objects look up, index and compare their members by Key
+        instead of by characters. Objects created before the table was installed, or while none is installed, are not affected.
+        Every member still stores its own copy of its name, so interning makes lookups faster but does not save memory.
+        Keys are never removed, so the table must outlive every object that was created while it was installed. Once it
+        holds its maximum number of names intern fails, and objects that need a new name compare by characters instead,
+        so documents with unbounded sets of names do not grow the table without limit. To release the names, install a
+        new table and destroy the old one when the objects that used it are gone.
+        Lookups do not lock, adding a new name locks one of LOCK_COUNT mutexes. When there are more than MAX_LOAD names
+        per bucket the number of buckets is doubled, which locks every mutex. Readers may still be walking the old buckets,
+        so they are kept until the table is destroyed, which costs at most as much memory again as the current buckets.
+        \version 1.0.0
+        \see GenericObjectMap
+    */
+	class KeyTable {
+    public:
+        enum : uint32_t {
+            DEFAULT_BUCKETS = 1024,     //!< The number of buckets used when none is given.
+            DEFAULT_MAX_SIZE = 65536,   //!< The number of names that a table holds when no limit is given.
+            MAX_LOAD = 2,               //!< The average number of names per bucket above which the buckets are doubled.
+            LOCK_COUNT = 16             //!< The number of mutexes that adding names is spread over.
+        };
+
+        /*!
+            \brief An interned name, the characters follow the Key in the same allocation.
+        */
+        class Key {
+        private:
+            const KeyTable* mTable;
+            uint64_t mNameHash;
+            uint32_t mHash;
+            uint32_t mLength;
+        private:
+            Key(const Key&) = delete;
+            Key& operator=(const Key&) = delete;
+
+            friend class KeyTable;
+        public:
+            Key() throw() = default;
+
+            SOLAIRE_FORCE_INLINE const KeyTable& getTable() const throw()       {return *mTable;}
+            SOLAIRE_FORCE_INLINE const char* getCharacters() const throw()      {return reinterpret_cast<const char*>(this + 1);}
+            SOLAIRE_FORCE_INLINE uint32_t getLength() const throw()             {return mLength;}
+            SOLAIRE_FORCE_INLINE uint32_t getHash() const throw()               {return mHash;}       //!< The same as GenericObjectMap::hash.
+            SOLAIRE_FORCE_INLINE uint64_t getNameHash() const throw()           {return mNameHash;}   //!< The same as StructuralHash::hashName.
+        };
+    private:
+        struct Link {
+            const Key* key;
+            Link* next;
+        };
+
+        // The heads of the chains follow the Buckets in the same allocation
+        struct Buckets {
+            Buckets* previous;
+            uint32_t mask;
+
+            SOLAIRE_FORCE_INLINE std::atomic<Link*>* getHeads() throw()                 {return reinterpret_cast<std::atomic<Link*>*>(this + 1);}
+            SOLAIRE_FORCE_INLINE const std::atomic<Link*>* getHeads() const throw()     {return reinterpret_cast<const std::atomic<Link*>*>(this + 1);}
+        };
+    private:
+        Allocator& mAllocator;
+        std::atomic<Buckets*> mBuckets;
+        const uint32_t mMaxSize;
+        std::atomic<uint32_t> mSize;
+        std::mutex mLocks[LOCK_COUNT];
+    private:
+        KeyTable(const KeyTable&) = delete;
+        KeyTable& operator=(const KeyTable&) = delete;
+
+        Buckets* createBuckets(const uint32_t aCount) throw();
+        void destroyBuckets(Buckets* aBuckets) throw();
+        void grow() throw();
+        const Key* find(const StringConstant<char>& aName, const uint32_t aHash) const throw();
+    public:
+        /*!
+            \brief Create an empty table.
+            \param aAllocator The allocator that buckets and keys are taken from.
+            \param aBuckets The initial number of buckets, which is rounded up to a power of two.
+            \param aMaxSize The largest number of distinct names that the table holds.
+        */
+        KeyTable(Allocator& aAllocator = getDefaultAllocator(), const uint32_t aBuckets = DEFAULT_BUCKETS, const uint32_t aMaxSize = DEFAULT_MAX_SIZE) throw();
+
+        /*!
+            \brief Release every key, which must no longer be used by any object.
+        */
+        ~KeyTable() throw();
+
+        /*!
+            \brief Get the key for a name, adding it if the table does not contain it.
+            \param aName The name.
+            \return The key, or nullptr if it could not be allocated or the table is full.
+        */
+        const Key* intern(const StringConstant<char>& aName) throw();
+
+        /*!
+            \brief Get the key for a name without adding it.
+            \param aName The name.
+            \return The key, or nullptr if the name has not been interned.
+        */
+        const Key* find(const StringConstant<char>& aName) const throw();
+
+        /*!
+            \brief Get the number of distinct names in the table.
+        */
+        uint32_t size() const throw();
+
+        /*!
+            \brief Install the table that objects created from now on intern their member names in.
+            \param aTable The table, or nullptr to stop interning names in objects that are created later.
+        */
+        static void SOLAIRE_EXPORT_CALL setShared(KeyTable* const aTable) throw();
+
+        /*!
+            \brief Get the table that was installed with setShared.
+            \return The table, or nullptr if none is installed.
+        */
+        static KeyTable* SOLAIRE_EXPORT_CALL getShared() throw();
+	};
+}
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef SOLAIRE_MAPPED_ISTREAM_HPP
+#define SOLAIRE_MAPPED_ISTREAM_HPP
+
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+/*!
+	\file MappedIStream.hpp
+	\brief
+	\author
+	Created			: Adam Smith
+	Last modified	: Adam Smith
+	\version 1.0
+	\date
+	Created			: 17th October 2026
+	Last Modified	: 17th October 2026
+*/
+
+#include "Solaire/Encode/BufferIStream.hpp"
+
+namespace Solaire {
+
+    /*!
+        \brief A BufferIStream over a read only memory mapping of a file.
+        \details Pages are loaded by the operating system as they are first touched, so opening a file does not copy
+        it. The kernel is advised that the mapping will be read sequentially. Because the stream is a BufferIStream,
+        formats detect it and parse the mapped bytes in place, and borrowed strings reference the mapping, so it must
+        remain open while they are in use. Files larger than 4 GiB - 1 bytes cannot be opened.
+        \version 1.0.0
+    */
+	class MappedIStream : public BufferIStream {
+    private:
+        void* mMapping;
+        void* mHandle;
+    private:
+        MappedIStream(const MappedIStream&) = delete;
+        MappedIStream& operator=(const MappedIStream&) = delete;
+    public:
+        /*!
+            \brief Create a stream that is not yet open.
+        */
+        MappedIStream() throw();
+
+        /*!
+            \brief Unmap the file.
+        */
+        SOLAIRE_EXPORT_CALL ~MappedIStream() throw();
+
+        /*!
+            \brief Map a file, closing the file that was previously open.
+            \param aPath The path of the file.
+            \return True if the file was mapped, the stream is then positioned at its first byte.
+        */
+        bool open(const char* const aPath) throw();
+
+        /*!
+            \brief Unmap the file, after which the stream is empty.
+        */
+        void close() throw();
+
+        /*!
+            \brief Check if a file is open.
+            \return True if open succeeded and close has not been called since.
+        */
+        bool isOpen() const throw();
+	};
+}
+
+#endif
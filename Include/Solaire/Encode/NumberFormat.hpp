@@ -0,0 +1,113 @@
+#ifndef SOLAIRE_NUMBER_FORMAT_HPP
+#define SOLAIRE_NUMBER_FORMAT_HPP
+
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+/*!
+	\file NumberFormat.hpp
+	\brief
+	\author
+	Created			: Adam Smith
+	Last modified	: Adam Smith
+	\version 1.0
+	\date
+	Created			: 17th October 2026
+	Last Modified	: 17th October 2026
+*/
+
+#include <cstdint>
+#include "Solaire/Core/Init.hpp"
+
+namespace Solaire {
+
+    /*!
+        \brief Converts numbers to and from text.
+        \details Doubles are formatted with the Ryu algorithm, which produces the shortest sequence of digits that
+        parses back to exactly the same value. Parsing accepts the JSON number grammar : an optional minus sign,
+        an integer part without leading zeros, an optional fraction and an optional exponent. Decimal values
+        with at most 19 significant digits and a small exponent are converted exactly with one floating point
+        operation, other values fall back to strtod so the result is always correctly rounded.
+        None of the functions depend on the current locale.
+        \version 1.0.0
+    */
+	class NumberFormat {
+    public:
+        enum : uint32_t {
+            MAX_UNSIGNED_CHARACTERS = 20,   //!< The longest text produced by formatUnsigned.
+            MAX_SIGNED_CHARACTERS = 20,     //!< The longest text produced by formatSigned.
+            MAX_DOUBLE_CHARACTERS = 25      //!< The longest text produced by formatDouble.
+        };
+    public:
+        /*!
+            \brief Write an unsigned integer in decimal.
+            \param aValue The value to write.
+            \param aBuffer Receives the characters, it must have space for MAX_UNSIGNED_CHARACTERS. No terminator is written.
+            \return The number of characters written.
+        */
+        static uint32_t formatUnsigned(uint64_t aValue, char* const aBuffer) throw();
+
+        /*!
+            \brief Write a signed integer in decimal.
+            \param aValue The value to write.
+            \param aBuffer Receives the characters, it must have space for MAX_SIGNED_CHARACTERS. No terminator is written.
+            \return The number of characters written.
+        */
+        static uint32_t formatSigned(const int64_t aValue, char* const aBuffer) throw();
+
+        /*!
+            \brief Write the shortest text that parses back to the same double.
+            \details Values between 1e-6 and 1e21 are written without an exponent, others as a single digit, a fraction
+            and an exponent, for example 1.5e-7. Integer values keep a fraction of .0 so that they are not read back as
+            integers. Infinities are written as Infinity and -Infinity and not a number as NaN.
+            \param aValue The value to write.
+            \param aBuffer Receives the characters, it must have space for MAX_DOUBLE_CHARACTERS. No terminator is written.
+            \return The number of characters written.
+        */
+        static uint32_t formatDouble(const double aValue, char* const aBuffer) throw();
+
+        /*!
+            \brief Read an unsigned integer.
+            \param aCharacters The first character of the text.
+            \param aLength The number of characters available.
+            \param aValue Receives the value.
+            \return The number of characters consumed, 0 if the text does not begin with an integer or the value does not fit.
+        */
+        static uint32_t parseUnsigned(const char* const aCharacters, const uint32_t aLength, uint64_t& aValue) throw();
+
+        /*!
+            \brief Read a signed integer.
+            \param aCharacters The first character of the text.
+            \param aLength The number of characters available.
+            \param aValue Receives the value.
+            \return The number of characters consumed, 0 if the text does not begin with an integer or the value does not fit.
+        */
+        static uint32_t parseSigned(const char* const aCharacters, const uint32_t aLength, int64_t& aValue) throw();
+
+        /*!
+            \brief Read a number as the nearest double.
+            \param aCharacters The first character of the text.
+            \param aLength The number of characters available.
+            \param aValue Receives the value.
+            \return The number of characters consumed, 0 if the text does not begin with a number.
+        */
+        static uint32_t parseDouble(const char* const aCharacters, const uint32_t aLength, double& aValue) throw();
+	};
+}
+
+#endif
@@ -0,0 +1,162 @@
+#ifndef SOLAIRE_PARALLEL_DOCUMENT_READER_HPP
+#define SOLAIRE_PARALLEL_DOCUMENT_READER_HPP
+
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+/*!
+	\file ParallelDocumentReader.hpp
+	\brief
+	\author
+	Created			: Adam Smith
+	Last modified	: Adam Smith
+	\version 1.0
+	\date
+	Created			: 17th October 2026
+	Last Modified	: 17th October 2026
+*/
+
+#include <atomic>
+#include "Solaire/Encode/Format.hpp"
+#include "Solaire/Encode/WorkerPool.hpp"
+
+namespace Solaire {
+
+    /*!
+        \brief Decodes a block of memory that holds many consecutive documents on several threads.
+        \details open finds the boundary of every document with Format::findDocuments on the calling thread, which
+        for JSON only runs the vectorised indexer. The documents are then decoded in groups of DOCUMENTS_PER_TASK,
+        idle threads claim the next group from the WorkerPool, and results are stored in the order that the
+        documents appear. The allocator given to read and the one used by GenericValue must be safe to use from
+        several threads at once.
+        \version 1.0.0
+        \see WorkerPool
+    */
+	class ParallelDocumentReader {
+    public:
+        enum : uint32_t {
+            DOCUMENTS_PER_TASK = 16     //!< The number of documents that a thread claims at once.
+        };
+    private:
+        template<class T>
+        struct DecodeTask {
+            const ParallelDocumentReader* reader;
+            Allocator* allocator;
+            List<T>* values;
+            int32_t first;
+            std::atomic<uint32_t> failures;
+        };
+    private:
+        const Format& mFormat;
+        WorkerPool& mPool;
+        const uint8_t* mData;
+        ArrayList<uint32_t> mEnds;
+    private:
+        ParallelDocumentReader(const ParallelDocumentReader&) = delete;
+        ParallelDocumentReader& operator=(const ParallelDocumentReader&) = delete;
+
+        uint32_t getTaskCount() const throw();
+        uint32_t getTaskEnd(const uint32_t aTask) const throw();
+        static void readValueTask(void* const aData, const uint32_t aTask) throw();
+
+        template<class T>
+        static void decodeTask(void* const aData, const uint32_t aTask) throw() {
+            DecodeTask<typename Encoder<T>::DecodeType>& task = *static_cast<DecodeTask<typename Encoder<T>::DecodeType>*>(aData);
+            const ParallelDocumentReader& reader = *task.reader;
+            const uint32_t end = reader.getTaskEnd(aTask);
+            for(uint32_t i = aTask * DOCUMENTS_PER_TASK; i < end; ++i) {
+                uint32_t size;
+                const void* const data = reader.getDocument(i, size);
+                BufferIStream stream(data, size);
+                typename Encoder<T>::DecodeType& value = (*task.values)[task.first + static_cast<int32_t>(i)];
+                Reader* const decoder = reader.mFormat.createReader(*task.allocator, stream);
+                if(decoder == nullptr) {
+                    GenericValue decoded;
+                    if(! reader.mFormat.tryReadValue(stream, decoded)) ++task.failures;
+                    value = Encoder<T>::decode(*task.allocator, decoded);
+                    continue;
+                }
+                value = Solaire::decode<T>(*task.allocator, *decoder);
+                if(decoder->hasFailed()) ++task.failures;
+                decoder->~Reader();
+                task.allocator->deallocate(decoder);
+            }
+        }
+    public:
+        /*!
+            \brief Create a reader.
+            \param aAllocator The allocator that document boundaries are stored in.
+            \param aFormat The format of the documents.
+            \param aPool The threads to decode on.
+        */
+        ParallelDocumentReader(Allocator& aAllocator, const Format& aFormat, WorkerPool& aPool) throw();
+
+        /*!
+            \brief Find the documents in a block of memory.
+            \param aData The first byte of the block, it must remain valid until the documents have been read.
+            \param aSize The number of bytes in the block.
+            \return True if the whole block was split into documents.
+            \see Format::findDocuments
+        */
+        bool open(const void* const aData, const uint32_t aSize) throw();
+
+        /*!
+            \brief Get the number of documents found by open.
+            \return The number of documents.
+        */
+        uint32_t getDocumentCount() const throw();
+
+        /*!
+            \brief Get the encoded bytes of a document.
+            \param aIndex The index of the document.
+            \param aSize Receives the number of bytes.
+            \return The first byte of the document.
+        */
+        const void* getDocument(const uint32_t aIndex, uint32_t& aSize) const throw();
+
+        /*!
+            \brief Decode every document into a GenericValue.
+            \param aValues Receives one value per document, appended in document order.
+            \return True if every document was decoded successfully.
+        */
+        bool readValues(List<GenericValue>& aValues) throw();
+
+        /*!
+            \brief Decode every document into a C++ object.
+            \tparam T The type of the objects, Encoder<T>::DecodeType must be default constructible.
+            \param aAllocator The allocator to allocate the objects and any parsing data from.
+            \param aValues Receives one object per document, appended in document order.
+            \return True if every document was decoded successfully.
+        */
+        template<class T>
+        bool read(Allocator& aAllocator, List<typename Encoder<T>::DecodeType>& aValues) throw() {
+            const uint32_t count = getDocumentCount();
+            DecodeTask<typename Encoder<T>::DecodeType> task;
+            task.reader = this;
+            task.allocator = &aAllocator;
+            task.values = &aValues;
+            task.first = aValues.size();
+            task.failures = 0;
+            for(uint32_t i = 0; i < count; ++i) aValues.pushBack(typename Encoder<T>::DecodeType());
+            mPool.run(&decodeTask<T>, &task, getTaskCount());
+            return task.failures == 0;
+        }
+	};
+}
+
+#endif
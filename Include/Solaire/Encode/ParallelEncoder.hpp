@@ -0,0 +1,271 @@
+#ifndef SOLAIRE_PARALLEL_ENCODER_HPP
+#define SOLAIRE_PARALLEL_ENCODER_HPP
+
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+/*!
+	\file ParallelEncoder.hpp
+	\brief
+	\author
+	Created			: Adam Smith
+	Last modified	: Adam Smith
+	\version 1.0
+	\date
+	Created			: 17th October 2026
+	Last Modified	: 17th October 2026
+*/
+
+#include "Solaire/Encode/Format.hpp"
+#include "Solaire/Encode/BufferOStream.hpp"
+#include "Solaire/Encode/WorkerPool.hpp"
+
+namespace Solaire {
+
+	/*!
+        \brief Encodes large containers on several threads.
+        \details Containers are split into chunks of consecutive elements. To write, each chunk is encoded by its
+        own Writer into a BufferOStream, then the chunks are passed in order to Writer::writeFragment, so the output
+        is identical to encoding on one thread. Chunks are processed in waves of a few per thread, which bounds the
+        memory held by unwritten chunks. To encode, the elements of a GenericValue array are assigned directly.
+        Containers that are too small to benefit, pools with one thread and formats without fragment support use
+        Encoder<StaticContainer<T>> on the calling thread.
+        Encoder<T> and the allocator must be safe to use from several threads at once.
+        \version 1.0.0
+        \see WorkerPool
+	*/
+	template<class T>
+	struct ParallelEncoder {
+	    typedef Encoder<StaticContainer<T>> ContainerEncoder;
+	    typedef PackedElement<T> Element;
+	    typedef std::integral_constant<bool, Element::value> IsPacked;
+
+	    enum : int32_t {
+	        MIN_CHUNK_ELEMENTS = 4096,      //!< The smallest number of elements given to a thread.
+	        MAX_CHUNK_ELEMENTS = 16384,     //!< The largest number of elements given to a thread.
+	        CHUNKS_PER_THREAD = 4           //!< The number of chunks in each wave for each thread.
+	    };
+
+	    struct ChunkOutput {
+	        BufferOStream buffer;
+	        bool result;
+
+	        ChunkOutput(Allocator& aAllocator) throw() :
+	            buffer(aAllocator),
+	            result(false)
+	        {}
+	    };
+
+	    struct Chunks {
+	        const Format* format;
+	        Allocator* allocator;
+	        const StaticContainer<T>* container;
+	        ChunkOutput* outputs;
+	        void* values;
+	        int32_t first;
+	        int32_t end;
+	        int32_t chunkElements;
+
+	        SOLAIRE_FORCE_INLINE int32_t getBegin(const uint32_t aIndex) const throw() {
+	            return first + static_cast<int32_t>(aIndex) * chunkElements;
+	        }
+
+	        SOLAIRE_FORCE_INLINE int32_t getEnd(const uint32_t aIndex) const throw() {
+	            const int32_t begin = getBegin(aIndex);
+	            return end - begin < chunkElements ? end : begin + chunkElements;
+	        }
+	    };
+
+	    static int32_t getChunkElements(const int32_t aSize, const uint32_t aThreads) throw() {
+            const int32_t elements = aSize / static_cast<int32_t>(aThreads * CHUNKS_PER_THREAD);
+            return elements < MIN_CHUNK_ELEMENTS ? MIN_CHUNK_ELEMENTS : elements > MAX_CHUNK_ELEMENTS ? MAX_CHUNK_ELEMENTS : elements;
+	    }
+
+	    static bool isWorthwhile(const int32_t aSize, WorkerPool& aPool) throw() {
+            return aPool.getThreadCount() > 1 && aSize >= MIN_CHUNK_ELEMENTS * 2;
+	    }
+
+	    static bool beginArray(Writer& aWriter, const int32_t aSize, std::false_type) throw() {
+            return aWriter.beginArray(aSize);
+	    }
+
+	    static bool beginArray(Writer& aWriter, const int32_t aSize, std::true_type) throw() {
+            return aWriter.beginPackedArray(Element::TYPE, aSize);
+	    }
+
+	    static bool writeElements(Allocator& aAllocator, Writer& aWriter, const StaticContainer<T>& aContainer, const int32_t aBegin, const int32_t aEnd, std::false_type) throw() {
+            for(int32_t i = aBegin; i < aEnd; ++i) {
+                if(! Solaire::encode<T>(aAllocator, aWriter, aContainer[i])) return false;
+            }
+            return true;
+	    }
+
+	    static bool writeElements(Allocator& aAllocator, Writer& aWriter, const StaticContainer<T>& aContainer, const int32_t aBegin, const int32_t aEnd, std::true_type) throw() {
+            typename Element::Type buffer[ContainerEncoder::CHUNK_ELEMENTS];
+            int32_t i = aBegin;
+            while(i < aEnd) {
+                uint32_t count = 0;
+                while(count < ContainerEncoder::CHUNK_ELEMENTS && i < aEnd) {
+                    buffer[count++] = static_cast<typename Element::Type>(aContainer[i++]);
+                }
+                if(! Element::write(aWriter, buffer, count)) return false;
+            }
+            return true;
+	    }
+
+	    static void writeChunk(void* const aData, const uint32_t aIndex) throw() {
+            const Chunks& chunks = *static_cast<const Chunks*>(aData);
+            ChunkOutput& output = chunks.outputs[aIndex];
+            output.buffer.clear();
+            Writer* const writer = chunks.format->createWriter(*chunks.allocator, output.buffer);
+            if(writer == nullptr) {
+                output.result = false;
+                return;
+            }
+            output.result = writeElements(*chunks.allocator, *writer, *chunks.container, chunks.getBegin(aIndex), chunks.getEnd(aIndex), IsPacked()) && writer->flush();
+            writer->~Writer();
+            chunks.allocator->deallocate(writer);
+	    }
+
+	    static void encodeChunk(void* const aData, const uint32_t aIndex) throw() {
+            const Chunks& chunks = *static_cast<const Chunks*>(aData);
+            GenericArray& array_ = *static_cast<GenericArray*>(chunks.values);
+            const int32_t end = chunks.getEnd(aIndex);
+            for(int32_t i = chunks.getBegin(aIndex); i < end; ++i) {
+                array_[i] = Encoder<T>::encode(*chunks.allocator, (*chunks.container)[i]);
+            }
+	    }
+
+	    static void encodePackedChunk(void* const aData, const uint32_t aIndex) throw() {
+            const Chunks& chunks = *static_cast<const Chunks*>(aData);
+            typename Element::Type* const values = static_cast<typename Element::Type*>(chunks.values);
+            const int32_t end = chunks.getEnd(aIndex);
+            for(int32_t i = chunks.getBegin(aIndex); i < end; ++i) {
+                values[i] = static_cast<typename Element::Type>((*chunks.container)[i]);
+            }
+	    }
+
+	    static void encodeValues(Chunks& aChunks, GenericValue& aValue, WorkerPool& aPool, std::false_type) throw() {
+            const int32_t size = aChunks.end;
+            GenericArray& array_ = aValue.setArray();
+            for(int32_t i = 0; i < size; ++i) array_.pushBack(GenericValue());
+            aChunks.values = &array_;
+            aPool.run(&encodeChunk, &aChunks, static_cast<uint32_t>((size + aChunks.chunkElements - 1) / aChunks.chunkElements));
+	    }
+
+	    static void encodeValues(Chunks& aChunks, GenericValue& aValue, WorkerPool& aPool, std::true_type) throw() {
+            const int32_t size = aChunks.end;
+            aChunks.values = aValue.setPackedArray(Element::TYPE, static_cast<uint32_t>(size));
+            if(aChunks.values == nullptr) return;
+            aPool.run(&encodePackedChunk, &aChunks, static_cast<uint32_t>((size + aChunks.chunkElements - 1) / aChunks.chunkElements));
+	    }
+
+	    /*!
+            \brief Encode a container into a GenericValue array.
+            \param aAllocator The allocator passed to Encoder<T>.
+            \param aPool The threads to encode on.
+            \param aContainer The container to encode.
+            \return The encoded array.
+	    */
+	    static GenericValue encode(Allocator& aAllocator, WorkerPool& aPool, const StaticContainer<T>& aContainer) throw() {
+            const int32_t size = aContainer.size();
+            if(! isWorthwhile(size, aPool)) return ContainerEncoder::encode(aAllocator, aContainer);
+
+            Chunks chunks;
+            chunks.format = nullptr;
+            chunks.allocator = &aAllocator;
+            chunks.container = &aContainer;
+            chunks.outputs = nullptr;
+            chunks.values = nullptr;
+            chunks.first = 0;
+            chunks.end = size;
+            chunks.chunkElements = getChunkElements(size, aPool.getThreadCount());
+
+            GenericValue value;
+            encodeValues(chunks, value, aPool, IsPacked());
+            return value;
+	    }
+
+	    /*!
+            \brief Write a container as an array.
+            \param aFormat The format that aWriter was created by, it creates the Writers for each chunk.
+            \param aAllocator The allocator that chunk Writers and buffers are taken from.
+            \param aPool The threads to encode on.
+            \param aWriter The Writer to write the array to.
+            \param aContainer The container to write.
+            \return True if the array was written successfully.
+	    */
+	    static bool write(const Format& aFormat, Allocator& aAllocator, WorkerPool& aPool, Writer& aWriter, const StaticContainer<T>& aContainer) throw() {
+            const int32_t size = aContainer.size();
+            if(! (isWorthwhile(size, aPool) && aWriter.writeFragment(nullptr, 0))) return ContainerEncoder::write(aAllocator, aWriter, aContainer);
+
+            const uint32_t chunkCount = aPool.getThreadCount() * CHUNKS_PER_THREAD;
+            ChunkOutput* const outputs = static_cast<ChunkOutput*>(aAllocator.allocate(sizeof(ChunkOutput) * chunkCount));
+            if(outputs == nullptr) return ContainerEncoder::write(aAllocator, aWriter, aContainer);
+            for(uint32_t i = 0; i < chunkCount; ++i) new(outputs + i) ChunkOutput(aAllocator);
+
+            Chunks chunks;
+            chunks.format = &aFormat;
+            chunks.allocator = &aAllocator;
+            chunks.container = &aContainer;
+            chunks.outputs = outputs;
+            chunks.values = nullptr;
+            chunks.chunkElements = getChunkElements(size, aPool.getThreadCount());
+
+            bool result = beginArray(aWriter, size, IsPacked());
+            const int32_t waveElements = chunks.chunkElements * static_cast<int32_t>(chunkCount);
+            for(int32_t first = 0; result && first < size; first += waveElements) {
+                chunks.first = first;
+                chunks.end = size - first < waveElements ? size : first + waveElements;
+                const uint32_t count = static_cast<uint32_t>((chunks.end - first + chunks.chunkElements - 1) / chunks.chunkElements);
+                aPool.run(&writeChunk, &chunks, count);
+                for(uint32_t i = 0; result && i < count; ++i) {
+                    const BufferOStream& buffer = outputs[i].buffer;
+                    result = outputs[i].result && aWriter.writeFragment(buffer.getData(), buffer.getSize());
+                }
+            }
+
+            for(uint32_t i = 0; i < chunkCount; ++i) outputs[i].~ChunkOutput();
+            aAllocator.deallocate(outputs);
+            return result && aWriter.endArray();
+	    }
+	};
+
+	/*!
+        \brief Encode a container on several threads and write it to a stream.
+        \details Formats that do not provide a Writer receive the output of ParallelEncoder::encode.
+        \param aFormat The format to encode with.
+        \param aAllocator The allocator to allocate any encoding data from.
+        \param aPool The threads to encode on.
+        \param aContainer The container to encode.
+        \param aStream The place to store the encoded data.
+        \return True if the container was encoded successfully.
+        \see Format::write
+	*/
+	template<class T>
+	static bool writeParallel(const Format& aFormat, Allocator& aAllocator, WorkerPool& aPool, const StaticContainer<T>& aContainer, OStream& aStream) throw() {
+	    Writer* const writer = aFormat.createWriter(aAllocator, aStream);
+	    if(writer == nullptr) return aFormat.writeValue(ParallelEncoder<T>::encode(aAllocator, aPool, aContainer), aStream);
+	    const bool result = ParallelEncoder<T>::write(aFormat, aAllocator, aPool, *writer, aContainer) && writer->flush();
+	    writer->~Writer();
+	    aAllocator.deallocate(writer);
+	    return result;
+	}
+}
+
+#endif
@@ -0,0 +1,111 @@
+#ifndef SOLAIRE_PARSER_HPP
+#define SOLAIRE_PARSER_HPP
+
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+/*!
+	\file Parser.hpp
+	\brief
+	\author
+	Created			: Adam Smith
+	Last modified	: Adam Smith
+	\version 1.0
+	\date
+	Created			: 17th October 2026
+	Last Modified	: 17th October 2026
+*/
+
+
+#include "Solaire/Encode/GenericValue.hpp"
+
+namespace Solaire {
+
+    /*!
+        \brief Decodes values from input that arrives in pieces, such as data received by a non-blocking socket.
+        \details Bytes are pushed into the parser as they become available and may be split at any position, even inside
+        a token. The partially decoded value is kept between calls, so the input itself is never buffered.
+        A typical receive loop is :
+        \code
+        while(aSize > 0) {
+            const uint32_t count = parser.parse(aData, aSize);
+            aData += count;
+            aSize -= count;
+            if(parser.hasValue()) {
+                parser.takeValue(value);
+                // Handle the value
+            }else if(parser.hasFailed()) {
+                // Close the connection
+            }
+        }
+        \endcode
+        Once any call fails the Parser stays failed until reset is called.
+        \version 1.0.0
+        \see Format::createParser
+    */
+	SOLAIRE_EXPORT_INTERFACE Parser {
+    public:
+        /*!
+            \brief Destroy the Parser object.
+        */
+        virtual SOLAIRE_EXPORT_CALL ~Parser(){}
+
+        /*!
+            \brief Decode the next piece of input.
+            \details Parsing stops as soon as a complete value has been decoded, any bytes that follow it must be passed
+            again once the value has been taken.
+            \param aData The first byte of the input.
+            \param aSize The number of bytes available.
+            \return The number of bytes consumed, which is less than aSize if a value was completed or the input was malformed.
+        */
+        virtual uint32_t SOLAIRE_EXPORT_CALL parse(const void* const aData, const uint32_t aSize) throw() = 0;
+
+        /*!
+            \brief Signal that no more input will be passed to parse.
+            \details Completes values that are only terminated by the end of the input, such as a JSON number at the top level.
+            \return False if the input ended inside a value, in which case the Parser fails.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL finish() throw() = 0;
+
+        /*!
+            \brief Check if a complete value is waiting to be taken.
+            \return True if takeValue will succeed.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL hasValue() const throw() = 0;
+
+        /*!
+            \brief Check if a previous call has failed.
+            \return True if the input was malformed.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL hasFailed() const throw() = 0;
+
+        /*!
+            \brief Take the completed value and begin parsing the next one.
+            \param aValue Receives the value.
+            \return False if no complete value was waiting.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL takeValue(GenericValue& aValue) throw() = 0;
+
+        /*!
+            \brief Discard any partially decoded value, clear a failure and begin parsing a new value.
+        */
+        virtual void SOLAIRE_EXPORT_CALL reset() throw() = 0;
+	};
+}
+
+#endif
@@ -0,0 +1,126 @@
+#ifndef SOLAIRE_PATH_QUERY_HPP
+#define SOLAIRE_PATH_QUERY_HPP
+
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+/*!
+	\file PathQuery.hpp
+	\brief
+	\author
+	Created			: Adam Smith
+	Last modified	: Adam Smith
+	\version 1.0
+	\date
+	Created			: 17th October 2026
+	Last Modified	: 17th October 2026
+*/
+
+#include "Solaire/Data/ArrayList.hpp"
+#include "Solaire/Data/CString.hpp"
+#include "Solaire/Encode/Format.hpp"
+
+namespace Solaire {
+
+    /*!
+        \brief Selects values from a document with a path in the style of a JSON Pointer, such as /routes/3/name.
+        \details Each segment of the path names an object member, or an array element when it is a decimal index, the
+        characters ~ and / are written as ~0 and ~1 within a segment. A segment of * matches every member or element.
+        The empty path selects the whole document. When a name appears more than once in an object only the first member
+        with that name is matched, unless the segment is a wildcard.
+        When run on a Reader only the matching values are decoded, every other value is stepped over with Reader::skip,
+        so nothing is allocated for it and member names are compared in a fixed buffer.
+        \version 1.0.0
+    */
+	class PathQuery {
+    public:
+        enum : uint32_t {
+            NAME_CAPACITY = 256     //!< The longest segment that compile accepts.
+        };
+    private:
+        enum : uint32_t {
+            NO_INDEX = UINT32_MAX
+        };
+
+        struct Segment {
+            CString name;
+            uint32_t index;
+            bool wildcard;
+        };
+    private:
+        Allocator& mAllocator;
+        ArrayList<Segment> mSegments;
+    private:
+        bool matchReader(Reader& aReader, const uint32_t aDepth, List<GenericValue>& aResults) const throw();
+        void matchValue(const GenericValue& aValue, const uint32_t aDepth, List<GenericValue>& aResults) const throw();
+    public:
+        /*!
+            \brief Create a query that selects the whole document.
+            \param aAllocator The allocator that the segments are taken from.
+        */
+        PathQuery(Allocator& aAllocator) throw();
+
+        /*!
+            \brief Set the path that the query selects.
+            \param aPath The first character of the path.
+            \param aLength The number of characters in the path.
+            \return False if the path is not empty and does not begin with /, contains an invalid escape or a segment
+            longer than NAME_CAPACITY, in which case the query selects the whole document.
+        */
+        bool compile(const char* const aPath, const uint32_t aLength) throw();
+
+        /*!
+            \copydoc compile
+        */
+        bool compile(const StringConstant<char>& aPath) throw();
+
+        /*!
+            \brief Get the number of segments in the path.
+            \return The number of segments, 0 for the empty path.
+        */
+        uint32_t getSegmentCount() const throw();
+
+        /*!
+            \brief Read one document and decode the values that the path selects.
+            \param aReader The source of the document, which is consumed entirely.
+            \param aResults Receives the selected values, appended in the order that they appear in the document.
+            \return True if the document was read successfully.
+        */
+        bool run(Reader& aReader, List<GenericValue>& aResults) const throw();
+
+        /*!
+            \brief Read one document from a stream and decode the values that the path selects.
+            \details If the format does not provide a Reader the whole document is decoded with Format::tryReadValue first,
+            nothing is selected if that fails.
+            \param aFormat The format of the document.
+            \param aStream The source of the document.
+            \param aResults Receives the selected values, appended in the order that they appear in the document.
+            \return True if the document was read successfully.
+        */
+        bool run(const Format& aFormat, IStream& aStream, List<GenericValue>& aResults) const throw();
+
+        /*!
+            \brief Select values from a document that has already been decoded.
+            \param aValue The document.
+            \param aResults Receives copies of the selected values, appended in document order.
+        */
+        void run(const GenericValue& aValue, List<GenericValue>& aResults) const throw();
+	};
+}
+
+#endif
@@ -0,0 +1,272 @@
+#ifndef SOLAIRE_READER_HPP
+#define SOLAIRE_READER_HPP
+
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+/*!
+	\file Reader.hpp
+	\brief
+	\author
+	Created			: Adam Smith
+	Last modified	: Adam Smith
+	\version 1.0
+	\date
+	Created			: 17th October 2026
+	Last Modified	: 17th October 2026
+*/
+
+#include "Solaire/Encode/GenericValue.hpp"
+
+namespace Solaire {
+
+    /*!
+        \brief Pulls encoded values out of a storage format one token at a time.
+        \details Scalars are converted to the requested type with the same rules as the GenericValue getters.
+        Once any call fails the Reader stays failed and every following call returns false.
+        \version 1.0.0
+        \see Format::createReader
+    */
+	SOLAIRE_EXPORT_INTERFACE Reader {
+    public:
+        enum : int32_t {
+            UNKNOWN_SIZE = -1,  //!< Returned by beginArray and beginObject when the format does not store element counts.
+            MAX_RESERVE = 4096  //!< The most elements getReserveSize returns when the size of the input is not known.
+        };
+    public:
+        /*!
+            \brief Destroy the Reader object.
+        */
+        virtual SOLAIRE_EXPORT_CALL ~Reader(){}
+
+        /*!
+            \brief Get the type of the next value without consuming it.
+            \return The type of the next value, NULL_T if the Reader has failed.
+        */
+        virtual GenericValue::ValueType SOLAIRE_EXPORT_CALL peekType() throw() = 0;
+
+        /*!
+            \brief Check if the current array or object has more elements to read.
+            \return True if there is another element, false at the end of the container or if the Reader has failed.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL hasNext() throw() = 0;
+
+        /*!
+            \brief Check if a previous call has failed.
+            \return True if the input was malformed or could not be read.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL hasFailed() const throw() = 0;
+
+        /*!
+            \brief Get the most bytes that the rest of the input could contain.
+            \details Element counts read from the input are checked against this before any space is allocated for
+            them, as an array can not have more elements than there are bytes left to read.
+            The default implementation does not know the size of the input.
+            \return The number of bytes left, or UINT32_MAX if it is not known.
+        */
+        virtual uint32_t SOLAIRE_EXPORT_CALL getRemainingBytes() const throw();
+
+        /*!
+            \brief Consume the start of an array.
+            \param aSize Set to the number of elements, or UNKNOWN_SIZE.
+            \return True if the next value was an array.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL beginArray(int32_t& aSize) throw() = 0;
+
+        /*!
+            \brief Consume the end of the current array, skipping any elements that have not been read.
+            \return True if the array was closed successfully.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL endArray() throw() = 0;
+
+        /*!
+            \brief Check if the next value is an array that was written with Writer::beginPackedArray.
+            \details Packed arrays are also reported as ARRAY_T by peekType and can be read element by element.
+            Formats that report packed arrays store each element in 8 bytes, which readValue relies on to check the count
+            against getRemainingBytes. The default implementation never reports packed arrays.
+            \return The element type of the packed array, or NULL_T if the next value is not a packed array.
+        */
+        virtual GenericValue::ValueType SOLAIRE_EXPORT_CALL peekPackedType() throw();
+
+        /*!
+            \brief Read elements of the current array.
+            \details Formats that store packed arrays copy the elements in bulk, the default implementation calls readUnsigned for each element.
+            \param aValues Receives the elements.
+            \param aCount The number of elements to read.
+            \return True if the elements were read successfully.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL readUnsignedArray(uint64_t* const aValues, const uint32_t aCount) throw();
+
+        /*!
+            \copydoc readUnsignedArray
+        */
+        virtual bool SOLAIRE_EXPORT_CALL readSignedArray(int64_t* const aValues, const uint32_t aCount) throw();
+
+        /*!
+            \copydoc readUnsignedArray
+        */
+        virtual bool SOLAIRE_EXPORT_CALL readDoubleArray(double* const aValues, const uint32_t aCount) throw();
+
+        /*!
+            \brief Consume the start of an object.
+            \param aSize Set to the number of members, or UNKNOWN_SIZE.
+            \return True if the next value was an object.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL beginObject(int32_t& aSize) throw() = 0;
+
+        /*!
+            \brief Consume the end of the current object, skipping any members that have not been read.
+            \return True if the object was closed successfully.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL endObject() throw() = 0;
+
+        /*!
+            \brief Read the name of the next object member.
+            \param aName Receives the name, existing characters are kept.
+            \return True if the name was read successfully.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL readName(String<char>& aName) throw() = 0;
+
+        /*!
+            \brief Read the name of the next object member into a fixed size buffer.
+            \details The default implementation reads the name into a CString and copies it.
+            \param aName Receives the first aCapacity characters of the name.
+            \param aCapacity The number of characters that aName can hold.
+            \param aLength Receives the full length of the name, which may be greater than aCapacity.
+            \return True if the name was read successfully.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL readName(char* const aName, const uint32_t aCapacity, uint32_t& aLength) throw();
+
+        /*!
+            \brief Consume the next value, which must be null.
+            \return True if a null value was read.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL readNull() throw() = 0;
+
+        /*!
+            \brief Read a character value.
+            \param aValue Receives the value.
+            \return True if the value was read successfully.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL readChar(char& aValue) throw() = 0;
+
+        /*!
+            \brief Read a boolean value.
+            \param aValue Receives the value.
+            \return True if the value was read successfully.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL readBool(bool& aValue) throw() = 0;
+
+        /*!
+            \brief Read an unsigned integer value.
+            \param aValue Receives the value.
+            \return True if the value was read successfully.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL readUnsigned(uint64_t& aValue) throw() = 0;
+
+        /*!
+            \brief Read a signed integer value.
+            \param aValue Receives the value.
+            \return True if the value was read successfully.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL readSigned(int64_t& aValue) throw() = 0;
+
+        /*!
+            \brief Read a floating point value.
+            \param aValue Receives the value.
+            \return True if the value was read successfully.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL readDouble(double& aValue) throw() = 0;
+
+        /*!
+            \brief Read a string value.
+            \param aValue Receives the value, existing characters are kept.
+            \return True if the value was read successfully.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL readString(String<char>& aValue) throw() = 0;
+
+        /*!
+            \brief Read a string value by referencing the characters in the source rather than copying them.
+            \details The default implementation never borrows.
+            \param aLength Receives the number of characters in the string.
+            \return The first character of the string, or nullptr if the next value can not be borrowed, in which case nothing is read.
+            \see GenericValue::setBorrowedString
+        */
+        virtual const char* SOLAIRE_EXPORT_CALL borrowString(uint32_t& aLength) throw();
+
+        /*!
+            \brief Consume the next array or object without decoding it and reference its encoded bytes.
+            \details The default implementation returns nullptr, formats that read from memory can override it.
+            \param aSize Receives the number of bytes.
+            \return The first byte of the value, or nullptr if the bytes are not held in memory that outlives the Reader,
+            or the next value is not an array or object. Nothing is consumed when nullptr is returned.
+            \see readLazyValue
+        */
+        virtual const void* SOLAIRE_EXPORT_CALL borrowValue(uint32_t& aSize) throw();
+
+        /*!
+            \brief Consume the next value without decoding it.
+            \return True if the value was skipped successfully.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL skip() throw() = 0;
+
+        /*!
+            \brief Read the next value as a complete GenericValue tree.
+            \param aValue Receives the value.
+            \return True if the value was read successfully.
+        */
+        bool readValue(GenericValue& aValue) throw();
+
+        /*!
+            \brief Read the next value as a complete GenericValue tree and calculate its hash while it is decoded.
+            \details The hashes of the arrays and objects in the tree are cached on their nodes, so GenericValue::hash
+            returns them without visiting the elements again.
+            \param aValue Receives the value.
+            \param aHash Receives the value of GenericValue::hash for the decoded value.
+            \return True if the value was read successfully.
+            \see StructuralHash
+        */
+        bool readValue(GenericValue& aValue, uint64_t& aHash) throw();
+
+        /*!
+            \brief Read the next value, leaving any arrays and objects inside it to be decoded when they are first accessed.
+            \details Nested values that borrowValue can reference are stored with GenericValue::setLazy, others and packed
+            arrays are decoded immediately.
+            \param aValue Receives the value.
+            \param aFormat The format that created the Reader, which decodes the nested values.
+            \return True if the value was read successfully.
+            \see Format::readLazyValue
+        */
+        bool readLazyValue(GenericValue& aValue, const Format& aFormat) throw();
+
+        /*!
+            \brief Limit an element count returned by beginArray or beginObject to a capacity that is safe to reserve.
+            \details The count comes from the input, which may be malformed. Every element takes at least one byte, so
+            no more than getRemainingBytes are reserved, or MAX_RESERVE if the size of the input is not known. Containers
+            that are filled with more elements than this grow as usual.
+            \param aSize The count, or UNKNOWN_SIZE.
+            \return The number of elements to reserve, which is 0 if aSize is UNKNOWN_SIZE.
+        */
+        int32_t getReserveSize(const int32_t aSize) const throw();
+    private:
+        bool readValue(GenericValue& aValue, CString& aBuffer, const Format* const aFormat, uint64_t* const aHash) throw();
+        bool readElement(GenericValue& aValue, CString& aBuffer, const Format* const aFormat, uint64_t* const aHash) throw();
+	};
+}
+
+#endif
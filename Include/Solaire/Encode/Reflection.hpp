@@ -0,0 +1,330 @@
+#ifndef SOLAIRE_ENCODE_REFLECTION_HPP
+#define SOLAIRE_ENCODE_REFLECTION_HPP
+
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+/*!
+	\file Reflection.hpp
+	\brief
+	\author
+	Created			: Adam Smith
+	Last modified	: Adam Smith
+	\version 1.0
+	\date
+	Created			: 17th October 2026
+	Last Modified	: 17th October 2026
+*/
+
+#include <cstring>
+#include <type_traits>
+#include "Solaire/Encode/Encoder.hpp"
+#include "Solaire/Encode/GenericObjectMap.hpp"
+
+/*!
+    \brief Begin the field list of a struct, which generates Encoder<TYPE>.
+    \details The list must be written at global scope and closed with SOLAIRE_ENCODE_END, for example :
+    \code
+    SOLAIRE_ENCODE_BEGIN(Point)
+        SOLAIRE_ENCODE_FIELD(x)
+        SOLAIRE_ENCODE_FIELD(y)
+    SOLAIRE_ENCODE_END
+    \endcode
+    \param TYPE The fully qualified name of the struct, which must be default constructible.
+    \see ReflectedEncoder
+*/
+#define SOLAIRE_ENCODE_BEGIN(TYPE)\
+    namespace Solaire {\
+        template<>\
+        struct Encoder<TYPE> : public ReflectedEncoder<TYPE> {\
+            template<class VISITOR, class OBJECT>\
+            static SOLAIRE_FORCE_INLINE bool visitFields(VISITOR& aVisitor, OBJECT& aObject) throw() {\
+                return true
+
+/*!
+    \brief Add a member of the struct to the field list.
+    \details The member is encoded with its own name, the hash of which is calculated at compile time.
+    \param NAME The name of the member.
+*/
+#define SOLAIRE_ENCODE_FIELD(NAME)\
+    && aVisitor.visit(#NAME, sizeof(#NAME) - 1, std::integral_constant<uint32_t, Solaire::hashFieldLiteral(#NAME)>::value, aObject.NAME)
+
+/*!
+    \brief Close a field list opened by SOLAIRE_ENCODE_BEGIN.
+*/
+#define SOLAIRE_ENCODE_END\
+                ;\
+            }\
+        };\
+    }
+
+namespace Solaire {
+
+	/*!
+        \brief Calculate the hash of a field name at compile time.
+        \param aName The null terminated name.
+        \param aHash The hash of the preceding characters.
+        \return The same value as GenericObjectMap::hash.
+	*/
+	constexpr uint32_t hashFieldLiteral(const char* const aName, const uint32_t aHash = 2166136261U) {
+	    return *aName == '\0' ? aHash : hashFieldLiteral(aName + 1, (aHash ^ static_cast<uint8_t>(*aName)) * 16777619U);
+	}
+
+	/*!
+        \brief Calculate the hash of a field name that was read at run time.
+        \param aName The first character of the name.
+        \param aLength The number of characters in the name.
+        \return The same value as GenericObjectMap::hash.
+	*/
+	static SOLAIRE_FORCE_INLINE uint32_t hashFieldName(const char* const aName, const uint32_t aLength) throw() {
+	    uint32_t hash = 2166136261U;
+	    for(uint32_t i = 0; i < aLength; ++i) {
+	        hash ^= static_cast<uint8_t>(aName[i]);
+	        hash *= 16777619U;
+	    }
+	    return hash;
+	}
+
+	/*!
+        \brief Select the Encoder used for a member of a reflected struct.
+        \details Strings use Encoder<String<char>> and containers use Encoder<StaticContainer<T>>,
+        every other type uses its own Encoder.
+	*/
+	template<class T>
+	struct ReflectedFieldType {
+	    static String<char>* test(const String<char>*);
+
+	    template<class E>
+	    static StaticContainer<E>* test(const StaticContainer<E>*);
+
+	    static T* test(...);
+
+	    typedef typename std::remove_pointer<decltype(test(static_cast<T*>(nullptr)))>::type Type;
+	};
+
+	/*!
+        \brief The base of the Encoder generated by SOLAIRE_ENCODE_BEGIN.
+        \details The generated Encoder provides visitFields, which passes the name, length, hash and value of each
+        member to a visitor in the order that they were listed. Members are written in that order, so when the same
+        struct is decoded every name is first compared against the field that follows the previously matched one.
+        Only when that fails is the name hashed and compared against the precomputed hashes of the other fields, the
+        characters are then compared to rule out collisions. Members that match no field are skipped and fields that
+        are missing keep their default value.
+        Names longer than NAME_CAPACITY characters are never matched when reading from a Reader.
+        \version 1.0.0
+	*/
+	template<class T>
+	struct ReflectedEncoder {
+	    typedef T DecodeType;
+
+	    enum : uint32_t {
+	        NAME_CAPACITY = 128     //!< The longest member name that read can match.
+	    };
+
+	    struct FieldCounter {
+	        int32_t count;
+
+	        template<class F>
+	        SOLAIRE_FORCE_INLINE bool visit(const char* const aName, const uint32_t aLength, const uint32_t aHash, const F& aField) throw() {
+	            ++count;
+	            return true;
+	        }
+	    };
+
+	    struct FieldEncoder {
+	        Allocator& allocator;
+	        GenericValue& object;
+
+	        template<class F>
+	        SOLAIRE_FORCE_INLINE bool visit(const char* const aName, const uint32_t aLength, const uint32_t aHash, const F& aField) throw() {
+	            object.emplace(CString(allocator, aName, aLength), Solaire::encode<typename ReflectedFieldType<F>::Type>(allocator, aField));
+	            return true;
+	        }
+	    };
+
+	    struct FieldWriter {
+	        Allocator& allocator;
+	        Writer& writer;
+
+	        template<class F>
+	        SOLAIRE_FORCE_INLINE bool visit(const char* const aName, const uint32_t aLength, const uint32_t aHash, const F& aField) throw() {
+	            return writer.writeName(aName, aLength) && Solaire::encode<typename ReflectedFieldType<F>::Type>(allocator, writer, aField);
+	        }
+	    };
+
+	    struct FieldMatcher {
+	        uint32_t hash;
+	        int32_t position;
+	        int32_t index;
+	        int32_t match;
+
+	        FieldMatcher() throw() :
+	            hash(0),
+	            position(0),
+	            index(0),
+	            match(-1)
+	        {}
+
+	        SOLAIRE_FORCE_INLINE int32_t accept(const uint32_t aHash) throw() {
+	            const int32_t index_ = index++;
+	            return (position >= 0 ? index_ == position : aHash == hash) ? index_ : -1;
+	        }
+	    };
+
+	    struct FieldDecoder : public FieldMatcher {
+	        Allocator& allocator;
+	        const CString& name;
+	        const GenericValue& value;
+
+	        FieldDecoder(Allocator& aAllocator, const CString& aName, const GenericValue& aValue) throw() :
+	            allocator(aAllocator),
+	            name(aName),
+	            value(aValue)
+	        {}
+
+	        SOLAIRE_FORCE_INLINE bool equals(const char* const aName, const uint32_t aLength) const throw() {
+	            if(static_cast<uint32_t>(name.size()) != aLength) return false;
+	            for(uint32_t i = 0; i < aLength; ++i) if(name[i] != aName[i]) return false;
+	            return true;
+	        }
+
+	        SOLAIRE_FORCE_INLINE void prepareHash() throw() {
+	            this->hash = GenericObjectMap::hash(name);
+	        }
+
+	        template<class F>
+	        SOLAIRE_FORCE_INLINE bool visit(const char* const aName, const uint32_t aLength, const uint32_t aHash, F& aField) throw() {
+	            const int32_t index_ = this->accept(aHash);
+	            if(index_ < 0) return true;
+	            if(! equals(aName, aLength)) return this->position < 0;
+	            this->match = index_;
+	            aField = Solaire::decode<typename ReflectedFieldType<F>::Type>(allocator, value);
+	            return false;
+	        }
+	    };
+
+	    struct FieldReader : public FieldMatcher {
+	        Allocator& allocator;
+	        Reader& reader;
+	        const char* const name;
+	        const uint32_t length;
+
+	        FieldReader(Allocator& aAllocator, Reader& aReader, const char* const aName, const uint32_t aLength) throw() :
+	            allocator(aAllocator),
+	            reader(aReader),
+	            name(aName),
+	            length(aLength)
+	        {}
+
+	        SOLAIRE_FORCE_INLINE bool equals(const char* const aName, const uint32_t aLength) const throw() {
+	            return aLength == length && std::memcmp(aName, name, length) == 0;
+	        }
+
+	        SOLAIRE_FORCE_INLINE void prepareHash() throw() {
+	            this->hash = hashFieldName(name, length);
+	        }
+
+	        template<class F>
+	        SOLAIRE_FORCE_INLINE bool visit(const char* const aName, const uint32_t aLength, const uint32_t aHash, F& aField) throw() {
+	            const int32_t index_ = this->accept(aHash);
+	            if(index_ < 0) return true;
+	            if(! equals(aName, aLength)) return this->position < 0;
+	            this->match = index_;
+	            aField = Solaire::decode<typename ReflectedFieldType<F>::Type>(allocator, reader);
+	            return false;
+	        }
+	    };
+
+	    template<class MATCHER>
+	    static int32_t matchField(MATCHER& aMatcher, T& aObject, const int32_t aPosition) throw() {
+            // Try the field after the previous match before hashing the name
+            aMatcher.position = aPosition;
+            aMatcher.index = 0;
+            aMatcher.match = -1;
+            Encoder<T>::visitFields(aMatcher, aObject);
+            if(aMatcher.match >= 0) return aMatcher.match;
+
+            aMatcher.prepareHash();
+            aMatcher.position = -1;
+            aMatcher.index = 0;
+            Encoder<T>::visitFields(aMatcher, aObject);
+            return aMatcher.match;
+	    }
+
+	    static DecodeType decode(Allocator& aAllocator, const GenericValue& aValue) throw() {
+            T object;
+            if(! aValue.isObject()) return object;
+            const GenericObject& members = aValue.getObject();
+            int32_t position = 0;
+            for(auto i = members.begin(); i != members.end(); ++i) {
+                FieldDecoder decoder(aAllocator, i->first, i->second);
+                const int32_t match = matchField(decoder, object, position);
+                if(match >= 0) position = match + 1;
+            }
+            return object;
+	    }
+
+	    static GenericValue encode(Allocator& aAllocator, const T& aObject) throw() {
+            GenericValue value;
+            value.setObject();
+            FieldCounter counter{0};
+            Encoder<T>::visitFields(counter, aObject);
+            value.reserve(counter.count);
+            FieldEncoder encoder{aAllocator, value};
+            Encoder<T>::visitFields(encoder, aObject);
+            return value;
+	    }
+
+	    static bool write(Allocator& aAllocator, Writer& aWriter, const T& aObject) throw() {
+            FieldCounter counter{0};
+            Encoder<T>::visitFields(counter, aObject);
+            FieldWriter writer{aAllocator, aWriter};
+            return aWriter.beginObject(counter.count) && Encoder<T>::visitFields(writer, aObject) && aWriter.endObject();
+	    }
+
+	    static DecodeType read(Allocator& aAllocator, Reader& aReader) throw() {
+            T object;
+            int32_t size;
+            if(aReader.peekType() != GenericValue::OBJECT_T || ! aReader.beginObject(size)) {
+                aReader.skip();
+                return object;
+            }
+
+            char name[NAME_CAPACITY];
+            int32_t position = 0;
+            while(aReader.hasNext()) {
+                uint32_t length;
+                if(! aReader.readName(name, NAME_CAPACITY, length)) break;
+                int32_t match = -1;
+                if(length <= NAME_CAPACITY) {
+                    FieldReader reader(aAllocator, aReader, name, length);
+                    match = matchField(reader, object, position);
+                }
+                if(match >= 0) {
+                    position = match + 1;
+                }else {
+                    aReader.skip();
+                }
+            }
+            aReader.endObject();
+            return object;
+	    }
+	};
+}
+
+#endif
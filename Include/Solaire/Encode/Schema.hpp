@@ -0,0 +1,122 @@
+#ifndef SOLAIRE_SCHEMA_HPP
+#define SOLAIRE_SCHEMA_HPP
+
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+/*!
+	\file Schema.hpp
+	\brief
+	\author
+	Created			: Adam Smith
+	Last modified	: Adam Smith
+	\version 1.0
+	\date
+	Created			: 17th October 2026
+	Last Modified	: 17th October 2026
+*/
+
+#include "Solaire/Data/ArrayList.hpp"
+#include "Solaire/Data/CString.hpp"
+
+namespace Solaire {
+
+    /*!
+        \brief Assigns small integer ids to object member names.
+        \details Ids are assigned in registration order starting from 1, so two schemas that register the same names
+        in the same order are compatible. Names should only ever be appended, removing or reordering them changes the
+        meaning of previously encoded data. Lookups by name use an open addressing hash table.
+        A Schema must not be modified while a Reader or Writer that uses it exists.
+        \version 1.0.0
+        \see SchemaFormat
+    */
+	class Schema {
+    public:
+        enum : uint32_t {
+            NO_ID = 0   //!< Returned when a name is not registered.
+        };
+    private:
+        struct Slot {
+            uint32_t hash;
+            uint32_t id;
+        };
+    private:
+        Allocator& mAllocator;
+        ArrayList<CString> mNames;
+        Slot* mSlots;
+        uint32_t mSlotMask;
+    private:
+        Schema(const Schema&) = delete;
+        Schema& operator=(const Schema&) = delete;
+
+        void insertIndex(const uint32_t aHash, const uint32_t aId) throw();
+        bool rebuildIndex(const uint32_t aSlots) throw();
+    public:
+        /*!
+            \brief Create an empty schema.
+            \param aAllocator The allocator that names and the hash table are taken from.
+        */
+        Schema(Allocator& aAllocator) throw();
+
+        /*!
+            \brief Destroy the schema.
+        */
+        ~Schema() throw();
+
+        /*!
+            \brief Register a name.
+            \param aName The first character of the name.
+            \param aLength The number of characters in the name.
+            \return The id of the name, which is unchanged if it was already registered, or NO_ID if memory could not be allocated.
+        */
+        uint32_t addField(const char* const aName, const uint32_t aLength) throw();
+
+        /*!
+            \copydoc addField
+        */
+        uint32_t addField(const StringConstant<char>& aName) throw();
+
+        /*!
+            \brief Find the id of a name.
+            \param aName The first character of the name.
+            \param aLength The number of characters in the name.
+            \return The id, or NO_ID if the name is not registered.
+        */
+        uint32_t getId(const char* const aName, const uint32_t aLength) const throw();
+
+        /*!
+            \copydoc getId
+        */
+        uint32_t getId(const StringConstant<char>& aName) const throw();
+
+        /*!
+            \brief Find the name that an id was assigned to.
+            \param aId The id.
+            \return The name, or nullptr if the id has not been assigned.
+        */
+        const CString* getName(const uint32_t aId) const throw();
+
+        /*!
+            \brief Get the number of registered names.
+            \return The highest id that has been assigned.
+        */
+        uint32_t getFieldCount() const throw();
+	};
+}
+
+#endif
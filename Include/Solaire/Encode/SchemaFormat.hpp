@@ -0,0 +1,68 @@
+#ifndef SOLAIRE_SCHEMA_FORMAT_HPP
+#define SOLAIRE_SCHEMA_FORMAT_HPP
+
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+/*!
+	\file SchemaFormat.hpp
+	\brief
+	\author
+	Created			: Adam Smith
+	Last modified	: Adam Smith
+	\version 1.0
+	\date
+	Created			: 17th October 2026
+	Last Modified	: 17th October 2026
+*/
+
+#include "Solaire/Encode/BinaryFormat.hpp"
+
+namespace Solaire {
+
+    /*!
+        \brief A BinaryFormat that replaces object member names with the ids assigned by a Schema.
+        \details Each member name is written as a varint id. Names that are not in the schema are written as id 0,
+        followed by a varint length and the characters, so any GenericValue can still be encoded.
+        When decoding, members with ids that the schema has not assigned, for example those written with a newer
+        version of the schema, are skipped without being reported by the Reader. The size given by
+        Reader::beginObject includes these members.
+        The reader and writer must use compatible schemas, the ids themselves are not stored in the data.
+        \version 1.0.0
+        \see Schema
+    */
+	class SchemaFormat : public BinaryFormat {
+    private:
+        const Schema& mSchema;
+    public:
+        /*!
+            \brief Create a SchemaFormat.
+            \param aSchema The schema that assigns member ids, it must outlive the format.
+            \param aBorrowStrings If decoded strings should reference the source when it is a BufferIStream.
+        */
+        SchemaFormat(const Schema& aSchema, const bool aBorrowStrings = false) throw();
+
+        /*!
+            \brief Get the schema that assigns member ids.
+            \return The schema.
+        */
+        const Schema& getSchema() const throw();
+	};
+}
+
+#endif
@@ -0,0 +1,165 @@
+#ifndef SOLAIRE_STRUCTURAL_HASH_HPP
+#define SOLAIRE_STRUCTURAL_HASH_HPP
+
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+/*!
+	\file StructuralHash.hpp
+	\brief
+	\author
+	Created			: Adam Smith
+	Last modified	: Adam Smith
+	\version 1.0
+	\date
+	Created			: 17th October 2026
+	Last Modified	: 17th October 2026
+*/
+
+#include <cstring>
+#include "Solaire/Encode/GenericValue.hpp"
+
+namespace Solaire {
+
+    /*!
+        \brief The pieces of the 64 bit hash returned by GenericValue::hash, so that it can be built while a value is decoded.
+        \details The hash depends only on the structure and contents of a value, so it is the same on every platform and in
+        every run. Values that compare equal with GenericValue::operator== have the same hash : strings hash their
+        characters however they are stored, packed arrays hash like the equivalent array of scalars, 0.0 and -0.0 hash
+        alike, and objects combine their members in an order independent way.
+        An array hash is built by adding the hash of each element in order to an ArrayHash, and an object hash by adding
+        the hash of each member name, from hashName, and value to an ObjectHash.
+        \version 1.0.0
+        \see GenericValue::hash
+    */
+	class StructuralHash {
+    private:
+        enum : uint64_t {
+            GOLDEN = 0x9E3779B97F4A7C15ULL,
+            BYTES_SEED = 0x27D4EB2F165667C5ULL
+        };
+    public:
+        static SOLAIRE_FORCE_INLINE uint64_t mix(uint64_t aValue) throw() {
+            // The splitmix64 finaliser, every bit of the input affects every bit of the output
+            aValue ^= aValue >> 30;
+            aValue *= 0xBF58476D1CE4E5B9ULL;
+            aValue ^= aValue >> 27;
+            aValue *= 0x94D049BB133111EBULL;
+            return aValue ^ (aValue >> 31);
+        }
+
+        static SOLAIRE_FORCE_INLINE uint64_t typeSeed(const GenericValue::ValueType aType) throw() {
+            return (static_cast<uint64_t>(aType) + 1) * GOLDEN;
+        }
+
+        static SOLAIRE_FORCE_INLINE uint64_t hashScalar(const GenericValue::ValueType aType, const uint64_t aBits) throw() {
+            return mix(mix(aBits) ^ typeSeed(aType));
+        }
+
+        /*!
+            \brief Hash a sequence of bytes, which are read in little endian order on every platform.
+        */
+        static uint64_t hashBytes(const char* const aBytes, const uint32_t aLength) throw() {
+            const uint8_t* const bytes = reinterpret_cast<const uint8_t*>(aBytes);
+            uint64_t hash = BYTES_SEED;
+            uint32_t i = 0;
+            for(; i + 8 <= aLength; i += 8) {
+                uint64_t word = 0;
+                for(uint32_t j = 0; j < 8; ++j) word |= static_cast<uint64_t>(bytes[i + j]) << (j * 8);
+                hash = mix(hash ^ word);
+            }
+            if(i < aLength) {
+                uint64_t word = 0;
+                for(uint32_t j = 0; i + j < aLength; ++j) word |= static_cast<uint64_t>(bytes[i + j]) << (j * 8);
+                hash = mix(hash ^ word);
+            }
+            return mix(hash ^ aLength);
+        }
+
+        static SOLAIRE_FORCE_INLINE uint64_t hashNull() throw()                                     {return mix(typeSeed(GenericValue::NULL_T));}
+        static SOLAIRE_FORCE_INLINE uint64_t hashChar(const char aValue) throw()                    {return hashScalar(GenericValue::CHAR_T, static_cast<uint8_t>(aValue));}
+        static SOLAIRE_FORCE_INLINE uint64_t hashBool(const bool aValue) throw()                    {return hashScalar(GenericValue::BOOL_T, aValue ? 1 : 0);}
+        static SOLAIRE_FORCE_INLINE uint64_t hashUnsigned(const uint64_t aValue) throw()            {return hashScalar(GenericValue::UNSIGNED_T, aValue);}
+        static SOLAIRE_FORCE_INLINE uint64_t hashSigned(const int64_t aValue) throw()               {return hashScalar(GenericValue::SIGNED_T, static_cast<uint64_t>(aValue));}
+        static SOLAIRE_FORCE_INLINE uint64_t hashString(const char* const aValue, const uint32_t aLength) throw() {return mix(hashBytes(aValue, aLength) ^ typeSeed(GenericValue::STRING_T));}
+        static SOLAIRE_FORCE_INLINE uint64_t hashName(const char* const aName, const uint32_t aLength) throw() {return hashBytes(aName, aLength);}
+
+        static SOLAIRE_FORCE_INLINE uint64_t hashDouble(const double aValue) throw() {
+            // Values that compare equal must hash alike, and every NaN is given the same bits
+            uint64_t bits = 0;
+            if(aValue != aValue) {
+                bits = 0x7FF8000000000000ULL;
+            }else if(aValue != 0.0) {
+                std::memcpy(&bits, &aValue, sizeof(bits));
+            }
+            return hashScalar(GenericValue::DOUBLE_T, bits);
+        }
+
+        /*!
+            \brief Builds the hash of an array from the hashes of its elements, which must be added in order.
+        */
+        class ArrayHash {
+        private:
+            uint64_t mState;
+            uint32_t mSize;
+        public:
+            SOLAIRE_FORCE_INLINE ArrayHash() throw() :
+                mState(typeSeed(GenericValue::ARRAY_T)),
+                mSize(0)
+            {}
+
+            SOLAIRE_FORCE_INLINE void add(const uint64_t aElement) throw() {
+                mState = mix(mState ^ aElement);
+                ++mSize;
+            }
+
+            SOLAIRE_FORCE_INLINE uint64_t finish() const throw() {
+                return mix(mState ^ (static_cast<uint64_t>(mSize) * GOLDEN));
+            }
+        };
+
+        /*!
+            \brief Builds the hash of an object from the hashes of its members, which may be added in any order.
+        */
+        class ObjectHash {
+        private:
+            uint64_t mSum;
+            uint32_t mSize;
+        public:
+            SOLAIRE_FORCE_INLINE ObjectHash() throw() :
+                mSum(0),
+                mSize(0)
+            {}
+
+            /*!
+                \param aName The hash of the member name, from hashName.
+                \param aValue The hash of the member value.
+            */
+            SOLAIRE_FORCE_INLINE void add(const uint64_t aName, const uint64_t aValue) throw() {
+                mSum += mix(aName + aValue * GOLDEN);
+                ++mSize;
+            }
+
+            SOLAIRE_FORCE_INLINE uint64_t finish() const throw() {
+                return mix(mix(mSum + mSize) ^ typeSeed(GenericValue::OBJECT_T));
+            }
+        };
+	};
+}
+
+#endif
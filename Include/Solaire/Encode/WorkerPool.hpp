@@ -0,0 +1,108 @@
+#ifndef SOLAIRE_WORKER_POOL_HPP
+#define SOLAIRE_WORKER_POOL_HPP
+
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+/*!
+	\file WorkerPool.hpp
+	\brief
+	\author
+	Created			: Adam Smith
+	Last modified	: Adam Smith
+	\version 1.0
+	\date
+	Created			: 17th October 2026
+	Last Modified	: 17th October 2026
+*/
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "Solaire/Core/Init.hpp"
+
+namespace Solaire {
+
+    /*!
+        \brief A fixed set of threads that run batches of independent tasks.
+        \details The thread that calls run also executes tasks, so a pool created with one thread runs everything
+        on the caller. Tasks are claimed one at a time from a shared counter, so uneven tasks are balanced
+        automatically. Only one thread may call run at a time.
+        \version 1.0.0
+    */
+	class WorkerPool {
+    public:
+        /*!
+            \brief A function that executes one task of a batch.
+            \param aData The pointer that was passed to run.
+            \param aIndex The index of the task, from 0 to the number of tasks - 1.
+        */
+        typedef void(*Task)(void* const aData, const uint32_t aIndex);
+    private:
+        Allocator& mAllocator;
+        std::thread* mThreads;
+        uint32_t mThreadCount;
+        std::mutex mLock;
+        std::condition_variable mTasksAvailable;
+        std::condition_variable mTasksFinished;
+        Task mTask;
+        void* mData;
+        uint32_t mTaskCount;
+        std::atomic<uint32_t> mNextTask;
+        uint32_t mFinishedTasks;
+        uint32_t mActiveWorkers;
+        uint32_t mBatch;
+        bool mStopping;
+    private:
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        void executeTasks(const Task aTask, void* const aData, const uint32_t aCount) throw();
+        void workerMain() throw();
+    public:
+        /*!
+            \brief Create a pool and start its threads.
+            \param aAllocator The allocator that thread objects are taken from.
+            \param aThreads The number of threads that execute tasks, including the one calling run.
+            0 uses the number of hardware threads.
+        */
+        WorkerPool(Allocator& aAllocator, const uint32_t aThreads = 0) throw();
+
+        /*!
+            \brief Stop and join every thread.
+        */
+        ~WorkerPool() throw();
+
+        /*!
+            \brief Get the number of threads that execute tasks.
+            \return The number of pool threads plus the thread calling run.
+        */
+        uint32_t getThreadCount() const throw();
+
+        /*!
+            \brief Execute a batch of tasks and wait for all of them to finish.
+            \param aTask The function to execute.
+            \param aData Passed to every call of aTask.
+            \param aCount The number of tasks.
+        */
+        void run(const Task aTask, void* const aData, const uint32_t aCount) throw();
+	};
+}
+
+#endif
@@ -0,0 +1,206 @@
+#ifndef SOLAIRE_WRITER_HPP
+#define SOLAIRE_WRITER_HPP
+
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+/*!
+	\file Writer.hpp
+	\brief
+	\author
+	Created			: Adam Smith
+	Last modified	: Adam Smith
+	\version 1.0
+	\date
+	Created			: 17th October 2026
+	Last Modified	: 17th October 2026
+*/
+
+#include "Solaire/Encode/GenericValue.hpp"
+
+namespace Solaire {
+
+    /*!
+        \brief Receives a stream of encoding events and writes them directly in a storage format.
+        \details Values are written in document order. Arrays and objects are opened with their element count,
+        each object member is a writeName call followed by its value.
+        \version 1.0.0
+        \see Format::createWriter
+    */
+	SOLAIRE_EXPORT_INTERFACE Writer {
+    public:
+        /*!
+            \brief Destroy the Writer object.
+        */
+        virtual SOLAIRE_EXPORT_CALL ~Writer(){}
+
+        /*!
+            \brief Begin writing an array.
+            \param aSize The number of elements that will be written before endArray.
+            \return True if the event was written successfully.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL beginArray(const int32_t aSize) throw() = 0;
+
+        /*!
+            \brief Finish writing the current array.
+            \return True if the event was written successfully.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL endArray() throw() = 0;
+
+        /*!
+            \brief Begin writing an array where every element is a number of the same type.
+            \details The elements must be written with the array function matching aType, for example writeDoubleArray,
+            which may be called any number of times before endArray. Formats that can store packed arrays copy the
+            elements in bulk, the default implementation writes a normal array.
+            \param aType The element type, UNSIGNED_T, SIGNED_T or DOUBLE_T.
+            \param aSize The number of elements that will be written before endArray.
+            \return True if the event was written successfully.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL beginPackedArray(const GenericValue::ValueType aType, const int32_t aSize) throw();
+
+        /*!
+            \brief Write elements of an array started by beginPackedArray.
+            \param aValues The first element to write.
+            \param aCount The number of elements to write.
+            \return True if the elements were written successfully.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL writeUnsignedArray(const uint64_t* const aValues, const uint32_t aCount) throw();
+
+        /*!
+            \copydoc writeUnsignedArray
+        */
+        virtual bool SOLAIRE_EXPORT_CALL writeSignedArray(const int64_t* const aValues, const uint32_t aCount) throw();
+
+        /*!
+            \copydoc writeUnsignedArray
+        */
+        virtual bool SOLAIRE_EXPORT_CALL writeDoubleArray(const double* const aValues, const uint32_t aCount) throw();
+
+        /*!
+            \brief Begin writing an object.
+            \param aSize The number of members that will be written before endObject.
+            \return True if the event was written successfully.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL beginObject(const int32_t aSize) throw() = 0;
+
+        /*!
+            \brief Finish writing the current object.
+            \return True if the event was written successfully.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL endObject() throw() = 0;
+
+        /*!
+            \brief Write the name of the next object member.
+            \param aName The name of the member.
+            \return True if the event was written successfully.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL writeName(const StringConstant<char>& aName) throw() = 0;
+
+        /*!
+            \brief Write the name of the next object member from a range of characters.
+            \details The default implementation copies the name into a CString.
+            \param aName The first character of the name.
+            \param aLength The number of characters in the name.
+            \return True if the event was written successfully.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL writeName(const char* const aName, const uint32_t aLength) throw();
+
+        /*!
+            \brief Write a null value.
+            \return True if the event was written successfully.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL writeNull() throw() = 0;
+
+        /*!
+            \brief Write a character value.
+            \param aValue The value to write.
+            \return True if the event was written successfully.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL writeChar(const char aValue) throw() = 0;
+
+        /*!
+            \brief Write a boolean value.
+            \param aValue The value to write.
+            \return True if the event was written successfully.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL writeBool(const bool aValue) throw() = 0;
+
+        /*!
+            \brief Write an unsigned integer value.
+            \param aValue The value to write.
+            \return True if the event was written successfully.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL writeUnsigned(const uint64_t aValue) throw() = 0;
+
+        /*!
+            \brief Write a signed integer value.
+            \param aValue The value to write.
+            \return True if the event was written successfully.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL writeSigned(const int64_t aValue) throw() = 0;
+
+        /*!
+            \brief Write a floating point value.
+            \param aValue The value to write.
+            \return True if the event was written successfully.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL writeDouble(const double aValue) throw() = 0;
+
+        /*!
+            \brief Write a string value.
+            \param aValue The value to write.
+            \return True if the event was written successfully.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL writeString(const StringConstant<char>& aValue) throw() = 0;
+
+        /*!
+            \brief Write a string value from a range of characters.
+            \param aValue The first character of the value.
+            \param aLength The number of characters in the value.
+            \return True if the event was written successfully.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL writeString(const char* const aValue, const uint32_t aLength) throw() = 0;
+
+        /*!
+            \brief Copy values that another Writer of the same format encoded separately.
+            \details This joins the output of Writers that encoded consecutive elements of an array in parallel, the
+            result is the same as if the elements had been written here. The fragment must only contain complete values
+            that were written outside of any array or object. Writing an empty fragment checks if the format supports them.
+            \param aBytes The encoded values.
+            \param aLength The number of bytes.
+            \return True if the fragment was written, false if it failed or the format cannot join fragments.
+            \see ParallelEncoder
+        */
+        virtual bool SOLAIRE_EXPORT_CALL writeFragment(const void* const aBytes, const uint32_t aLength) throw();
+
+        /*!
+            \brief Pass any buffered data on to the output stream.
+            \return True if all data was written successfully.
+        */
+        virtual bool SOLAIRE_EXPORT_CALL flush() throw() = 0;
+
+        /*!
+            \brief Write a complete GenericValue tree as a sequence of events.
+            \param aValue The value to write.
+            \return True if the value was written successfully.
+        */
+        bool writeValue(const GenericValue& aValue) throw();
+	};
+}
+
+#endif
@@ -0,0 +1,110 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+#include "Solaire/Encode/ArenaAllocator.hpp"
+
+namespace Solaire {
+
+    static SOLAIRE_FORCE_INLINE uint32_t alignArena(const uint32_t aBytes) throw() {
+        return (aBytes + ArenaAllocator::ALIGNMENT - 1) & ~static_cast<uint32_t>(ArenaAllocator::ALIGNMENT - 1);
+    }
+
+	// ArenaAllocator
+
+    ArenaAllocator::ArenaAllocator(Allocator& aAllocator, const uint32_t aBlockSize) throw() :
+        mAllocator(aAllocator),
+        mHead(nullptr),
+        mLast(nullptr),
+        mBlockSize(alignArena(aBlockSize)),
+        mAllocatedBytes(0)
+    {}
+
+    SOLAIRE_EXPORT_CALL ArenaAllocator::~ArenaAllocator() throw() {
+        while(mHead) {
+            Block* const previous = mHead->previous;
+            mAllocator.deallocate(mHead);
+            mHead = previous;
+        }
+    }
+
+    ArenaAllocator::Block* ArenaAllocator::addBlock(const uint32_t aBytes) throw() {
+        const uint32_t size = aBytes > mBlockSize ? aBytes : mBlockSize;
+        Block* const block = static_cast<Block*>(mAllocator.allocate(alignArena(sizeof(Block)) + size));
+        if(block == nullptr) return nullptr;
+        block->previous = mHead;
+        block->size = size;
+        block->used = 0;
+        mHead = block;
+        return block;
+    }
+
+    void ArenaAllocator::clear() throw() {
+        if(mHead == nullptr) return;
+        Block* block = mHead->previous;
+        while(block) {
+            Block* const previous = block->previous;
+            mAllocator.deallocate(block);
+            block = previous;
+        }
+        mHead->previous = nullptr;
+        mHead->used = 0;
+        mLast = nullptr;
+        mAllocatedBytes = 0;
+    }
+
+    bool ArenaAllocator::contains(const void* const aAddress) const throw() {
+        const uint8_t* const address = static_cast<const uint8_t*>(aAddress);
+        for(const Block* block = mHead; block; block = block->previous) {
+            const uint8_t* const begin = reinterpret_cast<const uint8_t*>(block) + alignArena(sizeof(Block));
+            if(address >= begin && address < begin + block->size) return true;
+        }
+        return false;
+    }
+
+    uint32_t SOLAIRE_EXPORT_CALL ArenaAllocator::getAllocatedBytes() const throw() {
+        return mAllocatedBytes;
+    }
+
+    uint32_t SOLAIRE_EXPORT_CALL ArenaAllocator::getFreeBytes() const throw() {
+        return mHead ? mHead->size - mHead->used : 0;
+    }
+
+    void* SOLAIRE_EXPORT_CALL ArenaAllocator::allocate(const uint32_t aBytes) throw() {
+        const uint32_t bytes = alignArena(aBytes > 0 ? aBytes : 1);
+        Block* block = mHead;
+        if(block == nullptr || block->size - block->used < bytes) {
+            block = addBlock(bytes);
+            if(block == nullptr) return nullptr;
+        }
+        void* const memory = reinterpret_cast<uint8_t*>(block) + alignArena(sizeof(Block)) + block->used;
+        block->used += bytes;
+        mAllocatedBytes += bytes;
+        mLast = memory;
+        return memory;
+    }
+
+    bool SOLAIRE_EXPORT_CALL ArenaAllocator::deallocate(const void* const aObject) throw() {
+        if(aObject != nullptr && aObject == mLast) {
+            const uint32_t offset = static_cast<uint32_t>(static_cast<const uint8_t*>(aObject) - (reinterpret_cast<uint8_t*>(mHead) + alignArena(sizeof(Block))));
+            mAllocatedBytes -= mHead->used - offset;
+            mHead->used = offset;
+            mLast = nullptr;
+        }
+        return true;
+    }
+}
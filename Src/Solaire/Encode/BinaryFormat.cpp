@@ -0,0 +1,1277 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+#include <cstring>
+#include <utility>
+#include "Solaire/Encode/BinaryFormat.hpp"
+#include "Solaire/Encode/EncodeStats.hpp"
+#include "Solaire/Encode/NumberFormat.hpp"
+#include "Solaire/Encode/Schema.hpp"
+
+namespace Solaire {
+
+    enum : uint32_t {
+        MAX_VARINT_BYTES = 10,
+        COPY_BUFFER_BYTES = 256,
+        PACKED_CHUNK_ELEMENTS = 8192
+    };
+
+    enum : uint8_t {
+        PACKED_UNSIGNED_TAG = 9,
+        PACKED_SIGNED_TAG = 10,
+        PACKED_DOUBLE_TAG = 11,
+        PACKED_TAG_OFFSET = PACKED_UNSIGNED_TAG - GenericValue::UNSIGNED_T
+    };
+
+    static SOLAIRE_FORCE_INLINE bool isLittleEndian() throw() {
+        const uint16_t value = 1;
+        return *reinterpret_cast<const uint8_t*>(&value) == 1;
+    }
+
+    static SOLAIRE_FORCE_INLINE uint64_t swapBytes(const uint64_t aValue) throw() {
+        uint64_t value = 0;
+        for(uint32_t i = 0; i < 8; ++i) value |= ((aValue >> (i * 8)) & 0xFF) << ((7 - i) * 8);
+        return value;
+    }
+
+    static void appendText(String<char>& aString, const GenericValue& aValue) throw() {
+        char buffer[NumberFormat::MAX_DOUBLE_CHARACTERS];
+        uint32_t length;
+        switch(aValue.getType()) {
+        case GenericValue::CHAR_T:
+            aString.pushBack(aValue.getChar());
+            return;
+        case GenericValue::BOOL_T:
+            if(aValue.getBool()) {
+                std::memcpy(buffer, "true", 4);
+                length = 4;
+            }else {
+                std::memcpy(buffer, "false", 5);
+                length = 5;
+            }
+            break;
+        case GenericValue::UNSIGNED_T:
+            length = NumberFormat::formatUnsigned(aValue.getUnsigned(), buffer);
+            break;
+        case GenericValue::SIGNED_T:
+            length = NumberFormat::formatSigned(aValue.getSigned(), buffer);
+            break;
+        case GenericValue::DOUBLE_T:
+            length = NumberFormat::formatDouble(aValue.getDouble(), buffer);
+            break;
+        default:
+            return;
+        }
+        for(uint32_t i = 0; i < length; ++i) aString.pushBack(buffer[i]);
+    }
+
+    // BinaryWriter
+
+    static uint32_t encodeVarint(uint8_t* const aBuffer, uint64_t aValue) throw() {
+        uint32_t count = 0;
+        while(aValue >= 0x80) {
+            aBuffer[count++] = static_cast<uint8_t>(aValue | 0x80);
+            aValue >>= 7;
+        }
+        aBuffer[count++] = static_cast<uint8_t>(aValue);
+        return count;
+    }
+
+    class BinaryWriter : public Writer {
+    private:
+        enum : uint32_t {
+            BUFFER_BYTES = 4096
+        };
+    private:
+        OStream& mStream;
+        const Schema* const mSchema;
+        uint32_t mSize;
+        bool mFailed;
+        uint8_t mBuffer[BUFFER_BYTES];
+    private:
+        uint8_t* reserve(const uint32_t aBytes) throw() {
+            if(mSize + aBytes > BUFFER_BYTES) flush();
+            return mBuffer + mSize;
+        }
+
+        bool writeVarint(const uint64_t aValue) throw() {
+            uint8_t* const buffer = reserve(MAX_VARINT_BYTES);
+            mSize += encodeVarint(buffer, aValue);
+            return ! mFailed;
+        }
+
+        bool writeTagged(const uint8_t aTag, const uint64_t aValue) throw() {
+            uint8_t* const buffer = reserve(MAX_VARINT_BYTES + 1);
+            buffer[0] = aTag;
+            mSize += encodeVarint(buffer + 1, aValue) + 1;
+            return ! mFailed;
+        }
+
+        bool writeCharacters(const StringConstant<char>& aString) throw() {
+            const int32_t size = aString.size();
+            int32_t i = 0;
+            while(i < size) {
+                if(mSize == BUFFER_BYTES) flush();
+                while(mSize < BUFFER_BYTES && i < size) {
+                    mBuffer[mSize++] = static_cast<uint8_t>(aString[i++]);
+                }
+            }
+            return ! mFailed;
+        }
+
+        bool writeBytes(const void* const aBytes, uint32_t aCount) throw() {
+            const uint8_t* bytes = static_cast<const uint8_t*>(aBytes);
+            while(aCount > 0) {
+                if(mSize == BUFFER_BYTES) flush();
+                const uint32_t count = aCount < BUFFER_BYTES - mSize ? aCount : BUFFER_BYTES - mSize;
+                std::memcpy(mBuffer + mSize, bytes, count);
+                mSize += count;
+                bytes += count;
+                aCount -= count;
+            }
+            return ! mFailed;
+        }
+
+        bool writePacked(const uint64_t* aValues, uint32_t aCount) throw() {
+            if(isLittleEndian()) {
+                while(aCount > 0) {
+                    const uint32_t count = aCount < PACKED_CHUNK_ELEMENTS ? aCount : static_cast<uint32_t>(PACKED_CHUNK_ELEMENTS);
+                    if(! writeBytes(aValues, count * sizeof(uint64_t))) return false;
+                    aValues += count;
+                    aCount -= count;
+                }
+            }else {
+                for(uint32_t i = 0; i < aCount; ++i) {
+                    const uint64_t value = swapBytes(aValues[i]);
+                    if(! writeBytes(&value, sizeof(uint64_t))) return false;
+                }
+            }
+            return ! mFailed;
+        }
+    public:
+        BinaryWriter(OStream& aStream, const Schema* const aSchema) throw() :
+            mStream(aStream),
+            mSchema(aSchema),
+            mSize(0),
+            mFailed(false)
+        {}
+
+        SOLAIRE_EXPORT_CALL ~BinaryWriter() {
+            flush();
+        }
+
+        // Inherited from Writer
+
+        bool SOLAIRE_EXPORT_CALL beginArray(const int32_t aSize) throw() override {
+            return writeTagged(GenericValue::ARRAY_T, static_cast<uint64_t>(aSize));
+        }
+
+        bool SOLAIRE_EXPORT_CALL endArray() throw() override {
+            return ! mFailed;
+        }
+
+        bool SOLAIRE_EXPORT_CALL beginObject(const int32_t aSize) throw() override {
+            return writeTagged(GenericValue::OBJECT_T, static_cast<uint64_t>(aSize));
+        }
+
+        bool SOLAIRE_EXPORT_CALL endObject() throw() override {
+            return ! mFailed;
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeName(const StringConstant<char>& aName) throw() override {
+            if(mSchema) {
+                // Names that are not in the schema are written as id 0 followed by the characters
+                const uint32_t id = mSchema->getId(aName);
+                if(! writeVarint(id)) return false;
+                if(id != Schema::NO_ID) return true;
+            }
+            return writeVarint(static_cast<uint64_t>(aName.size())) && writeCharacters(aName);
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeName(const char* const aName, const uint32_t aLength) throw() override {
+            if(mSchema) {
+                const uint32_t id = mSchema->getId(aName, aLength);
+                if(! writeVarint(id)) return false;
+                if(id != Schema::NO_ID) return true;
+            }
+            return writeVarint(aLength) && writeBytes(aName, aLength);
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeNull() throw() override {
+            *reserve(1) = GenericValue::NULL_T;
+            ++mSize;
+            return ! mFailed;
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeChar(const char aValue) throw() override {
+            uint8_t* const buffer = reserve(2);
+            buffer[0] = GenericValue::CHAR_T;
+            buffer[1] = static_cast<uint8_t>(aValue);
+            mSize += 2;
+            return ! mFailed;
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeBool(const bool aValue) throw() override {
+            uint8_t* const buffer = reserve(2);
+            buffer[0] = GenericValue::BOOL_T;
+            buffer[1] = aValue ? 1 : 0;
+            mSize += 2;
+            return ! mFailed;
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeUnsigned(const uint64_t aValue) throw() override {
+            return writeTagged(GenericValue::UNSIGNED_T, aValue);
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeSigned(const int64_t aValue) throw() override {
+            return writeTagged(GenericValue::SIGNED_T, (static_cast<uint64_t>(aValue) << 1) ^ static_cast<uint64_t>(aValue >> 63));
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeDouble(const double aValue) throw() override {
+            uint64_t bits;
+            std::memcpy(&bits, &aValue, sizeof(double));
+            uint8_t* const buffer = reserve(sizeof(double) + 1);
+            buffer[0] = GenericValue::DOUBLE_T;
+            for(uint32_t i = 0; i < sizeof(double); ++i) {
+                buffer[i + 1] = static_cast<uint8_t>(bits >> (i * 8));
+            }
+            mSize += sizeof(double) + 1;
+            return ! mFailed;
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeString(const StringConstant<char>& aValue) throw() override {
+            return writeTagged(GenericValue::STRING_T, static_cast<uint64_t>(aValue.size())) && writeCharacters(aValue);
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeString(const char* const aValue, const uint32_t aLength) throw() override {
+            return writeTagged(GenericValue::STRING_T, aLength) && writeBytes(aValue, aLength);
+        }
+
+        bool SOLAIRE_EXPORT_CALL beginPackedArray(const GenericValue::ValueType aType, const int32_t aSize) throw() override {
+            if(aType != GenericValue::UNSIGNED_T && aType != GenericValue::SIGNED_T && aType != GenericValue::DOUBLE_T) return false;
+            return writeTagged(aType + PACKED_TAG_OFFSET, static_cast<uint64_t>(aSize));
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeUnsignedArray(const uint64_t* const aValues, const uint32_t aCount) throw() override {
+            return writePacked(aValues, aCount);
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeSignedArray(const int64_t* const aValues, const uint32_t aCount) throw() override {
+            return writePacked(reinterpret_cast<const uint64_t*>(aValues), aCount);
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeDoubleArray(const double* const aValues, const uint32_t aCount) throw() override {
+            static_assert(sizeof(double) == sizeof(uint64_t), "Packed doubles must be 64 bits");
+            return writePacked(reinterpret_cast<const uint64_t*>(aValues), aCount);
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeFragment(const void* const aBytes, const uint32_t aLength) throw() override {
+            // Values carry no separators, so fragments are copied unchanged
+            if(aLength < BUFFER_BYTES) return writeBytes(aBytes, aLength);
+            if(! flush()) return false;
+            if(mStream.write(aBytes, aLength) != aLength) mFailed = true;
+            return ! mFailed;
+        }
+
+        bool SOLAIRE_EXPORT_CALL flush() throw() override {
+            if(mSize > 0) {
+                if(mStream.write(mBuffer, mSize) != mSize) mFailed = true;
+                mSize = 0;
+            }
+            return ! mFailed;
+        }
+    };
+
+    // BinaryReader
+
+    class BinaryReader : public Reader {
+    private:
+        enum : uint32_t {
+            MAX_DEPTH = 512
+        };
+        enum : int16_t {
+            NO_TAG = -1,
+            // Elements of packed arrays have no tag in the data, these are only used inside the reader
+            ELEMENT_UNSIGNED_TAG = 12,
+            ELEMENT_SIGNED_TAG,
+            ELEMENT_DOUBLE_TAG,
+            ELEMENT_TAG_OFFSET = ELEMENT_UNSIGNED_TAG - GenericValue::UNSIGNED_T
+        };
+    private:
+        struct Frame {
+            int32_t remaining;
+            int16_t elementTag;
+            bool isObject;
+        };
+    private:
+        IStream& mStream;
+        BufferIStream* const mBuffer;
+        const Schema* const mSchema;
+        const bool mBorrowStrings;
+        uint32_t mDepth;
+        uint32_t mPendingId;
+        int16_t mTag;
+        bool mHasPendingId;
+        bool mNameRead;
+        bool mFailed;
+        Frame mFrames[MAX_DEPTH];
+    private:
+        bool fail() throw() {
+            mFailed = true;
+            return false;
+        }
+
+        SOLAIRE_FORCE_INLINE bool readBytes(void* const aBytes, const uint32_t aCount) throw() {
+            const uint32_t count = mStream.read(aBytes, aCount);
+            return count == aCount || readRemaining(static_cast<uint8_t*>(aBytes), count, aCount);
+        }
+
+        bool readRemaining(uint8_t* const aBytes, uint32_t aCount, const uint32_t aTotal) throw() {
+            // Streams may return fewer bytes than were asked for before they end
+            while(aCount < aTotal) {
+                const uint32_t count = mStream.read(aBytes + aCount, aTotal - aCount);
+                if(count == 0) return fail();
+                aCount += count;
+            }
+            return true;
+        }
+
+        bool readVarint(uint64_t& aValue) throw() {
+            uint64_t value = 0;
+            for(uint32_t i = 0; i < MAX_VARINT_BYTES; ++i) {
+                uint8_t byte;
+                if(! readBytes(&byte, 1)) return false;
+                value |= static_cast<uint64_t>(byte & 0x7F) << (i * 7);
+                if((byte & 0x80) == 0) {
+                    aValue = value;
+                    return true;
+                }
+            }
+            return fail();
+        }
+
+        bool readSize(int32_t& aSize) throw() {
+            uint64_t size;
+            if(! readVarint(size)) return false;
+            if(size > INT32_MAX) return fail();
+            aSize = static_cast<int32_t>(size);
+            return true;
+        }
+
+        bool readCharacters(String<char>& aString, int32_t aSize) throw() {
+            char buffer[COPY_BUFFER_BYTES];
+            while(aSize > 0) {
+                const uint32_t count = aSize < static_cast<int32_t>(COPY_BUFFER_BYTES) ? static_cast<uint32_t>(aSize) : static_cast<uint32_t>(COPY_BUFFER_BYTES);
+                if(! readBytes(buffer, count)) return false;
+                for(uint32_t i = 0; i < count; ++i) {
+                    aString.pushBack(buffer[i]);
+                }
+                aSize -= count;
+            }
+            return true;
+        }
+
+        bool skipBytes(uint64_t aSize) throw() {
+            if(mBuffer) {
+                if(aSize > mBuffer->getRemaining()) return fail();
+                return mBuffer->borrow(static_cast<uint32_t>(aSize)) != nullptr;
+            }
+            uint8_t buffer[COPY_BUFFER_BYTES];
+            while(aSize > 0) {
+                const uint32_t count = aSize < COPY_BUFFER_BYTES ? static_cast<uint32_t>(aSize) : static_cast<uint32_t>(COPY_BUFFER_BYTES);
+                if(! readBytes(buffer, count)) return false;
+                aSize -= count;
+            }
+            return true;
+        }
+
+        bool readFixed(uint64_t& aValue) throw() {
+            uint8_t buffer[sizeof(uint64_t)];
+            if(! readBytes(buffer, sizeof(uint64_t))) return false;
+            uint64_t bits = 0;
+            for(uint32_t i = 0; i < sizeof(uint64_t); ++i) {
+                bits |= static_cast<uint64_t>(buffer[i]) << (i * 8);
+            }
+            aValue = bits;
+            return true;
+        }
+
+        bool readDoubleBits(double& aValue) throw() {
+            uint64_t bits;
+            if(! readFixed(bits)) return false;
+            std::memcpy(&aValue, &bits, sizeof(double));
+            return true;
+        }
+
+        bool readPacked(const int16_t aElementTag, uint64_t* aValues, uint32_t aCount) throw() {
+            if(mTag != NO_TAG || mDepth == 0) return false;
+            Frame& frame = mFrames[mDepth - 1];
+            if(frame.elementTag != aElementTag || static_cast<uint32_t>(frame.remaining) < aCount) return false;
+            frame.remaining -= static_cast<int32_t>(aCount);
+            const bool swap = ! isLittleEndian();
+            while(aCount > 0) {
+                const uint32_t count = aCount < PACKED_CHUNK_ELEMENTS ? aCount : static_cast<uint32_t>(PACKED_CHUNK_ELEMENTS);
+                if(! readBytes(aValues, count * sizeof(uint64_t))) return false;
+                if(swap) {
+                    for(uint32_t i = 0; i < count; ++i) aValues[i] = swapBytes(aValues[i]);
+                }
+                aValues += count;
+                aCount -= count;
+            }
+            return true;
+        }
+
+        static GenericValue::ValueType getTagType(const int16_t aTag) throw() {
+            if(aTag <= GenericValue::OBJECT_T) return static_cast<GenericValue::ValueType>(aTag);
+            if(aTag <= PACKED_DOUBLE_TAG) return GenericValue::ARRAY_T;
+            return static_cast<GenericValue::ValueType>(aTag - ELEMENT_TAG_OFFSET);
+        }
+
+        int16_t takeTag() throw() {
+            peekType();
+            if(mFailed) return NO_TAG;
+            const int16_t tag = mTag;
+            mTag = NO_TAG;
+            mNameRead = false;
+            if(mDepth > 0) --mFrames[mDepth - 1].remaining;
+            return tag;
+        }
+
+        bool push(const int32_t aSize, const bool aIsObject, const int16_t aElementTag = NO_TAG) throw() {
+            if(mDepth == MAX_DEPTH) return fail();
+            Frame& frame = mFrames[mDepth++];
+            frame.remaining = aSize;
+            frame.elementTag = aElementTag;
+            frame.isObject = aIsObject;
+            return true;
+        }
+
+        bool pop() throw() {
+            if(mDepth == 0) return fail();
+            Frame& frame = mFrames[mDepth - 1];
+            if(frame.elementTag != NO_TAG) {
+                // Unread packed elements can be skipped in one step
+                if(! skipBytes(static_cast<uint64_t>(frame.remaining) * sizeof(uint64_t))) return false;
+                frame.remaining = 0;
+            }
+            const bool isObject = frame.isObject;
+            while(hasNext()) {
+                if(isObject && ! skipName()) return false;
+                if(! skip()) return false;
+            }
+            --mDepth;
+            return ! mFailed;
+        }
+
+        bool findField() throw() {
+            // Members with ids that are not in the schema are skipped here, so they are never seen by the caller
+            while(mFrames[mDepth - 1].remaining > 0) {
+                uint64_t id;
+                if(! readVarint(id)) return false;
+                if(id == Schema::NO_ID || (id <= UINT32_MAX && mSchema->getName(static_cast<uint32_t>(id)))) {
+                    mPendingId = static_cast<uint32_t>(id);
+                    mHasPendingId = true;
+                    return true;
+                }
+                if(! skip()) return false;
+            }
+            return false;
+        }
+
+        bool readFieldId(uint32_t& aId) throw() {
+            if(mDepth == 0 || ! (mHasPendingId || findField())) return fail();
+            aId = mPendingId;
+            mHasPendingId = false;
+            mNameRead = true;
+            return true;
+        }
+
+        bool skipName() throw() {
+            if(mSchema) {
+                uint32_t id;
+                if(! readFieldId(id)) return false;
+                if(id != Schema::NO_ID) return true;
+            }
+            int32_t size;
+            return readSize(size) && skipBytes(size);
+        }
+
+        bool skipPayload(const int16_t aTag) throw() {
+            switch(aTag) {
+            case GenericValue::NULL_T:
+                return true;
+            case GenericValue::CHAR_T:
+            case GenericValue::BOOL_T:
+                return skipBytes(1);
+            case GenericValue::UNSIGNED_T:
+            case GenericValue::SIGNED_T:
+                {
+                    uint64_t value;
+                    return readVarint(value);
+                }
+            case GenericValue::DOUBLE_T:
+                return skipBytes(sizeof(double));
+            case GenericValue::STRING_T:
+                {
+                    int32_t size;
+                    return readSize(size) && skipBytes(size);
+                }
+            case GenericValue::ARRAY_T:
+                {
+                    int32_t size;
+                    return readSize(size) && push(size, false) && pop();
+                }
+            case GenericValue::OBJECT_T:
+                {
+                    int32_t size;
+                    return readSize(size) && push(size, true) && pop();
+                }
+            case PACKED_UNSIGNED_TAG:
+            case PACKED_SIGNED_TAG:
+            case PACKED_DOUBLE_TAG:
+                {
+                    int32_t size;
+                    return readSize(size) && skipBytes(static_cast<uint64_t>(size) * sizeof(uint64_t));
+                }
+            case ELEMENT_UNSIGNED_TAG:
+            case ELEMENT_SIGNED_TAG:
+            case ELEMENT_DOUBLE_TAG:
+                return skipBytes(sizeof(uint64_t));
+            default:
+                return fail();
+            }
+        }
+
+        bool readScalar(const int16_t aTag, GenericValue& aValue) throw() {
+            switch(aTag) {
+            case GenericValue::NULL_T:
+                return true;
+            case GenericValue::CHAR_T:
+                return readBytes(&aValue.setChar(0), 1);
+            case GenericValue::BOOL_T:
+                {
+                    uint8_t value;
+                    if(! readBytes(&value, 1)) return false;
+                    aValue.setBool(value != 0);
+                    return true;
+                }
+            case GenericValue::UNSIGNED_T:
+                return readVarint(aValue.setUnsigned(0));
+            case GenericValue::SIGNED_T:
+                {
+                    uint64_t value;
+                    if(! readVarint(value)) return false;
+                    aValue.setSigned(static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1));
+                    return true;
+                }
+            case GenericValue::DOUBLE_T:
+                return readDoubleBits(aValue.setDouble(0.0));
+            case GenericValue::STRING_T:
+                {
+                    int32_t size;
+                    if(! readSize(size)) return false;
+                    if(size > static_cast<int32_t>(GenericValue::INLINE_CAPACITY)) return readCharacters(aValue.setString(), size);
+                    char buffer[GenericValue::INLINE_CAPACITY];
+                    if(! readBytes(buffer, static_cast<uint32_t>(size))) return false;
+                    aValue.setString(buffer, static_cast<uint32_t>(size));
+                    return true;
+                }
+            case ELEMENT_UNSIGNED_TAG:
+                return readFixed(aValue.setUnsigned(0));
+            case ELEMENT_SIGNED_TAG:
+                {
+                    uint64_t value;
+                    if(! readFixed(value)) return false;
+                    aValue.setSigned(static_cast<int64_t>(value));
+                    return true;
+                }
+            case ELEMENT_DOUBLE_TAG:
+                return readDoubleBits(aValue.setDouble(0.0));
+            default:
+                return skipPayload(aTag);
+            }
+        }
+
+    public:
+        BinaryReader(IStream& aStream, const bool aBorrowStrings, const Schema* const aSchema) throw() :
+            mStream(aStream),
+            mBuffer(dynamic_cast<BufferIStream*>(&aStream)),
+            mSchema(aSchema),
+            mBorrowStrings(aBorrowStrings),
+            mDepth(0),
+            mPendingId(Schema::NO_ID),
+            mTag(NO_TAG),
+            mHasPendingId(false),
+            mNameRead(false),
+            mFailed(false)
+        {}
+
+        // Inherited from Reader
+
+        GenericValue::ValueType SOLAIRE_EXPORT_CALL peekType() throw() override {
+            if(mFailed) return GenericValue::NULL_T;
+            if(mTag == NO_TAG) {
+                if(mDepth > 0 && mFrames[mDepth - 1].elementTag != NO_TAG) {
+                    if(mFrames[mDepth - 1].remaining <= 0) {
+                        fail();
+                        return GenericValue::NULL_T;
+                    }
+                    mTag = mFrames[mDepth - 1].elementTag;
+                }else {
+                    uint8_t tag;
+                    if(! readBytes(&tag, 1)) return GenericValue::NULL_T;
+                    if(tag > PACKED_DOUBLE_TAG) {
+                        fail();
+                        return GenericValue::NULL_T;
+                    }
+                    mTag = tag;
+                }
+            }
+            return getTagType(mTag);
+        }
+
+        bool SOLAIRE_EXPORT_CALL hasNext() throw() override {
+            if(mFailed || mDepth == 0) return false;
+            const Frame& frame = mFrames[mDepth - 1];
+            if(frame.remaining <= 0) return false;
+            if(mSchema && frame.isObject && ! (mNameRead || mHasPendingId)) return findField();
+            return true;
+        }
+
+        bool SOLAIRE_EXPORT_CALL hasFailed() const throw() override {
+            return mFailed;
+        }
+
+        bool SOLAIRE_EXPORT_CALL beginArray(int32_t& aSize) throw() override {
+            if(peekType() != GenericValue::ARRAY_T) return fail();
+            const int16_t tag = takeTag();
+            const int16_t elementTag = tag == GenericValue::ARRAY_T ? static_cast<int16_t>(NO_TAG) : static_cast<int16_t>(tag - PACKED_TAG_OFFSET + ELEMENT_TAG_OFFSET);
+            if(! readSize(aSize)) return false;
+            // Every packed element is stored in 8 bytes, so a count that needs more than the rest of a buffer is malformed
+            if(elementTag != NO_TAG && mBuffer && static_cast<uint64_t>(aSize) * sizeof(uint64_t) > mBuffer->getRemaining()) return fail();
+            return push(aSize, false, elementTag);
+        }
+
+        bool SOLAIRE_EXPORT_CALL endArray() throw() override {
+            return pop();
+        }
+
+        uint32_t SOLAIRE_EXPORT_CALL getRemainingBytes() const throw() override {
+            return mBuffer ? mBuffer->getRemaining() : static_cast<uint32_t>(UINT32_MAX);
+        }
+
+        GenericValue::ValueType SOLAIRE_EXPORT_CALL peekPackedType() throw() override {
+            if(peekType() != GenericValue::ARRAY_T || mTag == GenericValue::ARRAY_T) return GenericValue::NULL_T;
+            return static_cast<GenericValue::ValueType>(mTag - PACKED_TAG_OFFSET);
+        }
+
+        bool SOLAIRE_EXPORT_CALL readUnsignedArray(uint64_t* const aValues, const uint32_t aCount) throw() override {
+            return readPacked(ELEMENT_UNSIGNED_TAG, aValues, aCount) || (! mFailed && Reader::readUnsignedArray(aValues, aCount));
+        }
+
+        bool SOLAIRE_EXPORT_CALL readSignedArray(int64_t* const aValues, const uint32_t aCount) throw() override {
+            return readPacked(ELEMENT_SIGNED_TAG, reinterpret_cast<uint64_t*>(aValues), aCount) || (! mFailed && Reader::readSignedArray(aValues, aCount));
+        }
+
+        bool SOLAIRE_EXPORT_CALL readDoubleArray(double* const aValues, const uint32_t aCount) throw() override {
+            return readPacked(ELEMENT_DOUBLE_TAG, reinterpret_cast<uint64_t*>(aValues), aCount) || (! mFailed && Reader::readDoubleArray(aValues, aCount));
+        }
+
+        bool SOLAIRE_EXPORT_CALL beginObject(int32_t& aSize) throw() override {
+            if(peekType() != GenericValue::OBJECT_T) return fail();
+            takeTag();
+            return readSize(aSize) && push(aSize, true);
+        }
+
+        bool SOLAIRE_EXPORT_CALL endObject() throw() override {
+            return pop();
+        }
+
+        bool SOLAIRE_EXPORT_CALL readName(String<char>& aName) throw() override {
+            if(mFailed) return false;
+            if(mSchema) {
+                uint32_t id;
+                if(! readFieldId(id)) return false;
+                if(id != Schema::NO_ID) {
+                    const CString& name = *mSchema->getName(id);
+                    const int32_t size = name.size();
+                    for(int32_t i = 0; i < size; ++i) aName.pushBack(name[i]);
+                    return true;
+                }
+            }
+            int32_t size;
+            return readSize(size) && readCharacters(aName, size);
+        }
+
+        bool SOLAIRE_EXPORT_CALL readName(char* const aName, const uint32_t aCapacity, uint32_t& aLength) throw() override {
+            if(mFailed) return false;
+            if(mSchema) {
+                uint32_t id;
+                if(! readFieldId(id)) return false;
+                if(id != Schema::NO_ID) {
+                    const CString& name = *mSchema->getName(id);
+                    aLength = static_cast<uint32_t>(name.size());
+                    const uint32_t count = aLength < aCapacity ? aLength : aCapacity;
+                    for(uint32_t i = 0; i < count; ++i) aName[i] = name[i];
+                    return true;
+                }
+            }
+            int32_t size;
+            if(! readSize(size)) return false;
+            aLength = static_cast<uint32_t>(size);
+            const uint32_t count = aLength < aCapacity ? aLength : aCapacity;
+            return readBytes(aName, count) && skipBytes(aLength - count);
+        }
+
+        bool SOLAIRE_EXPORT_CALL readNull() throw() override {
+            return takeTag() == GenericValue::NULL_T || fail();
+        }
+
+        bool SOLAIRE_EXPORT_CALL readChar(char& aValue) throw() override {
+            const int16_t tag = takeTag();
+            if(tag == GenericValue::CHAR_T) return readBytes(&aValue, 1);
+            GenericValue value;
+            if(! readScalar(tag, value)) return false;
+            aValue = value.getChar();
+            return true;
+        }
+
+        bool SOLAIRE_EXPORT_CALL readBool(bool& aValue) throw() override {
+            GenericValue value;
+            if(! readScalar(takeTag(), value)) return false;
+            aValue = value.getBool();
+            return true;
+        }
+
+        bool SOLAIRE_EXPORT_CALL readUnsigned(uint64_t& aValue) throw() override {
+            const int16_t tag = takeTag();
+            if(tag == GenericValue::UNSIGNED_T) return readVarint(aValue);
+            GenericValue value;
+            if(! readScalar(tag, value)) return false;
+            aValue = value.getUnsigned();
+            return true;
+        }
+
+        bool SOLAIRE_EXPORT_CALL readSigned(int64_t& aValue) throw() override {
+            GenericValue value;
+            if(! readScalar(takeTag(), value)) return false;
+            aValue = value.getSigned();
+            return true;
+        }
+
+        bool SOLAIRE_EXPORT_CALL readDouble(double& aValue) throw() override {
+            const int16_t tag = takeTag();
+            if(tag == GenericValue::DOUBLE_T) return readDoubleBits(aValue);
+            GenericValue value;
+            if(! readScalar(tag, value)) return false;
+            aValue = value.getDouble();
+            return true;
+        }
+
+        bool SOLAIRE_EXPORT_CALL readString(String<char>& aValue) throw() override {
+            const int16_t tag = takeTag();
+            if(tag == GenericValue::STRING_T) {
+                int32_t size;
+                return readSize(size) && readCharacters(aValue, size);
+            }
+            GenericValue value;
+            if(! readScalar(tag, value)) return false;
+            appendText(aValue, value);
+            return true;
+        }
+
+        const char* SOLAIRE_EXPORT_CALL borrowString(uint32_t& aLength) throw() override {
+            if(! mBorrowStrings || mBuffer == nullptr || peekType() != GenericValue::STRING_T) return nullptr;
+            takeTag();
+            int32_t size;
+            if(! readSize(size)) return nullptr;
+            const void* const characters = mBuffer->borrow(static_cast<uint32_t>(size));
+            if(characters == nullptr) {
+                fail();
+                return nullptr;
+            }
+            aLength = static_cast<uint32_t>(size);
+            return static_cast<const char*>(characters);
+        }
+
+        const void* SOLAIRE_EXPORT_CALL borrowValue(uint32_t& aSize) throw() override {
+            if(mBuffer == nullptr) return nullptr;
+            const GenericValue::ValueType type = peekType();
+            // Elements of packed arrays have no tag of their own to begin the range with
+            if((type != GenericValue::ARRAY_T && type != GenericValue::OBJECT_T) || mTag > PACKED_DOUBLE_TAG) return nullptr;
+            const uint32_t begin = static_cast<uint32_t>(mBuffer->getOffset()) - 1;
+            if(! skip()) return nullptr;
+            aSize = static_cast<uint32_t>(mBuffer->getOffset()) - begin;
+            return static_cast<const uint8_t*>(mBuffer->getData()) + begin;
+        }
+
+        bool SOLAIRE_EXPORT_CALL skip() throw() override {
+            return skipPayload(takeTag());
+        }
+    };
+
+    // BinaryParser
+
+    class BinaryParser : public Parser {
+    private:
+        enum : uint32_t {
+            MAX_DEPTH = 512,
+            PACKED_STAGING_ELEMENTS = 4096  //!< Packed arrays with more elements are collected as they arrive before they are allocated.
+        };
+        enum State : uint8_t {
+            STATE_TAG,          //!< Expecting the tag of a value.
+            STATE_NAME_ID,      //!< Inside the schema id of a member name.
+            STATE_NAME_LENGTH,  //!< Inside the length of a member name.
+            STATE_NAME,         //!< Inside the characters of a member name.
+            STATE_SIZE,         //!< Inside the length of a string or the element count of a container.
+            STATE_VARINT,       //!< Inside the payload of an UNSIGNED_T or SIGNED_T value.
+            STATE_FIXED,        //!< Inside the payload of a CHAR_T, BOOL_T or DOUBLE_T value.
+            STATE_STRING,       //!< Inside the characters of a string.
+            STATE_PACKED,       //!< Inside the elements of a packed array.
+            STATE_DONE,         //!< A complete value is waiting to be taken.
+            STATE_FAILED
+        };
+    private:
+        struct Frame {
+            GenericValue* value;
+            uint32_t remaining;
+            bool isObject;
+            bool discarded;
+        };
+    private:
+        Allocator& mAllocator;
+        const Schema* const mSchema;
+        GenericValue mRoot;
+        GenericValue mDiscard;
+        CString mName;
+        GenericValue* mValue;
+        String<char>* mString;
+        uint8_t* mPacked;
+        uint8_t* mStage;
+        uint32_t mStageSize;
+        uint32_t mStageCapacity;
+        uint32_t mPackedSize;
+        GenericValue::ValueType mPackedType;
+        uint64_t mVarint;
+        uint64_t mRemaining;
+        uint32_t mShift;
+        uint32_t mCount;
+        uint32_t mDepth;
+        uint8_t mTag;
+        State mState;
+        bool mDiscardMember;
+        char mBytes[GenericValue::INLINE_CAPACITY];
+        Frame mFrames[MAX_DEPTH];
+    private:
+        BinaryParser(const BinaryParser&) = delete;
+        BinaryParser& operator=(const BinaryParser&) = delete;
+
+        bool fail() throw() {
+            mState = STATE_FAILED;
+            return false;
+        }
+
+        void beginVarint(const State aState) throw() {
+            mVarint = 0;
+            mShift = 0;
+            mState = aState;
+        }
+
+        bool addVarintByte(const uint8_t aByte) throw() {
+            // Returns true once the last byte of the varint has been added
+            mVarint |= static_cast<uint64_t>(aByte & 0x7F) << mShift;
+            mShift += 7;
+            if((aByte & 0x80) == 0) return true;
+            if(mShift >= MAX_VARINT_BYTES * 7) fail();
+            return false;
+        }
+
+        GenericValue& beginValue() throw() {
+            // Only the innermost open container is modified, so the pointers to the others stay valid
+            if(mDepth == 0) return mRoot;
+            Frame& frame = mFrames[mDepth - 1];
+            --frame.remaining;
+            if(! frame.isObject) return frame.value->pushBack(GenericValue());
+            if(mDiscardMember && ! frame.discarded) {
+                // Members of a discarded container are discarded with it
+                mDiscard.setNull();
+                return mDiscard;
+            }
+            return frame.value->emplace(mName, GenericValue());
+        }
+
+        void beginName() throw() {
+            mDiscardMember = false;
+            mName.clear();
+            beginVarint(mSchema ? STATE_NAME_ID : STATE_NAME_LENGTH);
+        }
+
+        void endValue() throw() {
+            while(mDepth > 0 && mFrames[mDepth - 1].remaining == 0) --mDepth;
+            if(mDepth == 0) {
+                mState = STATE_DONE;
+            }else if(mFrames[mDepth - 1].isObject) {
+                beginName();
+            }else {
+                mState = STATE_TAG;
+            }
+        }
+
+        bool push(const uint32_t aSize, const bool aIsObject) throw() {
+            if(mDepth == MAX_DEPTH) return fail();
+            const bool discarded = mValue == &mDiscard || (mDepth > 0 && mFrames[mDepth - 1].discarded);
+            Frame& frame = mFrames[mDepth++];
+            frame.value = mValue;
+            frame.remaining = aSize;
+            frame.isObject = aIsObject;
+            frame.discarded = discarded;
+            endValue();
+            return true;
+        }
+
+        void endString() throw() {
+            if(mString == nullptr) mValue->setString(mBytes, mCount);
+            endValue();
+        }
+
+        void releaseStage() throw() {
+            if(mStage) mAllocator.deallocate(mStage);
+            mStage = nullptr;
+            mStageSize = 0;
+            mStageCapacity = 0;
+        }
+
+        bool stagePacked(const uint8_t* const aData, const uint32_t aCount) throw() {
+            if(aCount > mStageCapacity - mStageSize) {
+                // The buffer grows with the input, up to the size of the whole array
+                const uint64_t total = static_cast<uint64_t>(mPackedSize) * sizeof(uint64_t);
+                uint64_t capacity = mStageCapacity == 0 ? static_cast<uint64_t>(PACKED_STAGING_ELEMENTS) * sizeof(uint64_t) : static_cast<uint64_t>(mStageCapacity) * 2;
+                while(capacity < static_cast<uint64_t>(mStageSize) + aCount) capacity *= 2;
+                if(capacity > total) capacity = total;
+                uint8_t* const stage = static_cast<uint8_t*>(mAllocator.allocate(static_cast<uint32_t>(capacity)));
+                if(stage == nullptr) return fail();
+                if(mStage) {
+                    std::memcpy(stage, mStage, mStageSize);
+                    mAllocator.deallocate(mStage);
+                }
+                mStage = stage;
+                mStageCapacity = static_cast<uint32_t>(capacity);
+            }
+            std::memcpy(mStage + mStageSize, aData, aCount);
+            mStageSize += aCount;
+            return true;
+        }
+
+        void endPacked() throw() {
+            if(mPacked == nullptr) {
+                // Every element has arrived, so the count is known to be genuine
+                void* const values = mValue->setPackedArray(mPackedType, mPackedSize);
+                if(values == nullptr) {
+                    releaseStage();
+                    fail();
+                    return;
+                }
+                if(mStageSize > 0) std::memcpy(values, mStage, mStageSize);
+                releaseStage();
+            }
+            if(! isLittleEndian()) {
+                uint64_t* const values = static_cast<uint64_t*>(mValue->getPackedArray());
+                const int32_t size = mValue->size();
+                for(int32_t i = 0; i < size; ++i) values[i] = swapBytes(values[i]);
+            }
+            endValue();
+        }
+
+        bool beginPayload(const uint8_t aTag) throw() {
+            if(aTag > PACKED_DOUBLE_TAG) return fail();
+            mTag = aTag;
+            mValue = &beginValue();
+            switch(aTag) {
+            case GenericValue::NULL_T:
+                endValue();
+                break;
+            case GenericValue::CHAR_T:
+            case GenericValue::BOOL_T:
+                mCount = 0;
+                mRemaining = 1;
+                mState = STATE_FIXED;
+                break;
+            case GenericValue::DOUBLE_T:
+                mCount = 0;
+                mRemaining = sizeof(double);
+                mState = STATE_FIXED;
+                break;
+            case GenericValue::UNSIGNED_T:
+            case GenericValue::SIGNED_T:
+                beginVarint(STATE_VARINT);
+                break;
+            default:
+                beginVarint(STATE_SIZE);
+                break;
+            }
+            return true;
+        }
+
+        bool endFixed() throw() {
+            switch(mTag) {
+            case GenericValue::CHAR_T:
+                mValue->setChar(mBytes[0]);
+                break;
+            case GenericValue::BOOL_T:
+                mValue->setBool(mBytes[0] != 0);
+                break;
+            default:
+                {
+                    uint64_t bits = 0;
+                    for(uint32_t i = 0; i < sizeof(uint64_t); ++i) {
+                        bits |= static_cast<uint64_t>(static_cast<uint8_t>(mBytes[i])) << (i * 8);
+                    }
+                    std::memcpy(&mValue->setDouble(0.0), &bits, sizeof(double));
+                }
+                break;
+            }
+            endValue();
+            return true;
+        }
+
+        bool endSize() throw() {
+            if(mVarint > INT32_MAX) return fail();
+            const uint32_t size = static_cast<uint32_t>(mVarint);
+            switch(mTag) {
+            case GenericValue::STRING_T:
+                // Short strings are collected and stored inline
+                mString = size > GenericValue::INLINE_CAPACITY ? &mValue->setString() : nullptr;
+                mCount = 0;
+                mRemaining = size;
+                mState = STATE_STRING;
+                if(size == 0) endString();
+                return true;
+            case GenericValue::ARRAY_T:
+                mValue->setArray();
+                return push(size, false);
+            case GenericValue::OBJECT_T:
+                mValue->setObject();
+                return push(size, true);
+            default:
+                // The count is untrusted, so large arrays are only allocated once all of their elements have arrived
+                if(size > GenericValue::MAX_PACKED_SIZE) return fail();
+                mPackedType = static_cast<GenericValue::ValueType>(mTag - PACKED_TAG_OFFSET);
+                mPackedSize = size;
+                mPacked = nullptr;
+                if(size <= PACKED_STAGING_ELEMENTS) {
+                    mPacked = static_cast<uint8_t*>(mValue->setPackedArray(mPackedType, size));
+                    if(mPacked == nullptr) return fail();
+                }
+                mRemaining = static_cast<uint64_t>(size) * sizeof(uint64_t);
+                mState = STATE_PACKED;
+                if(size == 0) endPacked();
+                return true;
+            }
+        }
+
+        bool endNameId() throw() {
+            if(mVarint == Schema::NO_ID) {
+                // Names that are not in the schema follow as characters
+                beginVarint(STATE_NAME_LENGTH);
+                return true;
+            }
+            const CString* const name = mVarint <= UINT32_MAX ? mSchema->getName(static_cast<uint32_t>(mVarint)) : nullptr;
+            if(name) {
+                mName = *name;
+            }else {
+                mDiscardMember = true;
+            }
+            mState = STATE_TAG;
+            return true;
+        }
+
+        uint32_t consume(const uint8_t* const aData, const uint32_t aSize) throw() {
+            // Returns the number of bytes consumed in the current state
+            const uint32_t count = mRemaining < aSize ? static_cast<uint32_t>(mRemaining) : aSize;
+            switch(mState) {
+            case STATE_TAG:
+                beginPayload(aData[0]);
+                return 1;
+            case STATE_NAME_ID:
+                if(addVarintByte(aData[0])) endNameId();
+                return 1;
+            case STATE_NAME_LENGTH:
+                if(addVarintByte(aData[0])) {
+                    if(mVarint > INT32_MAX) {
+                        fail();
+                    }else {
+                        mRemaining = mVarint;
+                        mState = mRemaining == 0 ? STATE_TAG : STATE_NAME;
+                    }
+                }
+                return 1;
+            case STATE_NAME:
+                for(uint32_t i = 0; i < count; ++i) mName.pushBack(static_cast<char>(aData[i]));
+                mRemaining -= count;
+                if(mRemaining == 0) mState = STATE_TAG;
+                return count;
+            case STATE_SIZE:
+                if(addVarintByte(aData[0])) endSize();
+                return 1;
+            case STATE_VARINT:
+                if(addVarintByte(aData[0])) {
+                    if(mTag == GenericValue::UNSIGNED_T) {
+                        mValue->setUnsigned(mVarint);
+                    }else {
+                        mValue->setSigned(static_cast<int64_t>(mVarint >> 1) ^ -static_cast<int64_t>(mVarint & 1));
+                    }
+                    endValue();
+                }
+                return 1;
+            case STATE_FIXED:
+                mBytes[mCount++] = static_cast<char>(aData[0]);
+                if(mCount == mRemaining) endFixed();
+                return 1;
+            case STATE_STRING:
+                if(mString) {
+                    for(uint32_t i = 0; i < count; ++i) mString->pushBack(static_cast<char>(aData[i]));
+                }else {
+                    std::memcpy(mBytes + mCount, aData, count);
+                    mCount += count;
+                }
+                mRemaining -= count;
+                if(mRemaining == 0) endString();
+                return count;
+            case STATE_PACKED:
+                if(mPacked) {
+                    std::memcpy(mPacked, aData, count);
+                    mPacked += count;
+                }else if(! stagePacked(aData, count)) {
+                    return 0;
+                }
+                mRemaining -= count;
+                if(mRemaining == 0) endPacked();
+                return count;
+            default:
+                return 0;
+            }
+        }
+    public:
+        BinaryParser(Allocator& aAllocator, const Schema* const aSchema) throw() :
+            mAllocator(aAllocator),
+            mSchema(aSchema),
+            mName(aAllocator),
+            mValue(nullptr),
+            mString(nullptr),
+            mPacked(nullptr),
+            mStage(nullptr),
+            mStageSize(0),
+            mStageCapacity(0),
+            mPackedSize(0),
+            mPackedType(GenericValue::NULL_T),
+            mVarint(0),
+            mRemaining(0),
+            mShift(0),
+            mCount(0),
+            mDepth(0),
+            mTag(GenericValue::NULL_T),
+            mState(STATE_TAG),
+            mDiscardMember(false)
+        {}
+
+        SOLAIRE_EXPORT_CALL ~BinaryParser() throw() {
+            releaseStage();
+        }
+
+        // Inherited from Parser
+
+        uint32_t SOLAIRE_EXPORT_CALL parse(const void* const aData, const uint32_t aSize) throw() override {
+            const uint8_t* const bytes = static_cast<const uint8_t*>(aData);
+            uint32_t i = 0;
+            while(i < aSize && mState < STATE_DONE) {
+                i += consume(bytes + i, aSize - i);
+            }
+            return i;
+        }
+
+        bool SOLAIRE_EXPORT_CALL finish() throw() override {
+            return mState == STATE_DONE || (mState == STATE_TAG && mDepth == 0) || fail();
+        }
+
+        bool SOLAIRE_EXPORT_CALL hasValue() const throw() override {
+            return mState == STATE_DONE;
+        }
+
+        bool SOLAIRE_EXPORT_CALL hasFailed() const throw() override {
+            return mState == STATE_FAILED;
+        }
+
+        bool SOLAIRE_EXPORT_CALL takeValue(GenericValue& aValue) throw() override {
+            if(mState != STATE_DONE) return false;
+            aValue = std::move(mRoot);
+            mRoot.setNull();
+            mDiscard.setNull();
+            mState = STATE_TAG;
+            return true;
+        }
+
+        void SOLAIRE_EXPORT_CALL reset() throw() override {
+            releaseStage();
+            mRoot.setNull();
+            mDiscard.setNull();
+            mDepth = 0;
+            mState = STATE_TAG;
+        }
+    };
+
+	// BinaryFormat
+
+    BinaryFormat::BinaryFormat(const bool aBorrowStrings) throw() :
+        mSchema(nullptr),
+        mBorrowStrings(aBorrowStrings)
+    {}
+
+    BinaryFormat::BinaryFormat(const Schema* const aSchema, const bool aBorrowStrings) throw() :
+        mSchema(aSchema),
+        mBorrowStrings(aBorrowStrings)
+    {}
+
+    GenericValue SOLAIRE_EXPORT_CALL BinaryFormat::readValue(IStream& aStream) const throw() {
+        SOLAIRE_STATS_SCOPE(aStream);
+        BinaryReader reader(aStream, mBorrowStrings, mSchema);
+        GenericValue value;
+        if(! reader.readValue(value)) value.setNull();
+        return value;
+    }
+
+    bool SOLAIRE_EXPORT_CALL BinaryFormat::writeValue(const GenericValue& aValue, OStream& aStream) const throw() {
+        SOLAIRE_STATS_SCOPE(aStream);
+        BinaryWriter writer(aStream, mSchema);
+        return writer.writeValue(aValue) && writer.flush();
+    }
+
+    Reader* SOLAIRE_EXPORT_CALL BinaryFormat::createReader(Allocator& aAllocator, IStream& aStream) const throw() {
+        void* const memory = aAllocator.allocate(sizeof(BinaryReader));
+        return memory == nullptr ? nullptr : new(memory) BinaryReader(aStream, mBorrowStrings, mSchema);
+    }
+
+    Writer* SOLAIRE_EXPORT_CALL BinaryFormat::createWriter(Allocator& aAllocator, OStream& aStream) const throw() {
+        void* const memory = aAllocator.allocate(sizeof(BinaryWriter));
+        return memory == nullptr ? nullptr : new(memory) BinaryWriter(aStream, mSchema);
+    }
+
+    Parser* SOLAIRE_EXPORT_CALL BinaryFormat::createParser(Allocator& aAllocator) const throw() {
+        void* const memory = aAllocator.allocate(sizeof(BinaryParser));
+        return memory == nullptr ? nullptr : new(memory) BinaryParser(aAllocator, mSchema);
+    }
+}
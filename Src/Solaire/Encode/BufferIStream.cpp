@@ -0,0 +1,71 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+#include <cstring>
+#include "Solaire/Encode/BufferIStream.hpp"
+
+namespace Solaire {
+
+	// BufferIStream
+
+    BufferIStream::BufferIStream(const void* const aData, const uint32_t aSize) throw() :
+        mData(static_cast<const uint8_t*>(aData)),
+        mSize(aSize),
+        mOffset(0)
+    {}
+
+    SOLAIRE_EXPORT_CALL BufferIStream::~BufferIStream() throw() {
+
+    }
+
+    const void* BufferIStream::borrow(const uint32_t aBytes) throw() {
+        if(aBytes > mSize - mOffset) return nullptr;
+        const uint8_t* const bytes = mData + mOffset;
+        mOffset += aBytes;
+        return bytes;
+    }
+
+    // Inherited from IStream
+
+    uint32_t SOLAIRE_EXPORT_CALL BufferIStream::read(void* const aBuffer, const uint32_t aBytes) throw() {
+        const uint32_t remaining = mSize - mOffset;
+        const uint32_t count = aBytes < remaining ? aBytes : remaining;
+        if(count == 0) return 0;
+        std::memcpy(aBuffer, mData + mOffset, count);
+        mOffset += count;
+        return count;
+    }
+
+    bool SOLAIRE_EXPORT_CALL BufferIStream::end() const throw() {
+        return mOffset >= mSize;
+    }
+
+    bool SOLAIRE_EXPORT_CALL BufferIStream::isOffsetable() const throw() {
+        return true;
+    }
+
+    int32_t SOLAIRE_EXPORT_CALL BufferIStream::getOffset() const throw() {
+        return static_cast<int32_t>(mOffset);
+    }
+
+    bool SOLAIRE_EXPORT_CALL BufferIStream::setOffset(const int32_t aOffset) throw() {
+        if(aOffset < 0 || static_cast<uint32_t>(aOffset) > mSize) return false;
+        mOffset = static_cast<uint32_t>(aOffset);
+        return true;
+    }
+}
@@ -0,0 +1,88 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+#include <cstring>
+#include "Solaire/Encode/BufferOStream.hpp"
+
+namespace Solaire {
+
+	// BufferOStream
+
+    BufferOStream::BufferOStream(Allocator& aAllocator) throw() :
+        mAllocator(aAllocator),
+        mData(nullptr),
+        mSize(0),
+        mCapacity(0),
+        mOffset(0)
+    {}
+
+    SOLAIRE_EXPORT_CALL BufferOStream::~BufferOStream() throw() {
+        if(mData) mAllocator.deallocate(mData);
+    }
+
+    bool BufferOStream::reserve(const uint32_t aBytes) throw() {
+        if(aBytes <= mCapacity) return true;
+        uint32_t capacity = mCapacity < MIN_CAPACITY ? static_cast<uint32_t>(MIN_CAPACITY) : mCapacity;
+        while(capacity < aBytes) {
+            if(capacity > UINT32_MAX / 2) {
+                capacity = aBytes;
+                break;
+            }
+            capacity *= 2;
+        }
+        uint8_t* const data = static_cast<uint8_t*>(mAllocator.allocate(capacity));
+        if(data == nullptr) return false;
+        if(mData) {
+            std::memcpy(data, mData, mSize);
+            mAllocator.deallocate(mData);
+        }
+        mData = data;
+        mCapacity = capacity;
+        return true;
+    }
+
+    void BufferOStream::clear() throw() {
+        mSize = 0;
+        mOffset = 0;
+    }
+
+    // Inherited from OStream
+
+    uint32_t SOLAIRE_EXPORT_CALL BufferOStream::write(const void* const aData, const uint32_t aBytes) throw() {
+        if(aBytes == 0) return 0;
+        if(aBytes > UINT32_MAX - mOffset || ! reserve(mOffset + aBytes)) return 0;
+        std::memcpy(mData + mOffset, aData, aBytes);
+        mOffset += aBytes;
+        if(mOffset > mSize) mSize = mOffset;
+        return aBytes;
+    }
+
+    bool SOLAIRE_EXPORT_CALL BufferOStream::isOffsetable() const throw() {
+        return true;
+    }
+
+    int32_t SOLAIRE_EXPORT_CALL BufferOStream::getOffset() const throw() {
+        return static_cast<int32_t>(mOffset);
+    }
+
+    bool SOLAIRE_EXPORT_CALL BufferOStream::setOffset(const int32_t aOffset) throw() {
+        if(aOffset < 0 || static_cast<uint32_t>(aOffset) > mSize) return false;
+        mOffset = static_cast<uint32_t>(aOffset);
+        return true;
+    }
+}
@@ -0,0 +1,824 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+#include <atomic>
+#include <cstring>
+#include "Solaire/Encode/CompressedFormat.hpp"
+#include "Solaire/Encode/EncodeStats.hpp"
+#include "Solaire/Encode/Reader.hpp"
+#include "Solaire/Encode/Writer.hpp"
+
+namespace Solaire {
+
+    enum : uint32_t {
+        HEADER_BYTES = 12,
+        TERMINATOR_BYTES = 4,
+        STORED_FLAG = 0x80000000U,
+        MIN_MATCH = 4,
+        LAST_LITERALS = 5,
+        MAX_OFFSET = 65535,
+        HASH_BITS = 12,
+        SKIP_SHIFT = 6,
+        RUN_MASK = 15
+    };
+
+    enum : uint32_t {
+        PRIME_1 = 2654435761U,
+        PRIME_2 = 2246822519U,
+        PRIME_3 = 3266489917U,
+        PRIME_4 = 668265263U,
+        PRIME_5 = 374761393U
+    };
+
+    static SOLAIRE_FORCE_INLINE uint32_t readNative32(const uint8_t* const aBytes) throw() {
+        uint32_t value;
+        std::memcpy(&value, aBytes, sizeof(uint32_t));
+        return value;
+    }
+
+    static SOLAIRE_FORCE_INLINE uint64_t readNative64(const uint8_t* const aBytes) throw() {
+        uint64_t value;
+        std::memcpy(&value, aBytes, sizeof(uint64_t));
+        return value;
+    }
+
+    static SOLAIRE_FORCE_INLINE uint32_t readLittle32(const uint8_t* const aBytes) throw() {
+        return static_cast<uint32_t>(aBytes[0]) | (static_cast<uint32_t>(aBytes[1]) << 8) |
+            (static_cast<uint32_t>(aBytes[2]) << 16) | (static_cast<uint32_t>(aBytes[3]) << 24);
+    }
+
+    static SOLAIRE_FORCE_INLINE void writeLittle32(uint8_t* const aBytes, const uint32_t aValue) throw() {
+        for(uint32_t i = 0; i < 4; ++i) aBytes[i] = static_cast<uint8_t>(aValue >> (i * 8));
+    }
+
+    static SOLAIRE_FORCE_INLINE uint32_t rotateLeft(const uint32_t aValue, const uint32_t aBits) throw() {
+        return (aValue << aBits) | (aValue >> (32 - aBits));
+    }
+
+    static SOLAIRE_FORCE_INLINE uint32_t checksumRound(uint32_t aAccumulator, const uint32_t aInput) throw() {
+        aAccumulator += aInput * PRIME_2;
+        return rotateLeft(aAccumulator, 13) * PRIME_1;
+    }
+
+    static uint32_t checksum(const uint8_t* aBytes, const uint32_t aCount) throw() {
+        // xxHash32 with a seed of 0
+        const uint8_t* const end = aBytes + aCount;
+        uint32_t hash;
+        if(aCount >= 16) {
+            uint32_t v1 = PRIME_1 + PRIME_2;
+            uint32_t v2 = PRIME_2;
+            uint32_t v3 = 0;
+            uint32_t v4 = 0U - PRIME_1;
+            const uint8_t* const limit = end - 16;
+            do {
+                v1 = checksumRound(v1, readLittle32(aBytes));
+                v2 = checksumRound(v2, readLittle32(aBytes + 4));
+                v3 = checksumRound(v3, readLittle32(aBytes + 8));
+                v4 = checksumRound(v4, readLittle32(aBytes + 12));
+                aBytes += 16;
+            }while(aBytes <= limit);
+            hash = rotateLeft(v1, 1) + rotateLeft(v2, 7) + rotateLeft(v3, 12) + rotateLeft(v4, 18);
+        }else {
+            hash = PRIME_5;
+        }
+        hash += aCount;
+        while(aBytes + 4 <= end) {
+            hash += readLittle32(aBytes) * PRIME_3;
+            hash = rotateLeft(hash, 17) * PRIME_4;
+            aBytes += 4;
+        }
+        while(aBytes < end) {
+            hash += *aBytes * PRIME_5;
+            hash = rotateLeft(hash, 11) * PRIME_1;
+            ++aBytes;
+        }
+        hash ^= hash >> 15;
+        hash *= PRIME_2;
+        hash ^= hash >> 13;
+        hash *= PRIME_3;
+        hash ^= hash >> 16;
+        return hash;
+    }
+
+    static SOLAIRE_FORCE_INLINE uint32_t getCompressBound(const uint32_t aBytes) throw() {
+        return aBytes + aBytes / 255 + 16;
+    }
+
+    static SOLAIRE_FORCE_INLINE uint32_t hashSequence(const uint32_t aSequence) throw() {
+        return (aSequence * PRIME_1) >> (32 - HASH_BITS);
+    }
+
+    static SOLAIRE_FORCE_INLINE uint8_t* writeLength(uint8_t* aOutput, uint32_t aLength) throw() {
+        while(aLength >= 255) {
+            *aOutput++ = 255;
+            aLength -= 255;
+        }
+        *aOutput++ = static_cast<uint8_t>(aLength);
+        return aOutput;
+    }
+
+    static uint8_t* writeLiterals(uint8_t* aOutput, const uint8_t* const aLiterals, const uint32_t aCount) throw() {
+        *aOutput = static_cast<uint8_t>((aCount < RUN_MASK ? aCount : static_cast<uint32_t>(RUN_MASK)) << 4);
+        ++aOutput;
+        if(aCount >= RUN_MASK) aOutput = writeLength(aOutput, aCount - RUN_MASK);
+        std::memcpy(aOutput, aLiterals, aCount);
+        return aOutput + aCount;
+    }
+
+    static uint32_t compressBlock(const uint8_t* const aSource, const uint32_t aCount, uint8_t* const aTarget, uint32_t* const aTable) throw() {
+        // Each sequence is a token, literals, a 2 byte offset and a match length, the last sequence has no match
+        const uint8_t* const end = aSource + aCount;
+        const uint8_t* anchor = aSource;
+        uint8_t* output = aTarget;
+        if(aCount > MIN_MATCH + LAST_LITERALS) {
+            std::memset(aTable, 0, sizeof(uint32_t) << HASH_BITS);
+            const uint8_t* const limit = end - LAST_LITERALS;
+            const uint8_t* input = aSource + 1;
+            while(input + MIN_MATCH <= limit) {
+                const uint32_t sequence = readNative32(input);
+                uint32_t& slot = aTable[hashSequence(sequence)];
+                const uint8_t* match = aSource + slot;
+                slot = static_cast<uint32_t>(input - aSource);
+                if(input - match > MAX_OFFSET || readNative32(match) != sequence) {
+                    // Step further the longer nothing has matched, so incompressible data is passed over quickly
+                    input += 1 + ((input - anchor) >> SKIP_SHIFT);
+                    continue;
+                }
+
+                uint32_t length = MIN_MATCH;
+                while(input + length + 8 <= limit && readNative64(input + length) == readNative64(match + length)) length += 8;
+                while(input + length < limit && input[length] == match[length]) ++length;
+                while(input > anchor && match > aSource && input[-1] == match[-1]) {
+                    --input;
+                    --match;
+                    ++length;
+                }
+
+                uint8_t* const token = output;
+                output = writeLiterals(output, anchor, static_cast<uint32_t>(input - anchor));
+                const uint32_t offset = static_cast<uint32_t>(input - match);
+                *output++ = static_cast<uint8_t>(offset);
+                *output++ = static_cast<uint8_t>(offset >> 8);
+                const uint32_t extra = length - MIN_MATCH;
+                *token |= static_cast<uint8_t>(extra < RUN_MASK ? extra : static_cast<uint32_t>(RUN_MASK));
+                if(extra >= RUN_MASK) output = writeLength(output, extra - RUN_MASK);
+
+                input += length;
+                anchor = input;
+                if(input + MIN_MATCH <= limit) aTable[hashSequence(readNative32(input - 2))] = static_cast<uint32_t>(input - 2 - aSource);
+            }
+        }
+        output = writeLiterals(output, anchor, static_cast<uint32_t>(end - anchor));
+        return static_cast<uint32_t>(output - aTarget);
+    }
+
+    static SOLAIRE_FORCE_INLINE bool readLength(const uint8_t*& aInput, const uint8_t* const aEnd, uint32_t& aLength, const uint32_t aMax) throw() {
+        uint8_t byte;
+        do {
+            if(aInput == aEnd || aLength > aMax) return false;
+            byte = *aInput++;
+            aLength += byte;
+        }while(byte == 255);
+        return true;
+    }
+
+    static bool decompressBlock(const uint8_t* aInput, const uint32_t aCount, uint8_t* const aTarget, const uint32_t aBytes) throw() {
+        // Every length and offset is checked, so corrupt blocks fail instead of reading or writing out of bounds
+        const uint8_t* const inputEnd = aInput + aCount;
+        uint8_t* output = aTarget;
+        uint8_t* const outputEnd = aTarget + aBytes;
+        while(aInput < inputEnd) {
+            const uint32_t token = *aInput++;
+            uint32_t literals = token >> 4;
+            if(literals == RUN_MASK && ! readLength(aInput, inputEnd, literals, aBytes)) return false;
+            if(literals > static_cast<uint32_t>(inputEnd - aInput) || literals > static_cast<uint32_t>(outputEnd - output)) return false;
+            std::memcpy(output, aInput, literals);
+            output += literals;
+            aInput += literals;
+            if(aInput == inputEnd) break;
+
+            if(inputEnd - aInput < 2) return false;
+            const uint32_t offset = static_cast<uint32_t>(aInput[0]) | (static_cast<uint32_t>(aInput[1]) << 8);
+            aInput += 2;
+            if(offset == 0 || offset > static_cast<uint32_t>(output - aTarget)) return false;
+            uint32_t length = token & RUN_MASK;
+            if(length == RUN_MASK && ! readLength(aInput, inputEnd, length, aBytes)) return false;
+            length += MIN_MATCH;
+            if(length > static_cast<uint32_t>(outputEnd - output)) return false;
+
+            const uint8_t* const match = output - offset;
+            if(offset >= length) {
+                std::memcpy(output, match, length);
+            }else {
+                // Overlapping matches repeat the last offset bytes
+                for(uint32_t i = 0; i < length; ++i) output[i] = match[i];
+            }
+            output += length;
+        }
+        return output == outputEnd;
+    }
+
+    static bool readBytes(IStream& aStream, void* const aBuffer, const uint32_t aBytes) throw() {
+        uint8_t* const buffer = static_cast<uint8_t*>(aBuffer);
+        uint32_t count = 0;
+        while(count < aBytes) {
+            const uint32_t read = aStream.read(buffer + count, aBytes - count);
+            if(read == 0) return false;
+            count += read;
+        }
+        return true;
+    }
+
+    static bool checkHeader(const uint8_t* const aHeader, uint32_t& aBytes, uint32_t& aStored) throw() {
+        aBytes = readLittle32(aHeader);
+        aStored = readLittle32(aHeader + 4);
+        if(aBytes > CompressedFormat::MAX_BLOCK_SIZE) return false;
+        if(aStored & STORED_FLAG) return (aStored & ~STORED_FLAG) == aBytes;
+        return aStored > 0 && aStored <= getCompressBound(aBytes);
+    }
+
+    // FrameBlock
+
+    struct FrameBlock {
+        uint32_t source;
+        uint32_t stored;
+        uint32_t target;
+        uint32_t bytes;
+        uint32_t checksum;
+    };
+
+    struct FrameTask {
+        const uint8_t* source;
+        uint8_t* target;
+        const FrameBlock* blocks;
+        std::atomic<uint32_t> failures;
+    };
+
+    static void decodeBlockTask(void* const aData, const uint32_t aIndex) throw() {
+        FrameTask& task = *static_cast<FrameTask*>(aData);
+        const FrameBlock& block = task.blocks[aIndex];
+        const uint8_t* const source = task.source + block.source;
+        uint8_t* const target = task.target + block.target;
+        if(block.stored & STORED_FLAG) {
+            std::memcpy(target, source, block.bytes);
+        }else if(! decompressBlock(source, block.stored, target, block.bytes)) {
+            ++task.failures;
+            return;
+        }
+        if(checksum(target, block.bytes) != block.checksum) ++task.failures;
+    }
+
+    static bool readFrame(IStream& aStream, Allocator& aAllocator, WorkerPool* const aPool, uint8_t*& aData, uint32_t& aSize) throw() {
+        aData = nullptr;
+        aSize = 0;
+        ArrayList<FrameBlock> blocks(aAllocator);
+        uint8_t* source = nullptr;
+        uint32_t sourceSize = 0;
+        uint32_t sourceCapacity = 0;
+        uint64_t targetSize = 0;
+        bool result = true;
+
+        // Collect every block first, so the offsets of all of them are known before decompression begins
+        while(result) {
+            uint8_t header[HEADER_BYTES];
+            if(! readBytes(aStream, header, TERMINATOR_BYTES)) {
+                result = false;
+                break;
+            }
+            if(readLittle32(header) == 0) break;
+
+            FrameBlock block;
+            if(! readBytes(aStream, header + TERMINATOR_BYTES, HEADER_BYTES - TERMINATOR_BYTES) || ! checkHeader(header, block.bytes, block.stored)) {
+                result = false;
+                break;
+            }
+            const uint32_t stored = block.stored & ~STORED_FLAG;
+            block.source = sourceSize;
+            block.target = static_cast<uint32_t>(targetSize);
+            block.checksum = readLittle32(header + 8);
+            targetSize += block.bytes;
+            if(targetSize > UINT32_MAX || static_cast<uint64_t>(sourceSize) + stored > UINT32_MAX) {
+                result = false;
+                break;
+            }
+
+            if(sourceSize + stored > sourceCapacity) {
+                const uint64_t doubled = static_cast<uint64_t>(sourceCapacity) * 2;
+                const uint32_t capacity = doubled > sourceSize + stored && doubled <= UINT32_MAX ? static_cast<uint32_t>(doubled) : sourceSize + stored;
+                uint8_t* const buffer = static_cast<uint8_t*>(aAllocator.allocate(capacity));
+                if(buffer == nullptr) {
+                    result = false;
+                    break;
+                }
+                if(source) {
+                    std::memcpy(buffer, source, sourceSize);
+                    aAllocator.deallocate(source);
+                }
+                source = buffer;
+                sourceCapacity = capacity;
+            }
+            if(! readBytes(aStream, source + sourceSize, stored)) {
+                result = false;
+                break;
+            }
+            sourceSize += stored;
+            blocks.pushBack(block);
+        }
+
+        if(result && targetSize > 0) {
+            aData = static_cast<uint8_t*>(aAllocator.allocate(static_cast<uint32_t>(targetSize)));
+            result = aData != nullptr;
+        }
+        if(result && targetSize > 0) {
+            FrameTask task;
+            task.source = source;
+            task.target = aData;
+            task.blocks = &blocks[0];
+            task.failures = 0;
+            const uint32_t count = static_cast<uint32_t>(blocks.size());
+            if(aPool && count > 1) {
+                aPool->run(&decodeBlockTask, &task, count);
+            }else {
+                for(uint32_t i = 0; i < count; ++i) decodeBlockTask(&task, i);
+            }
+            result = task.failures == 0;
+        }
+
+        if(source) aAllocator.deallocate(source);
+        if(result) {
+            aSize = static_cast<uint32_t>(targetSize);
+        }else if(aData) {
+            aAllocator.deallocate(aData);
+            aData = nullptr;
+        }
+        return result;
+    }
+
+    // BlockOStream
+
+    class BlockOStream : public OStream {
+    private:
+        OStream& mStream;
+        Allocator& mAllocator;
+        uint32_t* mTable;
+        uint8_t* mBlock;
+        uint8_t* mCompressed;
+        const uint32_t mBlockSize;
+        uint32_t mSize;
+        uint32_t mOffset;
+        bool mOpen;
+        bool mFailed;
+    private:
+        BlockOStream(const BlockOStream&) = delete;
+        BlockOStream& operator=(const BlockOStream&) = delete;
+
+        bool fail() throw() {
+            mFailed = true;
+            return false;
+        }
+
+        bool writeBlock() throw() {
+            uint8_t header[HEADER_BYTES];
+            const uint32_t compressed = compressBlock(mBlock, mSize, mCompressed, mTable);
+            const bool stored = compressed >= mSize;
+            writeLittle32(header, mSize);
+            writeLittle32(header + 4, stored ? mSize | STORED_FLAG : compressed);
+            writeLittle32(header + 8, checksum(mBlock, mSize));
+            const uint32_t bytes = stored ? mSize : compressed;
+            if(mStream.write(header, HEADER_BYTES) != HEADER_BYTES) return fail();
+            if(mStream.write(stored ? mBlock : mCompressed, bytes) != bytes) return fail();
+            mSize = 0;
+            return true;
+        }
+    public:
+        BlockOStream(Allocator& aAllocator, OStream& aStream, const uint32_t aBlockSize) throw() :
+            mStream(aStream),
+            mAllocator(aAllocator),
+            mTable(static_cast<uint32_t*>(aAllocator.allocate((sizeof(uint32_t) << HASH_BITS) + aBlockSize + getCompressBound(aBlockSize)))),
+            mBlock(mTable ? reinterpret_cast<uint8_t*>(mTable + (1 << HASH_BITS)) : nullptr),
+            mCompressed(mBlock ? mBlock + aBlockSize : nullptr),
+            mBlockSize(aBlockSize),
+            mSize(0),
+            mOffset(0),
+            mOpen(false),
+            mFailed(mTable == nullptr)
+        {}
+
+        SOLAIRE_EXPORT_CALL ~BlockOStream() throw() {
+            if(mTable) mAllocator.deallocate(mTable);
+        }
+
+        bool isOpen() const throw() {
+            return mOpen;
+        }
+
+        bool finish() throw() {
+            if(mFailed) return false;
+            if(mSize > 0 && ! writeBlock()) return false;
+            uint8_t terminator[TERMINATOR_BYTES] = {0, 0, 0, 0};
+            if(mStream.write(terminator, TERMINATOR_BYTES) != TERMINATOR_BYTES) return fail();
+            mOpen = false;
+            return true;
+        }
+
+        // Inherited from OStream
+
+        uint32_t SOLAIRE_EXPORT_CALL write(const void* const aData, const uint32_t aBytes) throw() override {
+            if(mFailed) return 0;
+            const uint8_t* bytes = static_cast<const uint8_t*>(aData);
+            uint32_t remaining = aBytes;
+            while(remaining > 0) {
+                const uint32_t count = remaining < mBlockSize - mSize ? remaining : mBlockSize - mSize;
+                std::memcpy(mBlock + mSize, bytes, count);
+                mSize += count;
+                bytes += count;
+                remaining -= count;
+                mOpen = true;
+                if(mSize == mBlockSize && ! writeBlock()) return aBytes - remaining;
+            }
+            mOffset += aBytes;
+            return aBytes;
+        }
+
+        bool SOLAIRE_EXPORT_CALL isOffsetable() const throw() override {
+            return false;
+        }
+
+        int32_t SOLAIRE_EXPORT_CALL getOffset() const throw() override {
+            return static_cast<int32_t>(mOffset);
+        }
+
+        bool SOLAIRE_EXPORT_CALL setOffset(const int32_t aOffset) throw() override {
+            return false;
+        }
+    };
+
+    // CompressedReader
+
+    class CompressedReader : public Reader {
+    private:
+        Allocator& mAllocator;
+        uint8_t* const mData;
+        BufferIStream mStream;
+        Reader* mReader;
+    private:
+        CompressedReader(const CompressedReader&) = delete;
+        CompressedReader& operator=(const CompressedReader&) = delete;
+    public:
+        CompressedReader(Allocator& aAllocator, const Format& aInner, uint8_t* const aData, const uint32_t aSize) throw() :
+            mAllocator(aAllocator),
+            mData(aData),
+            mStream(aData, aSize),
+            mReader(aInner.createReader(aAllocator, mStream))
+        {}
+
+        SOLAIRE_EXPORT_CALL ~CompressedReader() {
+            if(mReader) {
+                mReader->~Reader();
+                mAllocator.deallocate(mReader);
+            }
+            if(mData) mAllocator.deallocate(mData);
+        }
+
+        bool isValid() const throw() {
+            return mReader != nullptr;
+        }
+
+        // Inherited from Reader
+
+        GenericValue::ValueType SOLAIRE_EXPORT_CALL peekType() throw() override {
+            return mReader->peekType();
+        }
+
+        bool SOLAIRE_EXPORT_CALL hasNext() throw() override {
+            return mReader->hasNext();
+        }
+
+        bool SOLAIRE_EXPORT_CALL hasFailed() const throw() override {
+            return mReader->hasFailed();
+        }
+
+        uint32_t SOLAIRE_EXPORT_CALL getRemainingBytes() const throw() override {
+            return mReader->getRemainingBytes();
+        }
+
+        bool SOLAIRE_EXPORT_CALL beginArray(int32_t& aSize) throw() override {
+            return mReader->beginArray(aSize);
+        }
+
+        bool SOLAIRE_EXPORT_CALL endArray() throw() override {
+            return mReader->endArray();
+        }
+
+        GenericValue::ValueType SOLAIRE_EXPORT_CALL peekPackedType() throw() override {
+            return mReader->peekPackedType();
+        }
+
+        bool SOLAIRE_EXPORT_CALL readUnsignedArray(uint64_t* const aValues, const uint32_t aCount) throw() override {
+            return mReader->readUnsignedArray(aValues, aCount);
+        }
+
+        bool SOLAIRE_EXPORT_CALL readSignedArray(int64_t* const aValues, const uint32_t aCount) throw() override {
+            return mReader->readSignedArray(aValues, aCount);
+        }
+
+        bool SOLAIRE_EXPORT_CALL readDoubleArray(double* const aValues, const uint32_t aCount) throw() override {
+            return mReader->readDoubleArray(aValues, aCount);
+        }
+
+        bool SOLAIRE_EXPORT_CALL beginObject(int32_t& aSize) throw() override {
+            return mReader->beginObject(aSize);
+        }
+
+        bool SOLAIRE_EXPORT_CALL endObject() throw() override {
+            return mReader->endObject();
+        }
+
+        bool SOLAIRE_EXPORT_CALL readName(String<char>& aName) throw() override {
+            return mReader->readName(aName);
+        }
+
+        bool SOLAIRE_EXPORT_CALL readName(char* const aName, const uint32_t aCapacity, uint32_t& aLength) throw() override {
+            return mReader->readName(aName, aCapacity, aLength);
+        }
+
+        bool SOLAIRE_EXPORT_CALL readNull() throw() override {
+            return mReader->readNull();
+        }
+
+        bool SOLAIRE_EXPORT_CALL readChar(char& aValue) throw() override {
+            return mReader->readChar(aValue);
+        }
+
+        bool SOLAIRE_EXPORT_CALL readBool(bool& aValue) throw() override {
+            return mReader->readBool(aValue);
+        }
+
+        bool SOLAIRE_EXPORT_CALL readUnsigned(uint64_t& aValue) throw() override {
+            return mReader->readUnsigned(aValue);
+        }
+
+        bool SOLAIRE_EXPORT_CALL readSigned(int64_t& aValue) throw() override {
+            return mReader->readSigned(aValue);
+        }
+
+        bool SOLAIRE_EXPORT_CALL readDouble(double& aValue) throw() override {
+            return mReader->readDouble(aValue);
+        }
+
+        bool SOLAIRE_EXPORT_CALL readString(String<char>& aValue) throw() override {
+            return mReader->readString(aValue);
+        }
+
+        const char* SOLAIRE_EXPORT_CALL borrowString(uint32_t& aLength) throw() override {
+            return mReader->borrowString(aLength);
+        }
+
+        bool SOLAIRE_EXPORT_CALL skip() throw() override {
+            return mReader->skip();
+        }
+    };
+
+    // CompressedWriter
+
+    class CompressedWriter : public Writer {
+    private:
+        Allocator& mAllocator;
+        BlockOStream mStream;
+        Writer* mWriter;
+    private:
+        CompressedWriter(const CompressedWriter&) = delete;
+        CompressedWriter& operator=(const CompressedWriter&) = delete;
+    public:
+        CompressedWriter(Allocator& aAllocator, const Format& aInner, OStream& aStream, const uint32_t aBlockSize) throw() :
+            mAllocator(aAllocator),
+            mStream(aAllocator, aStream, aBlockSize),
+            mWriter(aInner.createWriter(aAllocator, mStream))
+        {}
+
+        SOLAIRE_EXPORT_CALL ~CompressedWriter() {
+            if(mWriter) {
+                // The inner writer flushes as it is destroyed, so the frame is closed afterwards
+                mWriter->~Writer();
+                mAllocator.deallocate(mWriter);
+                if(mStream.isOpen()) mStream.finish();
+            }
+        }
+
+        bool isValid() const throw() {
+            return mWriter != nullptr;
+        }
+
+        // Inherited from Writer
+
+        bool SOLAIRE_EXPORT_CALL beginArray(const int32_t aSize) throw() override {
+            return mWriter->beginArray(aSize);
+        }
+
+        bool SOLAIRE_EXPORT_CALL endArray() throw() override {
+            return mWriter->endArray();
+        }
+
+        bool SOLAIRE_EXPORT_CALL beginPackedArray(const GenericValue::ValueType aType, const int32_t aSize) throw() override {
+            return mWriter->beginPackedArray(aType, aSize);
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeUnsignedArray(const uint64_t* const aValues, const uint32_t aCount) throw() override {
+            return mWriter->writeUnsignedArray(aValues, aCount);
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeSignedArray(const int64_t* const aValues, const uint32_t aCount) throw() override {
+            return mWriter->writeSignedArray(aValues, aCount);
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeDoubleArray(const double* const aValues, const uint32_t aCount) throw() override {
+            return mWriter->writeDoubleArray(aValues, aCount);
+        }
+
+        bool SOLAIRE_EXPORT_CALL beginObject(const int32_t aSize) throw() override {
+            return mWriter->beginObject(aSize);
+        }
+
+        bool SOLAIRE_EXPORT_CALL endObject() throw() override {
+            return mWriter->endObject();
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeName(const StringConstant<char>& aName) throw() override {
+            return mWriter->writeName(aName);
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeName(const char* const aName, const uint32_t aLength) throw() override {
+            return mWriter->writeName(aName, aLength);
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeNull() throw() override {
+            return mWriter->writeNull();
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeChar(const char aValue) throw() override {
+            return mWriter->writeChar(aValue);
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeBool(const bool aValue) throw() override {
+            return mWriter->writeBool(aValue);
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeUnsigned(const uint64_t aValue) throw() override {
+            return mWriter->writeUnsigned(aValue);
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeSigned(const int64_t aValue) throw() override {
+            return mWriter->writeSigned(aValue);
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeDouble(const double aValue) throw() override {
+            return mWriter->writeDouble(aValue);
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeString(const StringConstant<char>& aValue) throw() override {
+            return mWriter->writeString(aValue);
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeString(const char* const aValue, const uint32_t aLength) throw() override {
+            return mWriter->writeString(aValue, aLength);
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeFragment(const void* const aBytes, const uint32_t aLength) throw() override {
+            // Fragments are frames written by another CompressedWriter, the inner Writer joins their contents
+            if(aLength == 0) return mWriter->writeFragment(aBytes, aLength);
+            BufferIStream stream(aBytes, aLength);
+            uint8_t* data;
+            uint32_t size;
+            if(! readFrame(stream, mAllocator, nullptr, data, size)) return false;
+            const bool result = stream.end() && mWriter->writeFragment(data, size);
+            if(data) mAllocator.deallocate(data);
+            return result;
+        }
+
+        bool SOLAIRE_EXPORT_CALL flush() throw() override {
+            // Each flush closes the frame, so everything written since the last flush is one document
+            return mWriter->flush() && mStream.finish();
+        }
+    };
+
+	// CompressedFormat
+
+    CompressedFormat::CompressedFormat(const Format& aInner, const uint32_t aBlockSize, WorkerPool* const aPool) throw() :
+        mInner(aInner),
+        mPool(aPool),
+        mBlockSize(aBlockSize == 0 ? 1 : aBlockSize > MAX_BLOCK_SIZE ? static_cast<uint32_t>(MAX_BLOCK_SIZE) : aBlockSize),
+        mInnerHasReader(false)
+    {
+        // Frames are consumed before the inner Reader is created, so support for Readers is checked up front
+        Allocator& allocator = getDefaultAllocator();
+        BufferIStream empty(nullptr, 0);
+        Reader* const reader = aInner.createReader(allocator, empty);
+        if(reader) {
+            mInnerHasReader = true;
+            reader->~Reader();
+            allocator.deallocate(reader);
+        }
+    }
+
+    const Format& CompressedFormat::getInner() const throw() {
+        return mInner;
+    }
+
+    GenericValue SOLAIRE_EXPORT_CALL CompressedFormat::readValue(IStream& aStream) const throw() {
+        SOLAIRE_STATS_SCOPE(aStream);
+        Allocator& allocator = getDefaultAllocator();
+        uint8_t* data;
+        uint32_t size;
+        if(! readFrame(aStream, allocator, mPool, data, size)) return GenericValue();
+        BufferIStream stream(data, size);
+        GenericValue value = mInner.readValue(stream);
+        if(data) allocator.deallocate(data);
+        return value;
+    }
+
+    bool SOLAIRE_EXPORT_CALL CompressedFormat::tryReadValue(IStream& aStream, GenericValue& aValue) const throw() {
+        SOLAIRE_STATS_SCOPE(aStream);
+        Allocator& allocator = getDefaultAllocator();
+        uint8_t* data;
+        uint32_t size;
+        if(! readFrame(aStream, allocator, mPool, data, size)) {
+            aValue.setNull();
+            return false;
+        }
+        BufferIStream stream(data, size);
+        const bool result = mInner.tryReadValue(stream, aValue);
+        if(data) allocator.deallocate(data);
+        return result;
+    }
+
+    bool SOLAIRE_EXPORT_CALL CompressedFormat::writeValue(const GenericValue& aValue, OStream& aStream) const throw() {
+        SOLAIRE_STATS_SCOPE(aStream);
+        BlockOStream stream(getDefaultAllocator(), aStream, mBlockSize);
+        return mInner.writeValue(aValue, stream) && stream.finish();
+    }
+
+    Reader* SOLAIRE_EXPORT_CALL CompressedFormat::createReader(Allocator& aAllocator, IStream& aStream) const throw() {
+        if(! mInnerHasReader) return nullptr;
+        void* const memory = aAllocator.allocate(sizeof(CompressedReader));
+        if(memory == nullptr) return nullptr;
+
+        // A frame that cannot be decoded leaves the inner Reader with no input, so it fails on the first call
+        uint8_t* data;
+        uint32_t size;
+        if(! readFrame(aStream, aAllocator, mPool, data, size)) size = 0;
+        CompressedReader* const reader = new(memory) CompressedReader(aAllocator, mInner, data, size);
+        if(reader->isValid()) return reader;
+        reader->~CompressedReader();
+        aAllocator.deallocate(memory);
+        return nullptr;
+    }
+
+    Writer* SOLAIRE_EXPORT_CALL CompressedFormat::createWriter(Allocator& aAllocator, OStream& aStream) const throw() {
+        void* const memory = aAllocator.allocate(sizeof(CompressedWriter));
+        if(memory == nullptr) return nullptr;
+        CompressedWriter* const writer = new(memory) CompressedWriter(aAllocator, mInner, aStream, mBlockSize);
+        if(writer->isValid()) return writer;
+        writer->~CompressedWriter();
+        aAllocator.deallocate(memory);
+        return nullptr;
+    }
+
+    bool SOLAIRE_EXPORT_CALL CompressedFormat::findDocuments(const void* const aData, const uint32_t aSize, List<uint32_t>& aEnds) const throw() {
+        // Every frame is one document, so boundaries are found from the block headers without decompressing
+        const uint8_t* const data = static_cast<const uint8_t*>(aData);
+        uint32_t offset = 0;
+        while(offset < aSize) {
+            while(true) {
+                if(aSize - offset < TERMINATOR_BYTES) return false;
+                if(readLittle32(data + offset) == 0) {
+                    offset += TERMINATOR_BYTES;
+                    break;
+                }
+                uint32_t bytes;
+                uint32_t stored;
+                if(aSize - offset < HEADER_BYTES || ! checkHeader(data + offset, bytes, stored)) return false;
+                offset += HEADER_BYTES;
+                stored &= ~STORED_FLAG;
+                if(aSize - offset < stored) return false;
+                offset += stored;
+            }
+            aEnds.pushBack(offset);
+        }
+        return true;
+    }
+}
@@ -0,0 +1,144 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+#include <cstring>
+#include "Solaire/Encode/EncodeStats.hpp"
+
+#if defined(SOLAIRE_ENCODE_STATS)
+    #include <atomic>
+    #include "Solaire/Core/IStream.hpp"
+    #include "Solaire/Core/OStream.hpp"
+#endif
+
+namespace Solaire {
+
+#if defined(SOLAIRE_ENCODE_STATS)
+    typedef std::atomic<uint64_t> Counter;
+
+    static Counter gNodeAllocations[EncodeStats::NODE_KIND_COUNT];
+    static Counter gNodeBytes[EncodeStats::NODE_KIND_COUNT];
+    static Counter gDeepCopies(0);
+    static Counter gSharedCopies(0);
+    static Counter gMoves(0);
+    static Counter gCalls[EncodeStats::OPERATION_COUNT];
+    static Counter gBytes[EncodeStats::OPERATION_COUNT];
+    static Counter gNanoseconds[EncodeStats::OPERATION_COUNT];
+
+    // The number of readValue and writeValue calls that the current thread is inside of
+    static thread_local uint32_t gDepth = 0;
+
+    static SOLAIRE_FORCE_INLINE void increment(Counter& aCounter, const uint64_t aValue) throw() {
+        aCounter.fetch_add(aValue, std::memory_order_relaxed);
+    }
+
+    static void loadCounters(const Counter* const aCounters, uint64_t* const aValues, const uint32_t aCount) throw() {
+        for(uint32_t i = 0; i < aCount; ++i) aValues[i] = aCounters[i].load(std::memory_order_relaxed);
+    }
+
+    static void clearCounters(Counter* const aCounters, const uint32_t aCount) throw() {
+        for(uint32_t i = 0; i < aCount; ++i) aCounters[i].store(0, std::memory_order_relaxed);
+    }
+#endif
+
+	// EncodeStats
+
+    bool SOLAIRE_EXPORT_CALL EncodeStats::capture(EncodeStats& aStats) throw() {
+#if defined(SOLAIRE_ENCODE_STATS)
+        loadCounters(gNodeAllocations, aStats.nodeAllocations, NODE_KIND_COUNT);
+        loadCounters(gNodeBytes, aStats.nodeBytes, NODE_KIND_COUNT);
+        aStats.deepCopies = gDeepCopies.load(std::memory_order_relaxed);
+        aStats.sharedCopies = gSharedCopies.load(std::memory_order_relaxed);
+        aStats.moves = gMoves.load(std::memory_order_relaxed);
+        loadCounters(gCalls, aStats.calls, OPERATION_COUNT);
+        loadCounters(gBytes, aStats.bytes, OPERATION_COUNT);
+        loadCounters(gNanoseconds, aStats.nanoseconds, OPERATION_COUNT);
+        return true;
+#else
+        std::memset(&aStats, 0, sizeof(EncodeStats));
+        return false;
+#endif
+    }
+
+    void SOLAIRE_EXPORT_CALL EncodeStats::reset() throw() {
+#if defined(SOLAIRE_ENCODE_STATS)
+        clearCounters(gNodeAllocations, NODE_KIND_COUNT);
+        clearCounters(gNodeBytes, NODE_KIND_COUNT);
+        gDeepCopies.store(0, std::memory_order_relaxed);
+        gSharedCopies.store(0, std::memory_order_relaxed);
+        gMoves.store(0, std::memory_order_relaxed);
+        clearCounters(gCalls, OPERATION_COUNT);
+        clearCounters(gBytes, OPERATION_COUNT);
+        clearCounters(gNanoseconds, OPERATION_COUNT);
+#endif
+    }
+
+#if defined(SOLAIRE_ENCODE_STATS)
+    void SOLAIRE_EXPORT_CALL EncodeStats::recordNode(const NodeKind aKind, const uint32_t aBytes) throw() {
+        increment(gNodeAllocations[aKind], 1);
+        increment(gNodeBytes[aKind], aBytes);
+    }
+
+    void SOLAIRE_EXPORT_CALL EncodeStats::recordDeepCopy() throw() {
+        increment(gDeepCopies, 1);
+    }
+
+    void SOLAIRE_EXPORT_CALL EncodeStats::recordSharedCopy() throw() {
+        increment(gSharedCopies, 1);
+    }
+
+    void SOLAIRE_EXPORT_CALL EncodeStats::recordMove() throw() {
+        increment(gMoves, 1);
+    }
+
+	// EncodeStats::Scope
+
+    EncodeStats::Scope::Scope(const IStream& aStream) throw() :
+        mBegin(std::chrono::steady_clock::now()),
+        mInput(&aStream),
+        mOutput(nullptr),
+        mOffset(aStream.isOffsetable() ? aStream.getOffset() : 0),
+        mOperation(READ_VALUE),
+        mOutermost(gDepth++ == 0)
+    {}
+
+    EncodeStats::Scope::Scope(const OStream& aStream) throw() :
+        mBegin(std::chrono::steady_clock::now()),
+        mInput(nullptr),
+        mOutput(&aStream),
+        mOffset(aStream.isOffsetable() ? aStream.getOffset() : 0),
+        mOperation(WRITE_VALUE),
+        mOutermost(gDepth++ == 0)
+    {}
+
+    EncodeStats::Scope::~Scope() throw() {
+        --gDepth;
+        if(! mOutermost) return;
+        const std::chrono::steady_clock::duration time = std::chrono::steady_clock::now() - mBegin;
+        increment(gCalls[mOperation], 1);
+        increment(gNanoseconds[mOperation], static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(time).count()));
+
+        int32_t offset = mOffset;
+        if(mInput) {
+            if(mInput->isOffsetable()) offset = mInput->getOffset();
+        }else if(mOutput->isOffsetable()) {
+            offset = mOutput->getOffset();
+        }
+        if(offset > mOffset) increment(gBytes[mOperation], static_cast<uint64_t>(offset - mOffset));
+    }
+#endif
+}
@@ -0,0 +1,266 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+#include <cstring>
+#include <utility>
+#include "Solaire/Encode/GenericObjectMap.hpp"
+
+namespace Solaire {
+
+    enum : uint32_t {
+        MIN_SLOTS = 32,
+        MIN_KEYS = 8,
+        EMPTY_SLOT = 0xFFFFFFFF
+    };
+
+    static bool keyEquals(const StringConstant<char>& aFirst, const StringConstant<char>& aSecond) throw() {
+        const int32_t size = aFirst.size();
+        if(size != aSecond.size()) return false;
+        for(int32_t i = 0; i < size; ++i) {
+            if(aFirst[i] != aSecond[i]) return false;
+        }
+        return true;
+    }
+
+    static bool keyEquals(const StringConstant<char>& aFirst, const KeyTable::Key& aSecond) throw() {
+        const uint32_t length = aSecond.getLength();
+        if(static_cast<uint32_t>(aFirst.size()) != length) return false;
+        const char* const characters = aSecond.getCharacters();
+        for(uint32_t i = 0; i < length; ++i) {
+            if(aFirst[i] != characters[i]) return false;
+        }
+        return true;
+    }
+
+	// GenericObjectMap
+
+    uint32_t GenericObjectMap::hash(const StringConstant<char>& aKey) throw() {
+        const int32_t size = aKey.size();
+        uint32_t hash = 2166136261U;
+        for(int32_t i = 0; i < size; ++i) {
+            hash ^= static_cast<uint8_t>(aKey[i]);
+            hash *= 16777619U;
+        }
+        return hash;
+    }
+
+    GenericObjectMap::GenericObjectMap(Allocator& aAllocator) throw() :
+        BaseType(aAllocator),
+        mAllocator(aAllocator),
+        mKeyTable(KeyTable::getShared()),
+        mKeys(nullptr),
+        mKeyCapacity(0),
+        mSlots(nullptr),
+        mSlotMask(0)
+    {}
+
+    GenericObjectMap::~GenericObjectMap() throw() {
+        releaseIndex();
+        releaseKeys();
+    }
+
+    int32_t GenericObjectMap::findIndex(const StringConstant<char>& aKey) const throw() {
+        if(mKeys) {
+            // A name that has never been interned can not be the name of a member
+            const KeyTable::Key* const key = mKeyTable->find(aKey);
+            return key ? findIndex(*key) : -1;
+        }
+
+        const auto entries = begin();
+        if(mSlots == nullptr) {
+            const int32_t size = this->size();
+            for(int32_t i = 0; i < size; ++i) {
+                if(keyEquals(entries[i].first, aKey)) return i;
+            }
+            return -1;
+        }
+
+        const uint32_t hash_ = hash(aKey);
+        uint32_t i = hash_ & mSlotMask;
+        while(mSlots[i].index != static_cast<int32_t>(EMPTY_SLOT)) {
+            const Slot& slot = mSlots[i];
+            if(slot.hash == hash_ && keyEquals(entries[slot.index].first, aKey)) return slot.index;
+            i = (i + 1) & mSlotMask;
+        }
+        return -1;
+    }
+
+    int32_t GenericObjectMap::findIndex(const KeyTable::Key& aKey) const throw() {
+        const auto entries = begin();
+        const bool interned = mKeys != nullptr && &aKey.getTable() == mKeyTable;
+        if(mSlots == nullptr) {
+            const int32_t size = this->size();
+            for(int32_t i = 0; i < size; ++i) {
+                if(interned ? mKeys[i] == &aKey : keyEquals(entries[i].first, aKey)) return i;
+            }
+            return -1;
+        }
+
+        const uint32_t hash_ = aKey.getHash();
+        uint32_t i = hash_ & mSlotMask;
+        while(mSlots[i].index != static_cast<int32_t>(EMPTY_SLOT)) {
+            const Slot& slot = mSlots[i];
+            if(slot.hash == hash_ && (interned ? mKeys[slot.index] == &aKey : keyEquals(entries[slot.index].first, aKey))) return slot.index;
+            i = (i + 1) & mSlotMask;
+        }
+        return -1;
+    }
+
+    void GenericObjectMap::addKey(const CString& aKey, const int32_t aIndex) throw() {
+        // Keys are only kept if every member has one, which is decided by the first member
+        if(mKeyTable == nullptr || (mKeys == nullptr && aIndex != 0)) return;
+        const KeyTable::Key* const key = mKeyTable->intern(aKey);
+        if(key == nullptr) {
+            releaseKeys();
+            return;
+        }
+
+        if(aIndex >= mKeyCapacity) {
+            int32_t capacity = mKeyCapacity == 0 ? static_cast<int32_t>(MIN_KEYS) : mKeyCapacity * 2;
+            while(capacity <= aIndex) capacity *= 2;
+            const KeyTable::Key** const keys = static_cast<const KeyTable::Key**>(mAllocator.allocate(sizeof(const KeyTable::Key*) * capacity));
+            if(keys == nullptr) {
+                releaseKeys();
+                return;
+            }
+            if(mKeys) {
+                std::memcpy(keys, mKeys, sizeof(const KeyTable::Key*) * aIndex);
+                mAllocator.deallocate(mKeys);
+            }
+            mKeys = keys;
+            mKeyCapacity = capacity;
+        }
+        mKeys[aIndex] = key;
+    }
+
+    void GenericObjectMap::releaseKeys() throw() {
+        if(mKeys == nullptr) return;
+        mAllocator.deallocate(mKeys);
+        mKeys = nullptr;
+        mKeyCapacity = 0;
+    }
+
+    void GenericObjectMap::insertIndex(const uint32_t aHash, const int32_t aIndex) throw() {
+        uint32_t i = aHash & mSlotMask;
+        while(mSlots[i].index != static_cast<int32_t>(EMPTY_SLOT)) i = (i + 1) & mSlotMask;
+        mSlots[i].hash = aHash;
+        mSlots[i].index = aIndex;
+    }
+
+    void GenericObjectMap::rebuildIndex(const int32_t aCapacity) throw() {
+        releaseIndex();
+        if(aCapacity < INDEX_THRESHOLD) return;
+
+        // Keep the load factor at or below one half so probe sequences stay short
+        uint32_t count = MIN_SLOTS;
+        while(count < static_cast<uint32_t>(aCapacity) * 2) count *= 2;
+        Slot* const slots = static_cast<Slot*>(mAllocator.allocate(sizeof(Slot) * count));
+        if(slots == nullptr) return;
+        for(uint32_t i = 0; i < count; ++i) slots[i].index = static_cast<int32_t>(EMPTY_SLOT);
+        mSlots = slots;
+        mSlotMask = count - 1;
+
+        const auto entries = begin();
+        const int32_t size = this->size();
+        for(int32_t i = 0; i < size; ++i) insertIndex(mKeys ? mKeys[i]->getHash() : hash(entries[i].first), i);
+    }
+
+    void GenericObjectMap::releaseIndex() throw() {
+        if(mSlots == nullptr) return;
+        mAllocator.deallocate(mSlots);
+        mSlots = nullptr;
+        mSlotMask = 0;
+    }
+
+    GenericValue* GenericObjectMap::find(const StringConstant<char>& aKey) throw() {
+        const int32_t index = findIndex(aKey);
+        return index == -1 ? nullptr : &begin()[index].second;
+    }
+
+    const GenericValue* GenericObjectMap::find(const StringConstant<char>& aKey) const throw() {
+        const int32_t index = findIndex(aKey);
+        return index == -1 ? nullptr : &begin()[index].second;
+    }
+
+    const GenericValue* GenericObjectMap::find(const GenericObjectMap& aOther, const int32_t aIndex) const throw() {
+        const KeyTable::Key* const key = aOther.getKey(aIndex);
+        const int32_t index = key ? findIndex(*key) : findIndex(aOther.begin()[aIndex].first);
+        return index == -1 ? nullptr : &begin()[index].second;
+    }
+
+    bool GenericObjectMap::equalNames(const int32_t aIndex, const GenericObjectMap& aOther, const int32_t aOtherIndex) const throw() {
+        const KeyTable::Key* const key = getKey(aIndex);
+        const KeyTable::Key* const otherKey = aOther.getKey(aOtherIndex);
+        if(key && otherKey && mKeyTable == aOther.mKeyTable) return key == otherKey;
+        return keyEquals(begin()[aIndex].first, aOther.begin()[aOtherIndex].first);
+    }
+
+    GenericValue& GenericObjectMap::emplace(const CString& aKey, GenericValue&& aValue) throw() {
+        // Map only copies values in, so a null member is added and the value is moved into it
+        const GenericValue null;
+        GenericValue& value = emplace(aKey, null);
+        value = std::move(aValue);
+        return value;
+    }
+
+    void GenericObjectMap::reserve(const int32_t aCapacity) throw() {
+        if(aCapacity < INDEX_THRESHOLD || static_cast<uint32_t>(aCapacity) * 2 <= mSlotMask + 1) return;
+        rebuildIndex(aCapacity);
+    }
+
+    // Inherited from Map
+
+    GenericValue& GenericObjectMap::emplace(const CString& aKey, const GenericValue& aValue) throw() {
+        const int32_t index = size();
+        GenericValue& value = BaseType::emplace(aKey, aValue);
+        const int32_t size = this->size();
+        if(size == index) return value;
+
+        addKey(aKey, index);
+        if(mSlots == nullptr || static_cast<uint32_t>(size) * 2 > mSlotMask + 1) {
+            if(size >= INDEX_THRESHOLD) rebuildIndex(size);
+        }else {
+            insertIndex(mKeys ? mKeys[index]->getHash() : hash(aKey), index);
+        }
+        return value;
+    }
+
+    bool GenericObjectMap::erase(const CString& aKey) throw() {
+        const int32_t index = mKeys ? findIndex(aKey) : -1;
+        if(! BaseType::erase(aKey)) return false;
+        if(index != -1) std::memmove(mKeys + index, mKeys + index + 1, sizeof(const KeyTable::Key*) * (size() - index));
+        // Erasing shifts the position of every later member
+        if(mSlots) rebuildIndex(size());
+        return true;
+    }
+
+    void GenericObjectMap::clear() throw() {
+        BaseType::clear();
+        releaseIndex();
+    }
+
+    GenericValue& GenericObjectMap::operator[](const CString& aKey) throw() {
+        GenericValue* const value = find(aKey);
+        return value ? *value : emplace(aKey, GenericValue());
+    }
+
+    const GenericValue& GenericObjectMap::operator[](const CString& aKey) const throw() {
+        const GenericValue* const value = find(aKey);
+        return value ? *value : BaseType::operator[](aKey);
+    }
+}
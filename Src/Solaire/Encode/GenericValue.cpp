@@ -16,23 +16,151 @@
 // Email             : solairelibrary@mail.com
 // GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
 
-#include "Solaire/Encode/GenericValue.hpp"
+#include <atomic>
+#include <cstring>
+#include <utility>
+#include "Solaire/Encode/ArenaAllocator.hpp"
+#include "Solaire/Encode/EncodeStats.hpp"
+#include "Solaire/Encode/GenericObjectMap.hpp"
+#include "Solaire/Encode/Format.hpp"
+#include "Solaire/Encode/NumberFormat.hpp"
+#include "Solaire/Encode/StructuralHash.hpp"
 
 namespace Solaire {
 
     typedef ArrayList<GenericValue> ArrayType;
-    typedef ListMap<CString, GenericValue> ObjectType;
+    typedef GenericObjectMap ObjectType;
+
+    typedef std::atomic<uint32_t> ReferenceCount;
+    typedef std::atomic<uint64_t> HashCache;
+
+    enum : uint32_t {
+        PACKED_ELEMENT_BYTES = 8,
+        NODE_HEADER_BYTES = 8,          //!< Space in front of every node for its ReferenceCount, keeps the node 8 byte aligned.
+        CONTAINER_HEADER_BYTES = 16     //!< Array and object nodes also keep their HashCache in front of the ReferenceCount.
+    };
+
+    enum : uint64_t {
+        NO_HASH = 0
+    };
+
+    static SOLAIRE_FORCE_INLINE uint32_t getHeaderBytes(const EncodeStats::NodeKind aKind) throw() {
+        return aKind == EncodeStats::STRING_NODE ? NODE_HEADER_BYTES : CONTAINER_HEADER_BYTES;
+    }
+
+    static void* allocateNode(Allocator& aAllocator, const uint32_t aBytes, const EncodeStats::NodeKind aKind) throw() {
+        const uint32_t header = getHeaderBytes(aKind);
+        SOLAIRE_STATS_NODE(aKind, header + aBytes);
+        uint8_t* const block = static_cast<uint8_t*>(aAllocator.allocate(header + aBytes));
+        if(block == nullptr) return nullptr;
+        if(header == CONTAINER_HEADER_BYTES) new(block) HashCache(NO_HASH);
+        new(block + header - NODE_HEADER_BYTES) ReferenceCount(1);
+        return block + header;
+    }
+
+    static void deallocateNode(Allocator& aAllocator, void* const aNode, const EncodeStats::NodeKind aKind) throw() {
+        aAllocator.deallocate(static_cast<uint8_t*>(aNode) - getHeaderBytes(aKind));
+    }
+
+    static SOLAIRE_FORCE_INLINE ReferenceCount& getReferences(void* const aNode) throw() {
+        return *reinterpret_cast<ReferenceCount*>(static_cast<uint8_t*>(aNode) - NODE_HEADER_BYTES);
+    }
+
+    static SOLAIRE_FORCE_INLINE HashCache& getHashCache(void* const aNode) throw() {
+        return *reinterpret_cast<HashCache*>(static_cast<uint8_t*>(aNode) - CONTAINER_HEADER_BYTES);
+    }
+
+    static SOLAIRE_FORCE_INLINE const char* getCharacters(const GenericValue& aString) throw() {
+        return aString.getString().getCharacters();
+    }
+
+    static GenericValue getPackedElement(const GenericValue::ValueType aType, const void* const aValues, const uint32_t aIndex) throw() {
+        switch(aType) {
+        case GenericValue::UNSIGNED_T:
+            return GenericValue(static_cast<const uint64_t*>(aValues)[aIndex]);
+        case GenericValue::SIGNED_T:
+            return GenericValue(static_cast<const int64_t*>(aValues)[aIndex]);
+        default:
+            return GenericValue(static_cast<const double*>(aValues)[aIndex]);
+        }
+    }
+
+    static const GenericValue& getEmptyContainer(const GenericValue::ValueType aType) throw() {
+        // Returned when a cache can not be allocated
+        static const GenericValue EMPTY_ARRAY(GenericValue::ARRAY_T);
+        static const GenericValue EMPTY_OBJECT(GenericValue::OBJECT_T);
+        return aType == GenericValue::ARRAY_T ? EMPTY_ARRAY : EMPTY_OBJECT;
+    }
+
+    static void destroyCache(GenericValue* const aValue) throw() {
+        Allocator& allocator = aValue->getAllocator();
+        aValue->~GenericValue();
+        allocator.deallocate(aValue);
+    }
+
+    static void releaseCache(std::atomic<GenericValue*>& aCache) throw() {
+        GenericValue* const value = aCache.exchange(nullptr, std::memory_order_acquire);
+        if(value) destroyCache(value);
+    }
+
+    static const GenericValue& publishCache(std::atomic<GenericValue*>& aCache, GenericValue* const aValue) throw() {
+        // Threads that fill the same cache at once keep the first value that was published
+        GenericValue* expected = nullptr;
+        if(aCache.compare_exchange_strong(expected, aValue, std::memory_order_acq_rel, std::memory_order_acquire)) return *aValue;
+        destroyCache(aValue);
+        return *expected;
+    }
+
+    static bool equalMembersAnyOrder(const GenericValue& aFirst, const GenericValue& aSecond) throw() {
+        // Every member must be matched with a different member of the other object, which needs a scan when names repeat
+        const ObjectType& first = static_cast<const ObjectType&>(aFirst.getObject());
+        const ObjectType& second = static_cast<const ObjectType&>(aSecond.getObject());
+        const auto firstEntries = first.begin();
+        const auto secondEntries = second.begin();
+        const int32_t size = second.size();
+        ArrayList<uint8_t> matched(getDefaultAllocator());
+        matched.reserve(size);
+        for(int32_t i = 0; i < size; ++i) matched.pushBack(0);
+        for(int32_t i = 0; i < size; ++i) {
+            int32_t j = 0;
+            for(; j < size; ++j) {
+                if(matched[j] == 0 && first.equalNames(i, second, j) && firstEntries[i].second == secondEntries[j].second) break;
+            }
+            if(j == size) return false;
+            matched[j] = 1;
+        }
+        return true;
+    }
+
+    static GenericValue parseString(const GenericValue& aString) throw() {
+        // Strings are converted with the same rules as JSON text, anything else converts as null
+        const uint32_t length = aString.getStringLength();
+        if(length == 0) return GenericValue();
+        const char* const characters = aString.getString().getCharacters();
+
+        if(length == 4 && std::memcmp(characters, "true", 4) == 0) return GenericValue(true);
+        if(length == 5 && std::memcmp(characters, "false", 5) == 0) return GenericValue(false);
+        uint64_t unsignedValue;
+        if(NumberFormat::parseUnsigned(characters, length, unsignedValue) == length) return GenericValue(unsignedValue);
+        int64_t signedValue;
+        if(NumberFormat::parseSigned(characters, length, signedValue) == length) return GenericValue(signedValue);
+        double doubleValue;
+        if(NumberFormat::parseDouble(characters, length, doubleValue) == length) return GenericValue(doubleValue);
+        return GenericValue();
+    }
 
 	// GenericValue
 
     GenericValue::GenericValue() throw() :
         mAllocator(&getDefaultAllocator()),
-        mType(NULL_T)
+        mType(NULL_T),
+        mFlags(0)
     {}
 
     GenericValue::GenericValue(const ValueType aType) throw() :
         mAllocator(&getDefaultAllocator()),
-        mType(aType)
+        mType(aType),
+        mFlags(0)
     {
         switch(mType){
         case CHAR_T:
@@ -51,13 +179,15 @@ namespace Solaire {
             mDouble = 0.0;
             break;
         case STRING_T:
-            mString = new(mAllocator->allocate(sizeof(CString))) CString();
+            mInline[0] = '\0';
+            mInlineLength = 0;
+            mFlags = FLAG_INLINE_STRING;
             break;
         case ARRAY_T:
-            mArray = new(mAllocator->allocate(sizeof(ArrayType))) ArrayType();
+            mArray = new(allocateNode(*mAllocator, sizeof(ArrayType), EncodeStats::ARRAY_NODE)) ArrayType();
             break;
         case OBJECT_T:
-            mObject = new(mAllocator->allocate(sizeof(ObjectType))) ObjectType();
+            mObject = new(allocateNode(*mAllocator, sizeof(ObjectType), EncodeStats::OBJECT_NODE)) ObjectType(*mAllocator);
             break;
         default:
             break;
@@ -65,39 +195,28 @@ namespace Solaire {
     }
 
     GenericValue::GenericValue(const GenericValue& aOther) throw() :
-        mAllocator(aOther.mAllocator),
-        mType(aOther.mType)
+        mAllocator(aOther.mFlags & FLAG_ARENA ? &getDefaultAllocator() : aOther.mAllocator),
+        mType(NULL_T),
+        mFlags(0)
     {
-        switch(mType){
-        case CHAR_T:
-        case BOOL_T:
-            mChar = aOther.mChar;
-            break;
-        case UNSIGNED_T:
-        case SIGNED_T:
-            mUnsigned = aOther.mUnsigned;
-            break;
-        case DOUBLE_T:
-            mDouble = aOther.mDouble;
-            break;
-        case STRING_T:
-            mString = new(mAllocator->allocate(sizeof(CString))) CString(*aOther.mString);
-            break;
-        case ARRAY_T:
-            mArray = new(mAllocator->allocate(sizeof(ArrayType))) ArrayType(*aOther.mArray);
-            break;
-        case OBJECT_T:
-            mObject = new(mAllocator->allocate(sizeof(ObjectType))) ObjectType(*aOther.mObject);
-            break;
-        default:
-            break;
-        }
+        copyFrom(aOther);
     }
 
     GenericValue::GenericValue(GenericValue&& aOther) throw() :
         mAllocator(aOther.mAllocator),
-        mType(aOther.mType)
+        mType(aOther.mType),
+        mFlags(aOther.mFlags)
     {
+        if((mFlags & FLAG_ARENA) != 0 && ! static_cast<ArenaAllocator*>(mAllocator)->contains(this)) {
+            // Only containers in the same arena relocate its values, anywhere else the nodes would outlive the arena
+            mAllocator = &getDefaultAllocator();
+            mType = NULL_T;
+            mFlags = 0;
+            copyFrom(aOther);
+            aOther.setNull();
+            return;
+        }
+        SOLAIRE_STATS_MOVE();
         switch(mType){
         case CHAR_T:
         case BOOL_T:
@@ -111,6 +230,13 @@ namespace Solaire {
             mDouble = aOther.mDouble;
             break;
         case STRING_T:
+            if(mFlags & STRING_FLAGS) {
+                std::memcpy(mInline, aOther.mInline, sizeof(mInline));
+                mInlineLength = aOther.mInlineLength;
+            }else {
+                mString = aOther.mString;
+            }
+            break;
         case ARRAY_T:
         case OBJECT_T:
             mString = aOther.mString;
@@ -120,119 +246,138 @@ namespace Solaire {
         }
 
         aOther.mType = NULL_T;
+        aOther.mFlags &= ~STORAGE_FLAGS;
     }
 
     GenericValue::GenericValue(const char aValue)throw() :
         mChar(aValue),
         mAllocator(&getDefaultAllocator()),
-        mType(CHAR_T)
+        mType(CHAR_T),
+        mFlags(0)
     {}
 
     GenericValue::GenericValue(const bool aValue) throw() :
         mBool(aValue),
         mAllocator(&getDefaultAllocator()),
-        mType(BOOL_T)
+        mType(BOOL_T),
+        mFlags(0)
     {}
 
     GenericValue::GenericValue(const uint8_t aValue) throw() :
         mUnsigned(aValue),
         mAllocator(&getDefaultAllocator()),
-        mType(UNSIGNED_T)
+        mType(UNSIGNED_T),
+        mFlags(0)
     {}
 
     GenericValue::GenericValue(const uint16_t aValue) throw() :
         mUnsigned(aValue),
         mAllocator(&getDefaultAllocator()),
-        mType(UNSIGNED_T)
+        mType(UNSIGNED_T),
+        mFlags(0)
     {}
 
     GenericValue::GenericValue(const uint32_t aValue) throw() :
         mUnsigned(aValue),
         mAllocator(&getDefaultAllocator()),
-        mType(UNSIGNED_T)
+        mType(UNSIGNED_T),
+        mFlags(0)
     {}
 
     GenericValue::GenericValue(const uint64_t aValue) throw() :
         mUnsigned(aValue),
         mAllocator(&getDefaultAllocator()),
-        mType(UNSIGNED_T)
+        mType(UNSIGNED_T),
+        mFlags(0)
     {}
 
     GenericValue::GenericValue(const int8_t aValue) throw() :
         mSigned(aValue),
         mAllocator(&getDefaultAllocator()),
-        mType(SIGNED_T)
+        mType(SIGNED_T),
+        mFlags(0)
     {}
 
     GenericValue::GenericValue(const int16_t aValue) throw() :
         mSigned(aValue),
         mAllocator(&getDefaultAllocator()),
-        mType(SIGNED_T)
+        mType(SIGNED_T),
+        mFlags(0)
     {}
 
     GenericValue::GenericValue(const int32_t aValue) throw() :
         mSigned(aValue),
         mAllocator(&getDefaultAllocator()),
-        mType(SIGNED_T)
+        mType(SIGNED_T),
+        mFlags(0)
     {}
 
     GenericValue::GenericValue(const int64_t aValue) throw() :
         mSigned(aValue),
         mAllocator(&getDefaultAllocator()),
-        mType(SIGNED_T)
+        mType(SIGNED_T),
+        mFlags(0)
     {}
 
     GenericValue::GenericValue(const double aValue) throw() :
         mDouble(aValue),
         mAllocator(&getDefaultAllocator()),
-        mType(DOUBLE_T)
+        mType(DOUBLE_T),
+        mFlags(0)
     {}
 
     GenericValue::GenericValue(const StringConstant<char>& aValue) throw() :
-        mString(nullptr),
         mAllocator(&aValue.getAllocator()),
-        mType(NULL_T)
+        mType(NULL_T),
+        mFlags(0)
     {
-        setString() = aValue;
+        setString(aValue);
+    }
+
+    GenericValue::GenericValue(CString&& aValue) throw() :
+        mAllocator(&aValue.getAllocator()),
+        mType(NULL_T),
+        mFlags(0)
+    {
+        setString(std::move(aValue));
+    }
+
+    GenericValue::GenericValue(Allocator& aAllocator, const uint8_t aFlags) throw() :
+        mAllocator(&aAllocator),
+        mType(NULL_T),
+        mFlags(aFlags)
+    {}
+
+    GenericValue::~GenericValue() throw() {
+        setNull();
     }
 
         // C++ operators
 
     GenericValue& GenericValue::operator=(const GenericValue& aOther) throw() {
+        if(this == &aOther) return *this;
         setNull();
-        mType = aOther.mType;
-        mAllocator = aOther.mAllocator;
-        switch(mType){
-        case CHAR_T:
-        case BOOL_T:
-            mChar = aOther.mChar;
-            break;
-        case UNSIGNED_T:
-        case SIGNED_T:
-            mUnsigned = aOther.mUnsigned;
-            break;
-        case DOUBLE_T:
-            mDouble = aOther.mDouble;
-            break;
-        case STRING_T:
-            mString = new(mAllocator->allocate(sizeof(CString))) CString(*aOther.mString);
-            break;
-        case ARRAY_T:
-            mArray = new(mAllocator->allocate(sizeof(ArrayType))) ArrayType(*aOther.mArray);
-            break;
-        case OBJECT_T:
-            mObject = new(mAllocator->allocate(sizeof(ObjectType))) ObjectType(*aOther.mObject);
-            break;
-        default:
-            break;
-        }
+        if((mFlags & FLAG_ARENA) == 0) mAllocator = aOther.mFlags & FLAG_ARENA ? &getDefaultAllocator() : aOther.mAllocator;
+        copyFrom(aOther);
         return *this;
     }
 
     GenericValue& GenericValue::operator=(GenericValue&& aOther) throw() {
+        if(this == &aOther) return *this;
         setNull();
+        const bool arena = (mFlags & FLAG_ARENA) != 0;
+        if(arena ? aOther.mAllocator != mAllocator : (aOther.mFlags & FLAG_ARENA) != 0) {
+            // Nodes from outside the arena would never be released, and nodes from an arena would not outlive it,
+            // so they are copied the same way as the copy assignment does instead
+            if(! arena) mAllocator = &getDefaultAllocator();
+            copyFrom(aOther);
+            aOther.setNull();
+            return *this;
+        }
+        SOLAIRE_STATS_MOVE();
         mType = aOther.mType;
         mAllocator = aOther.mAllocator;
+        mFlags = aOther.mFlags;
         switch(mType){
         case CHAR_T:
         case BOOL_T:
@@ -246,6 +391,13 @@ namespace Solaire {
             mDouble = aOther.mDouble;
             break;
         case STRING_T:
+            if(mFlags & STRING_FLAGS) {
+                std::memcpy(mInline, aOther.mInline, sizeof(mInline));
+                mInlineLength = aOther.mInlineLength;
+            }else {
+                mString = aOther.mString;
+            }
+            break;
         case ARRAY_T:
         case OBJECT_T:
             mString = aOther.mString;
@@ -254,6 +406,7 @@ namespace Solaire {
             break;
         }
         aOther.mType = NULL_T;
+        aOther.mFlags &= ~STORAGE_FLAGS;
         return *this;
     }
 
@@ -272,7 +425,7 @@ namespace Solaire {
         case DOUBLE_T:
             return static_cast<char>(mDouble);
         case STRING_T:
-            return (*mString)[0];
+            return mFlags & FLAG_INLINE_STRING ? mInline[0] : mFlags & FLAG_BORROWED_STRING ? mBorrowed.characters[0] : (*mString)[0];
         default:
             return 0;
         }
@@ -291,7 +444,7 @@ namespace Solaire {
         case DOUBLE_T:
             return static_cast<bool>(mDouble);
         case STRING_T:
-            //! \todo Cast from string
+            return parseString(*this).getBool();
         default:
             return false;
         }
@@ -310,7 +463,7 @@ namespace Solaire {
         case DOUBLE_T:
             return static_cast<uint64_t>(mDouble);
         case STRING_T:
-            return static_cast<uint64_t>(*mString);
+            return parseString(*this).getUnsigned();
         default:
             return 0;
         }
@@ -329,7 +482,7 @@ namespace Solaire {
         case DOUBLE_T:
             return static_cast<int64_t>(mDouble);
         case STRING_T:
-            return static_cast<int64_t>(*mString);
+            return parseString(*this).getSigned();
         default:
             return 0;
         }
@@ -348,52 +501,596 @@ namespace Solaire {
         case DOUBLE_T:
             return mDouble;
         case STRING_T:
-            //! \todo Cast from string
-            return static_cast<int64_t>(*mString);
+            return parseString(*this).getDouble();
         default:
             return 0.0;
         }
     }
 
-    const String<char>& GenericValue::getString() const throw() {
-        return *mString;
+    GenericValue::StringView GenericValue::getString() const throw() {
+        if(mType != STRING_T) return StringView("", 0);
+        if(mFlags & FLAG_INLINE_STRING) return StringView(mInline, mInlineLength);
+        if(mFlags & FLAG_BORROWED_STRING) return StringView(mBorrowed.characters, mBorrowed.length);
+        return StringView(&(*mString)[0], static_cast<uint32_t>(mString->size()));
     }
 
     String<char>& GenericValue::getString() throw() {
+        if(mFlags & STRING_FLAGS) promoteString();
+        else detach();
         return *mString;
     }
 
+    const char* GenericValue::getStringPointer() const throw() {
+        if(mType != STRING_T) return nullptr;
+        return mFlags & FLAG_INLINE_STRING ? mInline : mFlags & FLAG_BORROWED_STRING ? mBorrowed.characters : nullptr;
+    }
+
+    uint32_t GenericValue::getStringLength() const throw() {
+        if(mType != STRING_T) return 0;
+        return mFlags & FLAG_INLINE_STRING ? mInlineLength : mFlags & FLAG_BORROWED_STRING ? mBorrowed.length : static_cast<uint32_t>(mString->size());
+    }
+
     const GenericArray& GenericValue::getArray() const throw() {
+        // Lazy and packed arrays are read through the caches on their nodes, the value itself is left as it is
+        if(mFlags & FLAG_LAZY) return getDecoded().getArray();
+        if(mFlags & FLAG_PACKED_ARRAY) return getUnpacked();
         return *mArray;
     }
 
     GenericArray& GenericValue::getArray() throw() {
+        if(mFlags & FLAG_LAZY) parseLazy();
+        if(mFlags & FLAG_PACKED_ARRAY) unpackArray();
+        else detach();
         return *mArray;
     }
 
+    GenericValue::ValueType GenericValue::getPackedType() const throw() {
+        if(mFlags & FLAG_LAZY) return getDecoded().getPackedType();
+        return mType == ARRAY_T && (mFlags & FLAG_PACKED_ARRAY) ? mPacked->type : NULL_T;
+    }
+
+    const void* GenericValue::getPackedArray() const throw() {
+        if(mFlags & FLAG_LAZY) return getDecoded().getPackedArray();
+        return mType == ARRAY_T && (mFlags & FLAG_PACKED_ARRAY) ? mPacked + 1 : nullptr;
+    }
+
+    void* GenericValue::getPackedArray() throw() {
+        if(mFlags & FLAG_LAZY) parseLazy();
+        if(mType != ARRAY_T || (mFlags & FLAG_PACKED_ARRAY) == 0) return nullptr;
+        detach();
+        return mPacked + 1;
+    }
+
     const GenericObject& GenericValue::getObject() const throw() {
+        if(mFlags & FLAG_LAZY) return getDecoded().getObject();
         return *mObject;
     }
 
     GenericObject& GenericValue::getObject() throw() {
+        if(mFlags & FLAG_LAZY) parseLazy();
+        else detach();
         return *mObject;
     }
 
-    void GenericValue::setNull() throw() {
+    void GenericValue::copyFrom(const GenericValue& aOther) throw() {
+        // Arena nodes are released with their arena, so they can only be shared by values that are not in an arena
+        void* const node = aOther.getNode();
+        if(node == nullptr || ((mFlags | aOther.mFlags) & FLAG_ARENA) != 0 || mAllocator != aOther.mAllocator) {
+            cloneFrom(aOther);
+            return;
+        }
+        SOLAIRE_STATS_SHARED_COPY();
+        ++getReferences(node);
+        mString = aOther.mString;
+        mFlags |= aOther.mFlags & (CONTAINER_FLAGS | FLAG_DECODE_FAILED);
+        mType = aOther.mType;
+    }
+
+    void GenericValue::cloneFrom(const GenericValue& aOther) throw() {
+        // Members are added with copyFrom, so outside of an arena only the top level node is copied
+        if(aOther.mFlags & FLAG_LAZY) {
+            SOLAIRE_STATS_DEEP_COPY();
+            const LazyValue& lazy = *aOther.mLazy;
+            setLazy(aOther.mType, *lazy.format, lazy.data, lazy.size);
+            return;
+        }
+        switch(aOther.mType){
+        case CHAR_T:
+        case BOOL_T:
+            mChar = aOther.mChar;
+            break;
+        case UNSIGNED_T:
+        case SIGNED_T:
+            mUnsigned = aOther.mUnsigned;
+            break;
+        case DOUBLE_T:
+            mDouble = aOther.mDouble;
+            break;
+        case STRING_T:
+            if(aOther.mFlags & STRING_FLAGS) {
+                // Borrowed strings stay borrowed, the copy references the same source
+                std::memcpy(mInline, aOther.mInline, sizeof(mInline));
+                mInlineLength = aOther.mInlineLength;
+                mFlags |= aOther.mFlags & STRING_FLAGS;
+            }else {
+                SOLAIRE_STATS_DEEP_COPY();
+                mString = new(allocateNode(*mAllocator, sizeof(CString), EncodeStats::STRING_NODE)) CString(*mAllocator);
+                *mString = *aOther.mString;
+            }
+            break;
+        case ARRAY_T:
+            SOLAIRE_STATS_DEEP_COPY();
+            if(aOther.mFlags & FLAG_PACKED_ARRAY) {
+                const uint32_t size = aOther.mPacked->size;
+                void* const values = setPackedArray(aOther.mPacked->type, size);
+                if(values) std::memcpy(values, aOther.mPacked + 1, static_cast<size_t>(size) * PACKED_ELEMENT_BYTES);
+                return;
+            }else {
+                const GenericArray& source = *aOther.mArray;
+                const int32_t size = source.size();
+                ArrayType* const array_ = new(allocateNode(*mAllocator, sizeof(ArrayType), EncodeStats::ARRAY_NODE)) ArrayType(*mAllocator);
+                array_->reserve(size);
+                for(int32_t i = 0; i < size; ++i) {
+                    adopt(array_->pushBack(GenericValue())).copyFrom(source[i]);
+                }
+                mArray = array_;
+            }
+            break;
+        case OBJECT_T:
+            {
+                SOLAIRE_STATS_DEEP_COPY();
+                const GenericObject& source = *aOther.mObject;
+                ObjectType* const object = new(allocateNode(*mAllocator, sizeof(ObjectType), EncodeStats::OBJECT_NODE)) ObjectType(*mAllocator);
+                object->reserve(source.size());
+                CString name(*mAllocator);
+                for(auto i = source.begin(); i != source.end(); ++i) {
+                    name = i->first;
+                    adopt(object->emplace(name, GenericValue())).copyFrom(i->second);
+                }
+                mObject = object;
+            }
+            break;
+        default:
+            break;
+        }
+        mType = aOther.mType;
+        mFlags |= aOther.mFlags & FLAG_DECODE_FAILED;
+    }
+
+    void* GenericValue::getNode() const throw() {
         switch(mType){
         case STRING_T:
-            mString->~String();
-            mAllocator->deallocate(mString);
+            return mFlags & STRING_FLAGS ? nullptr : mString;
+        case ARRAY_T:
+            return mFlags & CONTAINER_FLAGS ? static_cast<void*>(mPacked) : mArray;
+        case OBJECT_T:
+            return mFlags & FLAG_LAZY ? static_cast<void*>(mLazy) : mObject;
+        default:
+            return nullptr;
+        }
+    }
+
+    bool GenericValue::isShared() const throw() {
+        void* const node = getNode();
+        return node != nullptr && (mFlags & FLAG_ARENA) == 0 && getReferences(node).load() > 1;
+    }
+
+    void GenericValue::detach() throw() {
+        if(! isShared()) {
+            // The node is about to be modified, so a hash or elements that were cached for it would no longer match
+            if(mType == ARRAY_T || mType == OBJECT_T) getHashCache(getNode()).store(NO_HASH, std::memory_order_relaxed);
+            if(mFlags & FLAG_PACKED_ARRAY) releaseCache(mPacked->unpacked);
+            return;
+        }
+        // The temporary takes over this value's reference and releases it once the node has been copied
+        GenericValue shared(*mAllocator, 0);
+        shared.mString = mString;
+        shared.mFlags = mFlags & STORAGE_FLAGS;
+        shared.mType = mType;
+        mFlags &= ~STORAGE_FLAGS;
+        mType = NULL_T;
+        cloneFrom(shared);
+    }
+
+    GenericValue& GenericValue::adopt(GenericValue& aChild) const throw() {
+        // The container stores a copy of the placeholder, so the ownership is set on the stored value
+        aChild.mAllocator = mAllocator;
+        aChild.mFlags = mFlags & FLAG_ARENA;
+        return aChild;
+    }
+
+    void GenericValue::promoteString() throw() {
+        const char* const characters = getStringPointer();
+        const uint32_t length = getStringLength();
+        CString* const string = new(allocateNode(*mAllocator, sizeof(CString), EncodeStats::STRING_NODE)) CString(*mAllocator);
+        for(uint32_t i = 0; i < length; ++i) string->pushBack(characters[i]);
+        mString = string;
+        mFlags &= ~STRING_FLAGS;
+    }
+
+    GenericArray* GenericValue::unpackElements() const throw() {
+        const PackedArray* const packed = mPacked;
+        const uint32_t size = packed->size;
+        ArrayType* const array_ = new(allocateNode(*mAllocator, sizeof(ArrayType), EncodeStats::ARRAY_NODE)) ArrayType(*mAllocator);
+        array_->reserve(static_cast<int32_t>(size));
+        switch(packed->type) {
+        case UNSIGNED_T:
+            {
+                const uint64_t* const values = reinterpret_cast<const uint64_t*>(packed + 1);
+                for(uint32_t i = 0; i < size; ++i) adopt(array_->pushBack(GenericValue())).setUnsigned(values[i]);
+            }
+            break;
+        case SIGNED_T:
+            {
+                const int64_t* const values = reinterpret_cast<const int64_t*>(packed + 1);
+                for(uint32_t i = 0; i < size; ++i) adopt(array_->pushBack(GenericValue())).setSigned(values[i]);
+            }
+            break;
+        default:
+            {
+                const double* const values = reinterpret_cast<const double*>(packed + 1);
+                for(uint32_t i = 0; i < size; ++i) adopt(array_->pushBack(GenericValue())).setDouble(values[i]);
+            }
             break;
+        }
+        return array_;
+    }
+
+    void GenericValue::unpackArray() throw() {
+        // Elements that were unpacked through a const function are taken over when no other value can be reading them
+        GenericArray* array_ = nullptr;
+        if(! isShared()) {
+            GenericValue* const unpacked = mPacked->unpacked.exchange(nullptr, std::memory_order_acquire);
+            if(unpacked) {
+                array_ = unpacked->mArray;
+                unpacked->mType = NULL_T;
+                destroyCache(unpacked);
+            }
+        }
+        if(array_ == nullptr) array_ = unpackElements();
+        if((mFlags & FLAG_ARENA) == 0 && --getReferences(mPacked) == 0) {
+            releaseCache(mPacked->unpacked);
+            deallocateNode(*mAllocator, mPacked, EncodeStats::ARRAY_NODE);
+        }
+        mArray = array_;
+        mFlags &= ~FLAG_PACKED_ARRAY;
+    }
+
+    void GenericValue::decodeFrom(const ValueType aType, const Format& aFormat, const void* const aData, const uint32_t aSize) throw() {
+        if(! aFormat.readLazyValue(aData, aSize, *this) || mType != aType) {
+            if(aType == ARRAY_T) setArray();
+            else setObject();
+            mFlags |= FLAG_DECODE_FAILED;
+        }
+    }
+
+    void GenericValue::parseLazy() throw() {
+        const GenericValue* const decoded = mLazy->decoded.load(std::memory_order_acquire);
+        if(decoded == nullptr) {
+            // Copies share the LazyValue node, so it is released before the bytes are decoded into this value
+            const Format& format = *mLazy->format;
+            const void* const data = mLazy->data;
+            const uint32_t size = mLazy->size;
+            const ValueType type = mType;
+            setNull();
+            decodeFrom(type, format, data, size);
+        }else if(isShared()) {
+            // Other copies may still be reading the decoded value, so this value takes its own copy of the top level
+            GenericValue copy(*decoded);
+            setNull();
+            *this = std::move(copy);
+            detach();
+        }else {
+            GenericValue* const owned = mLazy->decoded.exchange(nullptr, std::memory_order_acquire);
+            setNull();
+            *this = std::move(*owned);
+            destroyCache(owned);
+        }
+    }
+
+    GenericValue* GenericValue::createCache() const throw() {
+        SOLAIRE_STATS_NODE(mType == OBJECT_T ? EncodeStats::OBJECT_NODE : EncodeStats::ARRAY_NODE, sizeof(GenericValue));
+        void* const memory = mAllocator->allocate(sizeof(GenericValue));
+        return memory ? new(memory) GenericValue(*mAllocator, mFlags & FLAG_ARENA) : nullptr;
+    }
+
+    const GenericValue& GenericValue::getDecoded() const throw() {
+        // The decoded value is kept on the node, so it is shared by every copy and thread that reads the value
+        std::atomic<GenericValue*>& cache = mLazy->decoded;
+        const GenericValue* const decoded = cache.load(std::memory_order_acquire);
+        if(decoded) return *decoded;
+        GenericValue* const value = createCache();
+        if(value == nullptr) return getEmptyContainer(mType);
+        value->decodeFrom(mType, *mLazy->format, mLazy->data, mLazy->size);
+        return publishCache(cache, value);
+    }
+
+    const GenericArray& GenericValue::getUnpacked() const throw() {
+        std::atomic<GenericValue*>& cache = mPacked->unpacked;
+        const GenericValue* unpacked = cache.load(std::memory_order_acquire);
+        if(unpacked == nullptr) {
+            GenericValue* const value = createCache();
+            if(value == nullptr) return *getEmptyContainer(ARRAY_T).mArray;
+            value->mArray = unpackElements();
+            value->mType = ARRAY_T;
+            unpacked = &publishCache(cache, value);
+        }
+        return *unpacked->mArray;
+    }
+
+    bool GenericValue::hasDecodeFailed() const throw() {
+        const GenericValue& value = mFlags & FLAG_LAZY ? getDecoded() : *this;
+        return (value.mFlags & FLAG_DECODE_FAILED) != 0;
+    }
+
+    GenericValue* GenericValue::find(const StringConstant<char>& aName) throw() {
+        if(! isObject()) return nullptr;
+        if(mFlags & FLAG_LAZY) parseLazy();
+        else detach();
+        return static_cast<ObjectType*>(mObject)->find(aName);
+    }
+
+    const GenericValue* GenericValue::find(const StringConstant<char>& aName) const throw() {
+        if(! isObject()) return nullptr;
+        if(mFlags & FLAG_LAZY) return getDecoded().find(aName);
+        return static_cast<const ObjectType*>(mObject)->find(aName);
+    }
+
+    GenericValue& GenericValue::operator[](const StringConstant<char>& aName) throw() {
+        GenericValue* const value = find(aName);
+        return value ? *value : emplace(aName, GenericValue());
+    }
+
+    const GenericValue& GenericValue::operator[](const StringConstant<char>& aName) const throw() {
+        const GenericValue* const value = find(aName);
+        if(value) return *value;
+        return mFlags & FLAG_LAZY ? getDecoded()[aName] : (*mObject)[aName];
+    }
+
+    GenericValue& GenericValue::pushBack(const GenericValue& aValue) throw() {
+        if(! isArray()) setArray();
+        else getArray();
+        if((mFlags & FLAG_ARENA) == 0) return mArray->pushBack(aValue);
+        GenericValue& value = adopt(mArray->pushBack(GenericValue()));
+        value.copyFrom(aValue);
+        return value;
+    }
+
+    GenericValue& GenericValue::pushBack(GenericValue&& aValue) throw() {
+        if(! isArray()) setArray();
+        else getArray();
+        if((mFlags & FLAG_ARENA) == 0) return mArray->pushBack(std::move(aValue));
+        // Move assignment copies the value instead if it was not allocated from the same arena
+        GenericValue& value = adopt(mArray->pushBack(GenericValue()));
+        value = std::move(aValue);
+        return value;
+    }
+
+    GenericValue& GenericValue::emplace(const StringConstant<char>& aName, const GenericValue& aValue) throw() {
+        if(! isObject()) setObject();
+        else getObject();
+        if((mFlags & FLAG_ARENA) == 0) return mObject->emplace(aName, aValue);
+        CString name(*mAllocator);
+        name = aName;
+        GenericValue& value = adopt(mObject->emplace(name, GenericValue()));
+        value.copyFrom(aValue);
+        return value;
+    }
+
+    GenericValue& GenericValue::emplace(const StringConstant<char>& aName, GenericValue&& aValue) throw() {
+        if(! isObject()) setObject();
+        else getObject();
+        if((mFlags & FLAG_ARENA) == 0) return static_cast<ObjectType*>(mObject)->emplace(aName, std::move(aValue));
+        CString name(*mAllocator);
+        name = aName;
+        GenericValue& value = adopt(mObject->emplace(name, GenericValue()));
+        value = std::move(aValue);
+        return value;
+    }
+
+    void GenericValue::reserve(const int32_t aCapacity) throw() {
+        if(mFlags & FLAG_LAZY) parseLazy();
+        if(isObject()) {
+            detach();
+            static_cast<ObjectType*>(mObject)->reserve(aCapacity);
+        }else if(isArray() && (mFlags & FLAG_PACKED_ARRAY) == 0) {
+            detach();
+            static_cast<ArrayType*>(mArray)->reserve(aCapacity);
+        }
+    }
+
+    void GenericValue::cacheHash(const uint64_t aHash) const throw() {
+        if((mType == ARRAY_T || mType == OBJECT_T) && (mFlags & FLAG_LAZY) == 0) getHashCache(getNode()).store(aHash, std::memory_order_relaxed);
+    }
+
+    uint64_t GenericValue::hash() const throw() {
+        switch(mType) {
+        case CHAR_T:
+            return StructuralHash::hashChar(mChar);
+        case BOOL_T:
+            return StructuralHash::hashBool(mBool);
+        case UNSIGNED_T:
+            return StructuralHash::hashUnsigned(mUnsigned);
+        case SIGNED_T:
+            return StructuralHash::hashSigned(mSigned);
+        case DOUBLE_T:
+            return StructuralHash::hashDouble(mDouble);
+        case STRING_T:
+            {
+                const uint32_t length = getStringLength();
+                return StructuralHash::hashString(length == 0 ? "" : getCharacters(*this), length);
+            }
         case ARRAY_T:
-            mArray->~GenericArray();
-            mAllocator->deallocate(mArray);
+        case OBJECT_T:
             break;
+        default:
+            return StructuralHash::hashNull();
+        }
+
+        if(mFlags & FLAG_LAZY) return getDecoded().hash();
+        HashCache& cache = getHashCache(getNode());
+        uint64_t result = cache.load(std::memory_order_relaxed);
+        if(result != NO_HASH) return result;
+
+        if(mType == OBJECT_T) {
+            StructuralHash::ObjectHash object;
+            const ObjectType& members = *static_cast<const ObjectType*>(mObject);
+            const auto entries = members.begin();
+            const int32_t size = members.size();
+            for(int32_t i = 0; i < size; ++i) {
+                // Interned names already carry their hash
+                const KeyTable::Key* const key = members.getKey(i);
+                const int32_t length = entries[i].first.size();
+                const uint64_t name = key ? key->getNameHash() : StructuralHash::hashName(length == 0 ? "" : &entries[i].first[0], static_cast<uint32_t>(length));
+                object.add(name, entries[i].second.hash());
+            }
+            result = object.finish();
+        }else if(mFlags & FLAG_PACKED_ARRAY) {
+            StructuralHash::ArrayHash array_;
+            const uint32_t size = mPacked->size;
+            const void* const values = mPacked + 1;
+            switch(mPacked->type) {
+            case UNSIGNED_T:
+                for(uint32_t i = 0; i < size; ++i) array_.add(StructuralHash::hashUnsigned(static_cast<const uint64_t*>(values)[i]));
+                break;
+            case SIGNED_T:
+                for(uint32_t i = 0; i < size; ++i) array_.add(StructuralHash::hashSigned(static_cast<const int64_t*>(values)[i]));
+                break;
+            default:
+                for(uint32_t i = 0; i < size; ++i) array_.add(StructuralHash::hashDouble(static_cast<const double*>(values)[i]));
+                break;
+            }
+            result = array_.finish();
+        }else {
+            StructuralHash::ArrayHash array_;
+            const GenericArray& elements = *mArray;
+            const int32_t size = elements.size();
+            for(int32_t i = 0; i < size; ++i) array_.add(elements[i].hash());
+            result = array_.finish();
+        }
+        cache.store(result, std::memory_order_relaxed);
+        return result;
+    }
+
+    bool GenericValue::operator==(const GenericValue& aOther) const throw() {
+        if(this == &aOther) return true;
+        if(mType != aOther.mType) return false;
+        switch(mType) {
+        case CHAR_T:
+            return mChar == aOther.mChar;
+        case BOOL_T:
+            return mBool == aOther.mBool;
+        case UNSIGNED_T:
+        case SIGNED_T:
+            return mUnsigned == aOther.mUnsigned;
+        case DOUBLE_T:
+            return mDouble == aOther.mDouble;
+        case STRING_T:
+            {
+                const uint32_t length = getStringLength();
+                if(length != aOther.getStringLength()) return false;
+                return length == 0 || std::memcmp(getCharacters(*this), getCharacters(aOther), length) == 0;
+            }
+        case ARRAY_T:
         case OBJECT_T:
-            mObject->~GenericObject();
-            mAllocator->deallocate(mObject);
             break;
+        default:
+            return true;
+        }
+
+        void* const node = getNode();
+        void* const otherNode = aOther.getNode();
+        if(node == otherNode) return true;
+        if((mFlags | aOther.mFlags) & FLAG_LAZY) {
+            // Lazy values are compared through the values they decode to, which are never lazy themselves
+            return (mFlags & FLAG_LAZY ? getDecoded() : *this) == (aOther.mFlags & FLAG_LAZY ? aOther.getDecoded() : aOther);
         }
+        const int32_t size = this->size();
+        if(size != aOther.size()) return false;
+
+        if(mType == OBJECT_T) {
+            // Names that are interned in the same KeyTable are compared by pointer
+            const ObjectType& members = *static_cast<const ObjectType*>(mObject);
+            const ObjectType& otherMembers = *static_cast<const ObjectType*>(aOther.mObject);
+            const auto entries = members.begin();
+            const auto otherEntries = otherMembers.begin();
+            int32_t i = 0;
+            for(; i < size; ++i) {
+                if(! members.equalNames(i, otherMembers, i) || entries[i].second != otherEntries[i].second) break;
+            }
+            if(i == size) return true;
+
+            // When every name is unique each member has exactly one partner, which is found through the index,
+            // so a difference in the same position is only confirmed here
+            for(i = 0; i < size; ++i) {
+                if(members.find(members, i) != &entries[i].second) return equalMembersAnyOrder(*this, aOther);
+            }
+            for(i = 0; i < size; ++i) {
+                const GenericValue* const member = otherMembers.find(members, i);
+                if(member == nullptr || *member != entries[i].second) return false;
+            }
+            return true;
+        }
+
+        const ValueType packedType = (mFlags & FLAG_PACKED_ARRAY) ? mPacked->type : NULL_T;
+        const ValueType otherPackedType = (aOther.mFlags & FLAG_PACKED_ARRAY) ? aOther.mPacked->type : NULL_T;
+        if(packedType != NULL_T && otherPackedType != NULL_T) {
+            if(packedType != otherPackedType) return false;
+            if(packedType != DOUBLE_T) return std::memcmp(mPacked + 1, aOther.mPacked + 1, size * PACKED_ELEMENT_BYTES) == 0;
+            const double* const values = reinterpret_cast<const double*>(mPacked + 1);
+            const double* const otherValues = reinterpret_cast<const double*>(aOther.mPacked + 1);
+            for(int32_t i = 0; i < size; ++i) {
+                if(values[i] != otherValues[i]) return false;
+            }
+            return true;
+        }
+        if(packedType != NULL_T || otherPackedType != NULL_T) {
+            // Unpacking would change the storage of a const value, so the packed side is compared element by element
+            const GenericValue& packed = packedType != NULL_T ? *this : aOther;
+            const GenericArray& elements = packedType != NULL_T ? *aOther.mArray : *mArray;
+            const ValueType type = packed.mPacked->type;
+            for(int32_t i = 0; i < size; ++i) {
+                if(elements[i] != getPackedElement(type, packed.mPacked + 1, static_cast<uint32_t>(i))) return false;
+            }
+            return true;
+        }
+        const GenericArray& elements = *mArray;
+        const GenericArray& otherElements = *aOther.mArray;
+        for(int32_t i = 0; i < size; ++i) {
+            if(elements[i] != otherElements[i]) return false;
+        }
+        return true;
+    }
+
+    void GenericValue::setNull() throw() {
+        if(mFlags & (FLAG_ARENA | STRING_FLAGS)) {
+            // The arena releases every node of the document at once, inline and borrowed strings own no memory
+            mType = NULL_T;
+            mFlags &= ~STORAGE_FLAGS;
+            return;
+        }
+        void* const node = getNode();
+        if(node != nullptr && --getReferences(node) == 0) {
+            // The last value that shares the node destroys it
+            switch(mType){
+            case STRING_T:
+                mString->~String();
+                break;
+            case ARRAY_T:
+                if(mFlags & FLAG_PACKED_ARRAY) releaseCache(mPacked->unpacked);
+                else if(mFlags & FLAG_LAZY) releaseCache(mLazy->decoded);
+                else mArray->~GenericArray();
+                break;
+            case OBJECT_T:
+                if(mFlags & FLAG_LAZY) releaseCache(mLazy->decoded);
+                else mObject->~GenericObject();
+                break;
+            default:
+                break;
+            }
+            deallocateNode(*mAllocator, node, mType == STRING_T ? EncodeStats::STRING_NODE : EncodeStats::ARRAY_NODE);
+        }
+        mFlags &= ~STORAGE_FLAGS;
         mType = NULL_T;
     }
 
@@ -417,7 +1114,7 @@ namespace Solaire {
 
     int64_t& GenericValue::setSigned(const int64_t aValue) throw() {
         setNull();
-        mType = UNSIGNED_T;
+        mType = SIGNED_T;
         return mSigned = aValue;
     }
 
@@ -428,9 +1125,9 @@ namespace Solaire {
     }
 
     String<char>& GenericValue::setString() throw() {
-        if(mType != STRING_T) {
+        if(mType != STRING_T || (mFlags & STRING_FLAGS) || isShared()) {
             setNull();
-            mString = new(mAllocator->allocate(sizeof(CString))) CString(*mAllocator);
+            mString = new(allocateNode(*mAllocator, sizeof(CString), EncodeStats::STRING_NODE)) CString(*mAllocator);
             mType = STRING_T;
         }else {
             mString->clear();
@@ -438,24 +1135,122 @@ namespace Solaire {
         return *mString;
     }
 
+    void GenericValue::setString(const char* const aValue, const uint32_t aLength) throw() {
+        const uint32_t ownLength = mType == STRING_T && (mFlags & FLAG_BORROWED_STRING) == 0 ? getStringLength() : 0;
+        const char* const own = ownLength > 0 ? getCharacters(*this) : nullptr;
+        if(mType == ARRAY_T || mType == OBJECT_T || (own && aValue >= own && aValue < own + ownLength)) {
+            // The characters may be owned by this value, so they are copied before its storage is released
+            GenericValue copy(*mAllocator, mFlags & FLAG_ARENA);
+            copy.setString(aValue, aLength);
+            *this = std::move(copy);
+            return;
+        }
+        if(aLength > INLINE_CAPACITY) {
+            String<char>& string = setString();
+            for(uint32_t i = 0; i < aLength; ++i) string.pushBack(aValue[i]);
+            return;
+        }
+        setNull();
+        std::memcpy(mInline, aValue, aLength);
+        mInline[aLength] = '\0';
+        mInlineLength = static_cast<uint8_t>(aLength);
+        mFlags |= FLAG_INLINE_STRING;
+        mType = STRING_T;
+    }
+
+    void GenericValue::setBorrowedString(const char* const aValue, const uint32_t aLength) throw() {
+        setNull();
+        mBorrowed.characters = aValue;
+        mBorrowed.length = aLength;
+        mFlags |= FLAG_BORROWED_STRING;
+        mType = STRING_T;
+    }
+
+    void GenericValue::setString(CString&& aValue) throw() {
+        // Arena nodes are never destroyed, so a CString in one would never release its characters
+        if(aValue.size() <= static_cast<int32_t>(INLINE_CAPACITY) || (mFlags & FLAG_ARENA)) {
+            setString(static_cast<const StringConstant<char>&>(aValue));
+            return;
+        }
+        setNull();
+        mString = new(allocateNode(*mAllocator, sizeof(CString), EncodeStats::STRING_NODE)) CString(std::move(aValue));
+        mType = STRING_T;
+    }
+
+    void GenericValue::setString(const StringConstant<char>& aValue) throw() {
+        if(mType == ARRAY_T || mType == OBJECT_T || (mType == STRING_T && (mFlags & STRING_FLAGS) == 0 && &aValue == mString)) {
+            // The string may be owned by this value, so it is copied before the storage is released
+            GenericValue copy(*mAllocator, mFlags & FLAG_ARENA);
+            copy.setString(aValue);
+            *this = std::move(copy);
+            return;
+        }
+        const uint32_t length = static_cast<uint32_t>(aValue.size());
+        if(length > INLINE_CAPACITY) {
+            setString() = aValue;
+            return;
+        }
+        setNull();
+        for(uint32_t i = 0; i < length; ++i) mInline[i] = aValue[i];
+        mInline[length] = '\0';
+        mInlineLength = static_cast<uint8_t>(length);
+        mFlags |= FLAG_INLINE_STRING;
+        mType = STRING_T;
+    }
+
     GenericArray& GenericValue::setArray() throw() {
-        if(mType != ARRAY_T) {
+        if(mType != ARRAY_T || (mFlags & CONTAINER_FLAGS) || isShared()) {
             setNull();
-            mArray = new(mAllocator->allocate(sizeof(ArrayType))) ArrayType(*mAllocator);
+            mArray = new(allocateNode(*mAllocator, sizeof(ArrayType), EncodeStats::ARRAY_NODE)) ArrayType(*mAllocator);
             mType = ARRAY_T;
         }else {
             mArray->clear();
+            getHashCache(mArray).store(NO_HASH, std::memory_order_relaxed);
+            mFlags &= ~FLAG_DECODE_FAILED;
         }
         return *mArray;
     }
 
+    void* GenericValue::setPackedArray(const ValueType aType, const uint32_t aSize) throw() {
+        if(aType != UNSIGNED_T && aType != SIGNED_T && aType != DOUBLE_T) return nullptr;
+        setNull();
+        static_assert(CONTAINER_HEADER_BYTES + sizeof(PackedArray) + static_cast<uint64_t>(MAX_PACKED_SIZE) * PACKED_ELEMENT_BYTES <= 0xFFFFFFFFU,
+            "The largest packed array node must fit in 32 bits");
+        if(aSize > MAX_PACKED_SIZE) return nullptr;
+        const uint64_t bytes = sizeof(PackedArray) + static_cast<uint64_t>(aSize) * PACKED_ELEMENT_BYTES;
+        PackedArray* const packed = static_cast<PackedArray*>(allocateNode(*mAllocator, static_cast<uint32_t>(bytes), EncodeStats::ARRAY_NODE));
+        if(packed == nullptr) return nullptr;
+        packed->size = aSize;
+        packed->type = aType;
+        new(&packed->unpacked) std::atomic<GenericValue*>(nullptr);
+        mPacked = packed;
+        mFlags |= FLAG_PACKED_ARRAY;
+        mType = ARRAY_T;
+        return packed + 1;
+    }
+
+    void GenericValue::setLazy(const ValueType aType, const Format& aFormat, const void* const aData, const uint32_t aSize) throw() {
+        if(aType != ARRAY_T && aType != OBJECT_T) return;
+        setNull();
+        LazyValue* const lazy = static_cast<LazyValue*>(allocateNode(*mAllocator, sizeof(LazyValue), aType == ARRAY_T ? EncodeStats::ARRAY_NODE : EncodeStats::OBJECT_NODE));
+        lazy->format = &aFormat;
+        lazy->data = aData;
+        lazy->size = aSize;
+        new(&lazy->decoded) std::atomic<GenericValue*>(nullptr);
+        mLazy = lazy;
+        mFlags |= FLAG_LAZY;
+        mType = aType;
+    }
+
     GenericObject& GenericValue::setObject() throw() {
-        if(mType != OBJECT_T) {
+        if(mType != OBJECT_T || (mFlags & FLAG_LAZY) || isShared()) {
             setNull();
-            mObject = new(mAllocator->allocate(sizeof(ObjectType))) ObjectType(*mAllocator);
+            mObject = new(allocateNode(*mAllocator, sizeof(ObjectType), EncodeStats::OBJECT_NODE)) ObjectType(*mAllocator);
             mType = OBJECT_T;
         }else {
             mObject->clear();
+            getHashCache(mObject).store(NO_HASH, std::memory_order_relaxed);
+            mFlags &= ~FLAG_DECODE_FAILED;
         }
         return *mObject;
     }
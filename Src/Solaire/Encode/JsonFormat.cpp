@@ -0,0 +1,1285 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+#include <cstring>
+#include <cmath>
+#include <utility>
+#include "Solaire/Encode/EncodeStats.hpp"
+#include "Solaire/Encode/JsonFormat.hpp"
+#include "Solaire/Encode/JsonIndexer.hpp"
+#include "Solaire/Encode/NumberFormat.hpp"
+
+namespace Solaire {
+
+    enum : uint32_t {
+        INITIAL_TEXT_BYTES = 4096,
+        DOCUMENT_CHUNK_BYTES = JsonIndexer::BLOCK_BYTES * 1024
+    };
+
+    static SOLAIRE_FORCE_INLINE bool isDelimiter(const char aCharacter) throw() {
+        switch(aCharacter) {
+        case ',':
+        case ':':
+        case '[':
+        case ']':
+        case '{':
+        case '}':
+        case '"':
+            return true;
+        default:
+            return static_cast<uint8_t>(aCharacter) <= 0x20;
+        }
+    }
+
+    static SOLAIRE_FORCE_INLINE bool isDigit(const char aCharacter) throw() {
+        return aCharacter >= '0' && aCharacter <= '9';
+    }
+
+    static void appendUtf8(String<char>& aString, const uint32_t aCode) throw() {
+        if(aCode < 0x80) {
+            aString.pushBack(static_cast<char>(aCode));
+        }else if(aCode < 0x800) {
+            aString.pushBack(static_cast<char>(0xC0 | (aCode >> 6)));
+            aString.pushBack(static_cast<char>(0x80 | (aCode & 0x3F)));
+        }else if(aCode < 0x10000) {
+            aString.pushBack(static_cast<char>(0xE0 | (aCode >> 12)));
+            aString.pushBack(static_cast<char>(0x80 | ((aCode >> 6) & 0x3F)));
+            aString.pushBack(static_cast<char>(0x80 | (aCode & 0x3F)));
+        }else {
+            aString.pushBack(static_cast<char>(0xF0 | (aCode >> 18)));
+            aString.pushBack(static_cast<char>(0x80 | ((aCode >> 12) & 0x3F)));
+            aString.pushBack(static_cast<char>(0x80 | ((aCode >> 6) & 0x3F)));
+            aString.pushBack(static_cast<char>(0x80 | (aCode & 0x3F)));
+        }
+    }
+
+    // JsonWriter
+
+    class JsonWriter : public Writer {
+    private:
+        enum : uint32_t {
+            BUFFER_BYTES = 4096
+        };
+    private:
+        OStream& mStream;
+        uint32_t mSize;
+        bool mNeedsComma;
+        bool mFailed;
+        char mBuffer[BUFFER_BYTES];
+    private:
+        SOLAIRE_FORCE_INLINE void put(const char aCharacter) throw() {
+            if(mSize == BUFFER_BYTES) flush();
+            mBuffer[mSize++] = aCharacter;
+        }
+
+        void putBytes(const char* aBytes, uint32_t aCount) throw() {
+            while(aCount > 0) {
+                if(mSize == BUFFER_BYTES) flush();
+                const uint32_t count = aCount < BUFFER_BYTES - mSize ? aCount : BUFFER_BYTES - mSize;
+                std::memcpy(mBuffer + mSize, aBytes, count);
+                mSize += count;
+                aBytes += count;
+                aCount -= count;
+            }
+        }
+
+        void putEscaped(const char aCharacter) throw() {
+            static const char HEX[] = "0123456789ABCDEF";
+            put('\\');
+            switch(aCharacter) {
+            case '"':
+                put('"');
+                break;
+            case '\\':
+                put('\\');
+                break;
+            case '\b':
+                put('b');
+                break;
+            case '\f':
+                put('f');
+                break;
+            case '\n':
+                put('n');
+                break;
+            case '\r':
+                put('r');
+                break;
+            case '\t':
+                put('t');
+                break;
+            default:
+                put('u');
+                put('0');
+                put('0');
+                put(HEX[(aCharacter >> 4) & 0xF]);
+                put(HEX[aCharacter & 0xF]);
+                break;
+            }
+        }
+
+        static SOLAIRE_FORCE_INLINE bool needsEscape(const char aCharacter) throw() {
+            return aCharacter == '"' || aCharacter == '\\' || static_cast<uint8_t>(aCharacter) < 0x20;
+        }
+
+        void putQuoted(const char* const aCharacters, const uint32_t aLength) throw() {
+            put('"');
+            uint32_t begin = 0;
+            for(uint32_t i = 0; i < aLength; ++i) {
+                if(needsEscape(aCharacters[i])) {
+                    // Copy the run of characters before the escape in one step
+                    putBytes(aCharacters + begin, i - begin);
+                    putEscaped(aCharacters[i]);
+                    begin = i + 1;
+                }
+            }
+            putBytes(aCharacters + begin, aLength - begin);
+            put('"');
+        }
+
+        void putQuoted(const StringConstant<char>& aString) throw() {
+            put('"');
+            const int32_t size = aString.size();
+            for(int32_t i = 0; i < size; ++i) {
+                const char character = aString[i];
+                if(needsEscape(character)) {
+                    putEscaped(character);
+                }else {
+                    put(character);
+                }
+            }
+            put('"');
+        }
+
+        SOLAIRE_FORCE_INLINE void beginValue() throw() {
+            if(mNeedsComma) put(',');
+        }
+
+        SOLAIRE_FORCE_INLINE bool endValue() throw() {
+            mNeedsComma = true;
+            return ! mFailed;
+        }
+    public:
+        JsonWriter(OStream& aStream) throw() :
+            mStream(aStream),
+            mSize(0),
+            mNeedsComma(false),
+            mFailed(false)
+        {}
+
+        SOLAIRE_EXPORT_CALL ~JsonWriter() {
+            flush();
+        }
+
+        // Inherited from Writer
+
+        bool SOLAIRE_EXPORT_CALL beginArray(const int32_t aSize) throw() override {
+            beginValue();
+            put('[');
+            mNeedsComma = false;
+            return ! mFailed;
+        }
+
+        bool SOLAIRE_EXPORT_CALL endArray() throw() override {
+            put(']');
+            return endValue();
+        }
+
+        bool SOLAIRE_EXPORT_CALL beginObject(const int32_t aSize) throw() override {
+            beginValue();
+            put('{');
+            mNeedsComma = false;
+            return ! mFailed;
+        }
+
+        bool SOLAIRE_EXPORT_CALL endObject() throw() override {
+            put('}');
+            return endValue();
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeName(const StringConstant<char>& aName) throw() override {
+            beginValue();
+            putQuoted(aName);
+            put(':');
+            mNeedsComma = false;
+            return ! mFailed;
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeName(const char* const aName, const uint32_t aLength) throw() override {
+            beginValue();
+            putQuoted(aName, aLength);
+            put(':');
+            mNeedsComma = false;
+            return ! mFailed;
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeNull() throw() override {
+            beginValue();
+            putBytes("null", 4);
+            return endValue();
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeChar(const char aValue) throw() override {
+            beginValue();
+            putQuoted(&aValue, 1);
+            return endValue();
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeBool(const bool aValue) throw() override {
+            beginValue();
+            if(aValue) {
+                putBytes("true", 4);
+            }else {
+                putBytes("false", 5);
+            }
+            return endValue();
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeUnsigned(const uint64_t aValue) throw() override {
+            beginValue();
+            char buffer[NumberFormat::MAX_UNSIGNED_CHARACTERS];
+            putBytes(buffer, NumberFormat::formatUnsigned(aValue, buffer));
+            return endValue();
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeSigned(const int64_t aValue) throw() override {
+            beginValue();
+            char buffer[NumberFormat::MAX_SIGNED_CHARACTERS];
+            putBytes(buffer, NumberFormat::formatSigned(aValue, buffer));
+            return endValue();
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeDouble(const double aValue) throw() override {
+            beginValue();
+            if(std::isfinite(aValue)) {
+                char buffer[NumberFormat::MAX_DOUBLE_CHARACTERS];
+                putBytes(buffer, NumberFormat::formatDouble(aValue, buffer));
+            }else {
+                // JSON has no representation of infinity or not a number
+                putBytes("null", 4);
+            }
+            return endValue();
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeString(const StringConstant<char>& aValue) throw() override {
+            beginValue();
+            putQuoted(aValue);
+            return endValue();
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeString(const char* const aValue, const uint32_t aLength) throw() override {
+            beginValue();
+            putQuoted(aValue, aLength);
+            return endValue();
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeFragment(const void* const aBytes, const uint32_t aLength) throw() override {
+            if(aLength == 0) return ! mFailed;
+            beginValue();
+            if(aLength < BUFFER_BYTES) {
+                putBytes(static_cast<const char*>(aBytes), aLength);
+            }else if(flush() && mStream.write(aBytes, aLength) != aLength) {
+                mFailed = true;
+            }
+            return endValue();
+        }
+
+        bool SOLAIRE_EXPORT_CALL flush() throw() override {
+            if(mSize > 0) {
+                if(mStream.write(mBuffer, mSize) != mSize) mFailed = true;
+                mSize = 0;
+            }
+            return ! mFailed;
+        }
+    };
+
+    // JsonReader
+
+    class JsonReader : public Reader {
+    private:
+        enum : uint32_t {
+            MAX_DEPTH = 512
+        };
+    private:
+        Allocator& mAllocator;
+        IStream& mStream;
+        BufferIStream* const mBuffer;
+        const char* mText;
+        char* mOwnedText;
+        uint32_t* mTokens;
+        int32_t mStreamOffset;
+        uint32_t mConsumed;
+        uint32_t mLength;
+        uint32_t mTokenCount;
+        uint32_t mToken;
+        uint32_t mDepth;
+        const bool mBorrowStrings;
+        bool mFailed;
+        char mFrames[MAX_DEPTH];
+    private:
+        JsonReader(const JsonReader&) = delete;
+        JsonReader& operator=(const JsonReader&) = delete;
+
+        bool fail() throw() {
+            mFailed = true;
+            return false;
+        }
+
+        bool load(IStream& aStream, BufferIStream* const aBuffer) throw() {
+            if(aBuffer) {
+                // Index the caller's memory in place, it is only consumed as each top level value is completed
+                mLength = aBuffer->getRemaining();
+                mText = static_cast<const char*>(aBuffer->getData()) + (aBuffer->getSize() - mLength);
+            }else {
+                if(aStream.isOffsetable()) mStreamOffset = aStream.getOffset();
+                uint32_t capacity = INITIAL_TEXT_BYTES;
+                mOwnedText = static_cast<char*>(mAllocator.allocate(capacity));
+                if(mOwnedText == nullptr) return fail();
+                while(true) {
+                    if(mLength == capacity) {
+                        char* const text = static_cast<char*>(mAllocator.allocate(capacity * 2));
+                        if(text == nullptr) return fail();
+                        std::memcpy(text, mOwnedText, mLength);
+                        mAllocator.deallocate(mOwnedText);
+                        mOwnedText = text;
+                        capacity *= 2;
+                    }
+                    const uint32_t count = aStream.read(mOwnedText + mLength, capacity - mLength);
+                    if(count == 0) break;
+                    mLength += count;
+                }
+                mText = mOwnedText;
+            }
+
+            mTokens = static_cast<uint32_t*>(mAllocator.allocate(sizeof(uint32_t) * (mLength + 1)));
+            if(mTokens == nullptr) return fail();
+            JsonIndexer indexer;
+            mTokenCount = indexer.index(mText, mLength, 0, mTokens);
+            return ! indexer.isInString() || fail();
+        }
+
+        SOLAIRE_FORCE_INLINE uint32_t getPosition() const throw() {
+            return mTokens[mToken];
+        }
+
+        SOLAIRE_FORCE_INLINE char getToken() const throw() {
+            return mToken < mTokenCount ? mText[mTokens[mToken]] : '\0';
+        }
+
+        uint32_t getScalarEnd(uint32_t aPosition) const throw() {
+            while(aPosition < mLength && ! isDelimiter(mText[aPosition])) ++aPosition;
+            return aPosition;
+        }
+
+        bool isLiteral(const char* const aLiteral, const uint32_t aLength) const throw() {
+            const uint32_t position = getPosition();
+            return getScalarEnd(position) - position == aLength && std::memcmp(mText + position, aLiteral, aLength) == 0;
+        }
+
+        uint32_t getValueEnd() const throw() {
+            const uint32_t position = getPosition();
+            const char token = mText[position];
+            if(token == ']' || token == '}') return position + 1;
+            if(token != '"') return getScalarEnd(position);
+            uint32_t length;
+            bool escaped;
+            return scanString(position, length, escaped) ? position + length + 2 : mLength;
+        }
+
+        bool endDocument() throw() {
+            // Only the value and the whitespace after it are consumed, so the stream may contain further documents
+            const uint32_t end = getValueEnd();
+            ++mToken;
+            const uint32_t next = mToken < mTokenCount ? getPosition() : mLength;
+            for(uint32_t i = end; i < next; ++i) {
+                if(static_cast<uint8_t>(mText[i]) > 0x20) return fail();
+            }
+            const char token = getToken();
+            if(token == ']' || token == '}' || token == ',' || token == ':') return fail();
+            // Numbers and literals must be separated from the value before them
+            if(next == end && token != '\0' && token != '[' && token != '{' && token != '"') return fail();
+            if(mBuffer) {
+                mBuffer->borrow(next - mConsumed);
+            }else if(mStreamOffset >= 0) {
+                mStream.setOffset(mStreamOffset + static_cast<int32_t>(next));
+            }
+            mConsumed = next;
+            return true;
+        }
+
+        bool finishValue() throw() {
+            if(mDepth == 0) return endDocument();
+            ++mToken;
+            const char token = getToken();
+            if(token == ',') {
+                ++mToken;
+                // A comma must be followed by another element
+                const char next = getToken();
+                return (next != ']' && next != '}') || fail();
+            }
+            return token == mFrames[mDepth - 1] || fail();
+        }
+
+        bool push(const char aClose) throw() {
+            if(mDepth == MAX_DEPTH) return fail();
+            mFrames[mDepth++] = aClose;
+            ++mToken;
+            return getToken() != ',' || fail();
+        }
+
+        bool pop(const char aClose) throw() {
+            if(mFailed || mDepth == 0 || mFrames[mDepth - 1] != aClose) return fail();
+            while(hasNext()) {
+                if(aClose == '}' && ! skipName()) return false;
+                if(! skip()) return false;
+            }
+            if(mFailed || getToken() != aClose) return fail();
+            --mDepth;
+            return finishValue();
+        }
+
+        bool findClose() throw() {
+            // Containers are skipped by walking the index to the matching close
+            uint32_t depth = 0;
+            while(mToken < mTokenCount) {
+                const char c = mText[mTokens[mToken]];
+                if(c == '[' || c == '{') {
+                    ++depth;
+                }else if(c == ']' || c == '}') {
+                    if(--depth == 0) return true;
+                }
+                ++mToken;
+            }
+            return fail();
+        }
+
+        bool skipName() throw() {
+            if(getToken() != '"') return fail();
+            ++mToken;
+            if(getToken() != ':') return fail();
+            ++mToken;
+            return true;
+        }
+
+        bool scanString(const uint32_t aPosition, uint32_t& aLength, bool& aEscaped) const throw() {
+            const char* const begin = mText + aPosition + 1;
+            const char* const end = mText + mLength;
+            bool escaped = false;
+            for(const char* i = begin; i < end; ++i) {
+                if(*i == '"') {
+                    aLength = static_cast<uint32_t>(i - begin);
+                    aEscaped = escaped;
+                    return true;
+                }else if(*i == '\\') {
+                    escaped = true;
+                    ++i;
+                }
+            }
+            return false;
+        }
+
+        static bool readHex(const char* const aBegin, uint32_t& aValue) throw() {
+            uint32_t value = 0;
+            for(uint32_t i = 0; i < 4; ++i) {
+                const char c = aBegin[i];
+                value <<= 4;
+                if(c >= '0' && c <= '9') {
+                    value |= c - '0';
+                }else if(c >= 'a' && c <= 'f') {
+                    value |= c - 'a' + 10;
+                }else if(c >= 'A' && c <= 'F') {
+                    value |= c - 'A' + 10;
+                }else {
+                    return false;
+                }
+            }
+            aValue = value;
+            return true;
+        }
+
+        bool decodeString(String<char>& aString) throw() {
+            const char* i = mText + getPosition() + 1;
+            const char* const end = mText + mLength;
+            while(i < end) {
+                const char c = *(i++);
+                if(c == '"') {
+                    return true;
+                }else if(static_cast<uint8_t>(c) < 0x20) {
+                    return fail();
+                }else if(c != '\\') {
+                    aString.pushBack(c);
+                    continue;
+                }
+
+                if(i == end) return fail();
+                switch(*(i++)) {
+                case '"':
+                    aString.pushBack('"');
+                    break;
+                case '\\':
+                    aString.pushBack('\\');
+                    break;
+                case '/':
+                    aString.pushBack('/');
+                    break;
+                case 'b':
+                    aString.pushBack('\b');
+                    break;
+                case 'f':
+                    aString.pushBack('\f');
+                    break;
+                case 'n':
+                    aString.pushBack('\n');
+                    break;
+                case 'r':
+                    aString.pushBack('\r');
+                    break;
+                case 't':
+                    aString.pushBack('\t');
+                    break;
+                case 'u':
+                    {
+                        uint32_t code;
+                        if(end - i < 4 || ! readHex(i, code)) return fail();
+                        i += 4;
+                        if(code >= 0xD800 && code <= 0xDBFF) {
+                            // Characters outside of the basic multilingual plane are written as a surrogate pair
+                            uint32_t low;
+                            if(end - i < 6 || i[0] != '\\' || i[1] != 'u' || ! readHex(i + 2, low)) return fail();
+                            if(low < 0xDC00 || low > 0xDFFF) return fail();
+                            i += 6;
+                            code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                        }else if(code >= 0xDC00 && code <= 0xDFFF) {
+                            return fail();
+                        }
+                        appendUtf8(aString, code);
+                    }
+                    break;
+                default:
+                    return fail();
+                }
+            }
+            return fail();
+        }
+
+        bool readNumber(GenericValue& aValue) throw() {
+            const uint32_t position = getPosition();
+            const char* const begin = mText + position;
+            const uint32_t length = getScalarEnd(position) - position;
+
+            if(begin[0] == '-') {
+                int64_t value;
+                if(NumberFormat::parseSigned(begin, length, value) == length) {
+                    aValue.setSigned(value);
+                    return true;
+                }
+            }else {
+                uint64_t value;
+                if(NumberFormat::parseUnsigned(begin, length, value) == length) {
+                    aValue.setUnsigned(value);
+                    return true;
+                }
+            }
+
+            // Fractions, exponents and integers that do not fit in 64 bits
+            return NumberFormat::parseDouble(begin, length, aValue.setDouble(0.0)) == length || fail();
+        }
+
+        GenericValue::ValueType getNumberType() throw() {
+            const uint32_t position = getPosition();
+            const uint32_t end = getScalarEnd(position);
+            const bool negative = mText[position] == '-';
+            uint32_t digits = 0;
+            for(uint32_t i = negative ? position + 1 : position; i < end; ++i) {
+                if(! isDigit(mText[i])) return GenericValue::DOUBLE_T;
+                ++digits;
+            }
+            // 19 digits always fit in 64 bits, longer integers are checked exactly
+            if(digits >= 19) {
+                GenericValue value;
+                if(! readNumber(value)) return GenericValue::NULL_T;
+                return value.getType();
+            }
+            return negative ? GenericValue::SIGNED_T : GenericValue::UNSIGNED_T;
+        }
+
+        bool readScalar(GenericValue& aValue) throw() {
+            switch(peekType()) {
+            case GenericValue::NULL_T:
+                if(mFailed || ! isLiteral("null", 4)) return fail();
+                break;
+            case GenericValue::BOOL_T:
+                if(isLiteral("true", 4)) {
+                    aValue.setBool(true);
+                }else if(isLiteral("false", 5)) {
+                    aValue.setBool(false);
+                }else {
+                    return fail();
+                }
+                break;
+            case GenericValue::UNSIGNED_T:
+            case GenericValue::SIGNED_T:
+            case GenericValue::DOUBLE_T:
+                if(! readNumber(aValue)) return false;
+                break;
+            case GenericValue::STRING_T:
+                if(! decodeString(aValue.setString())) return false;
+                break;
+            default:
+                return skip();
+            }
+            return finishValue();
+        }
+    public:
+        JsonReader(Allocator& aAllocator, IStream& aStream, BufferIStream* const aBuffer, const bool aBorrowStrings) throw() :
+            mAllocator(aAllocator),
+            mStream(aStream),
+            mBuffer(aBuffer),
+            mText(nullptr),
+            mOwnedText(nullptr),
+            mTokens(nullptr),
+            mStreamOffset(-1),
+            mConsumed(0),
+            mLength(0),
+            mTokenCount(0),
+            mToken(0),
+            mDepth(0),
+            mBorrowStrings(aBorrowStrings && aBuffer != nullptr),
+            mFailed(false)
+        {
+            load(aStream, aBuffer);
+        }
+
+        SOLAIRE_EXPORT_CALL ~JsonReader() {
+            if(mOwnedText) mAllocator.deallocate(mOwnedText);
+            if(mTokens) mAllocator.deallocate(mTokens);
+        }
+
+        // Inherited from Reader
+
+        GenericValue::ValueType SOLAIRE_EXPORT_CALL peekType() throw() override {
+            if(mFailed) return GenericValue::NULL_T;
+            switch(getToken()) {
+            case '"':
+                return GenericValue::STRING_T;
+            case '[':
+                return GenericValue::ARRAY_T;
+            case '{':
+                return GenericValue::OBJECT_T;
+            case 't':
+            case 'f':
+                return GenericValue::BOOL_T;
+            case 'n':
+                return GenericValue::NULL_T;
+            case '-':
+            case '0':
+            case '1':
+            case '2':
+            case '3':
+            case '4':
+            case '5':
+            case '6':
+            case '7':
+            case '8':
+            case '9':
+                return getNumberType();
+            default:
+                fail();
+                return GenericValue::NULL_T;
+            }
+        }
+
+        bool SOLAIRE_EXPORT_CALL hasNext() throw() override {
+            return ! mFailed && mDepth > 0 && mToken < mTokenCount && getToken() != mFrames[mDepth - 1];
+        }
+
+        bool SOLAIRE_EXPORT_CALL hasFailed() const throw() override {
+            return mFailed;
+        }
+
+        bool SOLAIRE_EXPORT_CALL beginArray(int32_t& aSize) throw() override {
+            if(mFailed || getToken() != '[') return fail();
+            aSize = UNKNOWN_SIZE;
+            return push(']');
+        }
+
+        bool SOLAIRE_EXPORT_CALL endArray() throw() override {
+            return pop(']');
+        }
+
+        bool SOLAIRE_EXPORT_CALL beginObject(int32_t& aSize) throw() override {
+            if(mFailed || getToken() != '{') return fail();
+            aSize = UNKNOWN_SIZE;
+            return push('}');
+        }
+
+        bool SOLAIRE_EXPORT_CALL endObject() throw() override {
+            return pop('}');
+        }
+
+        bool SOLAIRE_EXPORT_CALL readName(String<char>& aName) throw() override {
+            if(mFailed || mDepth == 0 || mFrames[mDepth - 1] != '}' || getToken() != '"') return fail();
+            if(! decodeString(aName)) return false;
+            ++mToken;
+            if(getToken() != ':') return fail();
+            ++mToken;
+            return true;
+        }
+
+        bool SOLAIRE_EXPORT_CALL readName(char* const aName, const uint32_t aCapacity, uint32_t& aLength) throw() override {
+            if(mFailed || mDepth == 0 || mFrames[mDepth - 1] != '}' || getToken() != '"') return fail();
+            uint32_t length;
+            bool escaped;
+            if(! scanString(getPosition(), length, escaped)) return fail();
+            // Names with escape sequences are decoded into a copy first
+            if(escaped) return Reader::readName(aName, aCapacity, aLength);
+            std::memcpy(aName, mText + getPosition() + 1, length < aCapacity ? length : aCapacity);
+            aLength = length;
+            ++mToken;
+            if(getToken() != ':') return fail();
+            ++mToken;
+            return true;
+        }
+
+        bool SOLAIRE_EXPORT_CALL readNull() throw() override {
+            if(mFailed || getToken() != 'n' || ! isLiteral("null", 4)) return fail();
+            return finishValue();
+        }
+
+        bool SOLAIRE_EXPORT_CALL readChar(char& aValue) throw() override {
+            GenericValue value;
+            if(! readScalar(value)) return false;
+            aValue = value.getChar();
+            return true;
+        }
+
+        bool SOLAIRE_EXPORT_CALL readBool(bool& aValue) throw() override {
+            GenericValue value;
+            if(! readScalar(value)) return false;
+            aValue = value.getBool();
+            return true;
+        }
+
+        bool SOLAIRE_EXPORT_CALL readUnsigned(uint64_t& aValue) throw() override {
+            GenericValue value;
+            if(! readScalar(value)) return false;
+            aValue = value.getUnsigned();
+            return true;
+        }
+
+        bool SOLAIRE_EXPORT_CALL readSigned(int64_t& aValue) throw() override {
+            GenericValue value;
+            if(! readScalar(value)) return false;
+            aValue = value.getSigned();
+            return true;
+        }
+
+        bool SOLAIRE_EXPORT_CALL readDouble(double& aValue) throw() override {
+            GenericValue value;
+            if(! readScalar(value)) return false;
+            aValue = value.getDouble();
+            return true;
+        }
+
+        bool SOLAIRE_EXPORT_CALL readString(String<char>& aValue) throw() override {
+            switch(peekType()) {
+            case GenericValue::STRING_T:
+                return decodeString(aValue) && finishValue();
+            case GenericValue::ARRAY_T:
+            case GenericValue::OBJECT_T:
+                return skip();
+            default:
+                {
+                    // The text of a number or literal is already its string form
+                    if(mFailed) return false;
+                    const uint32_t position = getPosition();
+                    const uint32_t end = getScalarEnd(position);
+                    for(uint32_t i = position; i < end; ++i) aValue.pushBack(mText[i]);
+                    return finishValue();
+                }
+            }
+        }
+
+        const char* SOLAIRE_EXPORT_CALL borrowString(uint32_t& aLength) throw() override {
+            if(! mBorrowStrings || mFailed || getToken() != '"') return nullptr;
+            uint32_t length;
+            bool escaped;
+            if(! scanString(getPosition(), length, escaped)) {
+                fail();
+                return nullptr;
+            }
+            // Escaped strings must be decoded into a copy
+            if(escaped) return nullptr;
+            const char* const characters = mText + getPosition() + 1;
+            for(uint32_t i = 0; i < length; ++i) {
+                if(static_cast<uint8_t>(characters[i]) < 0x20) {
+                    fail();
+                    return nullptr;
+                }
+            }
+            if(! finishValue()) return nullptr;
+            aLength = length;
+            return characters;
+        }
+
+        const void* SOLAIRE_EXPORT_CALL borrowValue(uint32_t& aSize) throw() override {
+            // Text that was read from a stream is owned by the Reader and released with it
+            const char token = getToken();
+            if(mFailed || mOwnedText || (token != '[' && token != '{')) return nullptr;
+            const uint32_t begin = getPosition();
+            if(! findClose()) return nullptr;
+            aSize = getPosition() + 1 - begin;
+            if(! finishValue()) return nullptr;
+            return mText + begin;
+        }
+
+        bool SOLAIRE_EXPORT_CALL skip() throw() override {
+            if(mFailed) return false;
+            const char token = getToken();
+            if(token == '[' || token == '{') return findClose() && finishValue();
+            if(token == ',' || token == ':' || token == ']' || token == '}' || token == '\0') return fail();
+            return finishValue();
+        }
+    };
+
+    // JsonParser
+
+    class JsonParser : public Parser {
+    private:
+        enum : uint32_t {
+            MAX_DEPTH = 512
+        };
+        enum State : uint8_t {
+            STATE_VALUE,            //!< Expecting a value.
+            STATE_FIRST_ELEMENT,    //!< Expecting a value or the end of an empty array.
+            STATE_FIRST_NAME,       //!< Expecting a name or the end of an empty object.
+            STATE_NAME,             //!< Expecting a name after a comma.
+            STATE_COLON,            //!< Expecting the colon after a name.
+            STATE_NEXT,             //!< Expecting a comma or the end of the current container.
+            STATE_STRING,           //!< Inside a string.
+            STATE_ESCAPE,           //!< After a backslash inside a string.
+            STATE_HEX,              //!< Inside the digits of a \u escape sequence.
+            STATE_LOW_ESCAPE,       //!< Expecting the backslash of the second half of a surrogate pair.
+            STATE_LOW_U,            //!< Expecting the u of the second half of a surrogate pair.
+            STATE_SCALAR,           //!< Inside a number or literal.
+            STATE_DONE,             //!< A complete value is waiting to be taken.
+            STATE_FAILED
+        };
+    private:
+        GenericValue mRoot;
+        CString mName;
+        CString mScalar;
+        String<char>* mString;
+        uint32_t mDepth;
+        uint32_t mCode;
+        uint32_t mHighSurrogate;
+        uint8_t mHexDigits;
+        State mState;
+        bool mInName;
+        GenericValue* mFrames[MAX_DEPTH];
+    private:
+        JsonParser(const JsonParser&) = delete;
+        JsonParser& operator=(const JsonParser&) = delete;
+
+        bool fail() throw() {
+            mState = STATE_FAILED;
+            return false;
+        }
+
+        static int32_t getHexDigit(const char aCharacter) throw() {
+            if(aCharacter >= '0' && aCharacter <= '9') return aCharacter - '0';
+            if(aCharacter >= 'a' && aCharacter <= 'f') return aCharacter - 'a' + 10;
+            if(aCharacter >= 'A' && aCharacter <= 'F') return aCharacter - 'A' + 10;
+            return -1;
+        }
+
+        GenericValue& beginValue() throw() {
+            // Only the innermost open container is modified, so the pointers to the others stay valid
+            if(mDepth == 0) return mRoot;
+            GenericValue& container = *mFrames[mDepth - 1];
+            return container.isArray() ? container.pushBack(GenericValue()) : container.emplace(mName, GenericValue());
+        }
+
+        void endValue() throw() {
+            mState = mDepth == 0 ? STATE_DONE : STATE_NEXT;
+        }
+
+        bool push(GenericValue& aContainer, const State aState) throw() {
+            if(mDepth == MAX_DEPTH) return fail();
+            mFrames[mDepth++] = &aContainer;
+            mState = aState;
+            return true;
+        }
+
+        bool pop(const char aClose) throw() {
+            if(mFrames[mDepth - 1]->isArray() != (aClose == ']')) return fail();
+            --mDepth;
+            endValue();
+            return true;
+        }
+
+        void beginString(const bool aIsName) throw() {
+            mInName = aIsName;
+            if(aIsName) {
+                mName.clear();
+                mString = &mName;
+            }else {
+                mString = &beginValue().setString();
+            }
+            mHighSurrogate = 0;
+            mState = STATE_STRING;
+        }
+
+        bool openValue(const char aCharacter) throw() {
+            // The first character of a value selects its type
+            switch(aCharacter) {
+            case '"':
+                beginString(false);
+                return true;
+            case '[':
+                {
+                    GenericValue& value = beginValue();
+                    value.setArray();
+                    return push(value, STATE_FIRST_ELEMENT);
+                }
+            case '{':
+                {
+                    GenericValue& value = beginValue();
+                    value.setObject();
+                    return push(value, STATE_FIRST_NAME);
+                }
+            default:
+                if(isDelimiter(aCharacter)) return fail();
+                mScalar.clear();
+                mScalar.pushBack(aCharacter);
+                mState = STATE_SCALAR;
+                return true;
+            }
+        }
+
+        bool endScalar() throw() {
+            const char* const begin = &mScalar[0];
+            const uint32_t length = static_cast<uint32_t>(mScalar.size());
+            GenericValue& value = beginValue();
+            if(begin[0] == '-' || isDigit(begin[0])) {
+                uint64_t unsignedValue;
+                int64_t signedValue;
+                if(begin[0] != '-' && NumberFormat::parseUnsigned(begin, length, unsignedValue) == length) {
+                    value.setUnsigned(unsignedValue);
+                }else if(begin[0] == '-' && NumberFormat::parseSigned(begin, length, signedValue) == length) {
+                    value.setSigned(signedValue);
+                }else if(NumberFormat::parseDouble(begin, length, value.setDouble(0.0)) != length) {
+                    // Fractions, exponents and integers that do not fit in 64 bits are parsed as doubles
+                    return fail();
+                }
+            }else if(length == 4 && std::memcmp(begin, "true", 4) == 0) {
+                value.setBool(true);
+            }else if(length == 5 && std::memcmp(begin, "false", 5) == 0) {
+                value.setBool(false);
+            }else if(length != 4 || std::memcmp(begin, "null", 4) != 0) {
+                return fail();
+            }
+            endValue();
+            return true;
+        }
+
+        bool escape(const char aCharacter) throw() {
+            switch(aCharacter) {
+            case '"':
+            case '\\':
+            case '/':
+                mString->pushBack(aCharacter);
+                break;
+            case 'b':
+                mString->pushBack('\b');
+                break;
+            case 'f':
+                mString->pushBack('\f');
+                break;
+            case 'n':
+                mString->pushBack('\n');
+                break;
+            case 'r':
+                mString->pushBack('\r');
+                break;
+            case 't':
+                mString->pushBack('\t');
+                break;
+            case 'u':
+                mCode = 0;
+                mHexDigits = 0;
+                mState = STATE_HEX;
+                return true;
+            default:
+                return fail();
+            }
+            mState = STATE_STRING;
+            return true;
+        }
+
+        bool appendCode() throw() {
+            if(mHighSurrogate != 0) {
+                if(mCode < 0xDC00 || mCode > 0xDFFF) return fail();
+                appendUtf8(*mString, 0x10000 + ((mHighSurrogate - 0xD800) << 10) + (mCode - 0xDC00));
+                mHighSurrogate = 0;
+            }else if(mCode >= 0xD800 && mCode <= 0xDBFF) {
+                // Characters outside of the basic multilingual plane are written as a surrogate pair
+                mHighSurrogate = mCode;
+                mState = STATE_LOW_ESCAPE;
+                return true;
+            }else if(mCode >= 0xDC00 && mCode <= 0xDFFF) {
+                return fail();
+            }else {
+                appendUtf8(*mString, mCode);
+            }
+            mState = STATE_STRING;
+            return true;
+        }
+
+        bool step(const char aCharacter) throw() {
+            // Returns false when the character has not been consumed and must be examined again in the new state
+            const bool space = static_cast<uint8_t>(aCharacter) <= 0x20;
+            switch(mState) {
+            case STATE_VALUE:
+                if(! space) openValue(aCharacter);
+                return true;
+            case STATE_FIRST_ELEMENT:
+                if(space) return true;
+                if(aCharacter == ']') {
+                    pop(']');
+                }else {
+                    openValue(aCharacter);
+                }
+                return true;
+            case STATE_FIRST_NAME:
+                if(space) return true;
+                if(aCharacter == '}') {
+                    pop('}');
+                }else if(aCharacter == '"') {
+                    beginString(true);
+                }else {
+                    fail();
+                }
+                return true;
+            case STATE_NAME:
+                if(space) return true;
+                if(aCharacter == '"') {
+                    beginString(true);
+                }else {
+                    fail();
+                }
+                return true;
+            case STATE_COLON:
+                if(aCharacter == ':') {
+                    mState = STATE_VALUE;
+                }else if(! space) {
+                    fail();
+                }
+                return true;
+            case STATE_NEXT:
+                if(space) return true;
+                if(aCharacter == ',') {
+                    mState = mFrames[mDepth - 1]->isArray() ? STATE_VALUE : STATE_NAME;
+                }else if(aCharacter == ']' || aCharacter == '}') {
+                    pop(aCharacter);
+                }else {
+                    fail();
+                }
+                return true;
+            case STATE_STRING:
+                if(aCharacter == '"') {
+                    if(mInName) {
+                        mState = STATE_COLON;
+                    }else {
+                        endValue();
+                    }
+                }else if(aCharacter == '\\') {
+                    mState = STATE_ESCAPE;
+                }else if(static_cast<uint8_t>(aCharacter) < 0x20) {
+                    fail();
+                }else {
+                    mString->pushBack(aCharacter);
+                }
+                return true;
+            case STATE_ESCAPE:
+                escape(aCharacter);
+                return true;
+            case STATE_HEX:
+                {
+                    const int32_t digit = getHexDigit(aCharacter);
+                    if(digit < 0) {
+                        fail();
+                    }else {
+                        mCode = (mCode << 4) | static_cast<uint32_t>(digit);
+                        if(++mHexDigits == 4) appendCode();
+                    }
+                }
+                return true;
+            case STATE_LOW_ESCAPE:
+                if(aCharacter == '\\') {
+                    mState = STATE_LOW_U;
+                }else {
+                    fail();
+                }
+                return true;
+            case STATE_LOW_U:
+                if(aCharacter == 'u') {
+                    mCode = 0;
+                    mHexDigits = 0;
+                    mState = STATE_HEX;
+                }else {
+                    fail();
+                }
+                return true;
+            case STATE_SCALAR:
+                if(isDelimiter(aCharacter)) {
+                    endScalar();
+                    return false;
+                }
+                mScalar.pushBack(aCharacter);
+                return true;
+            default:
+                return false;
+            }
+        }
+    public:
+        JsonParser(Allocator& aAllocator) throw() :
+            mName(aAllocator),
+            mScalar(aAllocator),
+            mString(nullptr),
+            mDepth(0),
+            mCode(0),
+            mHighSurrogate(0),
+            mHexDigits(0),
+            mState(STATE_VALUE),
+            mInName(false)
+        {}
+
+        // Inherited from Parser
+
+        uint32_t SOLAIRE_EXPORT_CALL parse(const void* const aData, const uint32_t aSize) throw() override {
+            const char* const text = static_cast<const char*>(aData);
+            uint32_t i = 0;
+            while(i < aSize && mState < STATE_DONE) {
+                if(step(text[i])) ++i;
+            }
+            return i;
+        }
+
+        bool SOLAIRE_EXPORT_CALL finish() throw() override {
+            // A number or literal at the top level is only terminated by the end of the input
+            if(mState == STATE_SCALAR && mDepth == 0) endScalar();
+            return mState == STATE_DONE || (mState == STATE_VALUE && mDepth == 0) || fail();
+        }
+
+        bool SOLAIRE_EXPORT_CALL hasValue() const throw() override {
+            return mState == STATE_DONE;
+        }
+
+        bool SOLAIRE_EXPORT_CALL hasFailed() const throw() override {
+            return mState == STATE_FAILED;
+        }
+
+        bool SOLAIRE_EXPORT_CALL takeValue(GenericValue& aValue) throw() override {
+            if(mState != STATE_DONE) return false;
+            aValue = std::move(mRoot);
+            mRoot.setNull();
+            mState = STATE_VALUE;
+            return true;
+        }
+
+        void SOLAIRE_EXPORT_CALL reset() throw() override {
+            mRoot.setNull();
+            mDepth = 0;
+            mState = STATE_VALUE;
+        }
+    };
+
+	// JsonFormat
+
+    JsonFormat::JsonFormat(const bool aBorrowStrings) throw() :
+        mBorrowStrings(aBorrowStrings)
+    {}
+
+    GenericValue SOLAIRE_EXPORT_CALL JsonFormat::readValue(IStream& aStream) const throw() {
+        SOLAIRE_STATS_SCOPE(aStream);
+        JsonReader reader(getDefaultAllocator(), aStream, dynamic_cast<BufferIStream*>(&aStream), mBorrowStrings);
+        GenericValue value;
+        if(! reader.readValue(value)) value.setNull();
+        return value;
+    }
+
+    bool SOLAIRE_EXPORT_CALL JsonFormat::writeValue(const GenericValue& aValue, OStream& aStream) const throw() {
+        SOLAIRE_STATS_SCOPE(aStream);
+        JsonWriter writer(aStream);
+        return writer.writeValue(aValue) && writer.flush();
+    }
+
+    Reader* SOLAIRE_EXPORT_CALL JsonFormat::createReader(Allocator& aAllocator, IStream& aStream) const throw() {
+        void* const memory = aAllocator.allocate(sizeof(JsonReader));
+        return memory == nullptr ? nullptr : new(memory) JsonReader(aAllocator, aStream, dynamic_cast<BufferIStream*>(&aStream), mBorrowStrings);
+    }
+
+    Writer* SOLAIRE_EXPORT_CALL JsonFormat::createWriter(Allocator& aAllocator, OStream& aStream) const throw() {
+        void* const memory = aAllocator.allocate(sizeof(JsonWriter));
+        return memory == nullptr ? nullptr : new(memory) JsonWriter(aStream);
+    }
+
+    Parser* SOLAIRE_EXPORT_CALL JsonFormat::createParser(Allocator& aAllocator) const throw() {
+        void* const memory = aAllocator.allocate(sizeof(JsonParser));
+        return memory == nullptr ? nullptr : new(memory) JsonParser(aAllocator);
+    }
+
+    bool SOLAIRE_EXPORT_CALL JsonFormat::findDocuments(const void* const aData, const uint32_t aSize, List<uint32_t>& aEnds) const throw() {
+        const char* const text = static_cast<const char*>(aData);
+        Allocator& allocator = getDefaultAllocator();
+        uint32_t* const positions = static_cast<uint32_t*>(allocator.allocate(sizeof(uint32_t) * DOCUMENT_CHUNK_BYTES));
+        if(positions == nullptr) return false;
+
+        // Only brackets need to be tracked, a token outside of every container begins the next document
+        JsonIndexer indexer;
+        uint32_t depth = 0;
+        bool started = false;
+        bool result = true;
+        for(uint32_t offset = 0; result && offset < aSize; offset += DOCUMENT_CHUNK_BYTES) {
+            const uint32_t length = aSize - offset < DOCUMENT_CHUNK_BYTES ? aSize - offset : static_cast<uint32_t>(DOCUMENT_CHUNK_BYTES);
+            const uint32_t count = indexer.index(text + offset, length, offset, positions);
+            for(uint32_t i = 0; i < count; ++i) {
+                const char token = text[positions[i]];
+                if(depth == 0) {
+                    if(token == ']' || token == '}' || token == ',' || token == ':') {
+                        result = false;
+                        break;
+                    }
+                    if(started) aEnds.pushBack(positions[i]);
+                    started = true;
+                }
+                if(token == '[' || token == '{') {
+                    ++depth;
+                }else if(token == ']' || token == '}') {
+                    --depth;
+                }
+            }
+        }
+
+        allocator.deallocate(positions);
+        if(! result || depth != 0 || indexer.isInString()) return false;
+        if(started) aEnds.pushBack(aSize);
+        return true;
+    }
+}
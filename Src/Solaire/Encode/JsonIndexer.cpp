@@ -0,0 +1,278 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+#include <cstring>
+#include "Solaire/Encode/JsonIndexer.hpp"
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define SOLAIRE_JSON_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define SOLAIRE_JSON_SSE2
+#endif
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+namespace Solaire {
+
+    struct JsonBlock {
+        uint64_t quotes;
+        uint64_t backslashes;
+        uint64_t structurals;
+        uint64_t whitespace;
+    };
+
+    static SOLAIRE_FORCE_INLINE uint32_t countTrailingZeros(const uint64_t aValue) throw() {
+        #if defined(_MSC_VER) && defined(_M_X64)
+            unsigned long index;
+            _BitScanForward64(&index, aValue);
+            return index;
+        #elif defined(_MSC_VER)
+            unsigned long index;
+            if(_BitScanForward(&index, static_cast<uint32_t>(aValue))) return index;
+            _BitScanForward(&index, static_cast<uint32_t>(aValue >> 32));
+            return index + 32;
+        #else
+            return static_cast<uint32_t>(__builtin_ctzll(aValue));
+        #endif
+    }
+
+    static SOLAIRE_FORCE_INLINE uint64_t prefixXor(uint64_t aValue) throw() {
+        // Each bit becomes the parity of itself and every lower bit
+        aValue ^= aValue << 1;
+        aValue ^= aValue << 2;
+        aValue ^= aValue << 4;
+        aValue ^= aValue << 8;
+        aValue ^= aValue << 16;
+        aValue ^= aValue << 32;
+        return aValue;
+    }
+
+#if defined(SOLAIRE_JSON_AVX2)
+
+    static SOLAIRE_FORCE_INLINE uint64_t combineMasks(const __m256i aLow, const __m256i aHigh) throw() {
+        return static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(aLow))) |
+            (static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(aHigh))) << 32);
+    }
+
+    static SOLAIRE_FORCE_INLINE uint64_t matchCharacter(const __m256i aLow, const __m256i aHigh, const char aCharacter) throw() {
+        const __m256i character = _mm256_set1_epi8(aCharacter);
+        return combineMasks(_mm256_cmpeq_epi8(aLow, character), _mm256_cmpeq_epi8(aHigh, character));
+    }
+
+    static SOLAIRE_FORCE_INLINE uint64_t matchBrackets(const __m256i aLow, const __m256i aHigh) throw() {
+        // Setting bit 5 maps [ to { and ] to }
+        const __m256i bit5 = _mm256_set1_epi8(0x20);
+        const __m256i low = _mm256_or_si256(aLow, bit5);
+        const __m256i high = _mm256_or_si256(aHigh, bit5);
+        return matchCharacter(low, high, '{') | matchCharacter(low, high, '}');
+    }
+
+    static SOLAIRE_FORCE_INLINE uint64_t matchWhitespace(const __m256i aLow, const __m256i aHigh) throw() {
+        const __m256i space = _mm256_set1_epi8(0x20);
+        return combineMasks(
+            _mm256_cmpeq_epi8(_mm256_max_epu8(aLow, space), space),
+            _mm256_cmpeq_epi8(_mm256_max_epu8(aHigh, space), space)
+        );
+    }
+
+    static SOLAIRE_FORCE_INLINE void classifyBlock(const char* const aText, JsonBlock& aBlock) throw() {
+        const __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(aText));
+        const __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(aText + 32));
+        aBlock.quotes = matchCharacter(low, high, '"');
+        aBlock.backslashes = matchCharacter(low, high, '\\');
+        aBlock.structurals = matchBrackets(low, high) | matchCharacter(low, high, ':') | matchCharacter(low, high, ',');
+        aBlock.whitespace = matchWhitespace(low, high);
+    }
+
+    const char* JsonIndexer::getImplementation() throw() {
+        return "AVX2";
+    }
+
+#elif defined(SOLAIRE_JSON_SSE2)
+
+    struct SseBlock {
+        __m128i chunks[4];
+    };
+
+    static SOLAIRE_FORCE_INLINE uint64_t combineMasks(const __m128i* const aMasks) throw() {
+        return static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(aMasks[0]))) |
+            (static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(aMasks[1]))) << 16) |
+            (static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(aMasks[2]))) << 32) |
+            (static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(aMasks[3]))) << 48);
+    }
+
+    static SOLAIRE_FORCE_INLINE uint64_t matchCharacter(const SseBlock& aBlock, const char aCharacter) throw() {
+        const __m128i character = _mm_set1_epi8(aCharacter);
+        __m128i masks[4];
+        for(uint32_t i = 0; i < 4; ++i) masks[i] = _mm_cmpeq_epi8(aBlock.chunks[i], character);
+        return combineMasks(masks);
+    }
+
+    static SOLAIRE_FORCE_INLINE uint64_t matchBrackets(const SseBlock& aBlock) throw() {
+        // Setting bit 5 maps [ to { and ] to }
+        const __m128i bit5 = _mm_set1_epi8(0x20);
+        SseBlock block;
+        for(uint32_t i = 0; i < 4; ++i) block.chunks[i] = _mm_or_si128(aBlock.chunks[i], bit5);
+        return matchCharacter(block, '{') | matchCharacter(block, '}');
+    }
+
+    static SOLAIRE_FORCE_INLINE uint64_t matchWhitespace(const SseBlock& aBlock) throw() {
+        const __m128i space = _mm_set1_epi8(0x20);
+        __m128i masks[4];
+        for(uint32_t i = 0; i < 4; ++i) masks[i] = _mm_cmpeq_epi8(_mm_max_epu8(aBlock.chunks[i], space), space);
+        return combineMasks(masks);
+    }
+
+    static SOLAIRE_FORCE_INLINE void classifyBlock(const char* const aText, JsonBlock& aBlock) throw() {
+        SseBlock block;
+        for(uint32_t i = 0; i < 4; ++i) block.chunks[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(aText + i * 16));
+        aBlock.quotes = matchCharacter(block, '"');
+        aBlock.backslashes = matchCharacter(block, '\\');
+        aBlock.structurals = matchBrackets(block) | matchCharacter(block, ':') | matchCharacter(block, ',');
+        aBlock.whitespace = matchWhitespace(block);
+    }
+
+    const char* JsonIndexer::getImplementation() throw() {
+        return "SSE2";
+    }
+
+#else
+
+    enum : uint8_t {
+        CLASS_QUOTE = 1,
+        CLASS_BACKSLASH = 2,
+        CLASS_STRUCTURAL = 4,
+        CLASS_WHITESPACE = 8
+    };
+
+    static uint8_t getCharacterClass(const uint8_t aCharacter) throw() {
+        switch(aCharacter) {
+        case '"':
+            return CLASS_QUOTE;
+        case '\\':
+            return CLASS_BACKSLASH;
+        case '{':
+        case '}':
+        case '[':
+        case ']':
+        case ':':
+        case ',':
+            return CLASS_STRUCTURAL;
+        default:
+            return aCharacter <= 0x20 ? CLASS_WHITESPACE : 0;
+        }
+    }
+
+    static void classifyBlock(const char* const aText, JsonBlock& aBlock) throw() {
+        aBlock.quotes = 0;
+        aBlock.backslashes = 0;
+        aBlock.structurals = 0;
+        aBlock.whitespace = 0;
+        for(uint32_t i = 0; i < JsonIndexer::BLOCK_BYTES; ++i) {
+            const uint8_t characterClass = getCharacterClass(static_cast<uint8_t>(aText[i]));
+            const uint64_t bit = 1ULL << i;
+            if(characterClass & CLASS_QUOTE) aBlock.quotes |= bit;
+            if(characterClass & CLASS_BACKSLASH) aBlock.backslashes |= bit;
+            if(characterClass & CLASS_STRUCTURAL) aBlock.structurals |= bit;
+            if(characterClass & CLASS_WHITESPACE) aBlock.whitespace |= bit;
+        }
+    }
+
+    const char* JsonIndexer::getImplementation() throw() {
+        return "Scalar";
+    }
+
+#endif
+
+	// JsonIndexer
+
+    JsonIndexer::JsonIndexer() throw() :
+        mEscapeCarry(0),
+        mStringCarry(0),
+        mScalarCarry(0)
+    {}
+
+    void JsonIndexer::reset() throw() {
+        mEscapeCarry = 0;
+        mStringCarry = 0;
+        mScalarCarry = 0;
+    }
+
+    uint32_t JsonIndexer::index(const char* const aText, const uint32_t aLength, const uint32_t aOffset, uint32_t* const aPositions) throw() {
+        const uint64_t evenBits = 0x5555555555555555ULL;
+        const uint64_t oddBits = ~evenBits;
+
+        uint32_t count = 0;
+        char padded[BLOCK_BYTES];
+
+        for(uint32_t offset = 0; offset < aLength; offset += BLOCK_BYTES) {
+            const char* block = aText + offset;
+            if(aLength - offset < BLOCK_BYTES) {
+                // The last partial block is padded with whitespace so that it never reads past the text
+                std::memset(padded, ' ', BLOCK_BYTES);
+                std::memcpy(padded, block, aLength - offset);
+                block = padded;
+            }
+
+            JsonBlock masks;
+            classifyBlock(block, masks);
+
+            // Find the characters escaped by an odd length sequence of backslashes
+            const uint64_t backslashes = masks.backslashes;
+            const uint64_t startEdges = backslashes & ~(backslashes << 1);
+            const uint64_t evenStartMask = evenBits ^ mEscapeCarry;
+            const uint64_t evenStarts = startEdges & evenStartMask;
+            const uint64_t oddStarts = startEdges & ~evenStartMask;
+            const uint64_t evenCarries = backslashes + evenStarts;
+            uint64_t oddCarries = backslashes + oddStarts;
+            const uint64_t endsOdd = oddCarries < backslashes ? 1 : 0;
+            oddCarries |= mEscapeCarry;
+            mEscapeCarry = endsOdd;
+            const uint64_t evenCarryEnds = evenCarries & ~backslashes;
+            const uint64_t oddCarryEnds = oddCarries & ~backslashes;
+            const uint64_t escaped = (evenCarryEnds & oddBits) | (oddCarryEnds & evenBits);
+
+            // Mark every character from an opening quote up to, but not including, its closing quote
+            const uint64_t quotes = masks.quotes & ~escaped;
+            const uint64_t inString = prefixXor(quotes) ^ mStringCarry;
+            mStringCarry = static_cast<uint64_t>(static_cast<int64_t>(inString) >> 63);
+
+            // Scalars are runs of characters that are not whitespace, structural or quoted
+            const uint64_t scalars = ~(masks.structurals | masks.whitespace | quotes) & ~inString;
+            const uint64_t scalarStarts = scalars & ~((scalars << 1) | mScalarCarry);
+            mScalarCarry = scalars >> 63;
+
+            uint64_t tokens = (masks.structurals & ~inString) | (quotes & inString) | scalarStarts;
+            const uint32_t base = aOffset + offset;
+            while(tokens != 0) {
+                aPositions[count++] = base + countTrailingZeros(tokens);
+                tokens &= tokens - 1;
+            }
+        }
+
+        return count;
+    }
+
+    bool JsonIndexer::isInString() const throw() {
+        return mStringCarry != 0;
+    }
+}
@@ -0,0 +1,208 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+#include <new>
+#include "Solaire/Encode/KeyTable.hpp"
+#include "Solaire/Encode/GenericObjectMap.hpp"
+#include "Solaire/Encode/StructuralHash.hpp"
+
+namespace Solaire {
+
+    static std::atomic<KeyTable*> gSharedTable(nullptr);
+
+    static bool keyEquals(const KeyTable::Key& aKey, const StringConstant<char>& aName) throw() {
+        const uint32_t length = aKey.getLength();
+        if(static_cast<uint32_t>(aName.size()) != length) return false;
+        const char* const characters = aKey.getCharacters();
+        for(uint32_t i = 0; i < length; ++i) {
+            if(characters[i] != aName[i]) return false;
+        }
+        return true;
+    }
+
+	// KeyTable
+
+    KeyTable::KeyTable(Allocator& aAllocator, const uint32_t aBuckets, const uint32_t aMaxSize) throw() :
+        mAllocator(aAllocator),
+        mBuckets(nullptr),
+        mMaxSize(aMaxSize),
+        mSize(0)
+    {
+        uint32_t count = LOCK_COUNT;
+        while(count < aBuckets) count *= 2;
+        mBuckets.store(createBuckets(count), std::memory_order_relaxed);
+    }
+
+    KeyTable::~KeyTable() throw() {
+        Buckets* const buckets = mBuckets.load(std::memory_order_relaxed);
+        if(buckets == nullptr) return;
+
+        // Every key is linked exactly once in the newest buckets
+        const std::atomic<Link*>* const heads = buckets->getHeads();
+        for(uint32_t i = 0; i <= buckets->mask; ++i) {
+            for(const Link* link = heads[i].load(std::memory_order_relaxed); link; link = link->next) {
+                Key* const key = const_cast<Key*>(link->key);
+                key->~Key();
+                mAllocator.deallocate(key);
+            }
+        }
+        destroyBuckets(buckets);
+    }
+
+    KeyTable::Buckets* KeyTable::createBuckets(const uint32_t aCount) throw() {
+        void* const memory = mAllocator.allocate(sizeof(Buckets) + sizeof(std::atomic<Link*>) * aCount);
+        if(memory == nullptr) return nullptr;
+        Buckets* const buckets = new(memory) Buckets();
+        buckets->previous = nullptr;
+        buckets->mask = aCount - 1;
+        std::atomic<Link*>* const heads = buckets->getHeads();
+        for(uint32_t i = 0; i < aCount; ++i) new(heads + i) std::atomic<Link*>(nullptr);
+        return buckets;
+    }
+
+    void KeyTable::destroyBuckets(Buckets* aBuckets) throw() {
+        while(aBuckets) {
+            Buckets* const previous = aBuckets->previous;
+            std::atomic<Link*>* const heads = aBuckets->getHeads();
+            for(uint32_t i = 0; i <= aBuckets->mask; ++i) {
+                Link* link = heads[i].load(std::memory_order_relaxed);
+                while(link) {
+                    Link* const next = link->next;
+                    mAllocator.deallocate(link);
+                    link = next;
+                }
+                heads[i].~atomic();
+            }
+            aBuckets->~Buckets();
+            mAllocator.deallocate(aBuckets);
+            aBuckets = previous;
+        }
+    }
+
+    void KeyTable::grow() throw() {
+        for(uint32_t i = 0; i < LOCK_COUNT; ++i) mLocks[i].lock();
+
+        // Another thread may have grown the buckets since the load was checked
+        Buckets* const buckets = mBuckets.load(std::memory_order_relaxed);
+        const uint32_t count = buckets->mask + 1;
+        if(mSize.load(std::memory_order_relaxed) > count * MAX_LOAD && count * 2 > count) {
+            Buckets* const newBuckets = createBuckets(count * 2);
+            bool linked = newBuckets != nullptr;
+            if(linked) {
+                const std::atomic<Link*>* const heads = buckets->getHeads();
+                std::atomic<Link*>* const newHeads = newBuckets->getHeads();
+                for(uint32_t i = 0; linked && i < count; ++i) {
+                    for(const Link* link = heads[i].load(std::memory_order_relaxed); link; link = link->next) {
+                        Link* const newLink = static_cast<Link*>(mAllocator.allocate(sizeof(Link)));
+                        if(newLink == nullptr) {
+                            linked = false;
+                            break;
+                        }
+                        std::atomic<Link*>& head = newHeads[link->key->mHash & newBuckets->mask];
+                        newLink->key = link->key;
+                        newLink->next = head.load(std::memory_order_relaxed);
+                        head.store(newLink, std::memory_order_relaxed);
+                    }
+                }
+            }
+
+            // The old buckets are never modified again, readers that loaded them can still walk them safely
+            if(linked) {
+                newBuckets->previous = buckets;
+                mBuckets.store(newBuckets, std::memory_order_release);
+            }else if(newBuckets) {
+                destroyBuckets(newBuckets);
+            }
+        }
+
+        for(uint32_t i = LOCK_COUNT; i > 0; --i) mLocks[i - 1].unlock();
+    }
+
+    const KeyTable::Key* KeyTable::find(const StringConstant<char>& aName, const uint32_t aHash) const throw() {
+        // Links and keys are fully written before they are published at the head of a bucket, and are never modified afterwards
+        const Buckets* const buckets = mBuckets.load(std::memory_order_acquire);
+        if(buckets == nullptr) return nullptr;
+        const Link* link = buckets->getHeads()[aHash & buckets->mask].load(std::memory_order_acquire);
+        while(link) {
+            const Key* const key = link->key;
+            if(key->mHash == aHash && keyEquals(*key, aName)) return key;
+            link = link->next;
+        }
+        return nullptr;
+    }
+
+    const KeyTable::Key* KeyTable::intern(const StringConstant<char>& aName) throw() {
+        const uint32_t hash = GenericObjectMap::hash(aName);
+        const Key* key = find(aName, hash);
+        if(key) return key;
+
+        Key* newKey;
+        bool overloaded;
+        {
+            // A name always uses the same mutex, growing the buckets takes all of them
+            std::lock_guard<std::mutex> lock(mLocks[hash & (LOCK_COUNT - 1)]);
+            Buckets* const buckets = mBuckets.load(std::memory_order_relaxed);
+            if(buckets == nullptr) return nullptr;
+            // Another thread may have added the name since it was looked up
+            key = find(aName, hash);
+            if(key) return key;
+
+            const uint32_t size = mSize.fetch_add(1, std::memory_order_relaxed);
+            const uint32_t length = static_cast<uint32_t>(aName.size());
+            void* const memory = size < mMaxSize ? mAllocator.allocate(sizeof(Key) + length) : nullptr;
+            Link* const link = memory ? static_cast<Link*>(mAllocator.allocate(sizeof(Link))) : nullptr;
+            if(link == nullptr) {
+                if(memory) mAllocator.deallocate(memory);
+                mSize.fetch_sub(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            newKey = new(memory) Key();
+            char* const characters = static_cast<char*>(memory) + sizeof(Key);
+            for(uint32_t i = 0; i < length; ++i) characters[i] = aName[i];
+            newKey->mTable = this;
+            newKey->mNameHash = StructuralHash::hashName(characters, length);
+            newKey->mHash = hash;
+            newKey->mLength = length;
+
+            std::atomic<Link*>& head = buckets->getHeads()[hash & buckets->mask];
+            link->key = newKey;
+            link->next = head.load(std::memory_order_relaxed);
+            head.store(link, std::memory_order_release);
+            overloaded = size + 1 > (buckets->mask + 1) * MAX_LOAD;
+        }
+        if(overloaded) grow();
+        return newKey;
+    }
+
+    const KeyTable::Key* KeyTable::find(const StringConstant<char>& aName) const throw() {
+        return find(aName, GenericObjectMap::hash(aName));
+    }
+
+    uint32_t KeyTable::size() const throw() {
+        return mSize.load(std::memory_order_relaxed);
+    }
+
+    void SOLAIRE_EXPORT_CALL KeyTable::setShared(KeyTable* const aTable) throw() {
+        gSharedTable.store(aTable, std::memory_order_release);
+    }
+
+    KeyTable* SOLAIRE_EXPORT_CALL KeyTable::getShared() throw() {
+        return gSharedTable.load(std::memory_order_acquire);
+    }
+}
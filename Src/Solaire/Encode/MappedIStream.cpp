@@ -0,0 +1,142 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+#include "Solaire/Encode/MappedIStream.hpp"
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace Solaire {
+
+    // An empty file has no mapping, this marks it as open
+    static uint8_t EMPTY_FILE = 0;
+
+	// MappedIStream
+
+    MappedIStream::MappedIStream() throw() :
+        BufferIStream(nullptr, 0),
+        mMapping(nullptr),
+        mHandle(nullptr)
+    {}
+
+    SOLAIRE_EXPORT_CALL MappedIStream::~MappedIStream() throw() {
+        close();
+    }
+
+#if defined(_WIN32)
+
+    bool MappedIStream::open(const char* const aPath) throw() {
+        close();
+        const HANDLE file = CreateFileA(aPath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if(file == INVALID_HANDLE_VALUE) return false;
+
+        LARGE_INTEGER size;
+        if(! GetFileSizeEx(file, &size) || size.QuadPart > UINT32_MAX) {
+            CloseHandle(file);
+            return false;
+        }
+        if(size.QuadPart == 0) {
+            CloseHandle(file);
+            mMapping = &EMPTY_FILE;
+            return true;
+        }
+
+        const HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if(mapping == nullptr) return false;
+        void* const view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if(view == nullptr) {
+            CloseHandle(mapping);
+            return false;
+        }
+
+        mMapping = view;
+        mHandle = mapping;
+        mData = static_cast<const uint8_t*>(view);
+        mSize = static_cast<uint32_t>(size.QuadPart);
+        mOffset = 0;
+        return true;
+    }
+
+    void MappedIStream::close() throw() {
+        if(mMapping != nullptr && mMapping != &EMPTY_FILE) {
+            UnmapViewOfFile(mMapping);
+            CloseHandle(static_cast<HANDLE>(mHandle));
+        }
+        mMapping = nullptr;
+        mHandle = nullptr;
+        mData = nullptr;
+        mSize = 0;
+        mOffset = 0;
+    }
+
+#else
+
+    bool MappedIStream::open(const char* const aPath) throw() {
+        close();
+        const int file = ::open(aPath, O_RDONLY);
+        if(file == -1) return false;
+
+        struct stat status;
+        if(fstat(file, &status) != 0 || static_cast<uint64_t>(status.st_size) > UINT32_MAX) {
+            ::close(file);
+            return false;
+        }
+        if(status.st_size == 0) {
+            ::close(file);
+            mMapping = &EMPTY_FILE;
+            return true;
+        }
+
+        // The mapping remains valid after the descriptor is closed
+        const size_t size = static_cast<size_t>(status.st_size);
+        void* const mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+        ::close(file);
+        if(mapping == MAP_FAILED) return false;
+        madvise(mapping, size, MADV_SEQUENTIAL);
+        madvise(mapping, size, MADV_WILLNEED);
+
+        mMapping = mapping;
+        mData = static_cast<const uint8_t*>(mapping);
+        mSize = static_cast<uint32_t>(size);
+        mOffset = 0;
+        return true;
+    }
+
+    void MappedIStream::close() throw() {
+        if(mMapping != nullptr && mMapping != &EMPTY_FILE) munmap(mMapping, mSize);
+        mMapping = nullptr;
+        mHandle = nullptr;
+        mData = nullptr;
+        mSize = 0;
+        mOffset = 0;
+    }
+
+#endif
+
+    bool MappedIStream::isOpen() const throw() {
+        return mMapping != nullptr;
+    }
+}
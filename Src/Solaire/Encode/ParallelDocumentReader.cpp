@@ -0,0 +1,95 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+#include "Solaire/Encode/ParallelDocumentReader.hpp"
+
+namespace Solaire {
+
+	// ParallelDocumentReader
+
+    ParallelDocumentReader::ParallelDocumentReader(Allocator& aAllocator, const Format& aFormat, WorkerPool& aPool) throw() :
+        mFormat(aFormat),
+        mPool(aPool),
+        mData(nullptr),
+        mEnds(aAllocator)
+    {}
+
+    uint32_t ParallelDocumentReader::getTaskCount() const throw() {
+        return (getDocumentCount() + DOCUMENTS_PER_TASK - 1) / DOCUMENTS_PER_TASK;
+    }
+
+    uint32_t ParallelDocumentReader::getTaskEnd(const uint32_t aTask) const throw() {
+        const uint32_t end = (aTask + 1) * DOCUMENTS_PER_TASK;
+        const uint32_t count = getDocumentCount();
+        return end < count ? end : count;
+    }
+
+    void ParallelDocumentReader::readValueTask(void* const aData, const uint32_t aTask) throw() {
+        DecodeTask<GenericValue>& task = *static_cast<DecodeTask<GenericValue>*>(aData);
+        const ParallelDocumentReader& reader = *task.reader;
+        const uint32_t end = reader.getTaskEnd(aTask);
+        for(uint32_t i = aTask * DOCUMENTS_PER_TASK; i < end; ++i) {
+            uint32_t size;
+            const void* const data = reader.getDocument(i, size);
+            BufferIStream stream(data, size);
+            GenericValue& value = (*task.values)[task.first + static_cast<int32_t>(i)];
+            Reader* const decoder = reader.mFormat.createReader(*task.allocator, stream);
+            if(decoder == nullptr) {
+                if(! reader.mFormat.tryReadValue(stream, value)) ++task.failures;
+                continue;
+            }
+            if(! decoder->readValue(value)) {
+                value.setNull();
+                ++task.failures;
+            }
+            decoder->~Reader();
+            task.allocator->deallocate(decoder);
+        }
+    }
+
+    bool ParallelDocumentReader::open(const void* const aData, const uint32_t aSize) throw() {
+        mData = static_cast<const uint8_t*>(aData);
+        mEnds.clear();
+        if(mFormat.findDocuments(aData, aSize, mEnds)) return true;
+        mEnds.clear();
+        return false;
+    }
+
+    uint32_t ParallelDocumentReader::getDocumentCount() const throw() {
+        return static_cast<uint32_t>(mEnds.size());
+    }
+
+    const void* ParallelDocumentReader::getDocument(const uint32_t aIndex, uint32_t& aSize) const throw() {
+        const uint32_t begin = aIndex == 0 ? 0 : mEnds[aIndex - 1];
+        aSize = mEnds[aIndex] - begin;
+        return mData + begin;
+    }
+
+    bool ParallelDocumentReader::readValues(List<GenericValue>& aValues) throw() {
+        const uint32_t count = getDocumentCount();
+        DecodeTask<GenericValue> task;
+        task.reader = this;
+        task.allocator = &getDefaultAllocator();
+        task.values = &aValues;
+        task.first = aValues.size();
+        task.failures = 0;
+        for(uint32_t i = 0; i < count; ++i) aValues.pushBack(GenericValue());
+        mPool.run(&readValueTask, &task, getTaskCount());
+        return task.failures == 0;
+    }
+}
@@ -0,0 +1,195 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+#include <utility>
+#include "Solaire/Encode/PathQuery.hpp"
+
+namespace Solaire {
+
+    static uint32_t parseIndex(const CString& aSegment) throw() {
+        // Indices are written without leading zeros, so /01 can only name a member
+        const int32_t size = aSegment.size();
+        if(size == 0 || size > 9 || (size > 1 && aSegment[0] == '0')) return UINT32_MAX;
+        uint32_t index = 0;
+        for(int32_t i = 0; i < size; ++i) {
+            const char c = aSegment[i];
+            if(c < '0' || c > '9') return UINT32_MAX;
+            index = index * 10 + static_cast<uint32_t>(c - '0');
+        }
+        return index;
+    }
+
+    static bool nameEquals(const CString& aFirst, const char* const aSecond, const uint32_t aLength) throw() {
+        if(static_cast<uint32_t>(aFirst.size()) != aLength) return false;
+        for(uint32_t i = 0; i < aLength; ++i) {
+            if(aFirst[i] != aSecond[i]) return false;
+        }
+        return true;
+    }
+
+	// PathQuery
+
+    PathQuery::PathQuery(Allocator& aAllocator) throw() :
+        mAllocator(aAllocator),
+        mSegments(aAllocator)
+    {}
+
+    bool PathQuery::compile(const char* const aPath, const uint32_t aLength) throw() {
+        mSegments.clear();
+        if(aLength == 0) return true;
+        if(aPath[0] != '/') return false;
+
+        uint32_t i = 1;
+        while(true) {
+            Segment segment{CString(mAllocator), NO_INDEX, false};
+            while(i < aLength && aPath[i] != '/') {
+                char c = aPath[i++];
+                if(c == '~') {
+                    const char escape = i < aLength ? aPath[i++] : '\0';
+                    if(escape == '0') {
+                        c = '~';
+                    }else if(escape == '1') {
+                        c = '/';
+                    }else {
+                        mSegments.clear();
+                        return false;
+                    }
+                }
+                segment.name.pushBack(c);
+            }
+            if(static_cast<uint32_t>(segment.name.size()) > NAME_CAPACITY) {
+                mSegments.clear();
+                return false;
+            }
+            segment.wildcard = segment.name.size() == 1 && segment.name[0] == '*';
+            segment.index = parseIndex(segment.name);
+            mSegments.pushBack(segment);
+            if(i == aLength) return true;
+            ++i;
+        }
+    }
+
+    bool PathQuery::compile(const StringConstant<char>& aPath) throw() {
+        CString path(mAllocator);
+        path = aPath;
+        return compile(path.size() == 0 ? "" : &path[0], static_cast<uint32_t>(path.size()));
+    }
+
+    uint32_t PathQuery::getSegmentCount() const throw() {
+        return static_cast<uint32_t>(mSegments.size());
+    }
+
+    bool PathQuery::matchReader(Reader& aReader, const uint32_t aDepth, List<GenericValue>& aResults) const throw() {
+        if(aDepth == static_cast<uint32_t>(mSegments.size())) {
+            GenericValue value;
+            if(! aReader.readValue(value)) return false;
+            aResults.pushBack(std::move(value));
+            return true;
+        }
+
+        const Segment& segment = mSegments[aDepth];
+        switch(aReader.peekType()) {
+        case GenericValue::ARRAY_T:
+            {
+                if(! segment.wildcard && segment.index == NO_INDEX) return aReader.skip();
+                int32_t size;
+                if(! aReader.beginArray(size)) return false;
+                uint32_t index = 0;
+                while(aReader.hasNext()) {
+                    if(segment.wildcard || index == segment.index) {
+                        if(! matchReader(aReader, aDepth + 1, aResults)) return false;
+                        // The remaining elements are stepped over by endArray
+                        if(! segment.wildcard) break;
+                    }else if(! aReader.skip()) {
+                        return false;
+                    }
+                    ++index;
+                }
+                return aReader.endArray();
+            }
+        case GenericValue::OBJECT_T:
+            {
+                int32_t size;
+                if(! aReader.beginObject(size)) return false;
+                char name[NAME_CAPACITY];
+                while(aReader.hasNext()) {
+                    uint32_t length;
+                    if(! aReader.readName(name, NAME_CAPACITY, length)) return false;
+                    // Names longer than the buffer differ in length from every segment, so they are never compared
+                    if(segment.wildcard || nameEquals(segment.name, name, length)) {
+                        if(! matchReader(aReader, aDepth + 1, aResults)) return false;
+                        if(! segment.wildcard) break;
+                    }else if(! aReader.skip()) {
+                        return false;
+                    }
+                }
+                return aReader.endObject();
+            }
+        default:
+            // Scalars have nothing inside them for the rest of the path to select
+            return aReader.skip();
+        }
+    }
+
+    void PathQuery::matchValue(const GenericValue& aValue, const uint32_t aDepth, List<GenericValue>& aResults) const throw() {
+        if(aDepth == static_cast<uint32_t>(mSegments.size())) {
+            aResults.pushBack(aValue);
+            return;
+        }
+
+        const Segment& segment = mSegments[aDepth];
+        if(aValue.isArray()) {
+            if(segment.wildcard) {
+                const int32_t size = aValue.size();
+                for(int32_t i = 0; i < size; ++i) matchValue(aValue[i], aDepth + 1, aResults);
+            }else if(segment.index != NO_INDEX && segment.index < static_cast<uint32_t>(aValue.size())) {
+                matchValue(aValue[static_cast<int32_t>(segment.index)], aDepth + 1, aResults);
+            }
+        }else if(aValue.isObject()) {
+            if(segment.wildcard) {
+                const GenericObject& members = aValue.getObject();
+                for(auto i = members.begin(); i != members.end(); ++i) matchValue(i->second, aDepth + 1, aResults);
+            }else {
+                const GenericValue* const member = aValue.find(segment.name);
+                if(member) matchValue(*member, aDepth + 1, aResults);
+            }
+        }
+    }
+
+    bool PathQuery::run(Reader& aReader, List<GenericValue>& aResults) const throw() {
+        return matchReader(aReader, 0, aResults);
+    }
+
+    bool PathQuery::run(const Format& aFormat, IStream& aStream, List<GenericValue>& aResults) const throw() {
+        Reader* const reader = aFormat.createReader(mAllocator, aStream);
+        if(reader == nullptr) {
+            GenericValue value;
+            if(! aFormat.tryReadValue(aStream, value)) return false;
+            matchValue(value, 0, aResults);
+            return true;
+        }
+        const bool result = matchReader(*reader, 0, aResults);
+        reader->~Reader();
+        mAllocator.deallocate(reader);
+        return result;
+    }
+
+    void PathQuery::run(const GenericValue& aValue, List<GenericValue>& aResults) const throw() {
+        matchValue(aValue, 0, aResults);
+    }
+}
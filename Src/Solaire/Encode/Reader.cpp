@@ -0,0 +1,279 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+#include <cstring>
+#include "Solaire/Encode/Reader.hpp"
+#include "Solaire/Encode/GenericObjectMap.hpp"
+#include "Solaire/Encode/StructuralHash.hpp"
+
+namespace Solaire {
+
+    static bool readPackedElements(Reader& aReader, const GenericValue::ValueType aType, void* const aValues, const uint32_t aCount) throw() {
+        switch(aType) {
+        case GenericValue::UNSIGNED_T:
+            return aReader.readUnsignedArray(static_cast<uint64_t*>(aValues), aCount);
+        case GenericValue::SIGNED_T:
+            return aReader.readSignedArray(static_cast<int64_t*>(aValues), aCount);
+        default:
+            return aReader.readDoubleArray(static_cast<double*>(aValues), aCount);
+        }
+    }
+
+    static bool readStagedElements(Reader& aReader, GenericValue& aValue, const GenericValue::ValueType aType, const uint32_t aSize) throw() {
+        // The count can not be checked against the input, so the elements are collected as they arrive and the
+        // array is only allocated once all of them have been read
+        Allocator& allocator = getDefaultAllocator();
+        uint8_t* stage = nullptr;
+        uint32_t capacity = 0;
+        uint32_t count = 0;
+        bool result = true;
+        while(count < aSize) {
+            if(count == capacity) {
+                const uint32_t remaining = aSize - capacity;
+                const uint32_t growth = capacity == 0 ? static_cast<uint32_t>(Reader::MAX_RESERVE) : capacity;
+                const uint32_t newCapacity = capacity + (growth < remaining ? growth : remaining);
+                uint8_t* const newStage = static_cast<uint8_t*>(allocator.allocate(newCapacity * sizeof(uint64_t)));
+                if(newStage == nullptr) {
+                    result = false;
+                    break;
+                }
+                if(stage) {
+                    std::memcpy(newStage, stage, count * sizeof(uint64_t));
+                    allocator.deallocate(stage);
+                }
+                stage = newStage;
+                capacity = newCapacity;
+            }
+            const uint32_t chunk = capacity - count < static_cast<uint32_t>(Reader::MAX_RESERVE) ? capacity - count : static_cast<uint32_t>(Reader::MAX_RESERVE);
+            if(! readPackedElements(aReader, aType, stage + count * sizeof(uint64_t), chunk)) {
+                result = false;
+                break;
+            }
+            count += chunk;
+        }
+        if(result) {
+            void* const values = aValue.setPackedArray(aType, aSize);
+            if(values == nullptr) {
+                result = false;
+            }else if(aSize > 0) {
+                std::memcpy(values, stage, aSize * sizeof(uint64_t));
+            }
+        }
+        if(stage) allocator.deallocate(stage);
+        return result;
+    }
+
+	// Reader
+
+    uint32_t SOLAIRE_EXPORT_CALL Reader::getRemainingBytes() const throw() {
+        return UINT32_MAX;
+    }
+
+    int32_t Reader::getReserveSize(const int32_t aSize) const throw() {
+        if(aSize <= 0) return 0;
+        const uint32_t remaining = getRemainingBytes();
+        const uint32_t limit = remaining == UINT32_MAX ? static_cast<uint32_t>(MAX_RESERVE) : remaining;
+        return static_cast<uint32_t>(aSize) < limit ? aSize : static_cast<int32_t>(limit);
+    }
+
+    GenericValue::ValueType SOLAIRE_EXPORT_CALL Reader::peekPackedType() throw() {
+        return GenericValue::NULL_T;
+    }
+
+    bool SOLAIRE_EXPORT_CALL Reader::readUnsignedArray(uint64_t* const aValues, const uint32_t aCount) throw() {
+        for(uint32_t i = 0; i < aCount; ++i) {
+            if(! readUnsigned(aValues[i])) return false;
+        }
+        return true;
+    }
+
+    bool SOLAIRE_EXPORT_CALL Reader::readSignedArray(int64_t* const aValues, const uint32_t aCount) throw() {
+        for(uint32_t i = 0; i < aCount; ++i) {
+            if(! readSigned(aValues[i])) return false;
+        }
+        return true;
+    }
+
+    bool SOLAIRE_EXPORT_CALL Reader::readDoubleArray(double* const aValues, const uint32_t aCount) throw() {
+        for(uint32_t i = 0; i < aCount; ++i) {
+            if(! readDouble(aValues[i])) return false;
+        }
+        return true;
+    }
+
+    bool SOLAIRE_EXPORT_CALL Reader::readName(char* const aName, const uint32_t aCapacity, uint32_t& aLength) throw() {
+        CString name(getDefaultAllocator());
+        if(! readName(name)) return false;
+        aLength = static_cast<uint32_t>(name.size());
+        const uint32_t count = aLength < aCapacity ? aLength : aCapacity;
+        for(uint32_t i = 0; i < count; ++i) aName[i] = name[i];
+        return true;
+    }
+
+    const char* SOLAIRE_EXPORT_CALL Reader::borrowString(uint32_t& aLength) throw() {
+        return nullptr;
+    }
+
+    const void* SOLAIRE_EXPORT_CALL Reader::borrowValue(uint32_t& aSize) throw() {
+        return nullptr;
+    }
+
+    bool Reader::readValue(GenericValue& aValue) throw() {
+        CString buffer(getDefaultAllocator());
+        return readValue(aValue, buffer, nullptr, nullptr);
+    }
+
+    bool Reader::readValue(GenericValue& aValue, uint64_t& aHash) throw() {
+        CString buffer(getDefaultAllocator());
+        return readValue(aValue, buffer, nullptr, &aHash);
+    }
+
+    bool Reader::readLazyValue(GenericValue& aValue, const Format& aFormat) throw() {
+        CString buffer(getDefaultAllocator());
+        return readValue(aValue, buffer, &aFormat, nullptr);
+    }
+
+    bool Reader::readElement(GenericValue& aValue, CString& aBuffer, const Format* const aFormat, uint64_t* const aHash) throw() {
+        // Packed arrays are copied in bulk, so they are cheaper to read now than to find again later
+        if(aFormat) {
+            const GenericValue::ValueType type = peekType();
+            if(type == GenericValue::OBJECT_T || (type == GenericValue::ARRAY_T && peekPackedType() == GenericValue::NULL_T)) {
+                uint32_t size;
+                const void* const bytes = borrowValue(size);
+                if(bytes) {
+                    aValue.setLazy(type, *aFormat, bytes, size);
+                    return true;
+                }
+            }
+        }
+        return readValue(aValue, aBuffer, aFormat, aHash);
+    }
+
+    bool Reader::readValue(GenericValue& aValue, CString& aBuffer, const Format* const aFormat, uint64_t* const aHash) throw() {
+        switch(peekType()) {
+        case GenericValue::NULL_T:
+            aValue.setNull();
+            if(! readNull()) return false;
+            if(aHash) *aHash = StructuralHash::hashNull();
+            return true;
+        case GenericValue::CHAR_T:
+            if(! readChar(aValue.setChar(0))) return false;
+            if(aHash) *aHash = StructuralHash::hashChar(aValue.getChar());
+            return true;
+        case GenericValue::BOOL_T:
+            if(! readBool(aValue.setBool(false))) return false;
+            if(aHash) *aHash = StructuralHash::hashBool(aValue.getBool());
+            return true;
+        case GenericValue::UNSIGNED_T:
+            if(! readUnsigned(aValue.setUnsigned(0))) return false;
+            if(aHash) *aHash = StructuralHash::hashUnsigned(aValue.getUnsigned());
+            return true;
+        case GenericValue::SIGNED_T:
+            if(! readSigned(aValue.setSigned(0))) return false;
+            if(aHash) *aHash = StructuralHash::hashSigned(aValue.getSigned());
+            return true;
+        case GenericValue::DOUBLE_T:
+            if(! readDouble(aValue.setDouble(0.0))) return false;
+            if(aHash) *aHash = StructuralHash::hashDouble(aValue.getDouble());
+            return true;
+        case GenericValue::STRING_T:
+            {
+                uint32_t length;
+                const char* const characters = borrowString(length);
+                if(characters) {
+                    aValue.setBorrowedString(characters, length);
+                    if(aHash) *aHash = StructuralHash::hashString(characters, length);
+                    return true;
+                }
+            }
+            // Strings are staged in aBuffer so that short ones can be stored inline
+            aBuffer.clear();
+            if(! readString(aBuffer)) return false;
+            aValue.setString(aBuffer);
+            if(aHash) *aHash = StructuralHash::hashString(aBuffer.size() == 0 ? "" : &aBuffer[0], static_cast<uint32_t>(aBuffer.size()));
+            return true;
+        case GenericValue::ARRAY_T:
+            {
+                const GenericValue::ValueType packedType = peekPackedType();
+                int32_t size;
+                if(! beginArray(size)) return false;
+                if(packedType != GenericValue::NULL_T && size != UNKNOWN_SIZE) {
+                    // The count comes from the input, so it is checked before the elements are allocated
+                    const uint32_t count = static_cast<uint32_t>(size);
+                    const uint32_t remaining = getRemainingBytes();
+                    if(remaining != UINT32_MAX || count <= static_cast<uint32_t>(MAX_RESERVE)) {
+                        if(static_cast<uint64_t>(count) * sizeof(uint64_t) > remaining) return false;
+                        void* const values = aValue.setPackedArray(packedType, count);
+                        if(values == nullptr || ! readPackedElements(*this, packedType, values, count)) return false;
+                    }else if(! readStagedElements(*this, aValue, packedType, count)) {
+                        return false;
+                    }
+                    if(! endArray()) return false;
+                    if(aHash) *aHash = aValue.hash();
+                    return true;
+                }
+                aValue.setArray();
+                aValue.reserve(getReserveSize(size));
+                StructuralHash::ArrayHash hash;
+                uint64_t element = 0;
+                while(hasNext()) {
+                    if(! readElement(aValue.pushBack(GenericValue()), aBuffer, aFormat, aHash ? &element : nullptr)) return false;
+                    if(aHash) hash.add(element);
+                }
+                if(! endArray()) return false;
+                if(aHash) {
+                    *aHash = hash.finish();
+                    aValue.cacheHash(*aHash);
+                }
+                return true;
+            }
+        case GenericValue::OBJECT_T:
+            {
+                int32_t size;
+                if(! beginObject(size)) return false;
+                aValue.setObject();
+                aValue.reserve(getReserveSize(size));
+                StructuralHash::ObjectHash hash;
+                uint64_t member = 0;
+                while(hasNext()) {
+                    aBuffer.clear();
+                    if(! readName(aBuffer)) return false;
+                    // The name is hashed before aBuffer is reused for the strings inside the member, interned names already carry their hash
+                    GenericValue& value = aValue.emplace(aBuffer, GenericValue());
+                    uint64_t name = 0;
+                    if(aHash) {
+                        const GenericObjectMap& object = *static_cast<const GenericObjectMap*>(aValue.mObject);
+                        const int32_t index = object.size() - 1;
+                        const KeyTable::Key* const key = &object.begin()[index].second == &value ? object.getKey(index) : nullptr;
+                        name = key ? key->getNameHash() : StructuralHash::hashName(aBuffer.size() == 0 ? "" : &aBuffer[0], static_cast<uint32_t>(aBuffer.size()));
+                    }
+                    if(! readElement(value, aBuffer, aFormat, aHash ? &member : nullptr)) return false;
+                    if(aHash) hash.add(name, member);
+                }
+                if(! endObject()) return false;
+                if(aHash) {
+                    *aHash = hash.finish();
+                    aValue.cacheHash(*aHash);
+                }
+                return true;
+            }
+        default:
+            return false;
+        }
+    }
+}
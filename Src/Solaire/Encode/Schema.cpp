@@ -0,0 +1,151 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+#include "Solaire/Encode/Schema.hpp"
+#include "Solaire/Encode/GenericObjectMap.hpp"
+
+namespace Solaire {
+
+    enum : uint32_t {
+        MIN_SCHEMA_SLOTS = 32
+    };
+
+    static uint32_t hashName(const char* const aName, const uint32_t aLength) throw() {
+        // Must match GenericObjectMap::hash
+        uint32_t hash = 2166136261U;
+        for(uint32_t i = 0; i < aLength; ++i) {
+            hash ^= static_cast<uint8_t>(aName[i]);
+            hash *= 16777619U;
+        }
+        return hash;
+    }
+
+    static bool nameEquals(const CString& aFirst, const char* const aSecond, const uint32_t aLength) throw() {
+        if(static_cast<uint32_t>(aFirst.size()) != aLength) return false;
+        for(uint32_t i = 0; i < aLength; ++i) {
+            if(aFirst[i] != aSecond[i]) return false;
+        }
+        return true;
+    }
+
+    static bool nameEquals(const CString& aFirst, const StringConstant<char>& aSecond) throw() {
+        const int32_t size = aFirst.size();
+        if(size != aSecond.size()) return false;
+        for(int32_t i = 0; i < size; ++i) {
+            if(aFirst[i] != aSecond[i]) return false;
+        }
+        return true;
+    }
+
+	// Schema
+
+    Schema::Schema(Allocator& aAllocator) throw() :
+        mAllocator(aAllocator),
+        mNames(aAllocator),
+        mSlots(nullptr),
+        mSlotMask(0)
+    {}
+
+    Schema::~Schema() throw() {
+        if(mSlots) mAllocator.deallocate(mSlots);
+    }
+
+    void Schema::insertIndex(const uint32_t aHash, const uint32_t aId) throw() {
+        uint32_t i = aHash & mSlotMask;
+        while(mSlots[i].id != NO_ID) i = (i + 1) & mSlotMask;
+        mSlots[i].hash = aHash;
+        mSlots[i].id = aId;
+    }
+
+    bool Schema::rebuildIndex(const uint32_t aSlots) throw() {
+        Slot* const slots = static_cast<Slot*>(mAllocator.allocate(sizeof(Slot) * aSlots));
+        if(slots == nullptr) return false;
+        for(uint32_t i = 0; i < aSlots; ++i) slots[i].id = NO_ID;
+        if(mSlots) mAllocator.deallocate(mSlots);
+        mSlots = slots;
+        mSlotMask = aSlots - 1;
+
+        const int32_t size = mNames.size();
+        for(int32_t i = 0; i < size; ++i) {
+            insertIndex(GenericObjectMap::hash(mNames[i]), static_cast<uint32_t>(i + 1));
+        }
+        return true;
+    }
+
+    uint32_t Schema::addField(const char* const aName, const uint32_t aLength) throw() {
+        const uint32_t existing = getId(aName, aLength);
+        if(existing != NO_ID) return existing;
+
+        // Keep the load factor at or below one half so probe sequences stay short
+        const uint32_t id = static_cast<uint32_t>(mNames.size()) + 1;
+        if(mSlots == nullptr || id * 2 > mSlotMask + 1) {
+            if(! rebuildIndex(mSlots == nullptr ? static_cast<uint32_t>(MIN_SCHEMA_SLOTS) : (mSlotMask + 1) * 2)) return NO_ID;
+        }
+        mNames.pushBack(CString(mAllocator, aName, aLength));
+        insertIndex(hashName(aName, aLength), id);
+        return id;
+    }
+
+    uint32_t Schema::addField(const StringConstant<char>& aName) throw() {
+        const uint32_t existing = getId(aName);
+        if(existing != NO_ID) return existing;
+
+        const uint32_t id = static_cast<uint32_t>(mNames.size()) + 1;
+        if(mSlots == nullptr || id * 2 > mSlotMask + 1) {
+            if(! rebuildIndex(mSlots == nullptr ? static_cast<uint32_t>(MIN_SCHEMA_SLOTS) : (mSlotMask + 1) * 2)) return NO_ID;
+        }
+        CString name(mAllocator);
+        name = aName;
+        mNames.pushBack(name);
+        insertIndex(GenericObjectMap::hash(aName), id);
+        return id;
+    }
+
+    uint32_t Schema::getId(const char* const aName, const uint32_t aLength) const throw() {
+        if(mSlots == nullptr) return NO_ID;
+        const uint32_t hash = hashName(aName, aLength);
+        uint32_t i = hash & mSlotMask;
+        while(mSlots[i].id != NO_ID) {
+            const Slot& slot = mSlots[i];
+            if(slot.hash == hash && nameEquals(mNames[slot.id - 1], aName, aLength)) return slot.id;
+            i = (i + 1) & mSlotMask;
+        }
+        return NO_ID;
+    }
+
+    uint32_t Schema::getId(const StringConstant<char>& aName) const throw() {
+        if(mSlots == nullptr) return NO_ID;
+        const uint32_t hash = GenericObjectMap::hash(aName);
+        uint32_t i = hash & mSlotMask;
+        while(mSlots[i].id != NO_ID) {
+            const Slot& slot = mSlots[i];
+            if(slot.hash == hash && nameEquals(mNames[slot.id - 1], aName)) return slot.id;
+            i = (i + 1) & mSlotMask;
+        }
+        return NO_ID;
+    }
+
+    const CString* Schema::getName(const uint32_t aId) const throw() {
+        if(aId == NO_ID || aId > static_cast<uint32_t>(mNames.size())) return nullptr;
+        return &mNames[aId - 1];
+    }
+
+    uint32_t Schema::getFieldCount() const throw() {
+        return static_cast<uint32_t>(mNames.size());
+    }
+}
@@ -0,0 +1,133 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+#include "Solaire/Encode/WorkerPool.hpp"
+
+namespace Solaire {
+
+	// WorkerPool
+
+    WorkerPool::WorkerPool(Allocator& aAllocator, const uint32_t aThreads) throw() :
+        mAllocator(aAllocator),
+        mThreads(nullptr),
+        mThreadCount(0),
+        mTask(nullptr),
+        mData(nullptr),
+        mTaskCount(0),
+        mNextTask(0),
+        mFinishedTasks(0),
+        mActiveWorkers(0),
+        mBatch(0),
+        mStopping(false)
+    {
+        uint32_t threads = aThreads == 0 ? std::thread::hardware_concurrency() : aThreads;
+        if(threads <= 1) return;
+
+        // The thread calling run is the last worker
+        --threads;
+        mThreads = static_cast<std::thread*>(mAllocator.allocate(sizeof(std::thread) * threads));
+        if(mThreads == nullptr) return;
+        for(uint32_t i = 0; i < threads; ++i) {
+            new(mThreads + i) std::thread(&WorkerPool::workerMain, this);
+        }
+        mThreadCount = threads;
+    }
+
+    WorkerPool::~WorkerPool() throw() {
+        {
+            std::lock_guard<std::mutex> lock(mLock);
+            mStopping = true;
+        }
+        mTasksAvailable.notify_all();
+        for(uint32_t i = 0; i < mThreadCount; ++i) {
+            mThreads[i].join();
+            mThreads[i].~thread();
+        }
+        if(mThreads) mAllocator.deallocate(mThreads);
+    }
+
+    void WorkerPool::executeTasks(const Task aTask, void* const aData, const uint32_t aCount) throw() {
+        uint32_t finished = 0;
+        for(uint32_t i = mNextTask.fetch_add(1); i < aCount; i = mNextTask.fetch_add(1)) {
+            aTask(aData, i);
+            ++finished;
+        }
+        if(finished == 0) return;
+
+        std::lock_guard<std::mutex> lock(mLock);
+        mFinishedTasks += finished;
+        if(mFinishedTasks == aCount) mTasksFinished.notify_all();
+    }
+
+    void WorkerPool::workerMain() throw() {
+        uint32_t batch = 0;
+        while(true) {
+            Task task;
+            void* data;
+            uint32_t count;
+            {
+                std::unique_lock<std::mutex> lock(mLock);
+                while(! (mStopping || mBatch != batch)) mTasksAvailable.wait(lock);
+                if(mStopping) return;
+                batch = mBatch;
+                task = mTask;
+                data = mData;
+                count = mTaskCount;
+                ++mActiveWorkers;
+            }
+
+            executeTasks(task, data, count);
+
+            {
+                std::lock_guard<std::mutex> lock(mLock);
+                --mActiveWorkers;
+            }
+            mTasksFinished.notify_all();
+        }
+    }
+
+    uint32_t WorkerPool::getThreadCount() const throw() {
+        return mThreadCount + 1;
+    }
+
+    void WorkerPool::run(const Task aTask, void* const aData, const uint32_t aCount) throw() {
+        if(aCount == 0) return;
+        if(mThreadCount == 0 || aCount == 1) {
+            for(uint32_t i = 0; i < aCount; ++i) aTask(aData, i);
+            return;
+        }
+
+        {
+            // A worker that woke late for the previous batch must finish before the counter is reset
+            std::unique_lock<std::mutex> lock(mLock);
+            while(mActiveWorkers != 0) mTasksFinished.wait(lock);
+            mTask = aTask;
+            mData = aData;
+            mTaskCount = aCount;
+            mFinishedTasks = 0;
+            mNextTask = 0;
+            ++mBatch;
+        }
+        mTasksAvailable.notify_all();
+
+        executeTasks(aTask, aData, aCount);
+
+        std::unique_lock<std::mutex> lock(mLock);
+        while(! (mFinishedTasks == aCount && mActiveWorkers == 0)) mTasksFinished.wait(lock);
+    }
+}
@@ -0,0 +1,119 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+#include "Solaire/Encode/Writer.hpp"
+
+namespace Solaire {
+
+    static bool writePackedArray(Writer& aWriter, const GenericValue& aValue) throw() {
+        const GenericValue::ValueType type = aValue.getPackedType();
+        const uint32_t size = static_cast<uint32_t>(aValue.size());
+        if(! aWriter.beginPackedArray(type, aValue.size())) return false;
+        switch(type) {
+        case GenericValue::UNSIGNED_T:
+            if(! aWriter.writeUnsignedArray(aValue.getUnsignedArray(), size)) return false;
+            break;
+        case GenericValue::SIGNED_T:
+            if(! aWriter.writeSignedArray(aValue.getSignedArray(), size)) return false;
+            break;
+        default:
+            if(! aWriter.writeDoubleArray(aValue.getDoubleArray(), size)) return false;
+            break;
+        }
+        return aWriter.endArray();
+    }
+
+	// Writer
+
+    bool SOLAIRE_EXPORT_CALL Writer::beginPackedArray(const GenericValue::ValueType aType, const int32_t aSize) throw() {
+        return beginArray(aSize);
+    }
+
+    bool SOLAIRE_EXPORT_CALL Writer::writeUnsignedArray(const uint64_t* const aValues, const uint32_t aCount) throw() {
+        for(uint32_t i = 0; i < aCount; ++i) {
+            if(! writeUnsigned(aValues[i])) return false;
+        }
+        return true;
+    }
+
+    bool SOLAIRE_EXPORT_CALL Writer::writeSignedArray(const int64_t* const aValues, const uint32_t aCount) throw() {
+        for(uint32_t i = 0; i < aCount; ++i) {
+            if(! writeSigned(aValues[i])) return false;
+        }
+        return true;
+    }
+
+    bool SOLAIRE_EXPORT_CALL Writer::writeDoubleArray(const double* const aValues, const uint32_t aCount) throw() {
+        for(uint32_t i = 0; i < aCount; ++i) {
+            if(! writeDouble(aValues[i])) return false;
+        }
+        return true;
+    }
+
+    bool SOLAIRE_EXPORT_CALL Writer::writeName(const char* const aName, const uint32_t aLength) throw() {
+        return writeName(CString(getDefaultAllocator(), aName, aLength));
+    }
+
+    bool SOLAIRE_EXPORT_CALL Writer::writeFragment(const void* const aBytes, const uint32_t aLength) throw() {
+        return false;
+    }
+
+    bool Writer::writeValue(const GenericValue& aValue) throw() {
+        switch(aValue.getType()) {
+        case GenericValue::NULL_T:
+            return writeNull();
+        case GenericValue::CHAR_T:
+            return writeChar(aValue.getChar());
+        case GenericValue::BOOL_T:
+            return writeBool(aValue.getBool());
+        case GenericValue::UNSIGNED_T:
+            return writeUnsigned(aValue.getUnsigned());
+        case GenericValue::SIGNED_T:
+            return writeSigned(aValue.getSigned());
+        case GenericValue::DOUBLE_T:
+            return writeDouble(aValue.getDouble());
+        case GenericValue::STRING_T:
+            {
+                const GenericValue::StringView string = aValue.getString();
+                return writeString(string.getCharacters(), string.getLength());
+            }
+        case GenericValue::ARRAY_T:
+            if(aValue.getPackedType() != GenericValue::NULL_T) return writePackedArray(*this, aValue);
+            {
+                const GenericArray& array_ = aValue.getArray();
+                const int32_t size = array_.size();
+                if(! beginArray(size)) return false;
+                for(int32_t i = 0; i < size; ++i) {
+                    if(! writeValue(array_[i])) return false;
+                }
+                return endArray();
+            }
+        case GenericValue::OBJECT_T:
+            {
+                const GenericObject& object = aValue.getObject();
+                if(! beginObject(object.size())) return false;
+                for(auto i = object.begin(); i != object.end(); ++i) {
+                    if(! (writeName(i->first) && writeValue(i->second))) return false;
+                }
+                return endObject();
+            }
+        default:
+            return false;
+        }
+    }
+}
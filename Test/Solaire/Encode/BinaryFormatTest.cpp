@@ -0,0 +1,98 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+// Checks that BinaryFormat reads back what it writes with every value type intact, and that truncated input and counts
+// larger than the input are rejected without large allocations.
+
+#include "Solaire/Encode/BinaryFormat.hpp"
+#include "EncodeTest.hpp"
+
+namespace Solaire {
+
+    enum : int32_t {
+        LARGE_COUNT = 70000     //!< More elements than any of the malformed inputs contain.
+    };
+
+    static void testTypes() throw() {
+        // Unlike JSON, the binary format keeps the type of every value
+        GenericValue value;
+        value.pushBack(GenericValue('x'));
+        value.pushBack(GenericValue(true));
+        value.pushBack(GenericValue(static_cast<uint64_t>(300)));
+        value.pushBack(GenericValue(static_cast<int64_t>(-5)));
+        value.pushBack(GenericValue(3.25));
+        value.pushBack(GenericValue());
+        value.pushBack(GenericValue(makeName("hello")));
+
+        const BinaryFormat binary;
+        BufferOStream output(getDefaultAllocator());
+        write(binary, value, output);
+        BufferIStream input(output.getData(), output.getSize());
+        const GenericValue decoded = binary.readValue(input);
+        SOLAIRE_CHECK(decoded == value);
+        SOLAIRE_CHECK(input.end());
+        if(decoded.size() != 7) return;
+        SOLAIRE_CHECK(decoded[0].getType() == GenericValue::CHAR_T && decoded[0].getChar() == 'x');
+        SOLAIRE_CHECK(decoded[1].getType() == GenericValue::BOOL_T);
+        SOLAIRE_CHECK(decoded[2].getType() == GenericValue::UNSIGNED_T && decoded[2].getUnsigned() == 300);
+        SOLAIRE_CHECK(decoded[3].getType() == GenericValue::SIGNED_T && decoded[3].getSigned() == -5);
+        SOLAIRE_CHECK(decoded[4].getType() == GenericValue::DOUBLE_T && decoded[4].getDouble() == 3.25);
+        SOLAIRE_CHECK(decoded[5].isNull());
+        SOLAIRE_CHECK(hasString(decoded[6], "hello"));
+    }
+
+    static void testOversizedCounts() throw() {
+        const BinaryFormat binary;
+
+        // Containers, strings and packed arrays that claim more elements than the input holds
+        const uint8_t counts[][5] = {
+            {0xFF, 0xFF, 0xFF, 0xFF, 0x0F},
+            {0xFF, 0xFF, 0xFF, 0xFF, 0x07},
+            {0x80, 0x80, 0x80, 0x80, 0x02},
+            {0x80, 0x80, 0x80, 0x80, 0x01}
+        };
+        ArrayList<uint8_t> data(getDefaultAllocator());
+        for(uint32_t tag = 0; tag < 32; ++tag) {
+            for(const auto& count : counts) {
+                data.clear();
+                data.pushBack(static_cast<uint8_t>(tag));
+                for(const uint8_t byte : count) data.pushBack(byte);
+                for(uint32_t i = 0; i < 64; ++i) data.pushBack(1);
+
+                BufferIStream input(&data[0], data.size());
+                const GenericValue value = binary.readValue(input);
+                SOLAIRE_CHECK(value.isNull() || ! (value.isArray() || value.isObject()) || value.size() < 64);
+
+                ChunkedIStream chunked(&data[0], data.size(), 3);
+                SOLAIRE_CHECK(binary.readValue(chunked).size() < LARGE_COUNT);
+            }
+        }
+    }
+}
+
+int main() {
+    using namespace Solaire;
+
+    const BinaryFormat binary;
+    checkRoundTrip(binary);
+    checkTruncated(binary);
+    testTypes();
+    testOversizedCounts();
+
+    return finishTest();
+}
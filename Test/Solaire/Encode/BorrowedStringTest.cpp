@@ -0,0 +1,96 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+// Checks that formats with string borrowing enabled decode strings that reference a BufferIStream instead of copying
+// them, copy them from any other stream, and that borrowed strings are copied before they are modified.
+
+#include "Solaire/Encode/BinaryFormat.hpp"
+#include "EncodeTest.hpp"
+
+namespace Solaire {
+
+    static const char* const LONG_TEXT = "a string that is longer than fifteen";
+
+    static bool isInside(const GenericValue& aValue, const BufferOStream& aBuffer) throw() {
+        const char* const characters = aValue.getStringPointer();
+        const char* const begin = static_cast<const char*>(aBuffer.getData());
+        return characters >= begin && characters < begin + aBuffer.getSize();
+    }
+
+    static void testBorrowing(const Format& aWriter, const Format& aBorrowing) throw() {
+        GenericValue array;
+        array.pushBack(GenericValue(makeName(LONG_TEXT)));
+        array.pushBack(GenericValue(makeName("escaped \"text\" that is long")));
+        BufferOStream output(getDefaultAllocator());
+        write(aWriter, array, output);
+
+        BufferIStream input(output.getData(), output.getSize());
+        GenericValue decoded = aBorrowing.readValue(input);
+        SOLAIRE_CHECK(decoded.size() == 2);
+        if(decoded.size() != 2) return;
+        SOLAIRE_CHECK(isInside(decoded[0], output));
+        SOLAIRE_CHECK(hasString(decoded[0], LONG_TEXT));
+        SOLAIRE_CHECK(hasString(decoded[1], "escaped \"text\" that is long"));
+
+        // Copies reference the same characters, modifying one copies them first
+        GenericValue copy(decoded[0]);
+        SOLAIRE_CHECK(copy.getStringPointer() == decoded[0].getStringPointer());
+        copy.getString().pushBack('!');
+        SOLAIRE_CHECK(copy.getStringPointer() == nullptr && copy.getStringLength() == decoded[0].getStringLength() + 1);
+        SOLAIRE_CHECK(isInside(decoded[0], output) && hasString(decoded[0], LONG_TEXT));
+
+        // Borrowed strings encode like any other
+        BufferOStream reencoded(getDefaultAllocator());
+        write(aWriter, decoded, reencoded);
+        SOLAIRE_CHECK(sameBytes(reencoded, output));
+
+        // Other streams can not be borrowed from
+        ChunkedIStream chunked(output.getData(), output.getSize(), 4);
+        const GenericValue copied = aBorrowing.readValue(chunked);
+        SOLAIRE_CHECK(copied.size() == 2 && ! isInside(copied[0], output) && hasString(copied[0], LONG_TEXT));
+
+        // Without borrowing enabled strings are always copied
+        BufferIStream again(output.getData(), output.getSize());
+        const GenericValue owned = aWriter.readValue(again);
+        SOLAIRE_CHECK(owned.size() == 2 && ! isInside(owned[0], output) && hasString(owned[0], LONG_TEXT));
+    }
+
+    static void testSetBorrowedString() throw() {
+        char text[] = "characters owned by the caller";
+        const uint32_t length = static_cast<uint32_t>(std::strlen(text));
+        GenericValue value;
+        value.setBorrowedString(text, length);
+        SOLAIRE_CHECK(value.getStringPointer() == text && value.getStringLength() == length);
+        SOLAIRE_CHECK(static_cast<const GenericValue&>(value).getString().getCharacters() == text);
+
+        // The non-const getString takes a copy, after which the caller's characters are no longer referenced
+        value.getString();
+        text[0] = 'X';
+        SOLAIRE_CHECK(hasString(value, "characters owned by the caller"));
+    }
+}
+
+int main() {
+    using namespace Solaire;
+
+    testBorrowing(BinaryFormat(), BinaryFormat(true));
+    testBorrowing(JsonFormat(), JsonFormat(true));
+    testSetBorrowedString();
+
+    return finishTest();
+}
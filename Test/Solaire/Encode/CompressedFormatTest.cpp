@@ -0,0 +1,200 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+// Checks that CompressedFormat decompresses exactly the bytes that its inner format wrote, for any block size and with
+// or without a pool, that every frame is a document, and that damaged or truncated frames are rejected.
+
+#include "Solaire/Encode/CompressedFormat.hpp"
+#include "Solaire/Encode/ParallelDocumentReader.hpp"
+#include "Solaire/Encode/ParallelEncoder.hpp"
+#include "Solaire/Encode/BinaryFormat.hpp"
+#include "EncodeTest.hpp"
+
+namespace Solaire {
+
+    static uint64_t gRandom = 0x2545F4914F6CDD1DULL;
+
+    static uint64_t nextRandom() throw() {
+        gRandom ^= gRandom << 13;
+        gRandom ^= gRandom >> 7;
+        gRandom ^= gRandom << 17;
+        return gRandom;
+    }
+
+    static GenericValue makeRecords(const uint32_t aCount) throw() {
+        GenericValue records;
+        records.setArray();
+        char text[32];
+        for(uint32_t i = 0; i < aCount; ++i) {
+            GenericValue& record = records.pushBack(GenericValue());
+            record[makeName("identifier")] = GenericValue(static_cast<uint64_t>(i));
+            const int length = std::snprintf(text, sizeof(text), "item number %u", i % 37);
+            record[makeName("description")] = GenericValue(CString(getDefaultAllocator(), text, static_cast<uint32_t>(length)));
+            record[makeName("random")] = GenericValue(nextRandom());
+        }
+        return records;
+    }
+
+    static void checkInnerBytes(const Format& aInner, const CompressedFormat& aCompressed, const GenericValue& aValue) throw() {
+        BufferOStream raw(getDefaultAllocator());
+        write(aInner, aValue, raw);
+        BufferOStream compressed(getDefaultAllocator());
+        write(aCompressed, aValue, compressed);
+
+        BufferIStream input(compressed.getData(), compressed.getSize());
+        BufferOStream decoded(getDefaultAllocator());
+        write(aInner, aCompressed.readValue(input), decoded);
+        SOLAIRE_CHECK(sameBytes(decoded, raw));
+        SOLAIRE_CHECK(input.end());
+
+        BufferIStream documentInput(compressed.getData(), compressed.getSize());
+        GenericDocument document;
+        SOLAIRE_CHECK(aCompressed.readDocument(documentInput, document));
+        write(aInner, document.getRoot(), decoded);
+        SOLAIRE_CHECK(sameBytes(decoded, raw));
+    }
+
+    static void testBlockSizes(WorkerPool& aPool) throw() {
+        const JsonFormat json;
+        const BinaryFormat binary;
+        const GenericValue records = makeRecords(20000);
+        for(const uint32_t blockSize : {1u, 7u, 100u, 4096u, 65536u, 1u << 20}) {
+            for(WorkerPool* const pool : {static_cast<WorkerPool*>(nullptr), &aPool}) {
+                // Tiny blocks are slow, so they are only checked with the smaller encoding on one thread
+                if(blockSize < 100 && pool != nullptr) continue;
+                checkInnerBytes(binary, CompressedFormat(binary, blockSize, pool), records);
+                if(blockSize >= 4096) checkInnerBytes(json, CompressedFormat(json, blockSize, pool), records);
+            }
+        }
+
+        // Strings that do not compress are stored, strings that repeat are compressed
+        const CompressedFormat compressed(binary, 65536, &aPool);
+        for(const uint32_t length : {0u, 1u, 5u, 9u, 10u, 13u, 100u, 70000u, 300000u}) {
+            CString random(getDefaultAllocator());
+            CString repeated(getDefaultAllocator());
+            for(uint32_t i = 0; i < length; ++i) {
+                random.pushBack(static_cast<char>('a' + nextRandom() % 26));
+                repeated.pushBack("abcabcabd"[i % 9]);
+            }
+            checkInnerBytes(binary, compressed, GenericValue(random));
+            checkInnerBytes(binary, compressed, GenericValue(repeated));
+        }
+    }
+
+    static void testDocuments(WorkerPool& aPool) throw() {
+        const BinaryFormat binary;
+        const CompressedFormat compressed(binary, 256);
+        BufferOStream output(getDefaultAllocator());
+        for(uint32_t i = 0; i < 2000; ++i) {
+            Writer* const writer = compressed.createWriter(getDefaultAllocator(), output);
+            SOLAIRE_CHECK(writer != nullptr);
+            if(writer == nullptr) return;
+            SOLAIRE_CHECK(writer->writeValue(makeRecords(i % 5)) && writer->flush());
+            writer->~Writer();
+            getDefaultAllocator().deallocate(writer);
+        }
+
+        // Destroying a Writer without flushing it still closes the frame
+        Writer* const unflushed = compressed.createWriter(getDefaultAllocator(), output);
+        SOLAIRE_CHECK(unflushed->writeUnsigned(2000));
+        unflushed->~Writer();
+        getDefaultAllocator().deallocate(unflushed);
+
+        ParallelDocumentReader reader(getDefaultAllocator(), compressed, aPool);
+        SOLAIRE_CHECK(reader.open(output.getData(), output.getSize()));
+        SOLAIRE_CHECK(reader.getDocumentCount() == 2001);
+        ArrayList<GenericValue> values(getDefaultAllocator());
+        SOLAIRE_CHECK(reader.readValues(values));
+        BufferIStream input(output.getData(), output.getSize());
+        for(int32_t i = 0; i < values.size(); ++i) SOLAIRE_CHECK(values[i] == compressed.readValue(input));
+        SOLAIRE_CHECK(values.size() == 2001 && values[2000].getUnsigned() == 2000);
+    }
+
+    static void testParallelEncoding(WorkerPool& aPool) throw() {
+        // Each chunk is compressed into its own frame, which the joining Writer decompresses
+        const BinaryFormat binary;
+        CompressedFormat compressed(binary, 4096);
+        ArrayList<double> doubles(getDefaultAllocator());
+        for(uint32_t i = 0; i < 300000; ++i) doubles.pushBack(i * 0.5 - 1000.0);
+
+        BufferOStream expected(getDefaultAllocator());
+        SOLAIRE_CHECK(compressed.write<ArrayList<double>>(getDefaultAllocator(), doubles, expected));
+        BufferOStream output(getDefaultAllocator());
+        SOLAIRE_CHECK(writeParallel<double>(compressed, getDefaultAllocator(), aPool, doubles, output));
+        SOLAIRE_CHECK(sameBytes(output, expected));
+
+        BufferIStream input(output.getData(), output.getSize());
+        const ArrayList<double> decoded = compressed.read<ArrayList<double>>(getDefaultAllocator(), input);
+        SOLAIRE_CHECK(decoded.size() == doubles.size() && decoded[299999] == doubles[299999]);
+    }
+
+    static void testDamaged() throw() {
+        const BinaryFormat binary;
+        const CompressedFormat compressed(binary, 1024);
+        BufferOStream output(getDefaultAllocator());
+        write(compressed, makeRecords(2000), output);
+        ArrayList<uint8_t> data(getDefaultAllocator());
+        const uint8_t* const bytes = static_cast<const uint8_t*>(output.getData());
+        for(uint32_t i = 0; i < output.getSize(); ++i) data.pushBack(bytes[i]);
+
+        // Any single damaged byte is either detected or harmless, it must never read out of bounds
+        for(uint32_t i = 0; i < 300; ++i) {
+            const uint32_t position = static_cast<uint32_t>(nextRandom() % output.getSize());
+            data[position] ^= static_cast<uint8_t>(1 + nextRandom() % 255);
+            BufferIStream input(&data[0], data.size());
+            compressed.readValue(input);
+            BufferIStream documentInput(&data[0], data.size());
+            GenericDocument document;
+            compressed.readDocument(documentInput, document);
+            data[position] = bytes[position];
+        }
+
+        // Damage inside the first block's data fails its checksum
+        data[20] ^= 1;
+        BufferIStream damaged(&data[0], data.size());
+        SOLAIRE_CHECK(compressed.readValue(damaged).isNull());
+        data[20] ^= 1;
+
+        const uint32_t half = output.getSize() / 2;
+        BufferIStream truncated(&data[0], half);
+        SOLAIRE_CHECK(compressed.readValue(truncated).isNull());
+        ArrayList<uint32_t> ends(getDefaultAllocator());
+        SOLAIRE_CHECK(! compressed.findDocuments(&data[0], half, ends));
+    }
+}
+
+int main() {
+    using namespace Solaire;
+
+    const JsonFormat json;
+    const BinaryFormat binary;
+    const CompressedFormat compressedBinary(binary);
+    const CompressedFormat compressedJson(json, 64);
+    checkRoundTrip(compressedBinary);
+    checkRoundTrip(compressedJson);
+    checkTruncated(compressedBinary);
+    checkTruncated(compressedJson);
+
+    WorkerPool pool(getDefaultAllocator(), 4);
+    testBlockSizes(pool);
+    testDocuments(pool);
+    testParallelEncoding(pool);
+    testDamaged();
+
+    return finishTest();
+}
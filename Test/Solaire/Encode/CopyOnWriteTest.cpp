@@ -0,0 +1,172 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+// Checks that copies of a GenericValue share their node until one of them is modified, that modifying a copy never
+// changes the original, including from several threads at once, and that values copied out of a document survive it.
+
+#include <thread>
+#include "EncodeTest.hpp"
+
+namespace Solaire {
+
+    enum : uint32_t {
+        THREAD_COUNT = 4,       //!< The number of threads that copy and modify one value.
+        THREAD_COPIES = 2000    //!< The number of copies that each thread modifies.
+    };
+
+    static const char* const LONG_TEXT = "a long string that is not inline";
+
+    static GenericValue makeShared() throw() {
+        GenericValue value;
+        value.setObject();
+        value.emplace(makeName("name"), GenericValue(makeName(LONG_TEXT)));
+        GenericValue& list = value[makeName("list")];
+        for(int32_t i = 0; i < 5; ++i) list.pushBack(GenericValue(i));
+        uint64_t* const packed = value[makeName("packed")].setUnsignedArray(3);
+        packed[0] = 1;
+        packed[1] = 2;
+        packed[2] = 3;
+        return value;
+    }
+
+    static void testCopies() throw() {
+        GenericValue original = makeShared();
+        const GenericValue& constOriginal = original;
+        GenericValue copy(original);
+        const GenericValue& constCopy = copy;
+        SOLAIRE_CHECK(&constOriginal.getObject() == &constCopy.getObject());
+        SOLAIRE_CHECK(copy == original);
+
+        copy[makeName("name")].getString().pushBack('!');
+        SOLAIRE_CHECK(&constOriginal.getObject() != &constCopy.getObject());
+        SOLAIRE_CHECK(hasString(constOriginal[makeName("name")], LONG_TEXT));
+        SOLAIRE_CHECK(constCopy[makeName("name")].getStringLength() == std::strlen(LONG_TEXT) + 1);
+
+        copy[makeName("list")][2] = GenericValue(42);
+        SOLAIRE_CHECK(constOriginal[makeName("list")][2].getSigned() == 2);
+        SOLAIRE_CHECK(constCopy[makeName("list")][2].getSigned() == 42);
+        SOLAIRE_CHECK(! (copy == original));
+
+        // Packed arrays copy their elements before they are written through getPackedArray
+        static_cast<uint64_t*>(copy[makeName("packed")].getPackedArray())[0] = 9;
+        SOLAIRE_CHECK(constOriginal.find(makeName("packed"))->getUnsignedArray()[0] == 1);
+        SOLAIRE_CHECK(constCopy.find(makeName("packed"))->getUnsignedArray()[0] == 9);
+
+        // Replacing the contents of a shared value leaves the other copies alone
+        GenericValue list(constOriginal[makeName("list")]);
+        list.setArray();
+        SOLAIRE_CHECK(list.size() == 0 && constOriginal[makeName("list")].size() == 5);
+        GenericValue object(original);
+        object.setObject();
+        SOLAIRE_CHECK(object.size() == 0 && original.size() == 3);
+        GenericValue name(constOriginal[makeName("name")]);
+        name.setString() = makeName("x");
+        SOLAIRE_CHECK(hasString(constOriginal[makeName("name")], LONG_TEXT));
+    }
+
+    static void testPacked() throw() {
+        GenericValue packed;
+        uint64_t* const elements = packed.setUnsignedArray(100);
+        for(uint32_t i = 0; i < 100; ++i) elements[i] = i;
+        GenericValue copy(packed);
+
+        // Const access to the elements of a shared packed array does not unpack either copy
+        const GenericValue& constPacked = packed;
+        SOLAIRE_CHECK(constPacked.getArray().size() == 100 && constPacked.getArray()[99].getUnsigned() == 99);
+        SOLAIRE_CHECK(packed.getPackedType() == GenericValue::UNSIGNED_T);
+
+        packed.getArray().pushBack(GenericValue(100u));
+        SOLAIRE_CHECK(packed.size() == 101 && copy.size() == 100);
+        SOLAIRE_CHECK(copy.getPackedType() == GenericValue::UNSIGNED_T);
+        static_cast<uint64_t*>(copy.getPackedArray())[0] = 7;
+        SOLAIRE_CHECK(copy.getArray()[0].getUnsigned() == 7 && packed[0].getUnsigned() == 0);
+    }
+
+    static void testOwnCharacters() throw() {
+        // Setting a string from the value's own characters copies them before the old storage is released
+        for(const char* const text : {"short", LONG_TEXT}) {
+            const uint32_t length = static_cast<uint32_t>(std::strlen(text));
+            GenericValue value;
+            value.setString(text, length);
+            value.setString(value.getString());
+            SOLAIRE_CHECK(hasString(value, text));
+            const GenericValue shared(value);
+            value.setString(value.getString());
+            SOLAIRE_CHECK(hasString(value, text) && hasString(shared, text));
+
+            GenericValue parent;
+            parent[makeName("m")].setString(text, length);
+            parent.setString(parent[makeName("m")].getString());
+            SOLAIRE_CHECK(hasString(parent, text));
+
+            GenericDocument document;
+            document.getRoot()[makeName("m")].setString(text, length);
+            document.getRoot().setString(document.getRoot()[makeName("m")].getString());
+            SOLAIRE_CHECK(hasString(document.getRoot(), text));
+        }
+    }
+
+    static void testDocuments() throw() {
+        // Values in a document are copied out of its arena rather than shared
+        const GenericValue value = makeShared();
+        GenericValue copy;
+        {
+            GenericDocument document;
+            document.getRoot() = value;
+            copy = document.getRoot();
+            document.clear();
+        }
+        SOLAIRE_CHECK(copy == value);
+        SOLAIRE_CHECK(copy[makeName("list")].size() == 5);
+    }
+
+    static void modifyCopies(const GenericValue* const aValue, bool* const aResult) throw() {
+        bool result = true;
+        for(uint32_t i = 0; i < THREAD_COPIES; ++i) {
+            GenericValue copy(*aValue);
+            GenericValue copyOfCopy(copy);
+            copyOfCopy[makeName("list")].pushBack(GenericValue(i));
+            result = result && copyOfCopy[makeName("list")].size() == 6 && copy[makeName("list")].size() == 5;
+        }
+        *aResult = result;
+    }
+
+    static void testThreads() throw() {
+        const GenericValue value = makeShared();
+        std::thread threads[THREAD_COUNT];
+        bool results[THREAD_COUNT];
+        for(uint32_t i = 0; i < THREAD_COUNT; ++i) threads[i] = std::thread(&modifyCopies, &value, results + i);
+        for(uint32_t i = 0; i < THREAD_COUNT; ++i) {
+            threads[i].join();
+            SOLAIRE_CHECK(results[i]);
+        }
+        SOLAIRE_CHECK(value == makeShared());
+    }
+}
+
+int main() {
+    using namespace Solaire;
+
+    testCopies();
+    testPacked();
+    testOwnCharacters();
+    testDocuments();
+    testThreads();
+
+    return finishTest();
+}
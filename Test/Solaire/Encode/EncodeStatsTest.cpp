@@ -0,0 +1,129 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+// Checks that EncodeStats counts node allocations, copies, moves and the outermost Format calls when the library is
+// compiled with SOLAIRE_ENCODE_STATS, and that every counter stays at 0 when it is not.
+
+#include "Solaire/Encode/EncodeStats.hpp"
+#include "Solaire/Encode/CompressedFormat.hpp"
+#include "Solaire/Encode/BinaryFormat.hpp"
+#include "EncodeTest.hpp"
+
+namespace Solaire {
+
+    static bool isZero(const EncodeStats& aStats) throw() {
+        for(uint32_t i = 0; i < EncodeStats::NODE_KIND_COUNT; ++i) {
+            if(aStats.nodeAllocations[i] != 0 || aStats.nodeBytes[i] != 0) return false;
+        }
+        for(uint32_t i = 0; i < EncodeStats::OPERATION_COUNT; ++i) {
+            if(aStats.calls[i] != 0 || aStats.bytes[i] != 0 || aStats.nanoseconds[i] != 0) return false;
+        }
+        return aStats.deepCopies == 0 && aStats.sharedCopies == 0 && aStats.moves == 0;
+    }
+
+    static GenericValue makeValue() throw() {
+        GenericValue value;
+        value.setObject();
+        value.emplace(makeName("a"), GenericValue(makeName("a long string that is not inline at all")));
+        GenericValue list;
+        list.setArray();
+        list.pushBack(GenericValue(1.0));
+        value.emplace(makeName("b"), std::move(list));
+        return value;
+    }
+
+    static void testNodes(const bool aEnabled) throw() {
+        EncodeStats stats;
+        EncodeStats::reset();
+        const GenericValue value = makeValue();
+        SOLAIRE_CHECK(EncodeStats::capture(stats) == aEnabled);
+        if(! aEnabled) {
+            SOLAIRE_CHECK(isZero(stats));
+            return;
+        }
+        SOLAIRE_CHECK(stats.nodeAllocations[EncodeStats::OBJECT_NODE] == 1);
+        SOLAIRE_CHECK(stats.nodeAllocations[EncodeStats::ARRAY_NODE] == 1);
+        SOLAIRE_CHECK(stats.nodeAllocations[EncodeStats::STRING_NODE] >= 1);
+        SOLAIRE_CHECK(stats.nodeBytes[EncodeStats::OBJECT_NODE] > 0);
+        SOLAIRE_CHECK(stats.moves > 0);
+
+        // A copy shares the node until it is modified
+        EncodeStats::reset();
+        GenericValue copy(value);
+        EncodeStats::capture(stats);
+        SOLAIRE_CHECK(stats.sharedCopies == 1 && stats.deepCopies == 0);
+        copy.getObject();
+        EncodeStats::capture(stats);
+        SOLAIRE_CHECK(stats.deepCopies == 1);
+
+        EncodeStats::reset();
+        EncodeStats::capture(stats);
+        SOLAIRE_CHECK(isZero(stats));
+    }
+
+    static void testCalls(const bool aEnabled) throw() {
+        const GenericValue value = makeValue();
+        const JsonFormat json;
+        const BinaryFormat binary;
+        const CompressedFormat compressed(binary);
+        EncodeStats stats;
+        EncodeStats::reset();
+
+        // The inner format of a CompressedFormat is not counted again, nor are the checks, which also write JSON
+        BufferOStream output(getDefaultAllocator());
+        SOLAIRE_CHECK(compressed.writeValue(value, output));
+        BufferIStream input(output.getData(), output.getSize());
+        const GenericValue decoded = compressed.readValue(input);
+        EncodeStats::capture(stats);
+        SOLAIRE_CHECK(decoded == value);
+        if(aEnabled) {
+            SOLAIRE_CHECK(stats.calls[EncodeStats::WRITE_VALUE] == 1 && stats.calls[EncodeStats::READ_VALUE] == 1);
+            SOLAIRE_CHECK(stats.bytes[EncodeStats::WRITE_VALUE] == output.getSize());
+            SOLAIRE_CHECK(stats.bytes[EncodeStats::READ_VALUE] == output.getSize());
+        }else {
+            SOLAIRE_CHECK(isZero(stats));
+        }
+
+        BufferOStream text(getDefaultAllocator());
+        const bool written = json.writeValue(value, text);
+        EncodeStats::capture(stats);
+        SOLAIRE_CHECK(written);
+        if(aEnabled) {
+            SOLAIRE_CHECK(stats.calls[EncodeStats::WRITE_VALUE] == 2);
+            SOLAIRE_CHECK(stats.bytes[EncodeStats::WRITE_VALUE] == output.getSize() + text.getSize());
+        }else {
+            SOLAIRE_CHECK(isZero(stats));
+        }
+    }
+}
+
+int main() {
+    using namespace Solaire;
+
+    EncodeStats stats;
+    const bool enabled = EncodeStats::capture(stats);
+#if defined(SOLAIRE_ENCODE_STATS)
+    SOLAIRE_CHECK(enabled);
+#else
+    SOLAIRE_CHECK(! enabled);
+#endif
+    testNodes(enabled);
+    testCalls(enabled);
+
+    return finishTest();
+}
@@ -0,0 +1,271 @@
+#ifndef SOLAIRE_ENCODE_TEST_HPP
+#define SOLAIRE_ENCODE_TEST_HPP
+
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+/*!
+	\file EncodeTest.hpp
+	\brief
+	\author
+	Created			: Adam Smith
+	Last modified	: Adam Smith
+	\version 1.0
+	\date
+	Created			: 17th October 2026
+	Last Modified	: 17th October 2026
+*/
+
+// Checks and sample data shared by the tests, every test is a separate program that includes this header once.
+
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include "Solaire/Encode/BufferIStream.hpp"
+#include "Solaire/Encode/BufferOStream.hpp"
+#include "Solaire/Encode/GenericDocument.hpp"
+#include "Solaire/Encode/JsonFormat.hpp"
+
+#define SOLAIRE_CHECK(CONDITION) Solaire::check(CONDITION, #CONDITION, __LINE__)
+
+namespace Solaire {
+
+    static uint32_t gFailures = 0;
+
+    inline void check(const bool aCondition, const char* const aText, const int aLine) throw() {
+        if(aCondition) return;
+        ++gFailures;
+        std::printf("FAIL line %d : %s\n", aLine, aText);
+    }
+
+    /*!
+        \brief Report the result of a test.
+        \return The number of failed checks, which the test returns from main.
+    */
+    inline int finishTest() throw() {
+        if(gFailures == 0) std::printf("All checks passed\n");
+        return static_cast<int>(gFailures);
+    }
+
+    inline CString makeName(const char* const aName) throw() {
+        return CString(getDefaultAllocator(), aName, static_cast<uint32_t>(std::strlen(aName)));
+    }
+
+    inline bool hasString(const GenericValue& aValue, const char* const aText) throw() {
+        const uint32_t length = static_cast<uint32_t>(std::strlen(aText));
+        if(! aValue.isString() || aValue.getStringLength() != length) return false;
+        return std::memcmp(aValue.getString().getCharacters(), aText, length) == 0;
+    }
+
+    inline bool sameBytes(const BufferOStream& aFirst, const BufferOStream& aSecond) throw() {
+        return aFirst.getSize() == aSecond.getSize() && std::memcmp(aFirst.getData(), aSecond.getData(), aFirst.getSize()) == 0;
+    }
+
+    inline bool sameJson(const GenericValue& aFirst, const GenericValue& aSecond) throw() {
+        // Packed and unpacked arrays with the same elements write the same text
+        const JsonFormat json;
+        BufferOStream first(getDefaultAllocator());
+        BufferOStream second(getDefaultAllocator());
+        json.writeValue(aFirst, first);
+        json.writeValue(aSecond, second);
+        return sameBytes(first, second);
+    }
+
+    inline GenericValue fromJson(const char* const aText) throw() {
+        BufferIStream input(aText, static_cast<uint32_t>(std::strlen(aText)));
+        return JsonFormat().readValue(input);
+    }
+
+    inline GenericValue makeSample() throw() {
+        GenericValue value = fromJson(
+            "{\"a\":[1,-2,3.5,true,false,null,\"x\\u00e9\\ud83d\\ude00\\n\"],\"b\":{},\"c\":[],"
+            "\"long name that is long\":\"a string that is longer than fifteen\",\"d\":[[{\"e\":18446744073709551615}]],"
+            "\"f\":-9223372036854775808,\"g\":1e300}"
+        );
+        uint64_t* const packed = value[makeName("p")].setUnsignedArray(3);
+        packed[0] = 1;
+        packed[1] = 300;
+        packed[2] = 70000;
+        double* const doubles = value[makeName("q")].setDoubleArray(2);
+        doubles[0] = -0.5;
+        doubles[1] = 1e-300;
+        return value;
+    }
+
+    inline void write(const Format& aFormat, const GenericValue& aValue, BufferOStream& aOutput) throw() {
+        aOutput.clear();
+        SOLAIRE_CHECK(aFormat.writeValue(aValue, aOutput));
+    }
+
+    inline void destroyParser(Parser* const aParser) throw() {
+        aParser->~Parser();
+        getDefaultAllocator().deallocate(aParser);
+    }
+
+	// ChunkedIStream
+
+    /*!
+        \brief Reads from a block of memory at most a fixed number of bytes at a time.
+        \details It is not a BufferIStream, so Readers can not borrow from it and have to copy what they read.
+    */
+    class ChunkedIStream : public IStream {
+    private:
+        const uint8_t* const mData;
+        const uint32_t mSize;
+        const uint32_t mChunk;
+        uint32_t mOffset;
+    public:
+        ChunkedIStream(const void* const aData, const uint32_t aSize, const uint32_t aChunk) throw() :
+            mData(static_cast<const uint8_t*>(aData)),
+            mSize(aSize),
+            mChunk(aChunk),
+            mOffset(0)
+        {}
+
+        // Inherited from IStream
+
+        uint32_t SOLAIRE_EXPORT_CALL read(void* const aBuffer, const uint32_t aBytes) throw() override {
+            uint32_t bytes = aBytes < mChunk ? aBytes : mChunk;
+            if(bytes > mSize - mOffset) bytes = mSize - mOffset;
+            std::memcpy(aBuffer, mData + mOffset, bytes);
+            mOffset += bytes;
+            return bytes;
+        }
+
+        bool SOLAIRE_EXPORT_CALL end() const throw() override {
+            return mOffset >= mSize;
+        }
+
+        bool SOLAIRE_EXPORT_CALL isOffsetable() const throw() override {
+            return true;
+        }
+
+        int32_t SOLAIRE_EXPORT_CALL getOffset() const throw() override {
+            return static_cast<int32_t>(mOffset);
+        }
+
+        bool SOLAIRE_EXPORT_CALL setOffset(const int32_t aOffset) throw() override {
+            if(aOffset < 0 || static_cast<uint32_t>(aOffset) > mSize) return false;
+            mOffset = static_cast<uint32_t>(aOffset);
+            return true;
+        }
+    };
+
+	// CountingAllocator
+
+    /*!
+        \brief Counts the allocations and deallocations that are made through it, and records the largest allocation.
+    */
+    class CountingAllocator : public Allocator {
+    private:
+        Allocator& mParent;
+        uint32_t mAllocations;
+        uint32_t mDeallocations;
+        uint32_t mLargest;
+    private:
+        CountingAllocator(const CountingAllocator&) = delete;
+        CountingAllocator& operator=(const CountingAllocator&) = delete;
+    public:
+        CountingAllocator(Allocator& aParent = getDefaultAllocator()) throw() :
+            mParent(aParent),
+            mAllocations(0),
+            mDeallocations(0),
+            mLargest(0)
+        {}
+
+        SOLAIRE_FORCE_INLINE uint32_t getAllocations() const throw()      {return mAllocations;}
+        SOLAIRE_FORCE_INLINE uint32_t getDeallocations() const throw()    {return mDeallocations;}
+        SOLAIRE_FORCE_INLINE uint32_t getLargestAllocation() const throw() {return mLargest;}
+
+        // Inherited from Allocator
+
+        uint32_t SOLAIRE_EXPORT_CALL getAllocatedBytes() const throw() override {
+            return mParent.getAllocatedBytes();
+        }
+
+        uint32_t SOLAIRE_EXPORT_CALL getFreeBytes() const throw() override {
+            return mParent.getFreeBytes();
+        }
+
+        void* SOLAIRE_EXPORT_CALL allocate(const uint32_t aBytes) throw() override {
+            ++mAllocations;
+            if(aBytes > mLargest) mLargest = aBytes;
+            return mParent.allocate(aBytes);
+        }
+
+        bool SOLAIRE_EXPORT_CALL deallocate(const void* const aObject) throw() override {
+            ++mDeallocations;
+            return mParent.deallocate(aObject);
+        }
+    };
+
+	// Shared checks
+
+    /*!
+        \brief Check that a format reads back the sample it writes, from any kind of stream and into a GenericDocument.
+    */
+    inline void checkRoundTrip(const Format& aFormat) throw() {
+        const GenericValue sample = makeSample();
+        BufferOStream output(getDefaultAllocator());
+        write(aFormat, sample, output);
+
+        {
+            BufferIStream input(output.getData(), output.getSize());
+            SOLAIRE_CHECK(sameJson(aFormat.readValue(input), sample));
+        }
+        for(const uint32_t chunk : {1u, 7u}) {
+            ChunkedIStream input(output.getData(), output.getSize(), chunk);
+            SOLAIRE_CHECK(sameJson(aFormat.readValue(input), sample));
+        }
+        {
+            BufferIStream input(output.getData(), output.getSize());
+            GenericDocument document;
+            SOLAIRE_CHECK(aFormat.readDocument(input, document));
+            SOLAIRE_CHECK(sameJson(document.getRoot(), sample));
+        }
+    }
+
+    /*!
+        \brief Check that every prefix of an encoded value is rejected by readValue and by the format's Parser.
+    */
+    inline void checkTruncated(const Format& aFormat) throw() {
+        const GenericValue sample = makeSample();
+        BufferOStream output(getDefaultAllocator());
+        write(aFormat, sample, output);
+        const uint8_t* const data = static_cast<const uint8_t*>(output.getData());
+
+        for(uint32_t size = 0; size < output.getSize(); ++size) {
+            BufferIStream input(data, size);
+            SOLAIRE_CHECK(! sameJson(aFormat.readValue(input), sample));
+
+            Parser* const parser = aFormat.createParser(getDefaultAllocator());
+            if(parser == nullptr) continue;
+            uint32_t offset = 0;
+            while(offset < size && ! parser->hasFailed() && ! parser->hasValue()) {
+                const uint32_t consumed = parser->parse(data + offset, size - offset);
+                if(consumed == 0) break;
+                offset += consumed;
+            }
+            parser->finish();
+            SOLAIRE_CHECK(! parser->hasValue());
+            destroyParser(parser);
+        }
+    }
+}
+
+#endif
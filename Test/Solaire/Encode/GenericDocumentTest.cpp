@@ -0,0 +1,147 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+// Checks that a GenericDocument allocates its tree in blocks that are released together, that values moved out of or
+// into a document own their data, and that readDocument reports failures for formats without a Reader.
+
+#include "Solaire/Encode/BinaryFormat.hpp"
+#include "EncodeTest.hpp"
+
+namespace Solaire {
+
+    /*!
+        \brief A format without a Reader : "u" is the number 7, "n" is null and anything else is an error.
+    */
+    class LetterFormat : public Format {
+    public:
+        // Inherited from Format
+
+        GenericValue SOLAIRE_EXPORT_CALL readValue(IStream& aStream) const throw() override {
+            char letter;
+            if(aStream.read(&letter, 1) != 1 || letter != 'u') return GenericValue();
+            return GenericValue(static_cast<uint64_t>(7));
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeValue(const GenericValue& aValue, OStream& aStream) const throw() override {
+            const char letter = aValue.isNull() ? 'n' : 'u';
+            return aStream.write(&letter, 1) == 1;
+        }
+    };
+
+    static void fillDocument(GenericValue& aRoot) throw() {
+        GenericValue& array = aRoot[makeName("a")];
+        for(uint32_t i = 0; i < 100; ++i) {
+            GenericValue& element = array.pushBack(GenericValue());
+            element[makeName("name")].setString("a member name that is long", 26);
+            element[makeName("i")] = GenericValue(i);
+            element[makeName("list")].pushBack(GenericValue(1u));
+        }
+        aRoot[makeName("s")].setString("another string that is long", 27);
+    }
+
+    static void testArena() throw() {
+        GenericValue expected;
+        fillDocument(expected);
+        const BinaryFormat binary;
+        BufferOStream output(getDefaultAllocator());
+        write(binary, expected, output);
+
+        // Hundreds of nodes are decoded into a few blocks, which are the only memory released with the document
+        CountingAllocator allocator;
+        {
+            GenericDocument document(allocator);
+            BufferIStream input(output.getData(), output.getSize());
+            SOLAIRE_CHECK(binary.readDocument(input, document));
+            SOLAIRE_CHECK(sameJson(document.getRoot(), expected));
+            SOLAIRE_CHECK(allocator.getAllocations() > 0 && allocator.getAllocations() < 20);
+
+            // Reading into a document again releases the previous tree
+            BufferIStream again(output.getData(), output.getSize());
+            SOLAIRE_CHECK(binary.readDocument(again, document));
+            SOLAIRE_CHECK(sameJson(document.getRoot(), expected));
+        }
+        SOLAIRE_CHECK(allocator.getDeallocations() == allocator.getAllocations());
+    }
+
+    static void testOwnership() throw() {
+        GenericValue moved;
+        GenericValue assigned;
+        GenericValue whole;
+        GenericValue expected;
+        {
+            GenericDocument document;
+            fillDocument(document.getRoot());
+            fillDocument(expected);
+
+            // Values moved out of the document are copied, because its arena is released with it
+            GenericValue out(std::move(document.getRoot()[makeName("a")]));
+            SOLAIRE_CHECK(document.getRoot()[makeName("a")].isNull());
+            SOLAIRE_CHECK(sameJson(out, expected[makeName("a")]));
+            moved = out;
+            assigned = std::move(document.getRoot()[makeName("s")]);
+            SOLAIRE_CHECK(document.getRoot()[makeName("s")].isNull());
+            GenericValue root(std::move(document.getRoot()));
+            whole = std::move(root);
+        }
+        SOLAIRE_CHECK(sameJson(moved, expected[makeName("a")]));
+        SOLAIRE_CHECK(hasString(assigned, "another string that is long"));
+        SOLAIRE_CHECK(whole.isObject() && whole.size() == 2);
+        moved[0][makeName("i")] = GenericValue(7u);
+        SOLAIRE_CHECK(moved[0][makeName("i")].getUnsigned() == 7);
+
+        // Values assigned into a document are copied into its arena
+        {
+            GenericDocument document;
+            GenericValue value;
+            fillDocument(value);
+            document.getRoot() = std::move(value);
+            SOLAIRE_CHECK(sameJson(document.getRoot(), expected));
+            document.getRoot()[makeName("a")].pushBack(GenericValue(std::move(document.getRoot()[makeName("s")])));
+            SOLAIRE_CHECK(document.getRoot()[makeName("a")].size() == 101);
+        }
+    }
+
+    static void testWithoutReader() throw() {
+        const LetterFormat format;
+        GenericDocument document;
+        {
+            BufferIStream input("u", 1);
+            SOLAIRE_CHECK(format.readDocument(input, document));
+            SOLAIRE_CHECK(document.getRoot().getUnsigned() == 7);
+        }
+        {
+            BufferIStream input("n", 1);
+            SOLAIRE_CHECK(format.readDocument(input, document));
+            SOLAIRE_CHECK(document.getRoot().isNull());
+        }
+        {
+            BufferIStream input("", 0);
+            SOLAIRE_CHECK(! format.readDocument(input, document));
+        }
+    }
+}
+
+int main() {
+    using namespace Solaire;
+
+    testArena();
+    testOwnership();
+    testWithoutReader();
+
+    return finishTest();
+}
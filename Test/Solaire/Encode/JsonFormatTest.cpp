@@ -0,0 +1,162 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+// Checks that JsonFormat reads back what it writes, reads consecutive documents from one stream, rejects malformed text,
+// and that JsonIndexer finds the same tokens as a character by character scan, however the text is split.
+
+#include "Solaire/Encode/JsonIndexer.hpp"
+#include "EncodeTest.hpp"
+
+namespace Solaire {
+
+    enum : uint32_t {
+        MAX_TEXT = 4096     //!< The longest text given to the indexer.
+    };
+
+    static uint32_t indexSlowly(const char* const aText, const uint32_t aLength, uint32_t* const aPositions) throw() {
+        uint32_t count = 0;
+        bool inString = false;
+        bool escaped = false;
+        bool inScalar = false;
+        for(uint32_t i = 0; i < aLength; ++i) {
+            const char c = aText[i];
+            if(inString) {
+                if(escaped) escaped = false;
+                else if(c == '\\') escaped = true;
+                else if(c == '"') inString = false;
+            }else if(c == '"') {
+                aPositions[count++] = i;
+                inString = true;
+                inScalar = false;
+            }else if(std::strchr("{}[]:,", c) != nullptr) {
+                aPositions[count++] = i;
+                inScalar = false;
+            }else if(c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+                inScalar = false;
+            }else if(! inScalar) {
+                aPositions[count++] = i;
+                inScalar = true;
+            }
+        }
+        return count;
+    }
+
+    static void checkIndex(const char* const aText, const uint32_t aLength) throw() {
+        static uint32_t expected[MAX_TEXT];
+        static uint32_t positions[MAX_TEXT];
+        const uint32_t count = indexSlowly(aText, aLength, expected);
+
+        JsonIndexer indexer;
+        SOLAIRE_CHECK(indexer.index(aText, aLength, 0, positions) == count);
+        SOLAIRE_CHECK(std::memcmp(positions, expected, sizeof(uint32_t) * count) == 0);
+        SOLAIRE_CHECK(! indexer.isInString());
+
+        // State carries between chunks of whole blocks
+        for(const uint32_t chunk : {static_cast<uint32_t>(JsonIndexer::BLOCK_BYTES), static_cast<uint32_t>(JsonIndexer::BLOCK_BYTES) * 3}) {
+            indexer.reset();
+            uint32_t found = 0;
+            for(uint32_t offset = 0; offset < aLength; offset += chunk) {
+                const uint32_t length = aLength - offset < chunk ? aLength - offset : chunk;
+                found += indexer.index(aText + offset, length, offset, positions + found);
+            }
+            SOLAIRE_CHECK(found == count);
+            SOLAIRE_CHECK(std::memcmp(positions, expected, sizeof(uint32_t) * count) == 0);
+        }
+    }
+
+    static void testIndexer() throw() {
+        std::printf("JsonIndexer : %s\n", JsonIndexer::getImplementation());
+
+        // Runs of backslashes and quotes that cross block boundaries at every offset
+        static char text[MAX_TEXT];
+        for(uint32_t shift = 0; shift < JsonIndexer::BLOCK_BYTES; ++shift) {
+            uint32_t length = 0;
+            text[length++] = '[';
+            for(uint32_t i = 0; i < shift; ++i) text[length++] = ' ';
+            for(uint32_t run = 0; run < 8; ++run) {
+                text[length++] = '"';
+                for(uint32_t i = 0; i < run * 2; ++i) text[length++] = '\\';
+                text[length++] = '\\';
+                text[length++] = '"';
+                text[length++] = '{';
+                text[length++] = '"';
+                text[length++] = ',';
+                length += static_cast<uint32_t>(std::snprintf(text + length, 32, "-12.5e3,true,{\"k\":null},"));
+            }
+            text[length++] = '1';
+            text[length++] = ']';
+            checkIndex(text, length);
+        }
+
+        BufferOStream output(getDefaultAllocator());
+        write(JsonFormat(), makeSample(), output);
+        checkIndex(static_cast<const char*>(output.getData()), output.getSize());
+    }
+
+    static void testDocuments() throw() {
+        const JsonFormat json;
+
+        // Only the value is consumed, so consecutive documents can be read from one stream
+        const char* const text = "{\"a\":[1,2]} [3]\n\"str\" 42 true\n";
+        const uint32_t size = static_cast<uint32_t>(std::strlen(text));
+        for(const uint32_t chunk : {1u, 5u, size}) {
+            ChunkedIStream input(text, size, chunk);
+            const GenericValue object = json.readValue(input);
+            SOLAIRE_CHECK(object.isObject() && object.size() == 1);
+            const GenericValue array = json.readValue(input);
+            SOLAIRE_CHECK(array.isArray() && array.size() == 1);
+            SOLAIRE_CHECK(hasString(json.readValue(input), "str"));
+            SOLAIRE_CHECK(json.readValue(input).getUnsigned() == 42);
+            SOLAIRE_CHECK(json.readValue(input).getBool());
+            SOLAIRE_CHECK(input.end());
+        }
+        {
+            BufferIStream input(text, size);
+            SOLAIRE_CHECK(json.readValue(input).isObject());
+            SOLAIRE_CHECK(json.readValue(input).isArray());
+        }
+
+        for(const char* const malformed : {"[1]]", "{\"a\":1}}", "[1],", "\"a\"x", "1 :", "[1]x", "[1,2", "{\"a\":}", "tru"}) {
+            BufferIStream input(malformed, static_cast<uint32_t>(std::strlen(malformed)));
+            SOLAIRE_CHECK(json.readValue(input).isNull());
+        }
+    }
+
+    static void testEscapes() throw() {
+        const GenericValue value = fromJson("[\"tab\\tquote\\\"slash\\/\\\\\",\"\\u00e9\\ud83d\\ude00\"]");
+        SOLAIRE_CHECK(value.size() == 2);
+        if(value.size() != 2) return;
+        SOLAIRE_CHECK(hasString(value[0], "tab\tquote\"slash/\\"));
+        SOLAIRE_CHECK(hasString(value[1], "\xC3\xA9\xF0\x9F\x98\x80"));
+        SOLAIRE_CHECK(fromJson("\"\\ud83d\"").isNull());
+        SOLAIRE_CHECK(fromJson("\"\\x\"").isNull());
+    }
+}
+
+int main() {
+    using namespace Solaire;
+
+    const JsonFormat json;
+    checkRoundTrip(json);
+    checkTruncated(json);
+    testIndexer();
+    testDocuments();
+    testEscapes();
+
+    return finishTest();
+}
@@ -0,0 +1,148 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+// Checks that a KeyTable gives each name one Key however many threads intern it, that it stops growing at its maximum
+// size, and that objects created while it is shared intern their member names when they are added or decoded.
+
+#include <thread>
+#include "Solaire/Encode/KeyTable.hpp"
+#include "Solaire/Encode/GenericObjectMap.hpp"
+#include "Solaire/Encode/StructuralHash.hpp"
+#include "Solaire/Encode/BinaryFormat.hpp"
+#include "EncodeTest.hpp"
+
+namespace Solaire {
+
+    enum : uint32_t {
+        NAME_COUNT = 20000,     //!< The number of distinct names that the threads intern.
+        THREAD_COUNT = 8        //!< The number of threads that intern names at once.
+    };
+
+    static CString makeKey(const uint32_t aIndex) throw() {
+        char name[16];
+        return CString(getDefaultAllocator(), name, static_cast<uint32_t>(std::snprintf(name, sizeof(name), "k%u", aIndex)));
+    }
+
+    static const GenericObjectMap& getMembers(const GenericValue& aValue) throw() {
+        return static_cast<const GenericObjectMap&>(aValue.getObject());
+    }
+
+    static void testIntern() throw() {
+        // Few buckets, so that they are doubled many times while names are added
+        KeyTable table(getDefaultAllocator(), 16, 5000);
+        ArrayList<const KeyTable::Key*> keys(getDefaultAllocator());
+        for(uint32_t i = 0; i < 5000; ++i) {
+            const CString name = makeKey(i);
+            const KeyTable::Key* const key = table.intern(name);
+            SOLAIRE_CHECK(key != nullptr);
+            if(key == nullptr) return;
+            SOLAIRE_CHECK(&key->getTable() == &table);
+            SOLAIRE_CHECK(key->getLength() == static_cast<uint32_t>(name.size()));
+            SOLAIRE_CHECK(std::memcmp(key->getCharacters(), &name[0], key->getLength()) == 0);
+            SOLAIRE_CHECK(key->getHash() == GenericObjectMap::hash(name));
+            SOLAIRE_CHECK(key->getNameHash() == StructuralHash::hashName(&name[0], key->getLength()));
+            keys.pushBack(key);
+        }
+        SOLAIRE_CHECK(table.size() == 5000);
+        for(uint32_t i = 0; i < 5000; ++i) {
+            SOLAIRE_CHECK(table.find(makeKey(i)) == keys[i]);
+            SOLAIRE_CHECK(table.intern(makeKey(i)) == keys[i]);
+        }
+
+        // A full table still finds its names but adds no more
+        SOLAIRE_CHECK(table.intern(makeKey(5000)) == nullptr);
+        SOLAIRE_CHECK(table.find(makeKey(5000)) == nullptr);
+        SOLAIRE_CHECK(table.size() == 5000);
+    }
+
+    static void internNames(KeyTable* const aTable, const uint32_t aThread, const KeyTable::Key** const aKeys) throw() {
+        for(uint32_t i = 0; i < NAME_COUNT; ++i) aKeys[i] = aTable->intern(makeKey((i * 7 + aThread * 13) % NAME_COUNT));
+    }
+
+    static void testThreads() throw() {
+        KeyTable table(getDefaultAllocator(), 16, 100000);
+        ArrayList<const KeyTable::Key*> keys(getDefaultAllocator());
+        for(uint32_t i = 0; i < THREAD_COUNT * NAME_COUNT; ++i) keys.pushBack(nullptr);
+        std::thread threads[THREAD_COUNT];
+        for(uint32_t i = 0; i < THREAD_COUNT; ++i) threads[i] = std::thread(&internNames, &table, i, &keys[i * NAME_COUNT]);
+        for(uint32_t i = 0; i < THREAD_COUNT; ++i) threads[i].join();
+
+        SOLAIRE_CHECK(table.size() == NAME_COUNT);
+        for(uint32_t thread = 0; thread < THREAD_COUNT; ++thread) {
+            for(uint32_t i = 0; i < NAME_COUNT; ++i) {
+                const KeyTable::Key* const key = keys[thread * NAME_COUNT + i];
+                SOLAIRE_CHECK(key != nullptr && key == table.find(makeKey((i * 7 + thread * 13) % NAME_COUNT)));
+            }
+        }
+    }
+
+    static void testShared() throw() {
+        // The table is full after 3 names, objects with a name that it can not hold compare all of theirs by characters
+        KeyTable table(getDefaultAllocator(), 16, 3);
+        const GenericValue small = fromJson("{\"k0\":0,\"k1\":1,\"k2\":2}");
+        const GenericValue large = fromJson("{\"k0\":0,\"k1\":1,\"k2\":2,\"k3\":3,\"k4\":4}");
+        KeyTable::setShared(&table);
+        SOLAIRE_CHECK(KeyTable::getShared() == &table);
+        {
+            GenericValue object;
+            object.setObject();
+            for(uint32_t i = 0; i < 3; ++i) object[makeKey(i)] = GenericValue(i);
+            SOLAIRE_CHECK(table.size() == 3);
+            for(uint32_t i = 0; i < 3; ++i) SOLAIRE_CHECK(getMembers(object).getKey(i) == table.find(makeKey(i)));
+            SOLAIRE_CHECK(object[makeKey(1)].getUnsigned() == 1);
+            SOLAIRE_CHECK(object == small && small == object && object.hash() == small.hash());
+
+            for(uint32_t i = 3; i < 10; ++i) object[makeKey(i)] = GenericValue(i);
+            for(uint32_t i = 0; i < 10; ++i) SOLAIRE_CHECK(object[makeKey(i)].getUnsigned() == i);
+            SOLAIRE_CHECK(getMembers(object).getKey(0) == nullptr);
+            SOLAIRE_CHECK(table.size() == 3);
+
+            GenericValue reversed;
+            reversed.setObject();
+            for(uint32_t i = 10; i > 0; --i) reversed.emplace(makeKey(i - 1), GenericValue(i - 1));
+            SOLAIRE_CHECK(object == reversed && object.hash() == reversed.hash());
+
+            // Decoded objects intern their names too, and compare equal to objects that do not
+            const BinaryFormat binary;
+            for(const GenericValue* const value : {&small, &large}) {
+                BufferOStream output(getDefaultAllocator());
+                write(binary, *value, output);
+                BufferIStream input(output.getData(), output.getSize());
+                const GenericValue decoded = binary.readValue(input);
+                SOLAIRE_CHECK(getMembers(*value).getKey(1) == nullptr);
+                SOLAIRE_CHECK(getMembers(decoded).getKey(1) == (value == &small ? table.find(makeKey(1)) : nullptr));
+                SOLAIRE_CHECK(decoded == *value && *value == decoded);
+                SOLAIRE_CHECK(decoded.hash() == value->hash());
+                SOLAIRE_CHECK(decoded.find(makeName("k2"))->getUnsigned() == 2);
+                SOLAIRE_CHECK(decoded.find(makeName("k5")) == nullptr);
+            }
+        }
+        KeyTable::setShared(nullptr);
+        SOLAIRE_CHECK(KeyTable::getShared() == nullptr);
+    }
+}
+
+int main() {
+    using namespace Solaire;
+
+    testIntern();
+    testThreads();
+    testShared();
+
+    return finishTest();
+}
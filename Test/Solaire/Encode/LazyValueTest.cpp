@@ -0,0 +1,158 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+// Checks that values read with readLazyValue are equal to the same values read eagerly, that nested containers are only
+// decoded when they are accessed, without changing their storage when that access is const, and that nested values
+// which can not be decoded are reported.
+
+#include "Solaire/Encode/SchemaFormat.hpp"
+#include "Solaire/Encode/CompressedFormat.hpp"
+#include "EncodeTest.hpp"
+
+namespace Solaire {
+
+    static const char* const TEXT =
+        "{\"route\":{\"from\":\"a\",\"to\":[1,2,{\"x\":[[]]}],\"meta\":{}},\"hops\":[{\"id\":1},{\"id\":2}],"
+        "\"n\":5,\"d\":[1.5,-2],\"s\":\"a string that is longer than fifteen\"}";
+
+    /*!
+        \brief A format without a Reader, 'u' decodes to 7 and 'n' to null.
+    */
+    class LetterFormat : public Format {
+    public:
+        // Inherited from Format
+
+        GenericValue SOLAIRE_EXPORT_CALL readValue(IStream& aStream) const throw() override {
+            char letter;
+            if(aStream.read(&letter, 1) != 1 || letter != 'u') return GenericValue();
+            return GenericValue(static_cast<uint64_t>(7));
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeValue(const GenericValue& aValue, OStream& aStream) const throw() override {
+            const char letter = aValue.isNull() ? 'n' : 'u';
+            return aStream.write(&letter, 1) == 1;
+        }
+    };
+
+    static void testFormat(const Format& aFormat, const bool aNested) throw() {
+        const GenericValue expected = fromJson(TEXT);
+        BufferOStream output(getDefaultAllocator());
+        write(aFormat, expected, output);
+
+        GenericValue value;
+        SOLAIRE_CHECK(aFormat.readLazyValue(output.getData(), output.getSize(), value));
+        SOLAIRE_CHECK(value.isObject() && ! value.isLazy());
+        const GenericValue& constValue = value;
+        if(aNested) {
+            SOLAIRE_CHECK(constValue.find(makeName("route"))->isLazy());
+            SOLAIRE_CHECK(constValue.find(makeName("hops"))->isLazy());
+        }
+
+        // Const access decodes without replacing the lazy storage, copies share it
+        const GenericValue copy(value);
+        SOLAIRE_CHECK(constValue[makeName("n")].getUnsigned() == 5);
+        SOLAIRE_CHECK(hasString(constValue[makeName("route")][makeName("from")], "a"));
+        SOLAIRE_CHECK(constValue[makeName("route")][makeName("to")].size() == 3);
+        SOLAIRE_CHECK(constValue[makeName("route")][makeName("to")][2][makeName("x")][0].size() == 0);
+        if(aNested) SOLAIRE_CHECK(constValue.find(makeName("route"))->isLazy());
+        SOLAIRE_CHECK(! constValue[makeName("route")].hasDecodeFailed());
+        SOLAIRE_CHECK(value == expected && copy == expected);
+        SOLAIRE_CHECK(value.hash() == expected.hash());
+        SOLAIRE_CHECK(sameJson(value, expected) && sameJson(copy, expected));
+
+        // Modifying a lazy value decodes it first
+        GenericValue modified;
+        SOLAIRE_CHECK(aFormat.readLazyValue(output.getData(), output.getSize(), modified));
+        const GenericValue unmodified(modified);
+        modified[makeName("hops")].pushBack(GenericValue(9u));
+        modified[makeName("route")].emplace(makeName("new"), GenericValue(true));
+        SOLAIRE_CHECK(! modified[makeName("hops")].isLazy());
+        SOLAIRE_CHECK(modified[makeName("hops")].size() == 3 && modified[makeName("route")].size() == 4);
+        SOLAIRE_CHECK(unmodified == expected);
+        modified[makeName("hops")].setNull();
+        SOLAIRE_CHECK(modified[makeName("hops")].isNull());
+
+        GenericValue reserved;
+        SOLAIRE_CHECK(aFormat.readLazyValue(output.getData(), output.getSize(), reserved));
+        reserved[makeName("hops")].reserve(10);
+        SOLAIRE_CHECK(reserved[makeName("hops")].size() == 2);
+
+        // Documents copy the decoded values into their arena
+        GenericDocument document;
+        SOLAIRE_CHECK(aFormat.readLazyValue(output.getData(), output.getSize(), document.getRoot()));
+        SOLAIRE_CHECK(sameJson(document.getRoot(), expected));
+        const GenericValue out(document.getRoot());
+        document.clear();
+        SOLAIRE_CHECK(sameJson(out, expected));
+    }
+
+    static void testMalformed() throw() {
+        const JsonFormat json;
+
+        // The outer value is read, the nested array that can not be decoded reports it when it is accessed
+        const char* const text = "[1,[1,,]]";
+        GenericValue value;
+        SOLAIRE_CHECK(json.readLazyValue(text, static_cast<uint32_t>(std::strlen(text)), value));
+        SOLAIRE_CHECK(value.size() == 2);
+        if(value.size() != 2) return;
+        const GenericValue& inner = static_cast<const GenericValue&>(value)[1];
+        SOLAIRE_CHECK(inner.isArray() && inner.size() == 0 && inner.hasDecodeFailed());
+
+        GenericValue malformed;
+        malformed.setLazy(GenericValue::ARRAY_T, json, "[1,2,", 5);
+        SOLAIRE_CHECK(malformed.hasDecodeFailed() && malformed.size() == 0);
+        GenericValue copy(malformed);
+        SOLAIRE_CHECK(copy.hasDecodeFailed());
+        copy.setArray();
+        SOLAIRE_CHECK(! copy.hasDecodeFailed());
+
+        // Data of another type decodes to an empty value of the stated type
+        GenericValue object;
+        object.setLazy(GenericValue::OBJECT_T, json, "[1]", 3);
+        SOLAIRE_CHECK(object.isObject() && object.size() == 0 && object.hasDecodeFailed());
+        GenericValue array;
+        array.setLazy(GenericValue::ARRAY_T, json, "[1]", 3);
+        SOLAIRE_CHECK(array[0].getUnsigned() == 1);
+    }
+
+    static void testWithoutReader() throw() {
+        const LetterFormat format;
+        GenericValue value;
+        SOLAIRE_CHECK(format.readLazyValue("u", 1, value) && value.getUnsigned() == 7);
+        SOLAIRE_CHECK(format.readLazyValue("n", 1, value) && value.isNull());
+        SOLAIRE_CHECK(! format.readLazyValue("", 0, value));
+    }
+}
+
+int main() {
+    using namespace Solaire;
+
+    Schema schema(getDefaultAllocator());
+    schema.addField(makeName("route"));
+    schema.addField(makeName("hops"));
+    const JsonFormat json;
+    const BinaryFormat binary;
+    testFormat(json, true);
+    testFormat(binary, true);
+    testFormat(SchemaFormat(schema), true);
+    testFormat(CompressedFormat(binary), false);
+    testMalformed();
+    testWithoutReader();
+
+    return finishTest();
+}
@@ -0,0 +1,110 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+// Checks that MappedIStream exposes exactly the bytes of a file, that formats decode from it the same values as from a
+// copy of the file in memory, and that borrowed strings reference the mapping. The files are written to the working
+// directory and removed afterwards.
+
+#include "Solaire/Encode/MappedIStream.hpp"
+#include "Solaire/Encode/BinaryFormat.hpp"
+#include "EncodeTest.hpp"
+
+namespace Solaire {
+
+    static const char* const FILE_PATH = "MappedIStreamTest.tmp";
+    static const char* const EMPTY_PATH = "MappedIStreamTest.empty";
+
+    static bool writeFile(const char* const aPath, const BufferOStream& aData) throw() {
+        std::FILE* const file = std::fopen(aPath, "wb");
+        if(file == nullptr) return false;
+        const bool result = aData.getSize() == 0 || std::fwrite(aData.getData(), 1, aData.getSize(), file) == aData.getSize();
+        return std::fclose(file) == 0 && result;
+    }
+
+    static void testFile(const Format& aFormat, const Format& aBorrowing) throw() {
+        // Enough documents to span many pages
+        BufferOStream output(getDefaultAllocator());
+        const GenericValue sample = makeSample();
+        for(uint32_t i = 0; i < 500; ++i) SOLAIRE_CHECK(aFormat.writeValue(sample, output));
+        SOLAIRE_CHECK(writeFile(FILE_PATH, output));
+
+        MappedIStream input;
+        SOLAIRE_CHECK(input.open(FILE_PATH));
+        SOLAIRE_CHECK(input.isOpen() && input.getSize() == output.getSize());
+        SOLAIRE_CHECK(std::memcmp(input.getData(), output.getData(), output.getSize()) == 0);
+
+        BufferIStream memory(output.getData(), output.getSize());
+        uint32_t documents = 0;
+        while(! input.end()) {
+            const GenericValue value = aFormat.readValue(input);
+            if(! (value == aFormat.readValue(memory))) break;
+            ++documents;
+        }
+        SOLAIRE_CHECK(documents == 500);
+        SOLAIRE_CHECK(input.getOffset() == memory.getOffset());
+
+        // Strings are borrowed from the mapping
+        SOLAIRE_CHECK(input.setOffset(0));
+        const GenericValue borrowed = aBorrowing.readValue(input);
+        SOLAIRE_CHECK(sameJson(borrowed, sample));
+        const char* const characters = borrowed[makeName("long name that is long")].getStringPointer();
+        const char* const begin = static_cast<const char*>(input.getData());
+        SOLAIRE_CHECK(characters >= begin && characters < begin + input.getSize());
+
+        input.close();
+        SOLAIRE_CHECK(! input.isOpen() && input.getSize() == 0);
+        SOLAIRE_CHECK(std::remove(FILE_PATH) == 0);
+    }
+
+    static void testOpening() throw() {
+        MappedIStream input;
+        SOLAIRE_CHECK(! input.isOpen());
+        SOLAIRE_CHECK(! input.open("MappedIStreamTest.missing"));
+        SOLAIRE_CHECK(! input.isOpen() && input.end());
+
+        BufferOStream text(getDefaultAllocator());
+        text.write("[1,2,3]", 7);
+        SOLAIRE_CHECK(writeFile(FILE_PATH, text));
+        SOLAIRE_CHECK(writeFile(EMPTY_PATH, BufferOStream(getDefaultAllocator())));
+
+        // Opening another file replaces the mapping, empty files open with no data
+        SOLAIRE_CHECK(input.open(FILE_PATH));
+        SOLAIRE_CHECK(JsonFormat().readValue(input).size() == 3);
+        SOLAIRE_CHECK(input.open(EMPTY_PATH));
+        SOLAIRE_CHECK(input.isOpen() && input.getSize() == 0 && input.end());
+        SOLAIRE_CHECK(JsonFormat().readValue(input).isNull());
+        SOLAIRE_CHECK(input.open(FILE_PATH));
+        SOLAIRE_CHECK(input.getOffset() == 0 && input.getSize() == 7);
+        input.close();
+        input.close();
+        SOLAIRE_CHECK(! input.isOpen());
+
+        SOLAIRE_CHECK(std::remove(FILE_PATH) == 0);
+        SOLAIRE_CHECK(std::remove(EMPTY_PATH) == 0);
+    }
+}
+
+int main() {
+    using namespace Solaire;
+
+    testFile(JsonFormat(), JsonFormat(true));
+    testFile(BinaryFormat(), BinaryFormat(true));
+    testOpening();
+
+    return finishTest();
+}
@@ -0,0 +1,182 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+// Checks that NumberFormat writes the shortest text that reads back to the same double, and that it parses integers and
+// doubles exactly as strtod and strtoull do. Random values are generated from a constant seed.
+
+#include <cstdlib>
+#include "Solaire/Encode/NumberFormat.hpp"
+#include "EncodeTest.hpp"
+
+namespace Solaire {
+
+    enum : uint32_t {
+        RANDOM_VALUES = 100000  //!< The number of random doubles and decimal texts that are checked.
+    };
+
+    static uint64_t gRandom = 0x9E3779B97F4A7C15ULL;
+
+    static uint64_t nextRandom() throw() {
+        gRandom ^= gRandom << 13;
+        gRandom ^= gRandom >> 7;
+        gRandom ^= gRandom << 17;
+        return gRandom;
+    }
+
+    static bool sameBits(const double aFirst, const double aSecond) throw() {
+        return std::memcmp(&aFirst, &aSecond, sizeof(double)) == 0;
+    }
+
+    static bool formatsAs(const double aValue, const char* const aText) throw() {
+        char buffer[NumberFormat::MAX_DOUBLE_CHARACTERS];
+        const uint32_t length = NumberFormat::formatDouble(aValue, buffer);
+        return length == std::strlen(aText) && std::memcmp(buffer, aText, length) == 0;
+    }
+
+    static uint32_t countDigits(const char* const aText, const uint32_t aLength) throw() {
+        // The significant digits of the mantissa, without leading or trailing zeros
+        uint32_t first = 0;
+        uint32_t last = 0;
+        uint32_t count = 0;
+        for(uint32_t i = 0; i < aLength && aText[i] != 'e'; ++i) {
+            if(aText[i] < '0' || aText[i] > '9') continue;
+            ++count;
+            if(aText[i] == '0') continue;
+            if(first == 0) first = count;
+            last = count;
+        }
+        return first == 0 ? 1 : last - first + 1;
+    }
+
+    static uint32_t countShortestDigits(const double aValue) throw() {
+        char text[32];
+        for(int precision = 1; precision < 17; ++precision) {
+            std::snprintf(text, sizeof(text), "%.*e", precision - 1, aValue);
+            if(sameBits(std::strtod(text, nullptr), aValue)) return static_cast<uint32_t>(precision);
+        }
+        return 17;
+    }
+
+    static void testFixed() throw() {
+        SOLAIRE_CHECK(formatsAs(0.1, "0.1"));
+        SOLAIRE_CHECK(formatsAs(1500.0, "1500.0"));
+        SOLAIRE_CHECK(formatsAs(-0.0, "-0.0"));
+        SOLAIRE_CHECK(formatsAs(1e20, "100000000000000000000.0"));
+        SOLAIRE_CHECK(formatsAs(1e21, "1e21"));
+        SOLAIRE_CHECK(formatsAs(0.000001, "0.000001"));
+        SOLAIRE_CHECK(formatsAs(1.5e-7, "1.5e-7"));
+        SOLAIRE_CHECK(formatsAs(5e-324, "5e-324"));
+        SOLAIRE_CHECK(formatsAs(1.7976931348623157e308, "1.7976931348623157e308"));
+        SOLAIRE_CHECK(formatsAs(1.0 / 0.0, "Infinity"));
+        SOLAIRE_CHECK(formatsAs(-1.0 / 0.0, "-Infinity"));
+
+        char buffer[NumberFormat::MAX_SIGNED_CHARACTERS];
+        SOLAIRE_CHECK(NumberFormat::formatSigned(INT64_MIN, buffer) == 20 && std::memcmp(buffer, "-9223372036854775808", 20) == 0);
+        SOLAIRE_CHECK(NumberFormat::formatUnsigned(UINT64_MAX, buffer) == 20 && std::memcmp(buffer, "18446744073709551615", 20) == 0);
+        SOLAIRE_CHECK(NumberFormat::formatUnsigned(0, buffer) == 1 && buffer[0] == '0');
+
+        uint64_t unsignedValue;
+        SOLAIRE_CHECK(NumberFormat::parseUnsigned("18446744073709551615", 20, unsignedValue) == 20 && unsignedValue == UINT64_MAX);
+        SOLAIRE_CHECK(NumberFormat::parseUnsigned("18446744073709551616", 20, unsignedValue) == 0);
+        SOLAIRE_CHECK(NumberFormat::parseUnsigned("123x", 4, unsignedValue) == 3 && unsignedValue == 123);
+        int64_t signedValue;
+        SOLAIRE_CHECK(NumberFormat::parseSigned("-9223372036854775808", 20, signedValue) == 20 && signedValue == INT64_MIN);
+        SOLAIRE_CHECK(NumberFormat::parseSigned("9223372036854775808", 19, signedValue) == 0);
+        double doubleValue;
+        SOLAIRE_CHECK(NumberFormat::parseDouble("01", 2, doubleValue) == 0);
+        SOLAIRE_CHECK(NumberFormat::parseDouble(".5", 2, doubleValue) == 0);
+        SOLAIRE_CHECK(NumberFormat::parseDouble("1.00000000000000000000001", 25, doubleValue) == 25 && doubleValue == 1.0);
+    }
+
+    static void testShortest() throw() {
+        char buffer[NumberFormat::MAX_DOUBLE_CHARACTERS];
+        for(uint32_t i = 0; i < RANDOM_VALUES; ++i) {
+            // Random bit patterns cover every exponent, small integers cover the values written without one
+            uint64_t bits = nextRandom();
+            double value;
+            if(i % 4 == 0) value = static_cast<double>(static_cast<int64_t>(bits % 2000001) - 1000000) / 1000.0;
+            else std::memcpy(&value, &bits, sizeof(double));
+            if(value != value || value - value != 0.0) continue;
+
+            const uint32_t length = NumberFormat::formatDouble(value, buffer);
+            double parsed;
+            if(NumberFormat::parseDouble(buffer, length, parsed) != length || ! sameBits(parsed, value)) {
+                SOLAIRE_CHECK(! "formatDouble reads back to the same double");
+                return;
+            }
+            if(value != 0.0 && countDigits(buffer, length) != countShortestDigits(value)) {
+                SOLAIRE_CHECK(! "formatDouble writes the fewest digits");
+                return;
+            }
+        }
+    }
+
+    static void testParse() throw() {
+        char text[64];
+        for(uint32_t i = 0; i < RANDOM_VALUES; ++i) {
+            // Up to 25 digits with a random decimal point and exponent, beyond what one multiplication can convert
+            uint32_t length = 0;
+            if(nextRandom() & 1) text[length++] = '-';
+            const uint32_t digits = 1 + static_cast<uint32_t>(nextRandom() % 25);
+            const uint32_t point = static_cast<uint32_t>(nextRandom() % (digits + 1));
+            text[length++] = static_cast<char>('1' + nextRandom() % 9);
+            for(uint32_t j = 1; j < digits; ++j) {
+                if(j == point) text[length++] = '.';
+                text[length++] = static_cast<char>('0' + nextRandom() % 10);
+            }
+            length += static_cast<uint32_t>(std::snprintf(text + length, 16, "e%d", static_cast<int>(nextRandom() % 700) - 350));
+
+            double parsed;
+            if(NumberFormat::parseDouble(text, length, parsed) != length || ! sameBits(parsed, std::strtod(text, nullptr))) {
+                SOLAIRE_CHECK(! "parseDouble matches strtod");
+                std::printf("  %.*s\n", static_cast<int>(length), text);
+                return;
+            }
+
+            const uint64_t expected = nextRandom() >> (nextRandom() % 64);
+            length = static_cast<uint32_t>(std::snprintf(text, sizeof(text), "%llu", static_cast<unsigned long long>(expected)));
+            uint64_t unsignedValue;
+            SOLAIRE_CHECK(NumberFormat::parseUnsigned(text, length, unsignedValue) == length && unsignedValue == expected);
+        }
+    }
+
+    static void testStrings() throw() {
+        // String values convert to numbers with the same rules as JSON text
+        SOLAIRE_CHECK(GenericValue(makeName("2.5")).getDouble() == 2.5);
+        SOLAIRE_CHECK(GenericValue(makeName("-42")).getSigned() == -42);
+        SOLAIRE_CHECK(GenericValue(makeName("true")).getBool());
+        SOLAIRE_CHECK(GenericValue(makeName("abc")).getDouble() == 0.0);
+
+        const GenericValue value = fromJson("[0.1,1e300,-2.5e-310,3.0,123456.789]");
+        BufferOStream output(getDefaultAllocator());
+        write(JsonFormat(), value, output);
+        const char* const expected = "[0.1,1e300,-2.5e-310,3.0,123456.789]";
+        SOLAIRE_CHECK(output.getSize() == std::strlen(expected) && std::memcmp(output.getData(), expected, output.getSize()) == 0);
+    }
+}
+
+int main() {
+    using namespace Solaire;
+
+    testFixed();
+    testShortest();
+    testParse();
+    testStrings();
+
+    return finishTest();
+}
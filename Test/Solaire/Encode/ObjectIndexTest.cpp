@@ -0,0 +1,120 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+// Checks that objects find the right member by name before and after their hash index is built, and that the index
+// follows every change made through the object.
+
+#include "Solaire/Encode/BinaryFormat.hpp"
+#include "Solaire/Encode/GenericObjectMap.hpp"
+#include "EncodeTest.hpp"
+
+namespace Solaire {
+
+    enum : uint32_t {
+        WIDE_SIZE = 300     //!< Far more members than GenericObjectMap::INDEX_THRESHOLD.
+    };
+
+    static CString makeField(const uint32_t aIndex) throw() {
+        char name[16];
+        const int length = std::snprintf(name, sizeof(name), "field%u", aIndex);
+        return CString(getDefaultAllocator(), name, static_cast<uint32_t>(length));
+    }
+
+    static bool hasFields(const GenericValue& aObject, const uint32_t aBegin, const uint32_t aEnd) throw() {
+        for(uint32_t i = aBegin; i < aEnd; ++i) {
+            const GenericValue* const member = aObject.find(makeField(i));
+            if(member == nullptr || member->getUnsigned() != i) return false;
+        }
+        return true;
+    }
+
+    static void testLookups() throw() {
+        GenericValue object;
+        object.setObject();
+        for(uint32_t i = 0; i < WIDE_SIZE; ++i) {
+            object.emplace(makeField(i), GenericValue(i));
+            // Check across the point where the index is built
+            if(i + 1 == static_cast<uint32_t>(GenericObjectMap::INDEX_THRESHOLD) - 1 || i + 1 == static_cast<uint32_t>(GenericObjectMap::INDEX_THRESHOLD)) {
+                SOLAIRE_CHECK(hasFields(object, 0, i + 1));
+            }
+        }
+        SOLAIRE_CHECK(object.size() == static_cast<int32_t>(WIDE_SIZE));
+        SOLAIRE_CHECK(hasFields(object, 0, WIDE_SIZE));
+        SOLAIRE_CHECK(object.find(makeName("missing")) == nullptr);
+        SOLAIRE_CHECK(object.find(makeName("field")) == nullptr);
+
+        // Members stay in insertion order
+        uint32_t expected = 0;
+        const GenericValue::GenericObject& members = object.getObject();
+        for(auto i = members.begin(); i != members.end(); ++i) SOLAIRE_CHECK(i->second.getUnsigned() == expected++);
+
+        // Existing members are replaced rather than added again
+        object[makeField(7)] = GenericValue(static_cast<uint32_t>(70));
+        SOLAIRE_CHECK(object.size() == static_cast<int32_t>(WIDE_SIZE));
+        SOLAIRE_CHECK(object.find(makeField(7))->getUnsigned() == 70);
+        object[makeField(7)] = GenericValue(static_cast<uint32_t>(7));
+
+        // Copies and decoded objects have a working index
+        const GenericValue copy(object);
+        SOLAIRE_CHECK(hasFields(copy, 0, WIDE_SIZE));
+        const BinaryFormat binary;
+        BufferOStream output(getDefaultAllocator());
+        write(binary, object, output);
+        BufferIStream input(output.getData(), output.getSize());
+        SOLAIRE_CHECK(hasFields(binary.readValue(input), 0, WIDE_SIZE));
+        GenericDocument document;
+        BufferIStream documentInput(output.getData(), output.getSize());
+        SOLAIRE_CHECK(binary.readDocument(documentInput, document));
+        SOLAIRE_CHECK(hasFields(document.getRoot(), 0, WIDE_SIZE));
+    }
+
+    static void testModifications() throw() {
+        GenericValue object;
+        GenericValue::GenericObject& members = object.setObject();
+        static_cast<GenericObjectMap&>(members).reserve(static_cast<int32_t>(WIDE_SIZE));
+        for(uint32_t i = 0; i < WIDE_SIZE; ++i) members.emplace(makeField(i), GenericValue(i));
+
+        // Erasing shifts the later members, which must still be found
+        SOLAIRE_CHECK(members.erase(makeField(0)));
+        SOLAIRE_CHECK(members.erase(makeField(150)));
+        SOLAIRE_CHECK(! members.erase(makeField(150)));
+        SOLAIRE_CHECK(object.size() == static_cast<int32_t>(WIDE_SIZE) - 2);
+        SOLAIRE_CHECK(object.find(makeField(0)) == nullptr && object.find(makeField(150)) == nullptr);
+        SOLAIRE_CHECK(hasFields(object, 1, 150) && hasFields(object, 151, WIDE_SIZE));
+
+        // Shrinking below the threshold and growing again
+        for(uint32_t i = 1; i < WIDE_SIZE - 4; ++i) members.erase(makeField(i));
+        SOLAIRE_CHECK(object.size() == 4 && hasFields(object, WIDE_SIZE - 4, WIDE_SIZE));
+        for(uint32_t i = 0; i < 100; ++i) members.emplace(makeField(i), GenericValue(i));
+        SOLAIRE_CHECK(hasFields(object, 0, 100) && hasFields(object, WIDE_SIZE - 4, WIDE_SIZE));
+
+        members.clear();
+        SOLAIRE_CHECK(object.size() == 0 && object.find(makeField(1)) == nullptr);
+        members.emplace(makeField(1), GenericValue(1u));
+        SOLAIRE_CHECK(hasFields(object, 1, 2));
+    }
+}
+
+int main() {
+    using namespace Solaire;
+
+    testLookups();
+    testModifications();
+
+    return finishTest();
+}
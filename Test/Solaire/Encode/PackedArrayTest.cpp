@@ -0,0 +1,117 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+// Checks that packed arrays behave like arrays of numbers, keep their element type through BinaryFormat, and that packed
+// counts which the input can not hold are rejected before they are allocated, whatever the kind of stream.
+
+#include "Solaire/Encode/BinaryFormat.hpp"
+#include "EncodeTest.hpp"
+
+namespace Solaire {
+
+    static void testElements() throw() {
+        GenericValue packed;
+        int64_t* const elements = packed.setSignedArray(5);
+        SOLAIRE_CHECK(elements != nullptr);
+        if(elements == nullptr) return;
+        GenericValue unpacked;
+        unpacked.setArray();
+        for(int32_t i = 0; i < 5; ++i) {
+            elements[i] = -i * 1000;
+            unpacked.pushBack(GenericValue(static_cast<int64_t>(-i * 1000)));
+        }
+
+        SOLAIRE_CHECK(packed.isArray() && packed.size() == 5);
+        SOLAIRE_CHECK(packed.getPackedType() == GenericValue::SIGNED_T);
+        SOLAIRE_CHECK(packed == unpacked && unpacked == packed);
+        SOLAIRE_CHECK(packed.hash() == unpacked.hash());
+        SOLAIRE_CHECK(sameJson(packed, unpacked));
+
+        // Const access reads the elements without unpacking the array
+        const GenericValue& constPacked = packed;
+        SOLAIRE_CHECK(constPacked[4].getSigned() == -4000);
+        SOLAIRE_CHECK(packed.getPackedType() == GenericValue::SIGNED_T);
+
+        // Adding an element converts it into a normal array
+        packed.pushBack(GenericValue(1.5));
+        SOLAIRE_CHECK(packed.getPackedType() == GenericValue::NULL_T && packed.size() == 6);
+        SOLAIRE_CHECK(packed[0].getSigned() == 0 && packed[5].getDouble() == 1.5);
+
+        GenericValue tooLarge;
+        SOLAIRE_CHECK(tooLarge.setUnsignedArray(GenericValue::MAX_PACKED_SIZE + 1) == nullptr);
+        SOLAIRE_CHECK(tooLarge.isNull());
+    }
+
+    static void testBinary() throw() {
+        const BinaryFormat binary;
+        BufferOStream output(getDefaultAllocator());
+
+        // Packed arrays keep their element type in the binary format
+        const GenericValue sample = makeSample();
+        write(binary, sample, output);
+        BufferIStream input(output.getData(), output.getSize());
+        const GenericValue value = binary.readValue(input);
+        SOLAIRE_CHECK(value == sample);
+        SOLAIRE_CHECK(value[makeName("p")].getPackedType() == GenericValue::UNSIGNED_T);
+        SOLAIRE_CHECK(value[makeName("q")].getPackedType() == GenericValue::DOUBLE_T);
+
+        // Streams that do not know their size are read in steps, larger arrays are still read whole
+        for(const uint32_t size : {0u, 10u, 4096u, 4097u, 20000u}) {
+            GenericValue doubles;
+            double* const elements = doubles.setDoubleArray(size);
+            for(uint32_t i = 0; i < size; ++i) elements[i] = i * 0.5;
+            write(binary, doubles, output);
+
+            ChunkedIStream chunked(output.getData(), output.getSize(), 1000);
+            const GenericValue decoded = binary.readValue(chunked);
+            SOLAIRE_CHECK(decoded == doubles);
+            SOLAIRE_CHECK(size == 0 || decoded.getPackedType() == GenericValue::DOUBLE_T);
+
+            if(size == 0) continue;
+            ChunkedIStream truncated(output.getData(), output.getSize() - 1, 1000);
+            SOLAIRE_CHECK(binary.readValue(truncated).isNull());
+        }
+    }
+
+    static void testOversizedCounts() throw() {
+        // Each element is 8 bytes, so a count is rejected if the rest of the input is smaller than 8 times it
+        const BinaryFormat binary;
+        for(const uint8_t tag : {9, 10, 11}) {
+            const uint8_t data[] = {tag, 0x80, 0x80, 0xBA, 0xBE, 0x01, 1, 2, 3, 4, 5, 6, 7, 8};
+            BufferIStream input(data, sizeof(data));
+            SOLAIRE_CHECK(binary.readValue(input).isNull());
+            ChunkedIStream chunked(data, sizeof(data), 3);
+            SOLAIRE_CHECK(binary.readValue(chunked).isNull());
+
+            // Two elements claimed, one present
+            const uint8_t partial[] = {tag, 2, 1, 2, 3, 4, 5, 6, 7, 8};
+            BufferIStream partialInput(partial, sizeof(partial));
+            SOLAIRE_CHECK(binary.readValue(partialInput).isNull());
+        }
+    }
+}
+
+int main() {
+    using namespace Solaire;
+
+    testElements();
+    testBinary();
+    testOversizedCounts();
+
+    return finishTest();
+}
@@ -0,0 +1,163 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+// Checks that ParallelDocumentReader splits a block into the same documents, and decodes them into the same values in
+// the same order, as reading them one after another from a single stream, and that it reports documents that fail.
+
+#include "Solaire/Encode/ParallelDocumentReader.hpp"
+#include "Solaire/Encode/Reflection.hpp"
+#include "Solaire/Encode/BinaryFormat.hpp"
+#include "EncodeTest.hpp"
+
+namespace ParallelDocumentReaderTest {
+    struct Record {
+        uint32_t id = 0;
+        Solaire::CString tag;
+        Solaire::ArrayList<double> xs;
+    };
+}
+
+SOLAIRE_ENCODE_BEGIN(ParallelDocumentReaderTest::Record)
+    SOLAIRE_ENCODE_FIELD(id)
+    SOLAIRE_ENCODE_FIELD(tag)
+    SOLAIRE_ENCODE_FIELD(xs)
+SOLAIRE_ENCODE_END
+
+namespace Solaire {
+
+    typedef ParallelDocumentReaderTest::Record Record;
+
+    /*!
+        \brief A format without a Reader, every byte is a document.
+        \details 'u' decodes to 7 and 'n' to null, any other byte is left unread.
+    */
+    class LetterFormat : public Format {
+    public:
+        // Inherited from Format
+
+        GenericValue SOLAIRE_EXPORT_CALL readValue(IStream& aStream) const throw() override {
+            const int32_t offset = aStream.getOffset();
+            char letter;
+            if(aStream.read(&letter, 1) != 1) return GenericValue();
+            if(letter == 'u') return GenericValue(static_cast<uint64_t>(7));
+            if(letter != 'n') aStream.setOffset(offset);
+            return GenericValue();
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeValue(const GenericValue& aValue, OStream& aStream) const throw() override {
+            const char letter = aValue.isNull() ? 'n' : 'u';
+            return aStream.write(&letter, 1) == 1;
+        }
+
+        bool SOLAIRE_EXPORT_CALL findDocuments(const void* const aData, const uint32_t aSize, List<uint32_t>& aEnds) const throw() override {
+            for(uint32_t i = 1; i <= aSize; ++i) aEnds.pushBack(i);
+            return true;
+        }
+    };
+
+    static bool openText(ParallelDocumentReader& aReader, const char* const aText) throw() {
+        return aReader.open(aText, static_cast<uint32_t>(std::strlen(aText)));
+    }
+
+    static void testDocuments(const Format& aFormat, WorkerPool& aPool, const uint32_t aCount, const bool aNewlines) throw() {
+        BufferOStream output(getDefaultAllocator());
+        for(uint32_t i = 0; i < aCount; ++i) {
+            // Tags contain the characters that end JSON documents
+            Record record;
+            record.id = i;
+            char tag[32];
+            record.tag = CString(getDefaultAllocator(), tag, static_cast<uint32_t>(std::snprintf(tag, sizeof(tag), "t%u\"}]", i)));
+            for(uint32_t j = 0; j < i % 5; ++j) record.xs.pushBack(j * 1.5);
+            SOLAIRE_CHECK(aFormat.writeValue(encode<Record>(getDefaultAllocator(), record), output));
+            if(aNewlines && i % 2 == 1) output.write("\n", 1);
+        }
+
+        ParallelDocumentReader reader(getDefaultAllocator(), aFormat, aPool);
+        SOLAIRE_CHECK(reader.open(output.getData(), output.getSize()));
+        SOLAIRE_CHECK(reader.getDocumentCount() == aCount);
+
+        ArrayList<GenericValue> values(getDefaultAllocator());
+        SOLAIRE_CHECK(reader.readValues(values));
+        SOLAIRE_CHECK(values.size() == static_cast<int32_t>(aCount));
+        BufferIStream input(output.getData(), output.getSize());
+        for(int32_t i = 0; i < values.size(); ++i) SOLAIRE_CHECK(values[i] == aFormat.readValue(input));
+
+        ArrayList<Record> records(getDefaultAllocator());
+        SOLAIRE_CHECK(reader.read<Record>(getDefaultAllocator(), records));
+        SOLAIRE_CHECK(records.size() == static_cast<int32_t>(aCount));
+        for(int32_t i = 0; i < records.size(); ++i) {
+            SOLAIRE_CHECK(records[i].id == static_cast<uint32_t>(i) && records[i].xs.size() == i % 5);
+        }
+    }
+
+    static void testJsonBoundaries(WorkerPool& aPool) throw() {
+        const JsonFormat json;
+        ParallelDocumentReader reader(getDefaultAllocator(), json, aPool);
+        SOLAIRE_CHECK(openText(reader, "1 \"a\" [1,{\"x\":[]}]\n{}\ntrue"));
+        SOLAIRE_CHECK(reader.getDocumentCount() == 5);
+        ArrayList<GenericValue> values(getDefaultAllocator());
+        SOLAIRE_CHECK(reader.readValues(values));
+        SOLAIRE_CHECK(values.size() == 5 && values[0].getUnsigned() == 1 && values[4].getBool());
+
+        SOLAIRE_CHECK(! openText(reader, "[1] ]"));
+        SOLAIRE_CHECK(! openText(reader, "[1] [2"));
+
+        // A document that has complete brackets but is not valid fails when it is decoded
+        SOLAIRE_CHECK(openText(reader, "[1] [2,]"));
+        values.clear();
+        SOLAIRE_CHECK(! reader.readValues(values));
+        SOLAIRE_CHECK(values.size() == 2 && values[0].size() == 1 && values[1].isNull());
+    }
+
+    static void testWithoutReader(WorkerPool& aPool) throw() {
+        const LetterFormat format;
+        ParallelDocumentReader reader(getDefaultAllocator(), format, aPool);
+        SOLAIRE_CHECK(openText(reader, "unu"));
+        ArrayList<GenericValue> values(getDefaultAllocator());
+        SOLAIRE_CHECK(reader.readValues(values));
+        SOLAIRE_CHECK(values.size() == 3 && values[0].getUnsigned() == 7 && values[1].isNull());
+        ArrayList<uint32_t> numbers(getDefaultAllocator());
+        SOLAIRE_CHECK(reader.read<uint32_t>(getDefaultAllocator(), numbers));
+
+        // A document that decodes nothing is a failure, not a null
+        SOLAIRE_CHECK(openText(reader, "unx"));
+        values.clear();
+        SOLAIRE_CHECK(! reader.readValues(values));
+        SOLAIRE_CHECK(values.size() == 3 && values[2].isNull());
+        numbers.clear();
+        SOLAIRE_CHECK(! reader.read<uint32_t>(getDefaultAllocator(), numbers));
+    }
+}
+
+int main() {
+    using namespace Solaire;
+
+    const JsonFormat json;
+    const BinaryFormat binary;
+    for(const uint32_t threads : {1u, 4u}) {
+        WorkerPool pool(getDefaultAllocator(), threads);
+        for(const uint32_t count : {0u, 1u, static_cast<uint32_t>(ParallelDocumentReader::DOCUMENTS_PER_TASK) + 1, 5000u}) {
+            testDocuments(json, pool, count, true);
+            testDocuments(binary, pool, count, false);
+        }
+        testJsonBoundaries(pool);
+        testWithoutReader(pool);
+    }
+
+    return finishTest();
+}
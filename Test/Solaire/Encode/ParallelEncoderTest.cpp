@@ -0,0 +1,131 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+// Checks that WorkerPool runs every task of every batch once, and that containers encoded on several threads produce
+// exactly the same bytes as the single threaded Format::write, for sizes either side of every chunk boundary.
+
+#include "Solaire/Encode/ParallelEncoder.hpp"
+#include "Solaire/Encode/Reflection.hpp"
+#include "Solaire/Encode/BinaryFormat.hpp"
+#include "EncodeTest.hpp"
+
+namespace ParallelEncoderTest {
+    struct Item {
+        int32_t a = 0;
+        Solaire::CString s;
+    };
+}
+
+SOLAIRE_ENCODE_BEGIN(ParallelEncoderTest::Item)
+    SOLAIRE_ENCODE_FIELD(a)
+    SOLAIRE_ENCODE_FIELD(s)
+SOLAIRE_ENCODE_END
+
+namespace Solaire {
+
+    typedef ParallelEncoderTest::Item Item;
+
+    struct TaskCounts {
+        std::atomic<uint32_t> sum;
+        std::atomic<uint32_t> calls;
+    };
+
+    static void countTask(void* const aData, const uint32_t aIndex) throw() {
+        TaskCounts& counts = *static_cast<TaskCounts*>(aData);
+        counts.sum += aIndex + 1;
+        ++counts.calls;
+    }
+
+    static void testPool(WorkerPool& aPool) throw() {
+        TaskCounts counts;
+        counts.sum = 0;
+        counts.calls = 0;
+        for(uint32_t batch = 0; batch < 200; ++batch) aPool.run(&countTask, &counts, 37);
+        aPool.run(&countTask, &counts, 0);
+        SOLAIRE_CHECK(counts.calls == 200 * 37);
+        SOLAIRE_CHECK(counts.sum == 200 * 37 * 38 / 2);
+    }
+
+    template<class T>
+    static void checkContainer(Format& aFormat, WorkerPool& aPool, const ArrayList<T>& aContainer) throw() {
+        BufferOStream expected(getDefaultAllocator());
+        SOLAIRE_CHECK(aFormat.write<ArrayList<T>>(getDefaultAllocator(), aContainer, expected));
+        BufferOStream output(getDefaultAllocator());
+        SOLAIRE_CHECK(writeParallel<T>(aFormat, getDefaultAllocator(), aPool, aContainer, output));
+        SOLAIRE_CHECK(sameBytes(output, expected));
+
+        // The GenericValue path encodes the same array
+        BufferOStream fromValue(getDefaultAllocator());
+        write(aFormat, ParallelEncoder<T>::encode(getDefaultAllocator(), aPool, aContainer), fromValue);
+        SOLAIRE_CHECK(sameBytes(fromValue, expected));
+    }
+
+    static void testContainers(Format& aFormat, WorkerPool& aPool) throw() {
+        typedef ParallelEncoder<double> Encoder;
+        const int32_t waveElements = Encoder::MAX_CHUNK_ELEMENTS * Encoder::CHUNKS_PER_THREAD * static_cast<int32_t>(aPool.getThreadCount());
+        const int32_t sizes[] = {
+            0, 1,
+            Encoder::MIN_CHUNK_ELEMENTS * 2 - 1, Encoder::MIN_CHUNK_ELEMENTS * 2, Encoder::MIN_CHUNK_ELEMENTS * 2 + 1,
+            waveElements - 1, waveElements + 1, waveElements * 2 + 12345
+        };
+
+        for(const int32_t size : sizes) {
+            ArrayList<double> doubles(getDefaultAllocator());
+            ArrayList<int32_t> integers(getDefaultAllocator());
+            for(int32_t i = 0; i < size; ++i) {
+                doubles.pushBack(i * 0.5 - 1000.0);
+                integers.pushBack(i % 2 == 0 ? i : -i);
+            }
+            checkContainer(aFormat, aPool, doubles);
+            checkContainer(aFormat, aPool, integers);
+        }
+
+        ArrayList<Item> items(getDefaultAllocator());
+        char text[16];
+        for(int32_t i = 0; i < 50000; ++i) {
+            Item item;
+            item.a = i;
+            item.s = CString(getDefaultAllocator(), text, static_cast<uint32_t>(std::snprintf(text, sizeof(text), "item %d", i)));
+            items.pushBack(item);
+        }
+        checkContainer(aFormat, aPool, items);
+
+        BufferOStream output(getDefaultAllocator());
+        SOLAIRE_CHECK(writeParallel<Item>(aFormat, getDefaultAllocator(), aPool, items, output));
+        ChunkedIStream input(output.getData(), output.getSize(), 4096);
+        const ArrayList<Item> decoded = aFormat.read<ArrayList<Item>>(getDefaultAllocator(), input);
+        SOLAIRE_CHECK(decoded.size() == 50000);
+        if(decoded.size() == 50000) SOLAIRE_CHECK(decoded[49999].a == 49999 && decoded[49999].s == makeName("item 49999"));
+    }
+}
+
+int main() {
+    using namespace Solaire;
+
+    JsonFormat json;
+    BinaryFormat binary;
+    for(const uint32_t threads : {1u, 4u}) {
+        WorkerPool pool(getDefaultAllocator(), threads);
+        SOLAIRE_CHECK(pool.getThreadCount() == threads);
+        testPool(pool);
+        testContainers(json, pool);
+        testContainers(binary, pool);
+    }
+
+    return finishTest();
+}
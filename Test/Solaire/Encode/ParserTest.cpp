@@ -0,0 +1,211 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+// Checks that Parsers produce the same values as Format::readValue however the input is split, that they reject
+// malformed and incomplete input, and that counts which the input can not hold never allocate their claimed size.
+
+#include "Solaire/Encode/SchemaFormat.hpp"
+#include "EncodeTest.hpp"
+
+namespace Solaire {
+
+    enum : uint32_t {
+        LARGE_COUNT = 1000000   //!< Far more elements than any of the oversized inputs contain.
+    };
+
+    static uint32_t feed(Parser& aParser, const void* const aData, const uint32_t aSize, const uint32_t aChunk, GenericValue* const aValues, const uint32_t aCapacity) throw() {
+        const uint8_t* const bytes = static_cast<const uint8_t*>(aData);
+        uint32_t count = 0;
+        uint32_t offset = 0;
+        while(offset < aSize) {
+            uint32_t size = aSize - offset < aChunk ? aSize - offset : aChunk;
+            const uint8_t* data = bytes + offset;
+            offset += size;
+            while(size > 0) {
+                const uint32_t consumed = aParser.parse(data, size);
+                data += consumed;
+                size -= consumed;
+                if(aParser.hasValue()) {
+                    GenericValue value;
+                    SOLAIRE_CHECK(aParser.takeValue(value));
+                    if(count < aCapacity) aValues[count] = std::move(value);
+                    ++count;
+                }else if(aParser.hasFailed() || consumed == 0) {
+                    return count;
+                }
+            }
+        }
+        aParser.finish();
+        if(aParser.hasValue()) {
+            GenericValue value;
+            aParser.takeValue(value);
+            if(count < aCapacity) aValues[count] = std::move(value);
+            ++count;
+        }
+        return count;
+    }
+
+    static uint32_t feedText(Parser& aParser, const char* const aText, const uint32_t aChunk) throw() {
+        GenericValue value;
+        return feed(aParser, aText, static_cast<uint32_t>(std::strlen(aText)), aChunk, &value, 1);
+    }
+
+    static void testChunks(const Format& aFormat, const bool aTrailingNumber) throw() {
+        const GenericValue sample = makeSample();
+        BufferOStream output(getDefaultAllocator());
+        write(aFormat, sample, output);
+        aFormat.writeValue(sample, output);
+        // A number is only complete once the input ends
+        if(aTrailingNumber) output.write(" 42", 3);
+        const uint32_t expected = aTrailingNumber ? 3 : 2;
+
+        for(const uint32_t chunk : {1u, 2u, 3u, 7u, 64u, 100000u}) {
+            Parser* const parser = aFormat.createParser(getDefaultAllocator());
+            SOLAIRE_CHECK(parser != nullptr);
+            if(parser == nullptr) return;
+            GenericValue values[3];
+            const uint32_t count = feed(*parser, output.getData(), output.getSize(), chunk, values, 3);
+            SOLAIRE_CHECK(! parser->hasFailed());
+            SOLAIRE_CHECK(count == expected);
+
+            BufferIStream input(output.getData(), output.getSize());
+            for(uint32_t i = 0; i < expected; ++i) SOLAIRE_CHECK(values[i] == aFormat.readValue(input));
+            SOLAIRE_CHECK(sameJson(values[0], sample));
+            if(aTrailingNumber) SOLAIRE_CHECK(values[2].getUnsigned() == 42);
+            destroyParser(parser);
+        }
+    }
+
+    static void testSchemaVersions() throw() {
+        // Members with ids that the parser's schema does not have are skipped, as readValue does
+        Schema older(getDefaultAllocator());
+        older.addField(makeName("a"));
+        older.addField(makeName("d"));
+        Schema newer(getDefaultAllocator());
+        newer.addField(makeName("a"));
+        newer.addField(makeName("d"));
+        newer.addField(makeName("b"));
+        newer.addField(makeName("c"));
+        const SchemaFormat olderFormat(older);
+        const SchemaFormat newerFormat(newer);
+
+        BufferOStream output(getDefaultAllocator());
+        write(newerFormat, makeSample(), output);
+        Parser* const parser = olderFormat.createParser(getDefaultAllocator());
+        GenericValue parsed;
+        SOLAIRE_CHECK(feed(*parser, output.getData(), output.getSize(), 5, &parsed, 1) == 1);
+        SOLAIRE_CHECK(parsed.find(makeName("b")) == nullptr && parsed.find(makeName("a")) != nullptr);
+        BufferIStream input(output.getData(), output.getSize());
+        SOLAIRE_CHECK(parsed == olderFormat.readValue(input));
+        destroyParser(parser);
+    }
+
+    static void testMalformed() throw() {
+        const JsonFormat json;
+        Parser* const parser = json.createParser(getDefaultAllocator());
+        for(const char* const malformed : {"[1,]", "{\"a\" 1}", "[1 2]", "tru ", "\"\\x\"", "[}", "{\"a\":1,}", "\"\\ud800x\""}) {
+            SOLAIRE_CHECK(feedText(*parser, malformed, 1) == 0);
+            SOLAIRE_CHECK(parser->hasFailed());
+            parser->reset();
+            SOLAIRE_CHECK(! parser->hasFailed());
+        }
+
+        // A reset parser reads again
+        SOLAIRE_CHECK(feedText(*parser, "[1,2]", 1) == 1);
+
+        // Values that are not complete when the input ends
+        parser->reset();
+        SOLAIRE_CHECK(parser->parse("[1,2", 4) == 4);
+        SOLAIRE_CHECK(! parser->hasValue());
+        SOLAIRE_CHECK(! parser->finish());
+        destroyParser(parser);
+
+        const BinaryFormat binary;
+        Parser* const binaryParser = binary.createParser(getDefaultAllocator());
+        SOLAIRE_CHECK(binaryParser->finish());
+        const uint8_t string[] = {GenericValue::STRING_T, 5};
+        binaryParser->parse(string, sizeof(string));
+        SOLAIRE_CHECK(! binaryParser->finish());
+        destroyParser(binaryParser);
+    }
+
+    static void testPackedChunks() throw() {
+        // Packed arrays that are larger than the parser's staging threshold arrive in pieces
+        const BinaryFormat binary;
+        BufferOStream output(getDefaultAllocator());
+        for(const uint32_t size : {0u, 5u, 4096u, 4097u, 100000u}) {
+            GenericValue value;
+            uint64_t* const elements = value.setUnsignedArray(size);
+            for(uint32_t i = 0; i < size; ++i) elements[i] = i * 2654435761ULL;
+            write(binary, value, output);
+
+            for(const uint32_t chunk : {1u, 13u, 4096u, 1000000u}) {
+                Parser* const parser = binary.createParser(getDefaultAllocator());
+                GenericValue parsed;
+                SOLAIRE_CHECK(feed(*parser, output.getData(), output.getSize(), chunk, &parsed, 1) == 1);
+                SOLAIRE_CHECK(parsed == value);
+                destroyParser(parser);
+            }
+        }
+    }
+
+    static void testOversizedCounts() throw() {
+        // Every tag followed by counts that are far larger than the 64 bytes that follow them
+        const BinaryFormat binary;
+        const uint8_t counts[][5] = {
+            {0xFF, 0xFF, 0xFF, 0xFF, 0x0F},
+            {0xFF, 0xFF, 0xFF, 0xFF, 0x07},
+            {0x80, 0x80, 0x80, 0x80, 0x02},
+            {0x80, 0x80, 0x80, 0x80, 0x01}
+        };
+        uint8_t data[70];
+        std::memset(data, 1, sizeof(data));
+        for(uint32_t tag = 0; tag < 32; ++tag) {
+            for(const auto& count : counts) {
+                data[0] = static_cast<uint8_t>(tag);
+                std::memcpy(data + 1, count, sizeof(count));
+
+                CountingAllocator allocator;
+                Parser* const parser = binary.createParser(allocator);
+                GenericValue parsed;
+                if(feed(*parser, data, sizeof(data), 7, &parsed, 1) == 1) SOLAIRE_CHECK(parsed.size() < static_cast<int32_t>(LARGE_COUNT));
+                parser->~Parser();
+                allocator.deallocate(parser);
+                SOLAIRE_CHECK(allocator.getAllocations() == allocator.getDeallocations());
+                SOLAIRE_CHECK(allocator.getLargestAllocation() < static_cast<uint32_t>(LARGE_COUNT));
+            }
+        }
+    }
+}
+
+int main() {
+    using namespace Solaire;
+
+    Schema schema(getDefaultAllocator());
+    schema.addField(makeName("a"));
+    schema.addField(makeName("d"));
+    testChunks(JsonFormat(), true);
+    testChunks(BinaryFormat(), false);
+    testChunks(SchemaFormat(schema), false);
+    testSchemaVersions();
+    testMalformed();
+    testPackedChunks();
+    testOversizedCounts();
+
+    return finishTest();
+}
@@ -0,0 +1,168 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+// Checks that a PathQuery run over a stream selects the same values as the same query run over the decoded
+// GenericValue, for every format and however the stream is read, and that malformed paths and input are rejected.
+
+#include "Solaire/Encode/PathQuery.hpp"
+#include "Solaire/Encode/SchemaFormat.hpp"
+#include "Solaire/Encode/CompressedFormat.hpp"
+#include "EncodeTest.hpp"
+
+namespace Solaire {
+
+    static const char* const TEXT =
+        "{\"routes\":[{\"name\":\"a\",\"hops\":[1,2]},{\"name\":\"b\",\"hops\":[3]},{\"x\":1}],\"a/b\":{\"m~n\":7},"
+        "\"3\":\"three\",\"n\":[[1,2],[3,4]],\"d\":[1.5,2.5]}";
+
+    /*!
+        \brief A format without a Reader, 'u' decodes to 7 and 'n' to null.
+    */
+    class LetterFormat : public Format {
+    public:
+        // Inherited from Format
+
+        GenericValue SOLAIRE_EXPORT_CALL readValue(IStream& aStream) const throw() override {
+            char letter;
+            if(aStream.read(&letter, 1) != 1 || letter != 'u') return GenericValue();
+            return GenericValue(static_cast<uint64_t>(7));
+        }
+
+        bool SOLAIRE_EXPORT_CALL writeValue(const GenericValue& aValue, OStream& aStream) const throw() override {
+            const char letter = aValue.isNull() ? 'n' : 'u';
+            return aStream.write(&letter, 1) == 1;
+        }
+    };
+
+    static bool sameResults(const List<GenericValue>& aFirst, const List<GenericValue>& aSecond) throw() {
+        if(aFirst.size() != aSecond.size()) return false;
+        for(int32_t i = 0; i < aFirst.size(); ++i) if(! sameJson(aFirst[i], aSecond[i])) return false;
+        return true;
+    }
+
+    static void checkQuery(const Format& aFormat, const BufferOStream& aData, const char* const aPath, const char* const aExpected) throw() {
+        PathQuery query(getDefaultAllocator());
+        SOLAIRE_CHECK(query.compile(aPath, static_cast<uint32_t>(std::strlen(aPath))));
+
+        BufferIStream valueInput(aData.getData(), aData.getSize());
+        const GenericValue value = aFormat.readValue(valueInput);
+        ArrayList<GenericValue> valueResults(getDefaultAllocator());
+        query.run(value, valueResults);
+
+        BufferIStream input(aData.getData(), aData.getSize());
+        ArrayList<GenericValue> results(getDefaultAllocator());
+        SOLAIRE_CHECK(query.run(aFormat, input, results));
+        SOLAIRE_CHECK(sameResults(results, valueResults));
+
+        // Streams that Readers can not borrow from select the same values
+        ChunkedIStream chunked(aData.getData(), aData.getSize(), 3);
+        ArrayList<GenericValue> chunkedResults(getDefaultAllocator());
+        SOLAIRE_CHECK(query.run(aFormat, chunked, chunkedResults));
+        SOLAIRE_CHECK(sameResults(chunkedResults, valueResults));
+
+        // The expected results are the JSON text of each value, separated by '|'
+        BufferOStream text(getDefaultAllocator());
+        const JsonFormat json;
+        for(int32_t i = 0; i < results.size(); ++i) {
+            if(i > 0) text.write("|", 1);
+            json.writeValue(results[i], text);
+        }
+        const uint32_t length = static_cast<uint32_t>(std::strlen(aExpected));
+        SOLAIRE_CHECK(text.getSize() == length && (length == 0 || std::memcmp(text.getData(), aExpected, length) == 0));
+    }
+
+    static void testFormat(const Format& aFormat) throw() {
+        const GenericValue value = fromJson(TEXT);
+        BufferOStream output(getDefaultAllocator());
+        write(aFormat, value, output);
+
+        checkQuery(aFormat, output, "/routes/1/name", "\"b\"");
+        checkQuery(aFormat, output, "/routes/*/name", "\"a\"|\"b\"");
+        checkQuery(aFormat, output, "/routes/*/hops/*", "1|2|3");
+        checkQuery(aFormat, output, "/routes/5", "");
+        checkQuery(aFormat, output, "/a~1b/m~0n", "7");
+        checkQuery(aFormat, output, "/3", "\"three\"");
+        checkQuery(aFormat, output, "/n/*/1", "2|4");
+        checkQuery(aFormat, output, "/d/1", "2.5");
+        checkQuery(aFormat, output, "/n/0/0/x", "");
+
+        // The empty path selects the whole value
+        PathQuery root(getDefaultAllocator());
+        SOLAIRE_CHECK(root.compile("", 0) && root.getSegmentCount() == 0);
+        BufferIStream input(output.getData(), output.getSize());
+        ArrayList<GenericValue> results(getDefaultAllocator());
+        SOLAIRE_CHECK(root.run(aFormat, input, results));
+        SOLAIRE_CHECK(results.size() == 1 && sameJson(results[0], value));
+
+        PathQuery members(getDefaultAllocator());
+        SOLAIRE_CHECK(members.compile(makeName("/*")));
+        BufferIStream memberInput(output.getData(), output.getSize());
+        results.clear();
+        SOLAIRE_CHECK(members.run(aFormat, memberInput, results));
+        SOLAIRE_CHECK(results.size() == 5);
+    }
+
+    static void testCompile() throw() {
+        PathQuery query(getDefaultAllocator());
+        SOLAIRE_CHECK(! query.compile(makeName("a")));
+        SOLAIRE_CHECK(! query.compile(makeName("/a~2")));
+        SOLAIRE_CHECK(query.compile(makeName("/")) && query.getSegmentCount() == 1);
+        SOLAIRE_CHECK(query.compile(makeName("/a//b")) && query.getSegmentCount() == 3);
+    }
+
+    static void testMalformed() throw() {
+        const JsonFormat json;
+        PathQuery query(getDefaultAllocator());
+        SOLAIRE_CHECK(query.compile(makeName("/a/0")));
+        for(const char* const text : {"{\"a\":[1,]}", "{\"a\":[1,2", "{\"a\" 1}", ""}) {
+            BufferIStream input(text, static_cast<uint32_t>(std::strlen(text)));
+            ArrayList<GenericValue> results(getDefaultAllocator());
+            SOLAIRE_CHECK(! query.run(json, input, results));
+        }
+
+        // Formats without a Reader decode the whole value first
+        const LetterFormat letters;
+        PathQuery root(getDefaultAllocator());
+        SOLAIRE_CHECK(root.compile("", 0));
+        ArrayList<GenericValue> results(getDefaultAllocator());
+        BufferIStream input("u", 1);
+        SOLAIRE_CHECK(root.run(letters, input, results));
+        SOLAIRE_CHECK(results.size() == 1 && results[0].getUnsigned() == 7);
+        results.clear();
+        BufferIStream empty("", 0);
+        SOLAIRE_CHECK(! root.run(letters, empty, results));
+        SOLAIRE_CHECK(results.size() == 0);
+    }
+}
+
+int main() {
+    using namespace Solaire;
+
+    Schema schema(getDefaultAllocator());
+    schema.addField(makeName("routes"));
+    const JsonFormat json;
+    const BinaryFormat binary;
+    testFormat(json);
+    testFormat(binary);
+    testFormat(SchemaFormat(schema));
+    testFormat(CompressedFormat(json));
+    testCompile();
+    testMalformed();
+
+    return finishTest();
+}
@@ -0,0 +1,131 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+// Checks that Readers decode the same values as Format::readValue from streams that return fewer bytes than requested,
+// that members can be read and skipped one token at a time, and that C++ objects decode through Format::read.
+
+#include "Solaire/Encode/BinaryFormat.hpp"
+#include "EncodeTest.hpp"
+
+namespace Solaire {
+
+    static Reader* createReader(const Format& aFormat, IStream& aStream) throw() {
+        Reader* const reader = aFormat.createReader(getDefaultAllocator(), aStream);
+        SOLAIRE_CHECK(reader != nullptr);
+        return reader;
+    }
+
+    static void destroyReader(Reader* const aReader) throw() {
+        aReader->~Reader();
+        getDefaultAllocator().deallocate(aReader);
+    }
+
+    static void testReadValue(const Format& aFormat) throw() {
+        const GenericValue sample = makeSample();
+        BufferOStream output(getDefaultAllocator());
+        write(aFormat, sample, output);
+
+        for(const uint32_t chunk : {1u, 3u, output.getSize()}) {
+            ChunkedIStream input(output.getData(), output.getSize(), chunk);
+            Reader* const reader = createReader(aFormat, input);
+            if(reader == nullptr) return;
+            GenericValue value;
+            SOLAIRE_CHECK(reader->readValue(value));
+            SOLAIRE_CHECK(! reader->hasFailed());
+            SOLAIRE_CHECK(sameJson(value, sample));
+            destroyReader(reader);
+        }
+    }
+
+    static void testTokens(const Format& aFormat) throw() {
+        BufferOStream output(getDefaultAllocator());
+        write(aFormat, fromJson("{\"skipped\":[1,[2,{\"x\":3}]],\"number\":-7,\"text\":\"a string that is longer than fifteen\"}"), output);
+        ChunkedIStream input(output.getData(), output.getSize(), 2);
+        Reader* const reader = createReader(aFormat, input);
+        if(reader == nullptr) return;
+
+        SOLAIRE_CHECK(reader->peekType() == GenericValue::OBJECT_T);
+        int32_t size;
+        SOLAIRE_CHECK(reader->beginObject(size));
+        uint32_t members = 0;
+        int64_t number = 0;
+        CString text(getDefaultAllocator());
+        while(reader->hasNext()) {
+            CString name(getDefaultAllocator());
+            SOLAIRE_CHECK(reader->readName(name));
+            if(name == makeName("number")) {
+                SOLAIRE_CHECK(reader->readSigned(number));
+            }else if(name == makeName("text")) {
+                SOLAIRE_CHECK(reader->peekType() == GenericValue::STRING_T);
+                SOLAIRE_CHECK(reader->readString(text));
+            }else {
+                SOLAIRE_CHECK(reader->skip());
+            }
+            ++members;
+        }
+        SOLAIRE_CHECK(reader->endObject());
+        SOLAIRE_CHECK(! reader->hasFailed());
+        SOLAIRE_CHECK(members == 3);
+        SOLAIRE_CHECK(number == -7);
+        SOLAIRE_CHECK(text == makeName("a string that is longer than fifteen"));
+        destroyReader(reader);
+
+        // Input that ends inside a value fails the Reader
+        ChunkedIStream truncated(output.getData(), output.getSize() - 1, 2);
+        Reader* const failing = createReader(aFormat, truncated);
+        if(failing == nullptr) return;
+        GenericValue value;
+        SOLAIRE_CHECK(! failing->readValue(value));
+        SOLAIRE_CHECK(failing->hasFailed());
+        destroyReader(failing);
+    }
+
+    static void testRead(Format& aFormat) throw() {
+        ArrayList<ArrayList<uint32_t>> lists(getDefaultAllocator());
+        for(uint32_t i = 0; i < 20; ++i) {
+            ArrayList<uint32_t>& list = lists.pushBack(ArrayList<uint32_t>(getDefaultAllocator()));
+            for(uint32_t j = 0; j < i; ++j) list.pushBack(i * 1000 + j);
+        }
+        BufferOStream output(getDefaultAllocator());
+        SOLAIRE_CHECK(aFormat.write<ArrayList<ArrayList<uint32_t>>>(getDefaultAllocator(), lists, output));
+
+        ChunkedIStream input(output.getData(), output.getSize(), 5);
+        const ArrayList<ArrayList<uint32_t>> decoded = aFormat.read<ArrayList<ArrayList<uint32_t>>>(getDefaultAllocator(), input);
+        SOLAIRE_CHECK(decoded.size() == 20);
+        if(decoded.size() != 20) return;
+        for(int32_t i = 0; i < 20; ++i) {
+            SOLAIRE_CHECK(decoded[i].size() == i);
+            if(i > 0 && decoded[i].size() == i) SOLAIRE_CHECK(decoded[i][i - 1] == static_cast<uint32_t>(i * 1000 + i - 1));
+        }
+    }
+}
+
+int main() {
+    using namespace Solaire;
+
+    JsonFormat json;
+    BinaryFormat binary;
+    testReadValue(json);
+    testReadValue(binary);
+    testTokens(json);
+    testTokens(binary);
+    testRead(json);
+    testRead(binary);
+
+    return finishTest();
+}
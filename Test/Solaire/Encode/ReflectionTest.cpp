@@ -0,0 +1,165 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+// Checks that structs listed with SOLAIRE_ENCODE_BEGIN encode to the same bytes whether they are written through a
+// Writer or a GenericValue, and decode the same fields from either, whatever the order or extra members of the input.
+
+#include "Solaire/Encode/Reflection.hpp"
+#include "Solaire/Encode/BinaryFormat.hpp"
+#include "EncodeTest.hpp"
+
+namespace ReflectionTest {
+    struct Inner {
+        int32_t a = 0;
+        double b = 0.0;
+    };
+
+    struct Outer {
+        uint32_t id = 0;
+        Solaire::CString name;
+        Solaire::ArrayList<int32_t> values;
+        Inner inner;
+        bool flag = false;
+        Solaire::ArrayList<Inner> list;
+    };
+}
+
+SOLAIRE_ENCODE_BEGIN(ReflectionTest::Inner)
+    SOLAIRE_ENCODE_FIELD(a)
+    SOLAIRE_ENCODE_FIELD(b)
+SOLAIRE_ENCODE_END
+
+SOLAIRE_ENCODE_BEGIN(ReflectionTest::Outer)
+    SOLAIRE_ENCODE_FIELD(id)
+    SOLAIRE_ENCODE_FIELD(name)
+    SOLAIRE_ENCODE_FIELD(values)
+    SOLAIRE_ENCODE_FIELD(inner)
+    SOLAIRE_ENCODE_FIELD(flag)
+    SOLAIRE_ENCODE_FIELD(list)
+SOLAIRE_ENCODE_END
+
+namespace Solaire {
+
+    typedef ReflectionTest::Inner Inner;
+    typedef ReflectionTest::Outer Outer;
+
+    static Outer makeOuter() throw() {
+        Outer outer;
+        outer.id = 7;
+        outer.name = makeName("bob");
+        for(int32_t i = 1; i <= 3; ++i) outer.values.pushBack(i);
+        outer.inner.a = -4;
+        outer.inner.b = 2.5;
+        outer.flag = true;
+        Inner inner;
+        inner.a = 1;
+        outer.list.pushBack(inner);
+        inner.a = 9;
+        outer.list.pushBack(inner);
+        return outer;
+    }
+
+    static bool isOuter(const Outer& aOuter) throw() {
+        return aOuter.id == 7 && aOuter.name == makeName("bob") &&
+            aOuter.values.size() == 3 && aOuter.values[2] == 3 &&
+            aOuter.inner.a == -4 && aOuter.inner.b == 2.5 && aOuter.flag &&
+            aOuter.list.size() == 2 && aOuter.list[0].a == 1 && aOuter.list[1].a == 9;
+    }
+
+    static void testHashes() throw() {
+        static_assert(hashFieldLiteral("abc") == 0x1A47E90BU, "hashFieldLiteral is FNV-1a");
+        for(const char* const name : {"", "id", "name", "a much longer member name"}) {
+            const uint32_t length = static_cast<uint32_t>(std::strlen(name));
+            SOLAIRE_CHECK(hashFieldLiteral(name) == hashFieldName(name, length));
+            SOLAIRE_CHECK(hashFieldLiteral(name) == GenericObjectMap::hash(makeName(name)));
+        }
+    }
+
+    static void testGenericValue() throw() {
+        const GenericValue value = encode<Outer>(getDefaultAllocator(), makeOuter());
+        SOLAIRE_CHECK(value.isObject() && value.size() == 6);
+        SOLAIRE_CHECK(sameJson(value, fromJson(
+            "{\"id\":7,\"name\":\"bob\",\"values\":[1,2,3],\"inner\":{\"a\":-4,\"b\":2.5},\"flag\":true,"
+            "\"list\":[{\"a\":1,\"b\":0.0},{\"a\":9,\"b\":0.0}]}"
+        )));
+        SOLAIRE_CHECK(isOuter(decode<Outer>(getDefaultAllocator(), value)));
+
+        // Fields that are missing keep their default value, anything other than an object decodes to the default
+        const Outer partial = decode<Outer>(getDefaultAllocator(), fromJson("{\"flag\":true,\"other\":1}"));
+        SOLAIRE_CHECK(partial.flag && partial.id == 0 && partial.name.size() == 0 && partial.list.size() == 0);
+        SOLAIRE_CHECK(decode<Outer>(getDefaultAllocator(), fromJson("[7]")).id == 0);
+    }
+
+    static void testFormat(Format& aFormat) throw() {
+        // The Writer produces the same bytes as the GenericValue
+        BufferOStream expected(getDefaultAllocator());
+        write(aFormat, encode<Outer>(getDefaultAllocator(), makeOuter()), expected);
+        BufferOStream output(getDefaultAllocator());
+        SOLAIRE_CHECK(aFormat.write<Outer>(getDefaultAllocator(), makeOuter(), output));
+        SOLAIRE_CHECK(sameBytes(output, expected));
+
+        for(const uint32_t chunk : {1u, 7u, output.getSize()}) {
+            ChunkedIStream input(output.getData(), output.getSize(), chunk);
+            SOLAIRE_CHECK(isOuter(aFormat.read<Outer>(getDefaultAllocator(), input)));
+        }
+        BufferIStream input(output.getData(), output.getSize());
+        SOLAIRE_CHECK(isOuter(decode<Outer>(getDefaultAllocator(), aFormat.readValue(input))));
+    }
+
+    static void checkText(Format& aFormat, const char* const aText, const bool aComplete) throw() {
+        const uint32_t length = static_cast<uint32_t>(std::strlen(aText));
+        ChunkedIStream input(aText, length, 5);
+        const Outer fromReader = aFormat.read<Outer>(getDefaultAllocator(), input);
+        BufferIStream valueInput(aText, length);
+        const Outer fromValue = decode<Outer>(getDefaultAllocator(), aFormat.readValue(valueInput));
+        if(aComplete) {
+            SOLAIRE_CHECK(isOuter(fromReader));
+            SOLAIRE_CHECK(isOuter(fromValue));
+        }else {
+            SOLAIRE_CHECK(fromReader.id == 7 && fromValue.id == 7);
+        }
+    }
+
+    static void testMatching() throw() {
+        JsonFormat json;
+
+        // Members in another order, unknown members and escaped names
+        checkText(json,
+            "{\"junk\":[1,{\"a\":2}],\"flag\":true,\"list\":[{\"b\":1,\"a\":1},{\"a\":9}],"
+            "\"inner\":{\"b\":2.5,\"a\":-4,\"zz\":1},\"na\\u006de\":\"bob\",\"values\":[1,2,3],\"id\":7}", true);
+
+        // Names longer than NAME_CAPACITY are skipped by the Reader and never match
+        char text[512];
+        std::snprintf(text, sizeof(text), "{\"%0*d\":1,\"id\":7}", 300, 0);
+        checkText(json, text, false);
+    }
+}
+
+int main() {
+    using namespace Solaire;
+
+    JsonFormat json;
+    BinaryFormat binary;
+    testHashes();
+    testGenericValue();
+    testFormat(json);
+    testFormat(binary);
+    testMatching();
+
+    return finishTest();
+}
@@ -0,0 +1,157 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+// Checks that values are moved rather than copied where the caller gives them up, that containers are sized once when
+// their element count is known, and that counts read from the input never reserve more than the input can hold.
+
+#include "Solaire/Encode/BinaryFormat.hpp"
+#include "EncodeTest.hpp"
+
+namespace Solaire {
+
+    static const char* const LONG_TEXT = "this is a string long enough to need a node";
+
+    static void testMoves() throw() {
+        const uint32_t length = static_cast<uint32_t>(std::strlen(LONG_TEXT));
+        GenericValue string = encode<String<char>>(getDefaultAllocator(), makeName(LONG_TEXT));
+        SOLAIRE_CHECK(hasString(string, LONG_TEXT));
+
+        ArrayList<int32_t> numbers(getDefaultAllocator());
+        for(int32_t i = 0; i < 100; ++i) numbers.pushBack(i);
+        const GenericValue array = encode<ArrayList<int32_t>>(getDefaultAllocator(), std::move(numbers));
+        SOLAIRE_CHECK(array.size() == 100 && array[99].getSigned() == 99);
+
+        ArrayList<char> characters(getDefaultAllocator());
+        characters.pushBack(1);
+        characters.pushBack(0);
+        const GenericValue characterArray = encode<ArrayList<char>>(getDefaultAllocator(), std::move(characters));
+        SOLAIRE_CHECK(characterArray.size() == 2 && characterArray[0].getChar() == 1);
+        const ArrayList<char> decoded = decode<StaticContainer<char>>(getDefaultAllocator(), characterArray);
+        SOLAIRE_CHECK(decoded.size() == 2 && decoded[0] == 1 && decoded[1] == 0);
+
+        // Moved values are left null
+        GenericValue object;
+        object.setObject();
+        object.reserve(40);
+        char name[8];
+        for(int32_t i = 0; i < 40; ++i) {
+            GenericValue member(i);
+            object.emplace(CString(getDefaultAllocator(), name, static_cast<uint32_t>(std::snprintf(name, sizeof(name), "k%d", i))), std::move(member));
+            SOLAIRE_CHECK(member.isNull());
+        }
+        for(int32_t i = 0; i < 40; ++i) {
+            const GenericValue* const member = object.find(CString(getDefaultAllocator(), name, static_cast<uint32_t>(std::snprintf(name, sizeof(name), "k%d", i))));
+            SOLAIRE_CHECK(member != nullptr && member->getSigned() == i);
+        }
+
+        GenericValue list;
+        list.setArray();
+        list.reserve(10);
+        GenericValue element(CString(getDefaultAllocator(), LONG_TEXT, length));
+        list.pushBack(std::move(element));
+        SOLAIRE_CHECK(element.isNull() && list.size() == 1 && hasString(list[0], LONG_TEXT));
+
+        // Values moved into a document are copied into its arena
+        GenericDocument document;
+        document.getRoot().setArray();
+        GenericValue member(CString(getDefaultAllocator(), LONG_TEXT, length));
+        document.getRoot().pushBack(std::move(member));
+        SOLAIRE_CHECK(hasString(document.getRoot()[0], LONG_TEXT));
+        document.getRoot().setString(CString(getDefaultAllocator(), LONG_TEXT, length));
+        SOLAIRE_CHECK(hasString(document.getRoot(), LONG_TEXT));
+    }
+
+    static void testPresized() throw() {
+        // Decoding a list of known size allocates its elements once
+        const uint32_t size = 10000;
+        ArrayList<uint32_t> numbers(getDefaultAllocator());
+        for(uint32_t i = 0; i < size; ++i) numbers.pushBack(i);
+        BinaryFormat binary;
+        BufferOStream output(getDefaultAllocator());
+        SOLAIRE_CHECK(binary.write<ArrayList<uint32_t>>(getDefaultAllocator(), numbers, output));
+
+        CountingAllocator allocator;
+        {
+            BufferIStream input(output.getData(), output.getSize());
+            const ArrayList<uint32_t> decoded = binary.read<ArrayList<uint32_t>>(allocator, input);
+            SOLAIRE_CHECK(decoded.size() == static_cast<int32_t>(size) && decoded[size - 1] == size - 1);
+        }
+        SOLAIRE_CHECK(allocator.getAllocations() <= 2);
+
+        // Streams of unknown size reserve in steps, so large lists still decode whole
+        for(const uint32_t chunk : {1u, 1000u}) {
+            ChunkedIStream input(output.getData(), output.getSize(), chunk);
+            const ArrayList<uint32_t> decoded = binary.read<ArrayList<uint32_t>>(getDefaultAllocator(), input);
+            SOLAIRE_CHECK(decoded.size() == static_cast<int32_t>(size) && decoded[size - 1] == size - 1);
+        }
+        ChunkedIStream input(output.getData(), output.getSize(), 1000);
+        GenericValue value;
+        Reader* const reader = binary.createReader(getDefaultAllocator(), input);
+        SOLAIRE_CHECK(reader != nullptr);
+        if(reader == nullptr) return;
+        SOLAIRE_CHECK(reader->readValue(value) && value.size() == static_cast<int32_t>(size));
+        reader->~Reader();
+        getDefaultAllocator().deallocate(reader);
+    }
+
+    static void checkReserveSize(const Format& aFormat, IStream& aStream, const int32_t aMaximum) throw() {
+        Reader* const reader = aFormat.createReader(getDefaultAllocator(), aStream);
+        SOLAIRE_CHECK(reader != nullptr);
+        if(reader == nullptr) return;
+        int32_t size;
+        SOLAIRE_CHECK(reader->beginArray(size) && size == 0x7FFFFFFF);
+        SOLAIRE_CHECK(reader->getReserveSize(size) > 0 && reader->getReserveSize(size) <= aMaximum);
+        SOLAIRE_CHECK(reader->getReserveSize(Reader::UNKNOWN_SIZE) == 0);
+        reader->~Reader();
+        getDefaultAllocator().deallocate(reader);
+    }
+
+    static void testClamped() throw() {
+        // An array that claims 2^31 - 1 elements followed by 3 bytes
+        BinaryFormat binary;
+        BufferOStream output(getDefaultAllocator());
+        Writer* const writer = binary.createWriter(getDefaultAllocator(), output);
+        SOLAIRE_CHECK(writer != nullptr);
+        if(writer == nullptr) return;
+        SOLAIRE_CHECK(writer->beginArray(0x7FFFFFFF));
+        for(uint32_t i = 0; i < 3; ++i) SOLAIRE_CHECK(writer->writeUnsigned(i));
+        SOLAIRE_CHECK(writer->flush());
+        writer->~Writer();
+        getDefaultAllocator().deallocate(writer);
+
+        BufferIStream input(output.getData(), output.getSize());
+        checkReserveSize(binary, input, static_cast<int32_t>(output.getSize()));
+        ChunkedIStream chunked(output.getData(), output.getSize(), 4);
+        checkReserveSize(binary, chunked, Reader::MAX_RESERVE);
+
+        BufferIStream valueInput(output.getData(), output.getSize());
+        SOLAIRE_CHECK(binary.readValue(valueInput).isNull());
+        ChunkedIStream listInput(output.getData(), output.getSize(), 4);
+        SOLAIRE_CHECK(binary.read<ArrayList<uint32_t>>(getDefaultAllocator(), listInput).size() <= 3);
+    }
+}
+
+int main() {
+    using namespace Solaire;
+
+    testMoves();
+    testPresized();
+    testClamped();
+
+    return finishTest();
+}
@@ -0,0 +1,135 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+// Checks that SchemaFormat reads back what it writes with fewer bytes than BinaryFormat, and that a format with an older
+// schema, which lacks some of the ids, still reads everything that it knows about.
+
+#include "Solaire/Encode/SchemaFormat.hpp"
+#include "Solaire/Encode/Reflection.hpp"
+#include "EncodeTest.hpp"
+
+namespace SchemaFormatTest {
+    struct Record {
+        uint32_t id = 0;
+        Solaire::CString name;
+        double score = 0.0;
+    };
+}
+
+SOLAIRE_ENCODE_BEGIN(SchemaFormatTest::Record)
+    SOLAIRE_ENCODE_FIELD(id)
+    SOLAIRE_ENCODE_FIELD(name)
+    SOLAIRE_ENCODE_FIELD(score)
+SOLAIRE_ENCODE_END
+
+namespace Solaire {
+
+    typedef SchemaFormatTest::Record Record;
+
+    static void testSchema() throw() {
+        Schema schema(getDefaultAllocator());
+        SOLAIRE_CHECK(schema.addField("id", 2) == 1);
+        SOLAIRE_CHECK(schema.addField("name", 4) == 2);
+        SOLAIRE_CHECK(schema.addField(makeName("id")) == 1);
+
+        char name[16];
+        for(uint32_t i = 0; i < 100; ++i) {
+            const int length = std::snprintf(name, sizeof(name), "f%u", i);
+            SOLAIRE_CHECK(schema.addField(name, static_cast<uint32_t>(length)) == 3 + i);
+        }
+        for(uint32_t i = 0; i < 100; ++i) {
+            std::snprintf(name, sizeof(name), "f%u", i);
+            SOLAIRE_CHECK(schema.getId(makeName(name)) == 3 + i);
+        }
+        SOLAIRE_CHECK(schema.getId("none", 4) == Schema::NO_ID);
+        SOLAIRE_CHECK(schema.getName(2) != nullptr && *schema.getName(2) == makeName("name"));
+        SOLAIRE_CHECK(schema.getName(0) == nullptr && schema.getName(200) == nullptr);
+    }
+
+    static void testVersions() throw() {
+        Schema older(getDefaultAllocator());
+        older.addField(makeName("id"));
+        older.addField(makeName("name"));
+        Schema newer(getDefaultAllocator());
+        newer.addField(makeName("id"));
+        newer.addField(makeName("name"));
+        newer.addField(makeName("score"));
+        newer.addField(makeName("extra"));
+        SchemaFormat olderFormat(older);
+        SchemaFormat newerFormat(newer);
+        const BinaryFormat binary;
+
+        const GenericValue value = fromJson("{\"id\":5,\"score\":1.5,\"unlisted\":true,\"name\":{\"extra\":-3,\"name\":\"x\"}}");
+        BufferOStream output(getDefaultAllocator());
+        write(newerFormat, value, output);
+        BufferOStream binaryOutput(getDefaultAllocator());
+        write(binary, value, binaryOutput);
+        SOLAIRE_CHECK(output.getSize() < binaryOutput.getSize());
+
+        BufferIStream input(output.getData(), output.getSize());
+        SOLAIRE_CHECK(newerFormat.readValue(input) == value);
+
+        // Members with ids that the older schema does not have are skipped, names that were written in full are kept
+        BufferIStream olderInput(output.getData(), output.getSize());
+        const GenericValue decoded = olderFormat.readValue(olderInput);
+        SOLAIRE_CHECK(sameJson(decoded, fromJson("{\"id\":5,\"unlisted\":true,\"name\":{\"name\":\"x\"}}")));
+
+        BufferIStream readerInput(output.getData(), output.getSize());
+        Reader* const reader = olderFormat.createReader(getDefaultAllocator(), readerInput);
+        SOLAIRE_CHECK(reader != nullptr);
+        if(reader == nullptr) return;
+        int32_t size;
+        CString name(getDefaultAllocator());
+        SOLAIRE_CHECK(reader->beginObject(size) && size == 4);
+        SOLAIRE_CHECK(reader->hasNext() && reader->readName(name) && name == makeName("id"));
+        SOLAIRE_CHECK(reader->skip());
+        SOLAIRE_CHECK(reader->endObject());
+        SOLAIRE_CHECK(! reader->hasFailed());
+        reader->~Reader();
+        getDefaultAllocator().deallocate(reader);
+
+        // Reflected structs through both schemas
+        Record record;
+        record.id = 9;
+        record.name = makeName("bob");
+        record.score = 2.25;
+        BufferOStream recordOutput(getDefaultAllocator());
+        SOLAIRE_CHECK(newerFormat.write<Record>(getDefaultAllocator(), record, recordOutput));
+        BufferIStream newerRecordInput(recordOutput.getData(), recordOutput.getSize());
+        const Record newerRecord = newerFormat.read<Record>(getDefaultAllocator(), newerRecordInput);
+        SOLAIRE_CHECK(newerRecord.id == 9 && newerRecord.name == makeName("bob") && newerRecord.score == 2.25);
+        BufferIStream olderRecordInput(recordOutput.getData(), recordOutput.getSize());
+        const Record olderRecord = olderFormat.read<Record>(getDefaultAllocator(), olderRecordInput);
+        SOLAIRE_CHECK(olderRecord.id == 9 && olderRecord.name == makeName("bob") && olderRecord.score == 0.0);
+    }
+}
+
+int main() {
+    using namespace Solaire;
+
+    Schema schema(getDefaultAllocator());
+    schema.addField(makeName("a"));
+    schema.addField(makeName("d"));
+    const SchemaFormat format(schema);
+    checkRoundTrip(format);
+    checkTruncated(format);
+    testSchema();
+    testVersions();
+
+    return finishTest();
+}
@@ -0,0 +1,114 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+// Checks that short strings are stored inside GenericValue until they are modified, that const access never changes how
+// a string is stored, and that setting a string from its own characters is safe.
+
+#include "Solaire/Encode/BinaryFormat.hpp"
+#include "EncodeTest.hpp"
+
+namespace Solaire {
+
+    static const char* const SHORT_TEXT = "short";
+    static const char* const LONG_TEXT = "a string that is longer than fifteen";
+
+    static void testInline() throw() {
+        static_assert(sizeof(GenericValue) <= 32, "Inline strings do not make GenericValue larger");
+
+        GenericValue value;
+        value.setString(SHORT_TEXT, 5);
+        SOLAIRE_CHECK(value.getStringPointer() != nullptr && hasString(value, SHORT_TEXT));
+        GenericValue copy(value);
+        SOLAIRE_CHECK(copy.getStringPointer() != nullptr && copy.getStringPointer() != value.getStringPointer());
+        GenericValue moved(std::move(copy));
+        SOLAIRE_CHECK(moved.getStringPointer() != nullptr && hasString(moved, SHORT_TEXT));
+
+        GenericValue full;
+        full.setString("fifteen chars!!", GenericValue::INLINE_CAPACITY);
+        SOLAIRE_CHECK(full.getStringPointer() != nullptr);
+        GenericValue longer;
+        longer.setString(LONG_TEXT, static_cast<uint32_t>(std::strlen(LONG_TEXT)));
+        SOLAIRE_CHECK(longer.getStringPointer() == nullptr && hasString(longer, LONG_TEXT));
+
+        // Strings decoded by a format are stored inline when they fit
+        const BinaryFormat binary;
+        BufferOStream output(getDefaultAllocator());
+        GenericValue array;
+        array.pushBack(value);
+        array.pushBack(longer);
+        write(binary, array, output);
+        BufferIStream input(output.getData(), output.getSize());
+        const GenericValue decoded = binary.readValue(input);
+        SOLAIRE_CHECK(decoded.size() == 2);
+        if(decoded.size() != 2) return;
+        SOLAIRE_CHECK(decoded[0].getStringPointer() != nullptr && hasString(decoded[0], SHORT_TEXT));
+        SOLAIRE_CHECK(hasString(decoded[1], LONG_TEXT));
+    }
+
+    static void testConstAccess() throw() {
+        // Reading through the const getString leaves the string where it is
+        GenericValue value;
+        value.setString(SHORT_TEXT, 5);
+        const GenericValue& constValue = value;
+        const GenericValue::StringView view = constValue.getString();
+        SOLAIRE_CHECK(view.getLength() == 5 && view[0] == 's');
+        SOLAIRE_CHECK(view.getCharacters() == value.getStringPointer());
+
+        GenericValue number(static_cast<uint64_t>(5));
+        SOLAIRE_CHECK(static_cast<const GenericValue&>(number).getString().getLength() == 0);
+
+        // The non-const getString moves it into a CString that can be modified
+        value.getString().pushBack('!');
+        SOLAIRE_CHECK(value.getStringPointer() == nullptr && hasString(value, "short!"));
+    }
+
+    static void testSelfAssignment() throw() {
+        // Setting a string from the value's own characters copies them before the old storage is released
+        for(const char* const text : {SHORT_TEXT, LONG_TEXT}) {
+            const uint32_t length = static_cast<uint32_t>(std::strlen(text));
+            GenericValue value;
+            value.setString(text, length);
+            value.getString();
+            value.setString(value.getString());
+            SOLAIRE_CHECK(hasString(value, text));
+            const GenericValue shared(value);
+            value.setString(value.getString());
+            SOLAIRE_CHECK(hasString(value, text) && hasString(shared, text));
+
+            GenericValue parent;
+            parent[makeName("m")].setString(text, length);
+            parent.setString(parent[makeName("m")].getString());
+            SOLAIRE_CHECK(hasString(parent, text));
+
+            GenericDocument document;
+            document.getRoot()[makeName("m")].setString(text, length);
+            document.getRoot().setString(document.getRoot()[makeName("m")].getString());
+            SOLAIRE_CHECK(hasString(document.getRoot(), text));
+        }
+    }
+}
+
+int main() {
+    using namespace Solaire;
+
+    testInline();
+    testConstAccess();
+    testSelfAssignment();
+
+    return finishTest();
+}
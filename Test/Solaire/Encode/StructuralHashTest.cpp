@@ -0,0 +1,171 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+// Checks that GenericValue::operator== compares structure and contents however values are stored, that values which
+// compare equal have the same hash, that the hashes built while decoding match those calculated afterwards, and
+// that cached hashes follow modifications.
+
+#include "Solaire/Encode/StructuralHash.hpp"
+#include "Solaire/Encode/BinaryFormat.hpp"
+#include "EncodeTest.hpp"
+
+namespace Solaire {
+
+    /*!
+        \brief Copy a value into new nodes, with object members in reverse order and packed arrays unpacked.
+    */
+    static GenericValue rebuild(const GenericValue& aValue) throw() {
+        GenericValue copy;
+        if(aValue.isObject()) {
+            copy.setObject();
+            const GenericValue::GenericObject& members = aValue.getObject();
+            for(int32_t i = members.size() - 1; i >= 0; --i) copy.emplace(members.begin()[i].first, rebuild(members.begin()[i].second));
+        }else if(aValue.isArray()) {
+            copy.setArray();
+            for(int32_t i = 0; i < aValue.size(); ++i) copy.pushBack(rebuild(aValue[i]));
+        }else if(aValue.isString()) {
+            copy.setString(aValue.getString().getCharacters(), aValue.getStringLength());
+        }else {
+            copy = aValue;
+        }
+        return copy;
+    }
+
+    static bool sameHash(const GenericValue& aFirst, const GenericValue& aSecond) throw() {
+        return aFirst == aSecond && aSecond == aFirst && aFirst.hash() == aSecond.hash();
+    }
+
+    static void testEquality() throw() {
+        SOLAIRE_CHECK(sameHash(GenericValue(), GenericValue()));
+        SOLAIRE_CHECK(sameHash(GenericValue(0.0), GenericValue(-0.0)));
+        SOLAIRE_CHECK(sameHash(makeSample(), makeSample()));
+        SOLAIRE_CHECK(sameHash(makeSample(), rebuild(makeSample())));
+        SOLAIRE_CHECK(sameHash(fromJson("{\"a\":1,\"b\":[2]}"), fromJson("{\"b\":[2],\"a\":1}")));
+
+        // Short strings are stored inline and long ones in a node
+        GenericValue string(makeName("short"));
+        GenericValue longString(makeName("a string that is longer than fifteen"));
+        longString.setString(makeName("short"));
+        SOLAIRE_CHECK(sameHash(string, longString));
+
+        GenericValue packed;
+        int64_t* const elements = packed.setSignedArray(3);
+        elements[0] = -1;
+        elements[1] = 0;
+        elements[2] = 1;
+        GenericValue unpacked;
+        unpacked.setArray();
+        for(const int64_t element : {-1, 0, 1}) unpacked.pushBack(GenericValue(element));
+        SOLAIRE_CHECK(sameHash(packed, unpacked));
+
+        // Values of different types are never equal
+        const GenericValue different[] = {
+            GenericValue(), GenericValue(static_cast<uint64_t>(1)), GenericValue(static_cast<int64_t>(1)), GenericValue(1.0),
+            GenericValue(true), GenericValue('1'), GenericValue(makeName("1")), fromJson("[1]"), fromJson("{\"1\":1}"),
+            fromJson("[]"), fromJson("{}"), fromJson("[1,2]"), fromJson("[2,1]"), fromJson("{\"1\":2}"), fromJson("{\"2\":1}")
+        };
+        const uint32_t count = sizeof(different) / sizeof(different[0]);
+        for(uint32_t i = 0; i < count; ++i) {
+            for(uint32_t j = 0; j < count; ++j) {
+                SOLAIRE_CHECK((different[i] == different[j]) == (i == j));
+                if(i != j) SOLAIRE_CHECK(different[i].hash() != different[j].hash());
+            }
+        }
+    }
+
+    static void testStable() throw() {
+        // The hash is the same on every platform and in every run
+        SOLAIRE_CHECK(GenericValue().hash() == 0xE220A8397B1DCDAFULL);
+        SOLAIRE_CHECK(fromJson("[1,\"a\",{\"b\":null},-2,0.5,true]").hash() == 0x5AEA3201E05F1924ULL);
+        SOLAIRE_CHECK(makeSample().hash() == 0x7D57A0209D708229ULL);
+    }
+
+    static void testIncremental() throw() {
+        // Hashes built from the pieces match GenericValue::hash
+        const GenericValue value = fromJson("[1,{\"name\":\"x\",\"n\":-2}]");
+        StructuralHash::ObjectHash object;
+        object.add(StructuralHash::hashName("n", 1), StructuralHash::hashSigned(-2));
+        object.add(StructuralHash::hashName("name", 4), StructuralHash::hashString("x", 1));
+        StructuralHash::ArrayHash array;
+        array.add(StructuralHash::hashUnsigned(1));
+        array.add(object.finish());
+        SOLAIRE_CHECK(array.finish() == value.hash());
+
+        // Decoded values cache the hash that was built while they were read
+        const JsonFormat json;
+        const BinaryFormat binary;
+        for(const Format* const format : {static_cast<const Format*>(&json), static_cast<const Format*>(&binary)}) {
+            const GenericValue sample = makeSample();
+            BufferOStream output(getDefaultAllocator());
+            write(*format, sample, output);
+            BufferIStream input(output.getData(), output.getSize());
+            const GenericValue decoded = format->readValue(input);
+            SOLAIRE_CHECK(sameHash(decoded, rebuild(sample)));
+            SOLAIRE_CHECK(decoded.hash() == sample.hash());
+        }
+    }
+
+    static void testCachedHashes() throw() {
+        // Replacing or modifying the contents of a container forgets its cached hash
+        GenericValue array;
+        array.setArray();
+        array.pushBack(GenericValue(1u));
+        array.hash();
+        array.setArray();
+        SOLAIRE_CHECK(sameHash(array, fromJson("[]")));
+
+        GenericValue object;
+        object[makeName("a")] = GenericValue(1u);
+        object.hash();
+        object.setObject();
+        SOLAIRE_CHECK(sameHash(object, fromJson("{}")));
+
+        GenericValue list = fromJson("[1,[2]]");
+        list.hash();
+        list[1].pushBack(GenericValue(3u));
+        SOLAIRE_CHECK(sameHash(list, fromJson("[1,[2,3]]")));
+
+        // A reference taken before the hash was cached is not tracked, but equality does not rely on the hash
+        GenericValue first;
+        first.pushBack(GenericValue(1u));
+        GenericValue second;
+        second.pushBack(GenericValue(2u));
+        GenericValue& element = first[0];
+        first.hash();
+        element = GenericValue(2u);
+        SOLAIRE_CHECK(first == second);
+
+        // Copies share the cached hash until one of them is modified
+        GenericValue copy(list);
+        SOLAIRE_CHECK(sameHash(copy, list));
+        copy[0] = GenericValue(5u);
+        SOLAIRE_CHECK(copy != list && copy.hash() != list.hash());
+        SOLAIRE_CHECK(sameHash(list, fromJson("[1,[2,3]]")));
+    }
+}
+
+int main() {
+    using namespace Solaire;
+
+    testEquality();
+    testStable();
+    testIncremental();
+    testCachedHashes();
+
+    return finishTest();
+}
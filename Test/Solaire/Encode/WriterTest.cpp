@@ -0,0 +1,111 @@
+//Copyright 2015 Adam Smith
+//
+//Licensed under the Apache License, Version 2.0 (the "License");
+//you may not use this file except in compliance with the License.
+//You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+//Unless required by applicable law or agreed to in writing, software
+//distributed under the License is distributed on an "AS IS" BASIS,
+//WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//See the License for the specific language governing permissions and
+//limitations under the License.
+
+// Contact :
+// Email             : solairelibrary@mail.com
+// GitHub repository : https://github.com/SolaireLibrary/SolaireCPP
+
+// Checks that streaming through a Writer produces the same bytes as encoding a GenericValue tree, both for whole values
+// and for C++ objects encoded with Format::write.
+
+#include "Solaire/Encode/BinaryFormat.hpp"
+#include "EncodeTest.hpp"
+
+namespace Solaire {
+
+    struct Point {
+        int32_t x;
+        int32_t y;
+    };
+
+    // Point has no write function, so Format::write encodes it as a GenericValue first
+    template<>
+    struct Encoder<Point> {
+        typedef Point DecodeType;
+
+        static DecodeType decode(Allocator& aAllocator, const GenericValue& aValue) throw() {
+            return Point{static_cast<int32_t>(aValue[0].getSigned()), static_cast<int32_t>(aValue[1].getSigned())};
+        }
+
+        static GenericValue encode(Allocator& aAllocator, const Point& aPoint) throw() {
+            GenericValue value;
+            value.pushBack(GenericValue(static_cast<int64_t>(aPoint.x)));
+            value.pushBack(GenericValue(static_cast<int64_t>(aPoint.y)));
+            return value;
+        }
+    };
+
+    static void testWriteValue(const Format& aFormat) throw() {
+        const GenericValue sample = makeSample();
+        BufferOStream expected(getDefaultAllocator());
+        write(aFormat, sample, expected);
+
+        BufferOStream output(getDefaultAllocator());
+        Writer* const writer = aFormat.createWriter(getDefaultAllocator(), output);
+        SOLAIRE_CHECK(writer != nullptr);
+        if(writer == nullptr) return;
+        SOLAIRE_CHECK(writer->writeValue(sample));
+        SOLAIRE_CHECK(writer->flush());
+        writer->~Writer();
+        getDefaultAllocator().deallocate(writer);
+        SOLAIRE_CHECK(sameBytes(output, expected));
+    }
+
+    template<class T>
+    static void checkEncoder(Format& aFormat, const T& aValue) throw() {
+        BufferOStream expected(getDefaultAllocator());
+        write(aFormat, Encoder<T>::encode(getDefaultAllocator(), aValue), expected);
+
+        BufferOStream output(getDefaultAllocator());
+        SOLAIRE_CHECK(aFormat.write<T>(getDefaultAllocator(), aValue, output));
+        SOLAIRE_CHECK(sameBytes(output, expected));
+    }
+
+    static void testEncoders(Format& aFormat) throw() {
+        static_assert(EncoderHasWrite<uint32_t>::value, "Numbers are streamed");
+        static_assert(! EncoderHasWrite<Point>::value, "Point is encoded through a GenericValue");
+
+        ArrayList<uint32_t> numbers(getDefaultAllocator());
+        for(uint32_t i = 0; i < 100; ++i) numbers.pushBack(i * 1000);
+        checkEncoder(aFormat, numbers);
+
+        ArrayList<double> doubles(getDefaultAllocator());
+        doubles.pushBack(-0.5);
+        doubles.pushBack(1e300);
+        checkEncoder(aFormat, doubles);
+
+        ArrayList<ArrayList<int32_t>> nested(getDefaultAllocator());
+        for(int32_t i = 0; i < 3; ++i) {
+            ArrayList<int32_t>& inner = nested.pushBack(ArrayList<int32_t>(getDefaultAllocator()));
+            for(int32_t j = 0; j <= i; ++j) inner.pushBack(-j);
+        }
+        checkEncoder(aFormat, nested);
+
+        checkEncoder(aFormat, makeName("a string that is longer than fifteen"));
+        checkEncoder(aFormat, Point{3, -4});
+    }
+}
+
+int main() {
+    using namespace Solaire;
+
+    JsonFormat json;
+    BinaryFormat binary;
+    testWriteValue(json);
+    testWriteValue(binary);
+    testEncoders(json);
+    testEncoders(binary);
+
+    return finishTest();
+}